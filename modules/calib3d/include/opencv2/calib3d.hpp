@@ -3658,6 +3658,28 @@ void initUndistortRectifyMap(InputArray cameraMatrix, InputArray distCoeffs,
                              InputArray R, InputArray newCameraMatrix,
                              Size size, int m1type, OutputArray map1, OutputArray map2);
 
+/** @brief Computes the undistortion and rectification transformation map at the nodes of a sparse grid.
+
+The function computes the same map as #initUndistortRectifyMap with m1type=CV_32FC2, but only at
+the destination pixels (i\*gridStep, j\*gridStep). The grid is passed to #remapGrid, which
+interpolates the map between the nodes on the fly. It takes gridStep\f$^2\f$ times less
+memory than the dense map, so it is much cheaper to keep and to read for the large images and the
+multi-camera setups.
+
+@param cameraMatrix Input camera matrix, see #initUndistortRectifyMap.
+@param distCoeffs Input vector of distortion coefficients, see #initUndistortRectifyMap.
+@param R Optional rectification transformation in the object space, see #initUndistortRectifyMap.
+@param newCameraMatrix New camera matrix, see #initUndistortRectifyMap.
+@param size Undistorted image size.
+@param gridStep The distance between the grid nodes in pixels, e.g. 8 or 16.
+@param grid The output CV_32FC2 map of ((size.width - 1)/gridStep + 2) columns and
+((size.height - 1)/gridStep + 2) rows.
+ */
+CV_EXPORTS_W
+void initUndistortRectifyMapGrid(InputArray cameraMatrix, InputArray distCoeffs,
+                                 InputArray R, InputArray newCameraMatrix,
+                                 Size size, int gridStep, OutputArray grid);
+
 //! initializes maps for #remap for wide-angle
 CV_EXPORTS
 float initWideAngleProjMap(InputArray cameraMatrix, InputArray distCoeffs,
@@ -3850,6 +3872,16 @@ namespace fisheye
     CV_EXPORTS_W void initUndistortRectifyMap(InputArray K, InputArray D, InputArray R, InputArray P,
         const cv::Size& size, int m1type, OutputArray map1, OutputArray map2);
 
+    /** @brief Computes undistortion and rectification maps at the nodes of a sparse grid for cv::remapGrid().
+
+    The function is the same as fisheye::initUndistortRectifyMap, but the map is computed only at the
+    destination pixels (i\*gridStep, j\*gridStep) and is stored as a single CV_32FC2 matrix of
+    ((size.width - 1)/gridStep + 2) columns and ((size.height - 1)/gridStep + 2) rows. See
+    cv::initUndistortRectifyMapGrid for details.
+     */
+    CV_EXPORTS_W void initUndistortRectifyMapGrid(InputArray K, InputArray D, InputArray R, InputArray P,
+        const cv::Size& size, int gridStep, OutputArray grid);
+
     /** @brief Transforms an image to compensate for fisheye lens distortion.
 
     @param distorted image with fisheye lens distortion.
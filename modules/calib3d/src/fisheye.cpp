@@ -555,6 +555,28 @@ void cv::fisheye::initUndistortRectifyMap( InputArray K, InputArray D, InputArra
     }
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// cv::fisheye::initUndistortRectifyMapGrid
+
+void cv::fisheye::initUndistortRectifyMapGrid( InputArray K, InputArray D, InputArray R, InputArray P,
+    const cv::Size& size, int gridStep, OutputArray grid )
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert( gridStep > 0 && !size.empty() );
+    CV_Assert(P.empty() || P.size() == Size(3, 3) || P.size() == Size(4, 3));
+    cv::Mat PP = cv::Mat::eye(3, 3, CV_64F);
+    if (!P.empty())
+        P.getMat().colRange(0, 3).convertTo(PP, CV_64F);
+
+    // the grid node (i, j) is the pixel (i*gridStep, j*gridStep) of the dense map
+    PP.rowRange(0, 2) = PP.rowRange(0, 2)*(1./gridStep);
+    Size gsize((size.width - 1)/gridStep + 2, (size.height - 1)/gridStep + 2);
+    cv::Mat maps[2];
+    fisheye::initUndistortRectifyMap(K, D, R, PP, gsize, CV_32FC1, maps[0], maps[1]);
+    cv::merge(maps, 2, grid);
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// cv::fisheye::undistortImage
 
@@ -164,6 +164,25 @@ void initUndistortRectifyMap( InputArray _cameraMatrix, InputArray _distCoeffs,
         fx, fy, k1, k2, p1, p2, k3, k4, k5, k6, s1, s2, s3, s4));
 }
 
+void initUndistortRectifyMapGrid( InputArray _cameraMatrix, InputArray _distCoeffs,
+                                  InputArray _matR, InputArray _newCameraMatrix,
+                                  Size size, int gridStep, OutputArray _grid )
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert( gridStep > 0 && !size.empty() );
+    Mat_<double> Ar;
+    if( !_newCameraMatrix.empty() )
+        _newCameraMatrix.getMat().convertTo(Ar, CV_64F);
+    else
+        Ar = getDefaultNewCameraMatrix( _cameraMatrix, size, true );
+
+    // the grid node (i, j) is the pixel (i*gridStep, j*gridStep) of the dense map
+    Ar.rowRange(0, 2) = Ar.rowRange(0, 2)*(1./gridStep);
+    Size gsize((size.width - 1)/gridStep + 2, (size.height - 1)/gridStep + 2);
+    initUndistortRectifyMap( _cameraMatrix, _distCoeffs, _matR, Ar, gsize, CV_32FC2, _grid, noArray() );
+}
+
 
 void undistort( InputArray _src, OutputArray _dst, InputArray _cameraMatrix,
                 InputArray _distCoeffs, InputArray _newCameraMatrix )
@@ -141,6 +141,25 @@ TEST_F(fisheyeTest, undistortImage)
     }
 }
 
+TEST_F(fisheyeTest, initUndistortRectifyMapGrid)
+{
+    const int gridStep = 8;
+    cv::Matx33d P = this->K;
+    P(0, 0) *= 0.5; P(1, 1) *= 0.5;
+    cv::Mat mapx, mapy, grid;
+    cv::fisheye::initUndistortRectifyMap(this->K, this->D, this->R, P, this->imageSize, CV_32FC1, mapx, mapy);
+    cv::fisheye::initUndistortRectifyMapGrid(this->K, this->D, this->R, P, this->imageSize, gridStep, grid);
+    ASSERT_EQ(CV_32FC2, grid.type());
+    ASSERT_EQ(cv::Size((this->imageSize.width - 1)/gridStep + 2, (this->imageSize.height - 1)/gridStep + 2), grid.size());
+    for (int j = 0; j*gridStep < this->imageSize.height; j++)
+        for (int i = 0; i*gridStep < this->imageSize.width; i++)
+        {
+            cv::Vec2f g = grid.at<cv::Vec2f>(j, i);
+            ASSERT_NEAR(mapx.at<float>(j*gridStep, i*gridStep), g[0], 1e-2) << i << " " << j;
+            ASSERT_NEAR(mapy.at<float>(j*gridStep, i*gridStep), g[1], 1e-2) << i << " " << j;
+        }
+}
+
 TEST_F(fisheyeTest, undistortAndDistortImage)
 {
     cv::Matx33d K_src = this->K;
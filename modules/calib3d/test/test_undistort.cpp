@@ -1537,4 +1537,34 @@ TEST(Calib3d_initUndistortRectifyMap, regression_14467)
     EXPECT_LE(cvtest::norm(dst, mesh_uv, NORM_INF), 1e-3);
 }
 
+TEST(Calib3d_initUndistortRectifyMapGrid, accuracy)
+{
+    const Size size(641, 479);
+    const int gridStep = 16;
+    Matx33d k(500, 0, 330, 0, 510, 235, 0, 0, 1), knew(450, 0, 320, 0, 450, 240, 0, 0, 1);
+    Matx<double, 1, 5> d(-0.28, 0.09, 0.001, -0.0005, -0.01);
+    Matx33d r;
+    cv::Rodrigues(Vec3d(0.01, -0.02, 0.005), r);
+
+    Mat map, grid;
+    initUndistortRectifyMap(k, d, r, knew, size, CV_32FC2, map, noArray());
+    initUndistortRectifyMapGrid(k, d, r, knew, size, gridStep, grid);
+    ASSERT_EQ(CV_32FC2, grid.type());
+    ASSERT_EQ(Size((size.width - 1)/gridStep + 2, (size.height - 1)/gridStep + 2), grid.size());
+    for (int j = 0; j*gridStep < size.height; j++)
+        for (int i = 0; i*gridStep < size.width; i++)
+        {
+            Vec2f diff = grid.at<Vec2f>(j, i) - map.at<Vec2f>(j*gridStep, i*gridStep);
+            ASSERT_LE(std::max(std::abs(diff[0]), std::abs(diff[1])), 1e-3) << i << " " << j;
+        }
+
+    // the map interpolated between the grid nodes is close to the dense one
+    Mat src(size, CV_8UC1), dst, ref;
+    randu(src, 0, 256);
+    GaussianBlur(src, src, Size(0, 0), 2);
+    remap(src, ref, map, noArray(), INTER_LINEAR, BORDER_REPLICATE);
+    remapGrid(src, dst, grid, size, gridStep, INTER_LINEAR, BORDER_REPLICATE);
+    EXPECT_LE(cvtest::norm(ref, dst, NORM_INF), 2);
+}
+
 }} // namespace
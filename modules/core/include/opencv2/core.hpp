@@ -219,7 +219,21 @@ enum KmeansFlags {
         user-supplied labels instead of computing them from the initial centers. For the second and
         further attempts, use the random or semi-random centers. Use one of KMEANS_\*_CENTERS flag
         to specify the exact method.*/
-    KMEANS_USE_INITIAL_LABELS = 1
+    KMEANS_USE_INITIAL_LABELS = 1,
+    /** Use the scalable k-means++ (k-means||) center initialization by Bahmani et al.
+        It needs a few passes over the data instead of K ones, so it is preferable for large K.*/
+    KMEANS_PARALLEL_CENTERS   = 4,
+    /** Skip the distance computations that cannot change the labels using the per-sample
+        distance bounds by Hamerly. The result is equivalent to the one without the flag up to ties
+        (the samples equidistant from several centers may get another label), but the iterations
+        after the first few ones are usually several times faster. It needs 2*N floats of memory.*/
+    KMEANS_HAMERLY            = 8,
+    /** Use the mini-batch k-means by Sculley: each iteration updates the centers using a random
+        batch of max(K, 1024) samples (the batch size can be changed with the
+        OPENCV_KMEANS_MINI_BATCH_SIZE configuration parameter), criteria.maxCount limits the number
+        of batches. The labels are computed at the end, some clusters may be empty.
+        Intended for the very large N, where the full iterations are too expensive.*/
+    KMEANS_MINI_BATCH         = 16
 };
 
 //! @} core_cluster
@@ -2408,7 +2422,12 @@ class CV_EXPORTS PCA
 public:
     enum Flags { DATA_AS_ROW = 0, //!< indicates that the input samples are stored as matrix rows
                  DATA_AS_COL = 1, //!< indicates that the input samples are stored as matrix columns
-                 USE_AVG     = 2  //!
+                 USE_AVG     = 2, //!
+                 /** compute the components with a randomized SVD of the centered data instead of
+                     the eigen decomposition of the covariance matrix. It is used when maxComponents
+                     is less than the data dimensionality and is ignored in the retainedVariance mode.
+                     Integer data is converted block by block, without a full floating-point copy. */
+                 RANDOMIZED  = 4
                };
 
     /** @brief default constructor
@@ -2422,8 +2441,7 @@ public:
     @param data input samples stored as matrix rows or matrix columns.
     @param mean optional mean value; if the matrix is empty (@c noArray()),
     the mean is computed from the data.
-    @param flags operation flags; currently the parameter is only used to
-    specify the data layout (PCA::Flags)
+    @param flags operation flags: the data layout and, optionally, PCA::RANDOMIZED (PCA::Flags)
     @param maxComponents maximum number of components that %PCA should
     retain; by default, all the components are retained.
     */
@@ -2456,8 +2474,7 @@ public:
     columns.
     @param mean optional mean value; if the matrix is empty (noArray()),
     the mean is computed from the data.
-    @param flags operation flags; currently the parameter is only used to
-    specify the data layout. (Flags)
+    @param flags operation flags: the data layout and, optionally, PCA::RANDOMIZED (Flags)
     @param maxComponents maximum number of components that PCA should
     retain; by default, all the components are retained.
     */
@@ -2653,7 +2670,13 @@ public:
         /** when the matrix is not square, by default the algorithm produces u and vt matrices of
             sufficiently large size for the further A reconstruction; if, however, FULL_UV flag is
             specified, u and vt will be full-size square orthogonal matrices.*/
-        FULL_UV  = 4
+        FULL_UV  = 4,
+        /** when only the leading `rank` singular values and vectors are requested (see the
+            SVD::compute overload with the rank parameter), compute them with a randomized
+            range finder instead of the full decomposition. It needs a few passes over the matrix
+            and \f$O(m \cdot n \cdot rank)\f$ operations, which makes it the method of choice for
+            large matrices of a low numerical rank. */
+        RANDOMIZED = 8
     };
 
     /** @brief the default constructor
@@ -2710,6 +2733,21 @@ public:
       */
     static void compute( InputArray src, OutputArray w, int flags = 0 );
 
+    /** @overload
+    computes the leading singular values and vectors of a matrix (truncated SVD)
+    @param src decomposed matrix. The depth has to be CV_32F or CV_64F.
+    @param w calculated singular values, rank x 1, in descending order
+    @param u calculated left singular vectors, src.rows x rank
+    @param vt transposed matrix of right singular vectors, rank x src.cols
+    @param flags operation flags - see SVD::Flags. With SVD::RANDOMIZED the triplets are
+    approximated with the randomized range finder, otherwise the full decomposition is truncated.
+    FULL_UV is ignored.
+    @param rank number of the singular triplets to compute; if it is not positive or not less
+    than min(src.rows, src.cols), the full decomposition is computed.
+      */
+    static void compute( InputArray src, OutputArray w,
+                         OutputArray u, OutputArray vt, int flags, int rank );
+
     /** @brief performs back substitution
       */
     static void backSubst( InputArray w, InputArray u,
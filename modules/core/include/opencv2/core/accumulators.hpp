@@ -0,0 +1,184 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_CORE_ACCUMULATORS_HPP
+#define OPENCV_CORE_ACCUMULATORS_HPP
+
+#include "opencv2/core.hpp"
+
+namespace cv
+{
+
+//! @addtogroup core_array
+//! @{
+
+/* Streaming statistics accumulators
+
+The accumulators compute the same statistics as meanStdDev, calcCovarMatrix, minMaxLoc and
+the uniform 1D histogram, but take the data chunk by chunk (frames of a video, tiles or
+row blocks of a huge dataset), so the whole dataset never has to be kept in memory or scanned
+twice. Every chunk is processed by the same optimized kernels as the corresponding one-shot
+function. Partial results are combined with the pairwise update of Chan, Golub and LeVeque,
+which does not lose precision on long streams the way the running sums do.
+
+The accumulators are not thread-safe. To process the data in parallel, use one accumulator
+per thread and combine them with merge() at the end:
+
+    MeanStdDevAccumulator total;
+    std::vector<MeanStdDevAccumulator> partial(nthreads);
+    // ... each thread calls partial[t].add(frame) for its frames ...
+    for (size_t t = 0; t < partial.size(); t++)
+        total.merge(partial[t]);
+    Scalar mean = total.mean(), stddev = total.stdDev();
+*/
+
+/** @brief Accumulates per-channel mean and standard deviation of array elements, see meanStdDev
+*/
+class CV_EXPORTS MeanStdDevAccumulator
+{
+public:
+    MeanStdDevAccumulator();
+
+    /** @brief adds elements of the next chunk
+    @param src input array with 1 to 4 channels; all the chunks must have the same number of channels.
+    @param mask optional operation mask of the CV_8UC1 type.
+    */
+    void add(InputArray src, InputArray mask = noArray());
+    //! combines the statistics of another accumulator with this one
+    void merge(const MeanStdDevAccumulator& other);
+    //! forgets all the accumulated data
+    void reset();
+
+    //! number of the accumulated elements (per channel)
+    int64 count() const { return n; }
+    //! per-channel mean
+    Scalar mean() const;
+    //! per-channel population variance
+    Scalar variance() const;
+    //! per-channel population standard deviation, as computed by meanStdDev
+    Scalar stdDev() const;
+
+protected:
+    int64 n;
+    int cn;
+    Vec4d mu, m2;
+};
+
+/** @brief Accumulates the mean vector and the covariance matrix of a set of vectors, see calcCovarMatrix
+*/
+class CV_EXPORTS CovarianceAccumulator
+{
+public:
+    CovarianceAccumulator();
+
+    /** @brief adds the next chunk of samples
+    @param samples single-channel matrix of samples; all the chunks must have the same dimensionality.
+    @param flags either #COVAR_ROWS (the samples are the matrix rows) or #COVAR_COLS (the samples
+    are the matrix columns).
+    */
+    void add(InputArray samples, int flags = COVAR_ROWS);
+    //! combines the statistics of another accumulator with this one
+    void merge(const CovarianceAccumulator& other);
+    //! forgets all the accumulated data
+    void reset();
+
+    //! number of the accumulated samples
+    int64 count() const { return n; }
+    /** @brief returns the mean vector
+    @param mean output 1 x dims mean vector.
+    @param ctype type of the output, CV_32F or CV_64F.
+    */
+    void getMean(OutputArray mean, int ctype = CV_64F) const;
+    /** @brief returns the covariance matrix
+    @param covar output dims x dims matrix.
+    @param flags if it contains #COVAR_SCALE, the matrix is divided by the number of samples,
+    otherwise the scatter matrix is returned, the same as calcCovarMatrix does.
+    @param ctype type of the output, CV_32F or CV_64F.
+    */
+    void getCovariance(OutputArray covar, int flags = COVAR_SCALE, int ctype = CV_64F) const;
+
+protected:
+    int64 n;
+    Mat mu, m2;
+};
+
+/** @brief Tracks the global minimum and maximum and their locations, see minMaxLoc
+*/
+class CV_EXPORTS MinMaxAccumulator
+{
+public:
+    MinMaxAccumulator();
+
+    /** @brief searches the next chunk
+    @param src single-channel input array.
+    @param mask optional mask to select a sub-array.
+    */
+    void add(InputArray src, InputArray mask = noArray());
+    /** @brief combines the statistics of another accumulator with this one
+
+    The chunks of the other accumulator are treated as the ones that follow the chunks of this one,
+    so their indices are shifted by the number of chunks added to this accumulator.
+    */
+    void merge(const MinMaxAccumulator& other);
+    //! forgets all the accumulated data
+    void reset();
+
+    //! number of the chunks passed to add()
+    int64 chunks() const { return nchunks; }
+    //! true if no element has been seen yet
+    bool empty() const { return minChunkIdx < 0; }
+    double minVal() const { return minv; }
+    double maxVal() const { return maxv; }
+    //! location of the minimum in its chunk
+    Point minLoc() const { return minp; }
+    //! location of the maximum in its chunk
+    Point maxLoc() const { return maxp; }
+    //! 0-based index of the chunk with the minimum, or -1
+    int64 minChunk() const { return minChunkIdx; }
+    //! 0-based index of the chunk with the maximum, or -1
+    int64 maxChunk() const { return maxChunkIdx; }
+
+protected:
+    int64 nchunks, minChunkIdx, maxChunkIdx;
+    double minv, maxv;
+    Point minp, maxp;
+};
+
+/** @brief Accumulates a uniform 1D histogram of array elements
+
+The element x goes to the bin floor((x - minVal)*bins/(maxVal - minVal)); the elements outside
+of [minVal, maxVal) are not counted. With the default parameters it is the histogram of 8-bit
+values, like calcHist with 256 bins and the [0, 256) range.
+*/
+class CV_EXPORTS HistogramAccumulator
+{
+public:
+    HistogramAccumulator(int bins = 256, double minVal = 0, double maxVal = 256);
+
+    /** @brief adds elements of the next chunk
+    @param src single-channel input array of any depth.
+    @param mask optional operation mask of the CV_8UC1 type.
+    */
+    void add(InputArray src, InputArray mask = noArray());
+    //! combines another accumulator, created with the same parameters, with this one
+    void merge(const HistogramAccumulator& other);
+    //! sets all the bins to zero
+    void reset();
+
+    //! 1 x bins matrix of CV_64F counters
+    const Mat& hist() const { return h; }
+    //! number of the counted elements
+    int64 count() const { return n; }
+
+protected:
+    Mat h;
+    int64 n;
+    double vmin, vmax;
+};
+
+//! @} core_array
+
+} // cv
+
+#endif // OPENCV_CORE_ACCUMULATORS_HPP
@@ -0,0 +1,141 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_CORE_COMPRESSED_SPARSE_HPP
+#define OPENCV_CORE_COMPRESSED_SPARSE_HPP
+
+#include "opencv2/core.hpp"
+
+namespace cv
+{
+
+//! @addtogroup core_basic
+//! @{
+
+/* Compressed sparse matrices
+
+SparseMat is convenient to fill a sparse matrix element by element, but its hash table is slow
+to traverse and it has no arithmetic. CompressedSparseMat keeps the non-zero elements of a 2D
+matrix in the compressed sparse row (CSR) or column (CSC) form, suitable for the fast products
+and the iterative solvers:
+
+    SparseMat builder(2, sizes, CV_64F);
+    // ... builder.ref<double>(i, j) += v; ...
+    CompressedSparseMat A(builder);
+    Mat x;
+    int iters = solveCG(A, b, x);
+
+The products and the solvers are fastest with the CSR matrices; the CSC form of A is the CSR
+form of A^T, so t() changes the format without copying the data.
+*/
+
+/** @brief 2D sparse matrix in the compressed sparse row or column format
+
+For the CSR format the elements of the row i are values[pointers[i]] ... values[pointers[i+1]-1]
+with the column indices taken from indices at the same positions; for the CSC format the same
+holds for the columns and the row indices. The indices are sorted within each row (column).
+*/
+class CV_EXPORTS CompressedSparseMat
+{
+public:
+    enum Format
+    {
+        CSR = 0, //!< compressed sparse rows
+        CSC = 1  //!< compressed sparse columns
+    };
+
+    CompressedSparseMat();
+
+    /** @brief converts SparseMat to the compressed form
+    @param m 2D single-channel sparse matrix; CV_64F values are kept in double precision,
+    the other types are converted to CV_32F.
+    @param format CompressedSparseMat::CSR or CompressedSparseMat::CSC.
+    */
+    explicit CompressedSparseMat(const SparseMat& m, int format = CSR);
+
+    /** @brief takes the non-zero elements of a dense matrix
+    @param m 2D single-channel matrix; CV_64F values are kept in double precision,
+    the other types are converted to CV_32F.
+    @param format CompressedSparseMat::CSR or CompressedSparseMat::CSC.
+    */
+    explicit CompressedSparseMat(const Mat& m, int format = CSR);
+
+    /** @brief wraps the existing arrays, the data are not copied
+    @param rows number of rows.
+    @param cols number of columns.
+    @param format CompressedSparseMat::CSR or CompressedSparseMat::CSC.
+    @param pointers CV_32S array of rows+1 (CSR) or cols+1 (CSC) elements.
+    @param indices CV_32S array of the column (CSR) or row (CSC) indices.
+    @param values CV_32F or CV_64F array of the same size as indices.
+    */
+    CompressedSparseMat(int rows, int cols, int format, const Mat& pointers, const Mat& indices, const Mat& values);
+
+    //! number of the stored elements
+    int nnz() const { return (int)values.total(); }
+    //! type of the elements, CV_32FC1 or CV_64FC1
+    int type() const { return values.empty() ? CV_64F : values.type(); }
+    Size size() const { return Size(cols, rows); }
+    bool empty() const { return rows == 0 || cols == 0; }
+
+    //! the transposed matrix; shares the data with this one and has the other format
+    CompressedSparseMat t() const;
+    //! the same matrix in the specified format; the data are shared if the format does not change
+    CompressedSparseMat toFormat(int format) const;
+    //! the matrix with the elements converted to the specified depth (CV_32F or CV_64F)
+    CompressedSparseMat toDepth(int depth) const;
+    //! the diagonal elements as a column of min(rows, cols) elements
+    Mat diag() const;
+
+    //! copies the matrix to a dense one
+    void copyTo(OutputArray dst) const;
+    //! copies the matrix to SparseMat
+    void copyTo(SparseMat& dst) const;
+
+    int format, rows, cols;
+    Mat pointers, indices, values;
+};
+
+/** @brief Multiplies a compressed sparse matrix by a dense one
+
+dst = alpha*op(A)*B + beta*C, the same as cv::gemm does for the dense matrices. For a single
+column B it is the sparse matrix-vector product. The rows of the result are computed in parallel
+when op(A) is available by rows, i.e. for CSR A without #GEMM_1_T or CSC A with it; otherwise A
+is converted to that form first.
+@param A sparse matrix.
+@param B dense single-channel CV_32F or CV_64F matrix with op(A).cols rows.
+@param alpha weight of the product.
+@param C optional dense matrix of the result size.
+@param beta weight of C.
+@param dst output matrix of the type of A.
+@param flags 0 or #GEMM_1_T that transposes A; the other flags are not supported.
+*/
+CV_EXPORTS void sparseGemm(const CompressedSparseMat& A, InputArray B, double alpha,
+                           InputArray C, double beta, OutputArray dst, int flags = 0);
+
+/** @brief Solves the symmetric positive definite sparse system with the conjugate gradient method
+
+The method is preconditioned by the diagonal of A (Jacobi preconditioner).
+@param A square symmetric positive definite matrix.
+@param b right-hand side, column of A.rows elements.
+@param x solution; if it has the size of b on input, it is used as the initial approximation,
+otherwise the iterations start from zero. It has the type of b.
+@param criteria stops the iterations after criteria.maxCount iterations or when
+||b - A*x|| <= criteria.epsilon*||b||.
+@return number of the performed iterations.
+*/
+CV_EXPORTS int solveCG(const CompressedSparseMat& A, InputArray b, InputOutputArray x,
+                       TermCriteria criteria = TermCriteria(TermCriteria::COUNT + TermCriteria::EPS, 1000, 1e-8));
+
+/** @brief Solves the general square sparse system with the BiCGSTAB method
+
+The method is preconditioned by the diagonal of A. See solveCG for the parameters.
+*/
+CV_EXPORTS int solveBiCGSTAB(const CompressedSparseMat& A, InputArray b, InputOutputArray x,
+                             TermCriteria criteria = TermCriteria(TermCriteria::COUNT + TermCriteria::EPS, 1000, 1e-8));
+
+//! @} core_basic
+
+} // cv
+
+#endif // OPENCV_CORE_COMPRESSED_SPARSE_HPP
@@ -0,0 +1,133 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_CORE_DLPACK_HPP
+#define OPENCV_CORE_DLPACK_HPP
+
+#include "opencv2/core.hpp"
+
+namespace cv { namespace dlpack {
+
+//! @addtogroup core_basic
+//! @{
+
+/* Zero-copy exchange of the arrays with the other frameworks
+
+The structures below have the same layout as the ones of the DLPack protocol (dlpack.h), which is
+supported by PyTorch, NumPy, ONNX Runtime, TensorFlow and many others, so the pointers to them
+can be passed between the libraries with a cast:
+
+    DLManagedTensor* t = at::toDLPack(tensor);
+    cv::Mat m = cv::dlpack::toMat((cv::dlpack::ManagedTensor*)t);   // no copy
+    // ... m shares the memory with tensor; t->deleter is called when the last Mat referencing
+    //     the data is released ...
+
+    cv::dlpack::ManagedTensor* out = cv::dlpack::fromMat(result);    // no copy
+    at::Tensor y = at::fromDLPack((DLManagedTensor*)out);
+
+The ownership of the managed tensor is passed with the pointer: the consumer calls the deleter
+once it does not need the data any more.
+*/
+
+enum DeviceType
+{
+    kDLCPU = 1,
+    kDLCUDA = 2,
+    kDLCUDAHost = 3,     //!< pinned memory of CUDA, accessible by CPU
+    kDLOpenCL = 4,
+    kDLVulkan = 7,
+    kDLMetal = 8,
+    kDLVPI = 9,
+    kDLROCM = 10,
+    kDLROCMHost = 11,    //!< pinned memory of ROCm, accessible by CPU
+    kDLExtDev = 12,
+    kDLCUDAManaged = 13, //!< CUDA unified memory, accessible by CPU
+    kDLOneAPI = 14
+};
+
+enum DataTypeCode
+{
+    kDLInt = 0,
+    kDLUInt = 1,
+    kDLFloat = 2,
+    kDLOpaqueHandle = 3,
+    kDLBfloat = 4,
+    kDLComplex = 5,
+    kDLBool = 6
+};
+
+struct Device
+{
+    int32_t device_type;  //!< one of cv::dlpack::DeviceType
+    int32_t device_id;
+};
+
+struct DataType
+{
+    uint8_t code;         //!< one of cv::dlpack::DataTypeCode
+    uint8_t bits;
+    uint16_t lanes;
+};
+
+struct Tensor
+{
+    void* data;           //!< pointer to the data; cl_mem for kDLOpenCL
+    Device device;
+    int32_t ndim;
+    DataType dtype;
+    int64_t* shape;
+    int64_t* strides;     //!< in elements, NULL for the compact row-major tensors
+    uint64_t byte_offset;
+};
+
+struct ManagedTensor
+{
+    Tensor dl_tensor;
+    void* manager_ctx;
+    void (*deleter)(ManagedTensor* self);
+};
+
+/** @brief Wraps the tensor with Mat without copying the data
+
+The Mat takes the ownership of the tensor: its deleter is called when the last Mat referencing
+the data is released. The tensor must be in the memory accessible by CPU (kDLCPU, kDLCUDAHost,
+kDLCUDAManaged or kDLROCMHost) and its innermost dimension must be contiguous. If the function
+fails, it throws an exception and the tensor stays owned by the caller.
+@param tensor the tensor of 8 or 16-bit unsigned integers, 8, 16 or 32-bit signed integers,
+16, 32 or 64-bit floats or 8-bit booleans.
+@param lastDimAsChannels if true, the last dimension of the contiguous 3D tensors with at most
+CV_CN_MAX elements in it becomes the channels, as it is done for the numpy arrays by the Python
+bindings; otherwise all the tensor dimensions become the Mat dimensions. 1D tensors become the
+single-column matrices.
+*/
+CV_EXPORTS Mat toMat(ManagedTensor* tensor, bool lastDimAsChannels = true);
+
+/** @brief Wraps the tensor with UMat
+
+The kDLOpenCL tensors from the current OpenCL context become UMat without copying, they must
+be 2D (or 3D with channels) with byte_offset equal to 0. The CPU tensors are wrapped without
+copying when OpenCL is not used; otherwise they are uploaded to a new UMat and the deleter is
+called immediately. See toMat() for the other details.
+*/
+CV_EXPORTS UMat toUMat(ManagedTensor* tensor, bool lastDimAsChannels = true);
+
+/** @brief Exports the matrix as a DLPack tensor without copying the data
+
+The tensor holds a reference to the data of m until its deleter is called. The channels of
+the multi-channel matrices become the last dimension of the tensor.
+*/
+CV_EXPORTS ManagedTensor* fromMat(const Mat& m);
+
+/** @brief Exports the matrix as a DLPack tensor without copying the data
+
+The matrices in the OpenCL memory are exported as kDLOpenCL tensors (the data pointer is cl_mem,
+the offset of the matrix is byte_offset), the other ones as kDLCPU tensors.
+*/
+CV_EXPORTS ManagedTensor* fromUMat(const UMat& m);
+
+//! @}
+
+}} // namespace
+
+#endif // OPENCV_CORE_DLPACK_HPP
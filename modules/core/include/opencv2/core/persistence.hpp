@@ -265,6 +265,28 @@ Here is how to read the file created by the code sample above:
     fs2.release();
 @endcode
 
+Binary storages    {#binary_storage}
+---------------
+Besides the text formats, FileStorage can write a compact binary format (FileStorage::FORMAT_BINARY).
+The storage has the same structure of nested mappings and sequences, but numbers and strings are
+written as-is and numerical arrays written with FileStorage::writeRaw (including the data of
+matrices) are stored as raw little-endian blocks aligned in the file. When such a file is opened
+for reading, it is memory-mapped, only the tree of nodes is built and the array payloads are not
+touched until they are accessed. Matrices read with `>>` / cv::read / FileNode::mat() get a private
+copy of the data, as with the text formats, while FileNode::sharedMat() returns a matrix that points
+directly into the mapped file: the memory is copy-on-write and stays valid after the storage is
+released, but the matrices obtained this way from the same opened storage share the memory. The
+binary format is detected automatically when the file is opened for reading; it does not support
+FileStorage::APPEND.
+@code
+    FileStorage fs("model.bin", FileStorage::WRITE | FileStorage::FORMAT_BINARY);
+    fs << "remap_x" << mapx << "remap_y" << mapy;
+    fs.release();
+
+    FileStorage fs2("model.bin", FileStorage::READ);
+    Mat mapx2 = fs2["remap_x"].sharedMat(); // no parsing, no copying
+@endcode
+
 Format specification    {#format_spec}
 --------------------
 `([count]{u|c|w|s|i|f|d})`... where the characters correspond to fundamental C++ types:
@@ -316,6 +338,7 @@ public:
         FORMAT_XML  = (1<<3), //!< flag, XML format
         FORMAT_YAML = (2<<3), //!< flag, YAML format
         FORMAT_JSON = (3<<3), //!< flag, JSON format
+        FORMAT_BINARY = (4<<3), //!< flag, binary format with aligned raw arrays (see @ref binary_storage "binary storages")
 
         BASE64      = 64,     //!< flag, write rawdata in Base64 by default. (consider using WRITE_BASE64)
         WRITE_BASE64 = BASE64 | WRITE, //!< flag, enable both WRITE and BASE64
@@ -615,6 +638,13 @@ public:
     CV_WRAP std::string string() const;
     //! Simplified reading API to use with bindings.
     CV_WRAP Mat mat() const;
+    /** @brief Reads the matrix without copying the data when possible.
+
+    For the matrices of binary storages the returned matrix uses the storage memory in place (see
+    @ref binary_storage "binary storages"), so all such matrices of the same storage share it.
+    Otherwise it is the same as mat().
+    */
+    Mat sharedMat() const;
 
     //protected:
     FileNode(FileStorage::Impl* fs, size_t blockIdx, size_t ofs);
@@ -0,0 +1,107 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_CORE_PIXEL_PIPELINE_HPP
+#define OPENCV_CORE_PIXEL_PIPELINE_HPP
+
+#include "opencv2/core.hpp"
+
+namespace cv
+{
+
+//! @addtogroup core_array
+//! @{
+
+/** @brief Chain of per-element operations applied in a single pass over the image
+
+The chains like convertTo + LUT + threshold are usually memory-bound: every operation reads and
+writes the whole image. The pipeline runs all the stages over the small pieces of the rows that
+stay in L1 cache, so the image is read and the result is written only once, and the work is split
+between the threads with a single parallel_for_ call:
+
+    PixelOpPipeline pipeline;
+    pipeline.convertTo(CV_8U, 1./16)          // 12-bit data to 8 bits
+            .LUT(gammaTable)                  // 256-entry table
+            .threshold(30, 255, 3);           // THRESH_TOZERO
+    pipeline.apply(frame, result);
+
+The stages take the element type produced by the previous stage and may change it, exactly as
+the corresponding standalone functions do, so the result is the same as the one of the chain of
+calls. The intermediate values are kept in single precision, therefore the chains that pass
+through CV_32S or CV_64F may produce slightly different results for the values that can not be
+represented by float exactly. Each normalize stage requires an additional pass over the source
+to compute the norm of its input. The stages that follow an 8-bit result and process the channels
+independently are folded into a single table of 256 values, so such chains cost a lookup per
+element regardless of their length.
+*/
+class CV_EXPORTS PixelOpPipeline
+{
+public:
+    PixelOpPipeline();
+
+    /** @brief adds the scaling with the optional type conversion, see Mat::convertTo
+    @param depth depth of the stage output; negative value keeps the depth of the input.
+    @param alpha scale factor.
+    @param beta value added to the scaled values.
+    */
+    PixelOpPipeline& convertTo(int depth, double alpha = 1, double beta = 0);
+
+    /** @brief adds the look-up table transform, see cv::LUT
+    @param lut look-up table of 256 elements with a single channel or the same number of channels
+    as the stage input; its depth becomes the depth of the stage output. The stage input must be
+    8-bit, as for cv::LUT.
+    */
+    PixelOpPipeline& LUT(InputArray lut);
+
+    /** @brief adds the fixed-level thresholding, see cv::threshold
+    @param thresh threshold value.
+    @param maxval value used with the binary threshold types.
+    @param type one of the basic threshold types: THRESH_BINARY (0), THRESH_BINARY_INV (1),
+    THRESH_TRUNC (2), THRESH_TOZERO (3) or THRESH_TOZERO_INV (4).
+    */
+    PixelOpPipeline& threshold(double thresh, double maxval, int type);
+
+    /** @brief adds the normalization of the norm or the value range, see cv::normalize
+    @param alpha norm value to normalize to or the lower range boundary for #NORM_MINMAX.
+    @param beta upper range boundary for #NORM_MINMAX.
+    @param normType one of #NORM_INF, #NORM_L1, #NORM_L2 or #NORM_MINMAX.
+    @param depth depth of the stage output; negative value keeps the depth of the input.
+    */
+    PixelOpPipeline& normalize(double alpha = 1, double beta = 0, int normType = NORM_L2, int depth = -1);
+
+    /** @brief adds the range check, see cv::inRange
+    The stage output is the CV_8UC1 mask: 255 where all the channels are within the bounds, 0 otherwise.
+    */
+    PixelOpPipeline& inRange(const Scalar& lowerb, const Scalar& upperb);
+
+    //! removes all the stages
+    void clear();
+    //! true if there are no stages
+    bool empty() const { return stages.empty(); }
+
+    //! returns the type of the pipeline output for the given input type
+    int outputType(int srcType) const;
+
+    /** @brief runs the pipeline
+    @param src input array with 1 to 4 channels.
+    @param dst output array of the same size and outputType(src.type()).
+    */
+    void apply(InputArray src, OutputArray dst) const;
+
+protected:
+    struct Stage
+    {
+        int op, depth, param;
+        double alpha, beta;
+        Scalar lowerb, upperb;
+        Mat lut;
+    };
+    std::vector<Stage> stages;
+};
+
+//! @} core_array
+
+} // cv
+
+#endif // OPENCV_CORE_PIXEL_PIPELINE_HPP
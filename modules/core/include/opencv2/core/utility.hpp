@@ -565,6 +565,22 @@ The function returns true if the optimized code is enabled. Otherwise, it return
  */
 CV_EXPORTS_W bool useOptimized();
 
+/** @brief Sets the output size starting from which the bulk copy and fill operations bypass the cache.
+
+Mat::copyTo, Mat::setTo (and the assignment of a scalar), Mat::convertTo and copyMakeBorder write
+the outputs of at least this size with the non-temporal (streaming) stores and split the work between
+the threads. Such outputs do not fit into the last level cache anyway, so writing them through the
+cache only evicts the data of the other threads and processes. The default value is 64MB, it can be
+changed with the OPENCV_STREAMING_STORE_THRESHOLD environment variable. Like setUseOptimized, the
+function should be called when no other OpenCV function is executed.
+@param bytes the threshold in bytes; 0 disables the streaming stores.
+ */
+CV_EXPORTS_W void setStreamingStoreThreshold(size_t bytes);
+
+/** @brief Returns the current threshold of the streaming stores, see setStreamingStoreThreshold
+ */
+CV_EXPORTS_W size_t getStreamingStoreThreshold();
+
 static inline size_t getElemSize(int type) { return (size_t)CV_ELEM_SIZE(type); }
 
 /////////////////////////////// Parallel Primitives //////////////////////////////////
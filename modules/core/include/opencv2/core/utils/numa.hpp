@@ -0,0 +1,77 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_CORE_UTILS_NUMA_HPP
+#define OPENCV_CORE_UTILS_NUMA_HPP
+
+#include "opencv2/core.hpp"
+
+namespace cv { namespace utils {
+
+//! @addtogroup core_utils
+//! @{
+
+/* NUMA placement of the data and the threads
+
+By default the pages of a buffer are placed on the node of the thread that touches them first
+(usually the one that allocated the buffer) and the parallel_for_ workers run on any CPU, so on
+a multi-socket host a big part of the memory traffic crosses the sockets. To keep a pipeline on
+a single node, pin its threads and its data there:
+
+    cv::utils::bindCurrentThreadToNumaNode(node);
+    cv::utils::setNumaThreadBinding(cv::utils::NUMA_THREADS_NODE, node);
+    cv::Mat::setDefaultAllocator(cv::utils::getNumaAllocator(node));
+
+When a single pipeline uses the whole host, NUMA_THREADS_SPREAD together with the interleaving
+allocator, getNumaAllocator(-1), spreads both the threads and the pages evenly over the nodes.
+
+The placement is supported on Linux only; on the other systems there is a single node and the
+functions do nothing.
+*/
+
+enum NumaThreadBinding
+{
+    NUMA_THREADS_FREE   = 0, //!< the workers are not bound, the OS scheduler places them (default)
+    NUMA_THREADS_SPREAD = 1, //!< the workers are spread evenly over the nodes, each one is bound to the CPUs of its node
+    NUMA_THREADS_NODE   = 2  //!< all the workers are bound to the CPUs of the single node
+};
+
+/** @brief Returns the number of NUMA nodes with CPUs, 1 if the topology is not available */
+CV_EXPORTS int getNumaNodesCount();
+
+/** @brief Returns the node of the CPU the calling thread runs on, or -1 if it is not known */
+CV_EXPORTS int getCurrentNumaNode();
+
+/** @brief Binds the calling thread to the CPUs of the specified NUMA node
+
+@param node the node index, from 0 to getNumaNodesCount()-1; a negative value allows all the CPUs.
+@return false if the binding is not supported or failed.
+ */
+CV_EXPORTS bool bindCurrentThreadToNumaNode(int node);
+
+/** @brief Sets the placement of the worker threads of the OpenCV thread pool
+
+The workers apply the new placement when they pick up the next parallel job. The setting is
+used by the builtin pthreads-based backend only.
+@param mode one of cv::utils::NumaThreadBinding. The default mode can be set with the
+OPENCV_NUMA_THREADS environment variable ("free", "spread" or the node index).
+@param node the node for NUMA_THREADS_NODE.
+ */
+CV_EXPORTS void setNumaThreadBinding(int mode, int node = 0);
+
+/** @brief Returns the allocator that places the pages of the large buffers on the specified NUMA node
+
+The placement is applied to the buffers of at least 1MB, the smaller ones are allocated in the
+same way as by the standard allocator. The allocator can be set to the individual matrices
+(Mat::allocator) or as the default one (Mat::setDefaultAllocator).
+@param node the node index; a negative value interleaves the pages over all the nodes, so the
+bandwidth of all the memory controllers is used whichever thread processes the data.
+ */
+CV_EXPORTS MatAllocator* getNumaAllocator(int node = -1);
+
+//! @}
+
+}} // namespace
+
+#endif // OPENCV_CORE_UTILS_NUMA_HPP
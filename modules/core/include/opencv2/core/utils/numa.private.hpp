@@ -0,0 +1,23 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_CORE_UTILS_NUMA_PRIVATE_HPP
+#define OPENCV_CORE_UTILS_NUMA_PRIVATE_HPP
+
+#include "opencv2/core/utils/numa.hpp"
+
+#include <string>
+
+namespace cv { namespace utils {
+
+/** @brief Re-reads the NUMA topology from the given sysfs node directory
+
+The empty path restores the system one, /sys/devices/system/node. Intended for the tests only,
+it must not be called while the NUMA allocators or the thread binding are in use.
+*/
+CV_EXPORTS void reloadNumaTopology(const std::string& sysfsNodeDir = std::string());
+
+}} // namespace
+
+#endif // OPENCV_CORE_UTILS_NUMA_PRIVATE_HPP
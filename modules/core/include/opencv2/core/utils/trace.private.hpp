@@ -53,6 +53,7 @@ namespace details {
 enum RegionFlag {
     REGION_FLAG__NEED_STACK_POP = (1 << 0),
     REGION_FLAG__ACTIVE = (1 << 1),
+    REGION_FLAG__TRACE_BUFFER = (1 << 2),   //!< the region is on the stack of the trace buffer
 
     ENUM_REGION_FLAG_IMPL_FORCE_INT = INT_MAX
 };
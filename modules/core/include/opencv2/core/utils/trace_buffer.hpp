@@ -0,0 +1,72 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_CORE_UTILS_TRACE_BUFFER_HPP
+#define OPENCV_CORE_UTILS_TRACE_BUFFER_HPP
+
+#include "opencv2/core.hpp"
+
+namespace cv { namespace utils { namespace trace {
+
+//! @addtogroup core_logging
+//! @{
+
+/* In-memory trace buffer
+
+The buffer records the CV_TRACE_* / CV_INSTRUMENT_REGION regions of all the threads into
+per-thread rings of a fixed size, without locks and without any I/O on the hot path, so it can
+be left on in the production builds. When the ring of a thread is full, its oldest events are
+overwritten. The recorded events are exported on demand in the Chrome trace event format,
+which is opened by chrome://tracing and https://ui.perfetto.dev:
+
+    cv::utils::trace::startTraceBuffer();
+    // ... process some frames ...
+    cv::utils::trace::writeTraceBuffer("frames.json");
+
+The export can run concurrently with the threads that write the events.
+
+To reduce the overhead further, only every samplingInterval-th outermost region of a thread is
+recorded, together with all the regions nested into it, and the events shorter than
+minDurationNs are dropped. When the buffer is stopped, the cost of a region is a single check
+of a global flag.
+
+The buffer is started at the process start if the OPENCV_TRACE_BUFFER environment variable is
+set; OPENCV_TRACE_BUFFER_SIZE, OPENCV_TRACE_BUFFER_SAMPLING and OPENCV_TRACE_BUFFER_MIN_DURATION
+(in nanoseconds) set its parameters, and the events are written to <OPENCV_TRACE_LOCATION>.json
+at the process exit.
+
+The buffer is available when OpenCV is built with the tracing support (CV_TRACE=ON).
+*/
+
+/** @brief Starts recording of the trace regions, the previously recorded events are discarded
+
+@param eventsPerThread the capacity of the ring of each thread, rounded up to a power of 2.
+@param samplingInterval record every samplingInterval-th outermost region of each thread.
+@param minDurationNs drop the events shorter than that, in nanoseconds.
+*/
+CV_EXPORTS void startTraceBuffer(size_t eventsPerThread = 65536, int samplingInterval = 1,
+                                 int64 minDurationNs = 0);
+
+/** @brief Stops recording, the recorded events stay available for the export */
+CV_EXPORTS void stopTraceBuffer();
+
+/** @brief Returns true if the trace buffer is recording */
+CV_EXPORTS bool isTraceBufferActive();
+
+/** @brief Exports the recorded events as a JSON string in the Chrome trace event format
+
+The regions are "complete" events ("ph":"X") with the timestamps and the durations in
+microseconds, the tid field is the OpenCV thread id (cv::utils::getThreadID()). The number of
+the events lost because of the ring overflow is reported as otherData.droppedEvents.
+*/
+CV_EXPORTS std::string exportTraceBuffer();
+
+/** @brief Writes exportTraceBuffer() output to the file */
+CV_EXPORTS void writeTraceBuffer(const std::string& filename);
+
+//! @}
+
+}}} // namespace
+
+#endif // OPENCV_CORE_UTILS_TRACE_BUFFER_HPP
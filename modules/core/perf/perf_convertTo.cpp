@@ -1,4 +1,5 @@
 #include "perf_precomp.hpp"
+#include "opencv2/core/pixel_pipeline.hpp"
 
 namespace opencv_test
 {
@@ -38,4 +39,35 @@ PERF_TEST_P( Size_DepthSrc_DepthDst_Channels_alpha, convertTo,
     SANITY_CHECK(dst, eps);
 }
 
+typedef perf::TestBaseWithParam<bool> PixelOpPipeline_Chain;
+
+PERF_TEST_P_(PixelOpPipeline_Chain, convert_lut_inRange)
+{
+    const bool fused = GetParam();
+    Mat src(4320, 7680, CV_16UC1), dst, t1, t2;
+    randu(src, 0, 4096);
+    Mat lut(1, 256, CV_8UC1);
+    randu(lut, 0, 256);
+    declare.in(src);
+
+    PixelOpPipeline pipeline;
+    pipeline.convertTo(CV_8U, 1./16).LUT(lut).inRange(Scalar(50), Scalar(200));
+
+    TEST_CYCLE()
+    {
+        if (fused)
+            pipeline.apply(src, dst);
+        else
+        {
+            src.convertTo(t1, CV_8U, 1./16);
+            LUT(t1, lut, t2);
+            inRange(t2, Scalar(50), Scalar(200), dst);
+        }
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/*nothing*/, PixelOpPipeline_Chain, testing::Bool());
+
 } // namespace
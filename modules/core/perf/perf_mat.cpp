@@ -138,6 +138,32 @@ PERF_TEST_P(Size_MatType, Mat_SetToWithMask,
     SANITY_CHECK(src);
 }
 
+///////////// Streaming stores ////////////////////////
+
+typedef perf::TestBaseWithParam<bool> Mat_LargeCopy;
+
+PERF_TEST_P_(Mat_LargeCopy, copyTo_setTo_convertTo)
+{
+    const bool streaming = GetParam();
+    Mat src(8192, 4096, CV_8UC3), dst(src.size(), CV_8UC3), dst16(src.size(), CV_16UC3);
+    randu(src, 0, 256);
+    declare.in(src).out(dst, dst16);
+
+    size_t threshold0 = getStreamingStoreThreshold();
+    setStreamingStoreThreshold(streaming ? (size_t)1 << 20 : 0);
+    TEST_CYCLE()
+    {
+        src.copyTo(dst);
+        dst.setTo(Scalar(1, 2, 3));
+        src.convertTo(dst16, CV_16U, 256);
+    }
+    setStreamingStoreThreshold(threshold0);
+
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/*nothing*/, Mat_LargeCopy, testing::Bool());
+
 ///////////// Transform ////////////////////////
 
 PERF_TEST_P(Size_MatType, Mat_Transform,
@@ -1,4 +1,5 @@
 #include "perf_precomp.hpp"
+#include "opencv2/core/compressed_sparse.hpp"
 
 namespace opencv_test
 {
@@ -106,6 +107,40 @@ PERF_TEST_P_(KMeans, good)
     SANITY_CHECK_NOTHING();
 }
 
+PERF_TEST_P_(KMeans, good_accelerated)
+{
+    RNG& rng = theRNG();
+    const int K = testing::get<0>(GetParam());
+    const int dims = testing::get<1>(GetParam());
+    const int N = testing::get<2>(GetParam());
+    const int attempts = 5;
+
+    Mat data(N, dims, CV_32F);
+    rng.fill(data, RNG::UNIFORM, -0.1, 0.1);
+
+    const int N0 = K;
+    Mat data0(N0, dims, CV_32F);
+    rng.fill(data0, RNG::UNIFORM, -1, 1);
+
+    for (int i = 0; i < N; i++)
+    {
+        int base = rng.uniform(0, N0);
+        cv::add(data0.row(base), data.row(i), data.row(i));
+    }
+
+    declare.in(data);
+
+    Mat labels, centers;
+
+    TEST_CYCLE()
+    {
+        kmeans(data, K, labels, TermCriteria(TermCriteria::MAX_ITER+TermCriteria::EPS, 30, 0),
+               attempts, KMEANS_PARALLEL_CENTERS | KMEANS_HAMERLY, centers);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
 PERF_TEST_P_(KMeans, with_duplicates)
 {
     RNG& rng = theRNG();
@@ -157,6 +192,72 @@ INSTANTIATE_TEST_CASE_P(/*nothing*/ , KMeans,
     )
 );
 
+
+typedef perf::TestBaseWithParam< testing::tuple<int, int, int, bool> > PCA_Components;
+
+PERF_TEST_P_(PCA_Components, compute)
+{
+    const int N = testing::get<0>(GetParam());
+    const int dims = testing::get<1>(GetParam());
+    const int components = testing::get<2>(GetParam());
+    const bool randomized = testing::get<3>(GetParam());
+
+    // samples spanning a low-dimensional subspace plus noise
+    Mat basis(components*2, dims, CV_32F), coeffs(N, components*2, CV_32F), noise(N, dims, CV_32F);
+    RNG& rng = theRNG();
+    rng.fill(basis, RNG::NORMAL, 0, 1);
+    rng.fill(coeffs, RNG::NORMAL, 0, 10);
+    rng.fill(noise, RNG::NORMAL, 0, 0.1);
+    Mat data = coeffs*basis + noise;
+
+    declare.in(data);
+
+    PCA pca;
+    TEST_CYCLE()
+    {
+        pca(data, noArray(), PCA::DATA_AS_ROW | (randomized ? PCA::RANDOMIZED : 0), components);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/*nothing*/ , PCA_Components,
+    testing::Combine(
+        testing::Values(20000),      // N points
+        testing::Values(128, 512),   // dims
+        testing::Values(16),         // components
+        testing::Bool()              // randomized
+    )
+);
+
+typedef perf::TestBaseWithParam<int> SparseGemm_Columns;
+
+PERF_TEST_P_(SparseGemm_Columns, laplacian)
+{
+    // 5-point Laplacian of the 512x512 grid
+    const int n = 512, ncols = GetParam();
+    int sizes[] = { n*n, n*n };
+    SparseMat sm(2, sizes, CV_32F);
+    for (int i = 0; i < n*n; i++)
+    {
+        sm.ref<float>(i, i) = 4;
+        if (i % n > 0) sm.ref<float>(i, i - 1) = -1;
+        if (i % n < n - 1) sm.ref<float>(i, i + 1) = -1;
+        if (i >= n) sm.ref<float>(i, i - n) = -1;
+        if (i < n*n - n) sm.ref<float>(i, i + n) = -1;
+    }
+    CompressedSparseMat A(sm);
+    Mat B(n*n, ncols, CV_32F), dst;
+    randu(B, -1, 1);
+    declare.in(B);
+
+    TEST_CYCLE() sparseGemm(A, B, 1, noArray(), 0, dst);
+
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/*nothing*/ , SparseGemm_Columns, testing::Values(1, 8));
+
 }
 
 } // namespace
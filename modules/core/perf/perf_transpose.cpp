@@ -0,0 +1,53 @@
+#include "perf_precomp.hpp"
+
+namespace opencv_test
+{
+using namespace perf;
+
+typedef tuple<Size, MatType> Size_MatType_t;
+typedef perf::TestBaseWithParam<Size_MatType_t> Size_MatType;
+
+PERF_TEST_P( Size_MatType, transpose,
+             testing::Combine
+             (
+                 testing::Values(szVGA, sz1080p, sz2160p),
+                 testing::Values(CV_8UC1, CV_8UC3, CV_16UC1, CV_32FC1, CV_8UC4, CV_64FC1)
+             )
+           )
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+
+    Mat src(sz, type), dst(sz.width, sz.height, type);
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() cv::transpose(src, dst);
+
+    SANITY_CHECK_NOTHING();
+}
+
+typedef tuple<Size, MatType, RotateFlags> Size_MatType_Rotate_t;
+typedef perf::TestBaseWithParam<Size_MatType_Rotate_t> Size_MatType_Rotate;
+
+PERF_TEST_P( Size_MatType_Rotate, rotate,
+             testing::Combine
+             (
+                 testing::Values(szVGA, sz1080p, sz2160p),
+                 testing::Values(CV_8UC1, CV_8UC3, CV_8UC4, CV_32FC1),
+                 testing::Values(ROTATE_90_CLOCKWISE, ROTATE_90_COUNTERCLOCKWISE)
+             )
+           )
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    int rotateCode = get<2>(GetParam());
+
+    Mat src(sz, type), dst(sz.width, sz.height, type);
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() rotate(src, dst, rotateCode);
+
+    SANITY_CHECK_NOTHING();
+}
+
+} // namespace
@@ -0,0 +1,428 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "stat.hpp"
+#include "opencv2/core/accumulators.hpp"
+
+namespace cv
+{
+
+/****************************************************************************************\
+*                                   MeanStdDevAccumulator                                *
+\****************************************************************************************/
+
+MeanStdDevAccumulator::MeanStdDevAccumulator()
+{
+    reset();
+}
+
+void MeanStdDevAccumulator::reset()
+{
+    n = 0;
+    cn = 0;
+    mu = m2 = Vec4d();
+}
+
+void MeanStdDevAccumulator::add(InputArray _src, InputArray _mask)
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat src = _src.getMat(), mask = _mask.getMat();
+    int scn = src.channels();
+    CV_Assert( scn <= 4 && (cn == 0 || cn == scn) );
+    CV_Assert( mask.empty() || (mask.type() == CV_8UC1 && mask.size == src.size) );
+    if( src.empty() )
+        return;
+    cn = scn;
+
+    // the sums of the small integer types are exact, so the textbook formula is fine for them;
+    // for the rest the second pass computes the squared deviations from the chunk mean.
+    // The chunks are combined as in merge()
+    double s[4], sq[4], m2b[4];
+    int nb = sumSqr(src, mask, s, sq);
+    if( nb == 0 )
+        return;
+
+    Scalar mub;
+    for( int c = 0; c < cn; c++ )
+    {
+        mub[c] = s[c]/nb;
+        m2b[c] = sq[c] - s[c]*mub[c];
+    }
+    if( src.depth() >= CV_32S )
+    {
+        Mat d;
+        subtract(src, mub, d, noArray(), CV_64F);
+        double ds[4];
+        sumSqr(d, mask, ds, m2b);
+        for( int c = 0; c < cn; c++ )
+            m2b[c] -= ds[c]*ds[c]/nb;
+    }
+
+    int64 na = n;
+    n += nb;
+    for( int c = 0; c < cn; c++ )
+    {
+        double delta = mub[c] - mu[c];
+        mu[c] += delta*nb/n;
+        m2[c] += std::max(m2b[c], 0.) + delta*delta*((double)na*nb/n);
+    }
+}
+
+void MeanStdDevAccumulator::merge(const MeanStdDevAccumulator& other)
+{
+    if( other.n == 0 )
+        return;
+    CV_Assert( cn == 0 || cn == other.cn );
+    cn = other.cn;
+
+    int64 na = n, nb = other.n;
+    n += nb;
+    for( int c = 0; c < cn; c++ )
+    {
+        double delta = other.mu[c] - mu[c];
+        mu[c] += delta*nb/n;
+        m2[c] += other.m2[c] + delta*delta*((double)na*nb/n);
+    }
+}
+
+Scalar MeanStdDevAccumulator::mean() const
+{
+    return Scalar(mu);
+}
+
+Scalar MeanStdDevAccumulator::variance() const
+{
+    return n > 0 ? Scalar(m2*(1./n)) : Scalar();
+}
+
+Scalar MeanStdDevAccumulator::stdDev() const
+{
+    Scalar v = variance();
+    for( int c = 0; c < 4; c++ )
+        v[c] = std::sqrt(v[c]);
+    return v;
+}
+
+/****************************************************************************************\
+*                                   CovarianceAccumulator                                *
+\****************************************************************************************/
+
+CovarianceAccumulator::CovarianceAccumulator()
+{
+    reset();
+}
+
+void CovarianceAccumulator::reset()
+{
+    n = 0;
+    mu.release();
+    m2.release();
+}
+
+void CovarianceAccumulator::add(InputArray _samples, int flags)
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat samples = _samples.getMat();
+    CV_Assert( samples.channels() == 1 && samples.dims <= 2 );
+    CV_Assert( (flags & (COVAR_ROWS | COVAR_COLS)) == COVAR_ROWS ||
+               (flags & (COVAR_ROWS | COVAR_COLS)) == COVAR_COLS );
+    if( samples.empty() )
+        return;
+
+    bool rows = (flags & COVAR_ROWS) != 0;
+    int nb = rows ? samples.rows : samples.cols, dims = rows ? samples.cols : samples.rows;
+    CV_Assert( mu.empty() || mu.cols == dims );
+
+    // the scatter matrix of the chunk around its own mean, with the optimized
+    // mulTransposed() kernels; it doesn't suffer from the cancellation
+    Mat mub, m2b;
+    reduce(samples, mub, rows ? 0 : 1, REDUCE_AVG, CV_64F);
+    mulTransposed(samples, m2b, rows, mub, 1, CV_64F);
+    if( !rows )
+        mub = mub.reshape(1, 1);
+
+    if( n == 0 )
+    {
+        n = nb;
+        mu = mub;
+        m2 = m2b;
+        return;
+    }
+
+    int64 na = n;
+    n += nb;
+    Mat delta = mub - mu;
+    scaleAdd(delta, (double)nb/n, mu, mu);
+    m2 += m2b;
+    gemm(delta, delta, (double)na*nb/n, m2, 1, m2, GEMM_1_T);
+}
+
+void CovarianceAccumulator::merge(const CovarianceAccumulator& other)
+{
+    if( other.n == 0 )
+        return;
+    if( n == 0 )
+    {
+        n = other.n;
+        other.mu.copyTo(mu);
+        other.m2.copyTo(m2);
+        return;
+    }
+    CV_Assert( mu.cols == other.mu.cols );
+
+    int64 na = n, nb = other.n;
+    n += nb;
+    Mat delta = other.mu - mu;
+    scaleAdd(delta, (double)nb/n, mu, mu);
+    m2 += other.m2;
+    gemm(delta, delta, (double)na*nb/n, m2, 1, m2, GEMM_1_T);
+}
+
+void CovarianceAccumulator::getMean(OutputArray _mean, int ctype) const
+{
+    CV_Assert( ctype == CV_32F || ctype == CV_64F );
+    if( n == 0 )
+    {
+        _mean.release();
+        return;
+    }
+    mu.convertTo(_mean, ctype);
+}
+
+void CovarianceAccumulator::getCovariance(OutputArray _covar, int flags, int ctype) const
+{
+    CV_Assert( ctype == CV_32F || ctype == CV_64F );
+    if( n == 0 )
+    {
+        _covar.release();
+        return;
+    }
+    m2.convertTo(_covar, ctype, (flags & COVAR_SCALE) ? 1./n : 1.);
+}
+
+/****************************************************************************************\
+*                                     MinMaxAccumulator                                  *
+\****************************************************************************************/
+
+MinMaxAccumulator::MinMaxAccumulator()
+{
+    reset();
+}
+
+void MinMaxAccumulator::reset()
+{
+    nchunks = 0;
+    minChunkIdx = maxChunkIdx = -1;
+    minv = maxv = 0;
+    minp = maxp = Point(-1, -1);
+}
+
+void MinMaxAccumulator::add(InputArray src, InputArray mask)
+{
+    CV_INSTRUMENT_REGION();
+
+    int64 idx = nchunks++;
+    if( src.empty() )
+        return;
+
+    double vmin = 0, vmax = 0;
+    Point pmin, pmax;
+    minMaxLoc(src, &vmin, &vmax, &pmin, &pmax, mask);
+    if( pmin.x < 0 ) // everything is masked out
+        return;
+
+    // the first occurrence wins, as in minMaxLoc
+    if( minChunkIdx < 0 || vmin < minv )
+    {
+        minv = vmin;
+        minp = pmin;
+        minChunkIdx = idx;
+    }
+    if( maxChunkIdx < 0 || vmax > maxv )
+    {
+        maxv = vmax;
+        maxp = pmax;
+        maxChunkIdx = idx;
+    }
+}
+
+void MinMaxAccumulator::merge(const MinMaxAccumulator& other)
+{
+    int64 ofs = nchunks;
+    nchunks += other.nchunks;
+    if( other.empty() )
+        return;
+
+    if( minChunkIdx < 0 || other.minv < minv )
+    {
+        minv = other.minv;
+        minp = other.minp;
+        minChunkIdx = other.minChunkIdx + ofs;
+    }
+    if( maxChunkIdx < 0 || other.maxv > maxv )
+    {
+        maxv = other.maxv;
+        maxp = other.maxp;
+        maxChunkIdx = other.maxChunkIdx + ofs;
+    }
+}
+
+/****************************************************************************************\
+*                                   HistogramAccumulator                                 *
+\****************************************************************************************/
+
+class HistogramAccumulatorInvoker : public ParallelLoopBody
+{
+public:
+    HistogramAccumulatorInvoker(const Mat& _src, const Mat& _mask, const int* _lut,
+                                double _vmin, double _vmax, double* _hist, int _bins,
+                                int64* _count, Mutex* _mutex)
+        : src(_src), mask(_mask), lut(_lut), vmin(_vmin), vmax(_vmax),
+          hist(_hist), bins(_bins), count(_count), mutex(_mutex)
+    {
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        AutoBuffer<int64> _h(bins);
+        int64* h = _h.data();
+        int64 total = 0;
+        for( int b = 0; b < bins; b++ )
+            h[b] = 0;
+
+        if( lut )
+        {
+            // 8-bit data: count the values in 4 interleaved tables to break the dependency
+            // on the same counter, map the values to the bins at the end
+            AutoBuffer<int> _c(256*4);
+            int* c = _c.data();
+            int64 c8[256] = {};
+            for( int i = range.start; i < range.end; i++ )
+            {
+                const uchar* sptr = src.ptr<uchar>(i);
+                const uchar* mptr = mask.empty() ? 0 : mask.ptr<uchar>(i);
+                int j = 0, width = src.cols;
+                memset(c, 0, 256*4*sizeof(c[0]));
+                if( !mptr )
+                {
+                    for( ; j <= width - 4; j += 4 )
+                    {
+                        c[sptr[j]]++;
+                        c[256 + sptr[j+1]]++;
+                        c[512 + sptr[j+2]]++;
+                        c[768 + sptr[j+3]]++;
+                    }
+                    for( ; j < width; j++ )
+                        c[sptr[j]]++;
+                }
+                else
+                {
+                    for( ; j < width; j++ )
+                        if( mptr[j] )
+                            c[sptr[j]]++;
+                }
+                for( int v = 0; v < 256; v++ )
+                    c8[v] += c[v] + c[256 + v] + c[512 + v] + c[768 + v];
+            }
+            for( int v = 0; v < 256; v++ )
+            {
+                if( lut[v] >= 0 )
+                {
+                    h[lut[v]] += c8[v];
+                    total += c8[v];
+                }
+            }
+        }
+        else
+        {
+            double scale = bins/(vmax - vmin);
+            Mat buf;
+            for( int i = range.start; i < range.end; i++ )
+            {
+                src.row(i).convertTo(buf, CV_64F);
+                const double* sptr = buf.ptr<double>();
+                const uchar* mptr = mask.empty() ? 0 : mask.ptr<uchar>(i);
+                for( int j = 0; j < src.cols; j++ )
+                {
+                    double v = sptr[j];
+                    // the comparisons also reject NaNs
+                    if( (!mptr || mptr[j]) && v >= vmin && v < vmax )
+                    {
+                        h[std::min(cvFloor((v - vmin)*scale), bins - 1)]++;
+                        total++;
+                    }
+                }
+            }
+        }
+
+        AutoLock lock(*mutex);
+        for( int b = 0; b < bins; b++ )
+            hist[b] += (double)h[b];
+        *count += total;
+    }
+
+protected:
+    const Mat& src;
+    const Mat& mask;
+    const int* lut;
+    double vmin, vmax;
+    double* hist;
+    int bins;
+    int64* count;
+    Mutex* mutex;
+};
+
+HistogramAccumulator::HistogramAccumulator(int bins, double minVal, double maxVal)
+{
+    CV_Assert( bins > 0 && minVal < maxVal );
+    h = Mat::zeros(1, bins, CV_64F);
+    n = 0;
+    vmin = minVal;
+    vmax = maxVal;
+}
+
+void HistogramAccumulator::reset()
+{
+    h = Scalar::all(0);
+    n = 0;
+}
+
+void HistogramAccumulator::add(InputArray _src, InputArray _mask)
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat src = _src.getMat(), mask = _mask.getMat();
+    CV_Assert( src.channels() == 1 && src.dims <= 2 );
+    CV_Assert( mask.empty() || (mask.type() == CV_8UC1 && mask.size() == src.size()) );
+    if( src.empty() )
+        return;
+
+    int bins = h.cols;
+    int lut[256];
+    bool use_lut = src.depth() == CV_8U;
+    if( use_lut )
+    {
+        double scale = bins/(vmax - vmin);
+        for( int v = 0; v < 256; v++ )
+            lut[v] = v >= vmin && v < vmax ? std::min(cvFloor((v - vmin)*scale), bins - 1) : -1;
+    }
+
+    Mutex mutex;
+    parallel_for_(Range(0, src.rows),
+                  HistogramAccumulatorInvoker(src, mask, use_lut ? lut : 0, vmin, vmax,
+                                              h.ptr<double>(), bins, &n, &mutex),
+                  src.total()/(double)(1 << 16));
+}
+
+void HistogramAccumulator::merge(const HistogramAccumulator& other)
+{
+    CV_Assert( h.cols == other.h.cols && vmin == other.vmin && vmax == other.vmax );
+    h += other.h;
+    n += other.n;
+}
+
+} // cv
@@ -100,28 +100,6 @@ void batchDistL2_(const float* src1, const float* src2, size_t step2,
     }
 }
 
-static void batchDistHamming(const uchar* src1, const uchar* src2, size_t step2,
-                             int nvecs, int len, int* dist, const uchar* mask)
-{
-    step2 /= sizeof(src2[0]);
-    if( !mask )
-    {
-        for( int i = 0; i < nvecs; i++ )
-             dist[i] = hal::normHamming(src1, src2 + step2*i, len);
-    }
-    else
-    {
-        int val0 = INT_MAX;
-        for( int i = 0; i < nvecs; i++ )
-        {
-            if (mask[i])
-                dist[i] = hal::normHamming(src1, src2 + step2*i, len);
-            else
-                dist[i] = val0;
-        }
-    }
-}
-
 static void batchDistHamming2(const uchar* src1, const uchar* src2, size_t step2,
                               int nvecs, int len, int* dist, const uchar* mask)
 {
@@ -260,6 +238,114 @@ struct BatchDistInvoker : public ParallelLoopBody
     BatchDistFunc func;
 };
 
+// L2/L2SQR top-K search for CV_32F data through ||a||^2 + ||b||^2 - 2*a.b:
+// the dot products of a block of src1 rows against a chunk of src2 rows are
+// computed with a tiled kernel (hal::batchDotProd_32f) and merged into the K-best
+// lists right away, so the full src1.rows x src2.rows distance matrix is never
+// materialized.
+// The expansion loses precision when the points are close to each other, so it
+// is only used to reject the far candidates: every pair that may get into the
+// K-best list within the rounding error bound is re-evaluated directly, and
+// the reported distances are exactly the same as the per-pair path gives.
+struct BatchDistL2BlockInvoker : public ParallelLoopBody
+{
+    enum { BLOCK_ROWS = 64, BLOCK_COLS = 256 };
+
+    BatchDistL2BlockInvoker( const Mat& _src1, const Mat& _src2,
+                            Mat& _dist, Mat& _nidx, int _K,
+                            int _update, bool _sqrtDist )
+    {
+        src1 = &_src1;
+        src2 = &_src2;
+        dist = &_dist;
+        nidx = &_nidx;
+        K = _K;
+        update = _update;
+        sqrtDist = _sqrtDist;
+
+        norms2.create(1, src2->rows, CV_32F);
+        float* n2 = norms2.ptr<float>();
+        for( int j = 0; j < src2->rows; j++ )
+        {
+            const float* b = src2->ptr<float>(j);
+            n2[j] = normL2Sqr<float, float>(b, src2->cols);
+        }
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        const int len = src1->cols, n = src2->rows;
+        const float* n2 = norms2.ptr<float>();
+        // bound of the float rounding error of ||a||^2 + ||b||^2 - 2*a.b,
+        // relative to ||a||^2 + ||b||^2
+        const float tolScale = (len + 4)*FLT_EPSILON;
+        AutoBuffer<float> buf(BLOCK_ROWS*(BLOCK_COLS + 1));
+        float* n1 = buf.data();
+        float* dots = n1 + BLOCK_ROWS;
+
+        for( int blk = range.start; blk < range.end; blk++ )
+        {
+            int i0 = blk*BLOCK_ROWS, i1 = std::min(i0 + BLOCK_ROWS, src1->rows);
+            for( int i = i0; i < i1; i++ )
+            {
+                const float* ai = src1->ptr<float>(i);
+                n1[i - i0] = normL2Sqr<float, float>(ai, len);
+            }
+
+            for( int j0 = 0; j0 < n; j0 += BLOCK_COLS )
+            {
+                int j1 = std::min(j0 + BLOCK_COLS, n);
+                hal::batchDotProd_32f(src1->ptr<float>(i0), src1->step, i1 - i0,
+                                      src2->ptr<float>(j0), src2->step, j1 - j0,
+                                      len, dots, BLOCK_COLS*sizeof(float));
+
+                for( int i = i0; i < i1; i++ )
+                {
+                    const float* dotptr = dots + (i - i0)*BLOCK_COLS;
+                    float* distptr = dist->ptr<float>(i);
+                    int* nidxptr = nidx->ptr<int>(i);
+                    const float* ai = src1->ptr<float>(i);
+                    float ni = n1[i - i0];
+                    float worst = distptr[K-1];
+                    float worst2 = sqrtDist && worst < FLT_MAX ? worst*worst : worst;
+
+                    for( int j = j0; j < j1; j++ )
+                    {
+                        float d = ni + n2[j] - 2*dotptr[j - j0];
+                        if( d - (ni + n2[j])*tolScale >= worst2 )
+                            continue;
+                        d = hal::normL2Sqr_(ai, src2->ptr<float>(j), len);
+                        if( d < worst2 )
+                        {
+                            if( sqrtDist )
+                                d = std::sqrt(d);
+                            int k;
+                            for( k = K-2; k >= 0 && distptr[k] > d; k-- )
+                            {
+                                nidxptr[k+1] = nidxptr[k];
+                                distptr[k+1] = distptr[k];
+                            }
+                            nidxptr[k+1] = j + update;
+                            distptr[k+1] = d;
+                            worst = distptr[K-1];
+                            worst2 = sqrtDist && worst < FLT_MAX ? worst*worst : worst;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    const Mat *src1;
+    const Mat *src2;
+    Mat *dist;
+    Mat *nidx;
+    Mat norms2;
+    int K;
+    int update;
+    bool sqrtDist;
+};
+
 }
 
 void cv::batchDistance( InputArray _src1, InputArray _src2,
@@ -348,6 +434,19 @@ void cv::batchDistance( InputArray _src1, InputArray _src2,
         return;
     }
 
+    // The Gram-matrix expansion pays off once there are enough vectors to amortize
+    // the norms computation. The full distance matrix output (K == 0) has nothing to prune,
+    // so it stays on the per-pair path.
+    if( type == CV_32F && dtype == CV_32F && K > 0 && mask.empty() &&
+        (normType == NORM_L2 || normType == NORM_L2SQR) &&
+        src2.rows >= 64 && src1.cols >= 16 )
+    {
+        int nblocks = (src1.rows + BatchDistL2BlockInvoker::BLOCK_ROWS - 1)/BatchDistL2BlockInvoker::BLOCK_ROWS;
+        parallel_for_(Range(0, nblocks),
+                      BatchDistL2BlockInvoker(src1, src2, dist, nidx, K, update, normType == NORM_L2));
+        return;
+    }
+
     BatchDistFunc func = 0;
     if( type == CV_8U )
     {
@@ -362,7 +461,7 @@ void cv::batchDistance( InputArray _src1, InputArray _src2,
         else if( normType == NORM_L2 && dtype == CV_32F )
             func = (BatchDistFunc)batchDistL2_8u32f;
         else if( normType == NORM_HAMMING && dtype == CV_32S )
-            func = (BatchDistFunc)batchDistHamming;
+            func = (BatchDistFunc)hal::batchDistHamming;
         else if( normType == NORM_HAMMING2 && dtype == CV_32S )
             func = (BatchDistFunc)batchDistHamming2;
     }
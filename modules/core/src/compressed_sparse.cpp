@@ -0,0 +1,504 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "opencv2/core/compressed_sparse.hpp"
+
+namespace cv
+{
+
+namespace {
+
+struct SparseElem
+{
+    int major, minor;
+    double value;
+
+    bool operator < (const SparseElem& e) const
+    {
+        return major < e.major || (major == e.major && minor < e.minor);
+    }
+};
+
+static void compressElems(std::vector<SparseElem>& elems, int nmajor, int depth,
+                          Mat& pointers, Mat& indices, Mat& values)
+{
+    std::sort(elems.begin(), elems.end());
+    int nnz = (int)elems.size();
+    pointers.create(1, nmajor + 1, CV_32S);
+    indices.create(1, nnz, CV_32S);
+    Mat values64(1, nnz, CV_64F);
+    int* ptr = pointers.ptr<int>();
+    int* idx = indices.ptr<int>();
+    double* val = values64.ptr<double>();
+
+    int m = 0;
+    for( int k = 0; k < nnz; k++ )
+    {
+        const SparseElem& e = elems[k];
+        while( m <= e.major )
+            ptr[m++] = k;
+        idx[k] = e.minor;
+        val[k] = e.value;
+    }
+    while( m <= nmajor )
+        ptr[m++] = nnz;
+    values64.convertTo(values, depth);
+}
+
+template<typename T> static void
+transposeStorage_(int nmajor, int nminor, const Mat& pointers, const Mat& indices, const Mat& values,
+                  Mat& tpointers, Mat& tindices, Mat& tvalues)
+{
+    int nnz = (int)values.total();
+    const int* ptr = pointers.ptr<int>();
+    const int* idx = indices.ptr<int>();
+    const T* val = values.ptr<T>();
+    tpointers.create(1, nminor + 1, CV_32S);
+    tindices.create(1, nnz, CV_32S);
+    tvalues.create(1, nnz, values.type());
+    int* tptr = tpointers.ptr<int>();
+    int* tidx = tindices.ptr<int>();
+    T* tval = tvalues.ptr<T>();
+
+    // counting sort by the minor index keeps the new minor indices sorted
+    std::vector<int> next(nminor + 1, 0);
+    for( int k = 0; k < nnz; k++ )
+        next[idx[k] + 1]++;
+    for( int j = 0; j < nminor; j++ )
+        next[j + 1] += next[j];
+    std::copy(next.begin(), next.end(), tptr);
+    for( int i = 0; i < nmajor; i++ )
+    {
+        for( int k = ptr[i]; k < ptr[i + 1]; k++ )
+        {
+            int pos = next[idx[k]]++;
+            tidx[pos] = i;
+            tval[pos] = val[k];
+        }
+    }
+}
+
+template<typename T> static void
+copyToDense_(const CompressedSparseMat& m, Mat& dst)
+{
+    int nmajor = m.format == CompressedSparseMat::CSR ? m.rows : m.cols;
+    const int* ptr = m.pointers.ptr<int>();
+    const int* idx = m.indices.ptr<int>();
+    const T* val = m.values.ptr<T>();
+    for( int i = 0; i < nmajor; i++ )
+        for( int k = ptr[i]; k < ptr[i + 1]; k++ )
+        {
+            if( m.format == CompressedSparseMat::CSR )
+                dst.at<T>(i, idx[k]) = val[k];
+            else
+                dst.at<T>(idx[k], i) = val[k];
+        }
+}
+
+template<typename T> static void
+copyToSparse_(const CompressedSparseMat& m, SparseMat& dst)
+{
+    int nmajor = m.format == CompressedSparseMat::CSR ? m.rows : m.cols;
+    const int* ptr = m.pointers.ptr<int>();
+    const int* idx = m.indices.ptr<int>();
+    const T* val = m.values.ptr<T>();
+    for( int i = 0; i < nmajor; i++ )
+        for( int k = ptr[i]; k < ptr[i + 1]; k++ )
+        {
+            if( m.format == CompressedSparseMat::CSR )
+                dst.ref<T>(i, idx[k]) = val[k];
+            else
+                dst.ref<T>(idx[k], i) = val[k];
+        }
+}
+
+template<typename T> class SparseGemmInvoker : public ParallelLoopBody
+{
+public:
+    SparseGemmInvoker(const CompressedSparseMat& _A, const Mat& _B, double _alpha,
+                      const Mat& _C, double _beta, Mat& _dst)
+        : A(_A), B(_B), C(_C), dst(_dst), alpha(_alpha), beta(_beta)
+    {
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        const int* ptr = A.pointers.ptr<int>();
+        const int* idx = A.indices.ptr<int>();
+        const T* val = A.values.ptr<T>();
+        int ncols = B.cols;
+        AutoBuffer<double> _acc(ncols);
+        double* acc = _acc.data();
+
+        for( int i = range.start; i < range.end; i++ )
+        {
+            T* d = dst.ptr<T>(i);
+            const T* c = C.empty() ? 0 : C.ptr<T>(i);
+            if( ncols == 1 )
+            {
+                // matrix-vector product, B is a column
+                const uchar* b = B.ptr();
+                size_t bstep = B.step;
+                double s = 0;
+                for( int k = ptr[i]; k < ptr[i + 1]; k++ )
+                    s += (double)val[k]*((const T*)(b + bstep*idx[k]))[0];
+                d[0] = saturate_cast<T>(alpha*s + (c ? beta*c[0] : 0.));
+                continue;
+            }
+
+            for( int j = 0; j < ncols; j++ )
+                acc[j] = 0;
+            for( int k = ptr[i]; k < ptr[i + 1]; k++ )
+            {
+                double v = val[k];
+                const T* b = B.ptr<T>(idx[k]);
+                for( int j = 0; j < ncols; j++ )
+                    acc[j] += v*b[j];
+            }
+            for( int j = 0; j < ncols; j++ )
+                d[j] = saturate_cast<T>(alpha*acc[j] + (c ? beta*c[j] : 0.));
+        }
+    }
+
+private:
+    const CompressedSparseMat& A;
+    const Mat& B;
+    const Mat& C;
+    Mat& dst;
+    double alpha, beta;
+};
+
+} // namespace
+
+CompressedSparseMat::CompressedSparseMat()
+    : format(CSR), rows(0), cols(0),
+      pointers(1, 1, CV_32S, Scalar::all(0)), indices(1, 0, CV_32S), values(1, 0, CV_64F)
+{
+}
+
+CompressedSparseMat::CompressedSparseMat(const SparseMat& m, int _format)
+{
+    CV_Assert( m.dims() == 2 && m.channels() == 1 );
+    CV_Assert( _format == CSR || _format == CSC );
+    format = _format;
+    rows = m.size(0);
+    cols = m.size(1);
+
+    SparseMat m64;
+    if( m.depth() == CV_64F )
+        m64 = m;
+    else
+        m.convertTo(m64, CV_64F);
+
+    std::vector<SparseElem> elems;
+    elems.reserve(m64.nzcount());
+    SparseMatConstIterator_<double> it = m64.begin<double>(), it_end = m64.end<double>();
+    for( ; it != it_end; ++it )
+    {
+        const SparseMat::Node* n = it.node();
+        SparseElem e;
+        e.major = format == CSR ? n->idx[0] : n->idx[1];
+        e.minor = format == CSR ? n->idx[1] : n->idx[0];
+        e.value = *it;
+        elems.push_back(e);
+    }
+    compressElems(elems, format == CSR ? rows : cols, m.depth() == CV_64F ? CV_64F : CV_32F,
+                  pointers, indices, values);
+}
+
+CompressedSparseMat::CompressedSparseMat(const Mat& m, int _format)
+{
+    CV_Assert( m.dims <= 2 && m.channels() == 1 );
+    CV_Assert( _format == CSR || _format == CSC );
+    format = _format;
+    rows = m.rows;
+    cols = m.cols;
+
+    Mat m64;
+    m.convertTo(m64, CV_64F);
+    std::vector<SparseElem> elems;
+    for( int i = 0; i < rows; i++ )
+    {
+        const double* row = m64.ptr<double>(i);
+        for( int j = 0; j < cols; j++ )
+        {
+            if( row[j] == 0 )
+                continue;
+            SparseElem e;
+            e.major = format == CSR ? i : j;
+            e.minor = format == CSR ? j : i;
+            e.value = row[j];
+            elems.push_back(e);
+        }
+    }
+    compressElems(elems, format == CSR ? rows : cols, m.depth() == CV_64F ? CV_64F : CV_32F,
+                  pointers, indices, values);
+}
+
+CompressedSparseMat::CompressedSparseMat(int _rows, int _cols, int _format, const Mat& _pointers,
+                                         const Mat& _indices, const Mat& _values)
+    : format(_format), rows(_rows), cols(_cols)
+{
+    CV_Assert( rows >= 0 && cols >= 0 && (format == CSR || format == CSC) );
+    int nmajor = format == CSR ? rows : cols;
+    CV_Assert( _pointers.isContinuous() && _pointers.checkVector(1, CV_32S) == nmajor + 1 );
+    int nnz = _pointers.ptr<int>()[nmajor];
+    CV_Assert( _indices.isContinuous() && _indices.checkVector(1, CV_32S) == nnz );
+    CV_Assert( _values.isContinuous() && (_values.type() == CV_32F || _values.type() == CV_64F) &&
+               (int)_values.total() == nnz );
+    pointers = _pointers.reshape(1, 1);
+    indices = _indices.reshape(1, 1);
+    values = _values.reshape(1, 1);
+}
+
+CompressedSparseMat CompressedSparseMat::t() const
+{
+    CompressedSparseMat m = *this;
+    std::swap(m.rows, m.cols);
+    m.format = format == CSR ? CSC : CSR;
+    return m;
+}
+
+CompressedSparseMat CompressedSparseMat::toFormat(int _format) const
+{
+    CV_Assert( _format == CSR || _format == CSC );
+    if( _format == format )
+        return *this;
+
+    CompressedSparseMat m;
+    m.format = _format;
+    m.rows = rows;
+    m.cols = cols;
+    int nmajor = format == CSR ? rows : cols, nminor = format == CSR ? cols : rows;
+    if( values.depth() == CV_64F )
+        transposeStorage_<double>(nmajor, nminor, pointers, indices, values, m.pointers, m.indices, m.values);
+    else
+        transposeStorage_<float>(nmajor, nminor, pointers, indices, values, m.pointers, m.indices, m.values);
+    return m;
+}
+
+CompressedSparseMat CompressedSparseMat::toDepth(int depth) const
+{
+    CV_Assert( depth == CV_32F || depth == CV_64F );
+    CompressedSparseMat m = *this;
+    if( values.depth() != depth )
+        values.convertTo(m.values, depth);
+    return m;
+}
+
+Mat CompressedSparseMat::diag() const
+{
+    int n = std::min(rows, cols);
+    Mat d = Mat::zeros(n, 1, type());
+    const int* ptr = pointers.ptr<int>();
+    const int* idx = indices.ptr<int>();
+    for( int i = 0; i < n; i++ )
+    {
+        const int* p = std::lower_bound(idx + ptr[i], idx + ptr[i + 1], i);
+        if( p == idx + ptr[i + 1] || *p != i )
+            continue;
+        int k = (int)(p - idx);
+        if( type() == CV_64F )
+            d.at<double>(i) = values.at<double>(k);
+        else
+            d.at<float>(i) = values.at<float>(k);
+    }
+    return d;
+}
+
+void CompressedSparseMat::copyTo(OutputArray _dst) const
+{
+    _dst.create(rows, cols, type());
+    Mat dst = _dst.getMat();
+    dst.setTo(Scalar::all(0));
+    if( type() == CV_64F )
+        copyToDense_<double>(*this, dst);
+    else
+        copyToDense_<float>(*this, dst);
+}
+
+void CompressedSparseMat::copyTo(SparseMat& dst) const
+{
+    int sizes[] = { rows, cols };
+    dst.create(2, sizes, type());
+    if( type() == CV_64F )
+        copyToSparse_<double>(*this, dst);
+    else
+        copyToSparse_<float>(*this, dst);
+}
+
+void sparseGemm(const CompressedSparseMat& _A, InputArray _B, double alpha,
+                InputArray _C, double beta, OutputArray _dst, int flags)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert( (flags & ~GEMM_1_T) == 0 );
+    CompressedSparseMat A = (flags & GEMM_1_T) ? _A.t() : _A;
+    A = A.toFormat(CompressedSparseMat::CSR);
+    int type = A.type();
+
+    Mat B = _B.getMat(), C;
+    CV_Assert( B.dims <= 2 && B.channels() == 1 && (B.depth() == CV_32F || B.depth() == CV_64F) );
+    CV_Assert( B.rows == A.cols );
+    if( B.type() != type )
+        B.convertTo(B, type);
+    if( !_C.empty() && beta != 0 )
+    {
+        C = _C.getMat();
+        CV_Assert( C.rows == A.rows && C.cols == B.cols && C.channels() == 1 );
+        if( C.type() != type )
+            C.convertTo(C, type);
+    }
+
+    _dst.create(A.rows, B.cols, type);
+    Mat dst = _dst.getMat();
+    // the rows of B are read at random, so it must not be overwritten
+    if( dst.data == B.data )
+        B = B.clone();
+    if( dst.empty() )
+        return;
+
+    double nstripes = (double)A.nnz()*B.cols/(1 << 16);
+    if( type == CV_64F )
+        parallel_for_(Range(0, A.rows), SparseGemmInvoker<double>(A, B, alpha, C, beta, dst), nstripes);
+    else
+        parallel_for_(Range(0, A.rows), SparseGemmInvoker<float>(A, B, alpha, C, beta, dst), nstripes);
+}
+
+namespace {
+
+// the common part of the solvers: the matrix in the form used by the products, the right-hand
+// side and the initial approximation in double precision and the Jacobi preconditioner
+struct SparseSystem
+{
+    SparseSystem(const CompressedSparseMat& _A, InputArray _b, InputOutputArray _x, const TermCriteria& criteria)
+    {
+        A = _A.toFormat(CompressedSparseMat::CSR).toDepth(CV_64F);
+        CV_Assert( A.rows == A.cols );
+        Mat b0 = _b.getMat();
+        CV_Assert( b0.isContinuous() && b0.checkVector(1) == A.rows &&
+                   (b0.depth() == CV_32F || b0.depth() == CV_64F) );
+        bdepth = b0.depth();
+        b0.reshape(1, A.rows).convertTo(b, CV_64F);
+
+        if( !_x.empty() && _x.total() == (size_t)A.rows && _x.channels() == 1 && _x.isContinuous() )
+            _x.getMat().reshape(1, A.rows).convertTo(x, CV_64F);
+        else
+            x = Mat::zeros(A.rows, 1, CV_64F);
+
+        invDiag = A.diag();
+        for( int i = 0; i < A.rows; i++ )
+        {
+            double& d = invDiag.at<double>(i);
+            d = d != 0 ? 1./d : 1.;
+        }
+
+        maxIters = (criteria.type & TermCriteria::COUNT) ? criteria.maxCount : INT_MAX;
+        eps = (criteria.type & TermCriteria::EPS) ? criteria.epsilon : 0.;
+        CV_Assert( maxIters >= 0 && eps >= 0 );
+        threshold = eps*norm(b);
+    }
+
+    void residual(Mat& r) const
+    {
+        sparseGemm(A, x, -1, b, 1, r);
+    }
+
+    void finish(OutputArray _x) const
+    {
+        x.convertTo(_x, bdepth);
+    }
+
+    CompressedSparseMat A;
+    Mat b, x, invDiag;
+    int bdepth, maxIters;
+    double eps, threshold;
+};
+
+}
+
+int solveCG(const CompressedSparseMat& _A, InputArray _b, InputOutputArray _x, TermCriteria criteria)
+{
+    CV_INSTRUMENT_REGION();
+
+    SparseSystem sys(_A, _b, _x, criteria);
+    Mat r, z, p, Ap;
+    sys.residual(r);
+    multiply(r, sys.invDiag, z);
+    z.copyTo(p);
+    double rz = r.dot(z);
+
+    int iter = 0;
+    for( ; iter < sys.maxIters && norm(r) > sys.threshold; iter++ )
+    {
+        sparseGemm(sys.A, p, 1, noArray(), 0, Ap);
+        double pAp = p.dot(Ap);
+        if( pAp <= 0 )
+            break; // A is not positive definite or the residual has vanished
+        double alpha = rz/pAp;
+        scaleAdd(p, alpha, sys.x, sys.x);
+        scaleAdd(Ap, -alpha, r, r);
+        multiply(r, sys.invDiag, z);
+        double rz1 = r.dot(z);
+        scaleAdd(p, rz1/rz, z, p);
+        rz = rz1;
+    }
+
+    sys.finish(_x);
+    return iter;
+}
+
+int solveBiCGSTAB(const CompressedSparseMat& _A, InputArray _b, InputOutputArray _x, TermCriteria criteria)
+{
+    CV_INSTRUMENT_REGION();
+
+    SparseSystem sys(_A, _b, _x, criteria);
+    Mat r, r0, p, v, s, t, phat, shat;
+    sys.residual(r);
+    r.copyTo(r0);
+    p = Mat::zeros(r.size(), CV_64F);
+    v = Mat::zeros(r.size(), CV_64F);
+    double rho = 1, alpha = 1, omega = 1;
+
+    int iter = 0;
+    for( ; iter < sys.maxIters && norm(r) > sys.threshold; iter++ )
+    {
+        double rho1 = r0.dot(r);
+        if( std::abs(rho1) < DBL_MIN || omega == 0 )
+            break; // breakdown
+        double beta = (rho1/rho)*(alpha/omega);
+        rho = rho1;
+        // p = r + beta*(p - omega*v)
+        scaleAdd(v, -omega, p, p);
+        scaleAdd(p, beta, r, p);
+
+        multiply(p, sys.invDiag, phat);
+        sparseGemm(sys.A, phat, 1, noArray(), 0, v);
+        double r0v = r0.dot(v);
+        if( std::abs(r0v) < DBL_MIN )
+            break;
+        alpha = rho/r0v;
+        scaleAdd(v, -alpha, r, s);
+        scaleAdd(phat, alpha, sys.x, sys.x);
+        if( norm(s) <= sys.threshold )
+        {
+            s.copyTo(r);
+            iter++;
+            break;
+        }
+
+        multiply(s, sys.invDiag, shat);
+        sparseGemm(sys.A, shat, 1, noArray(), 0, t);
+        double tt = t.dot(t);
+        omega = tt > 0 ? t.dot(s)/tt : 0.;
+        scaleAdd(shat, omega, sys.x, sys.x);
+        scaleAdd(t, -omega, s, r);
+    }
+
+    sys.finish(_x);
+    return iter;
+}
+
+} // cv
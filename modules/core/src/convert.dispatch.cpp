@@ -171,6 +171,52 @@ static bool ocl_convertFp16( InputArray _src, OutputArray _dst, int sdepth, int
 }
 #endif
 
+namespace {
+
+// converts the pieces of the rows into a small cache-resident buffer and flushes it
+// to the destination with the streaming stores
+class ConvertStreamingInvoker : public ParallelLoopBody
+{
+public:
+    enum { BUF_SIZE = 16 << 10 };
+
+    ConvertStreamingInvoker(BinaryFunc _func, const Mat& _src, Mat& _dst, Size _sz, double* _scale)
+        : func(_func), src(_src), dst(_dst), sz(_sz), scale(_scale)
+    {
+        sesz = src.elemSize1();
+        desz = dst.elemSize1();
+        chunk = BUF_SIZE/desz;
+        chunksPerRow = (sz.width + chunk - 1)/chunk;
+    }
+
+    int total() const { return sz.height*chunksPerRow; }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        AutoBuffer<double> _buf(BUF_SIZE/sizeof(double));
+        uchar* buf = (uchar*)_buf.data();
+        for( int i = range.start; i < range.end; i++ )
+        {
+            int y = i/chunksPerRow, x = (i - y*chunksPerRow)*chunk;
+            int w = std::min(chunk, sz.width - x);
+            func(src.ptr(y) + x*sesz, src.step, 0, 0, buf, 0, Size(w, 1), scale);
+            streamingStoreRow(buf, dst.ptr(y) + x*desz, w*desz);
+        }
+        streamingStoreFence();
+    }
+
+private:
+    BinaryFunc func;
+    const Mat& src;
+    Mat& dst;
+    Size sz;
+    double* scale;
+    size_t sesz, desz;
+    int chunk, chunksPerRow;
+};
+
+}
+
 void Mat::convertTo(OutputArray _dst, int _type, double alpha, double beta) const
 {
     CV_INSTRUMENT_REGION();
@@ -210,7 +256,13 @@ void Mat::convertTo(OutputArray _dst, int _type, double alpha, double beta) cons
     if( dims <= 2 )
     {
         Size sz = getContinuousSize2D(src, dst, cn);
-        func( src.data, src.step, 0, 0, dst.data, dst.step, sz, scale );
+        if( useStreamingStores(dst.total()*dst.elemSize()) )
+        {
+            ConvertStreamingInvoker invoker(func, src, dst, sz, scale);
+            parallel_for_(Range(0, invoker.total()), invoker, invoker.total()/256.);
+        }
+        else
+            func( src.data, src.step, 0, 0, dst.data, dst.step, sz, scale );
     }
     else
     {
@@ -48,6 +48,7 @@
 
 #include "precomp.hpp"
 #include "opencl_kernels_core.hpp"
+#include "opencv2/core/utils/configuration.private.hpp"
 
 
 namespace cv
@@ -119,6 +120,161 @@ void convertAndUnrollScalar( const Mat& sc, int buftype, uchar* scbuf, size_t bl
         scbuf[i] = scbuf[i - esz];
 }
 
+//////////////////////////////// Streaming stores ////////////////////////////////
+
+static size_t& streamingStoreThreshold()
+{
+    static size_t threshold = utils::getConfigurationParameterSizeT("OPENCV_STREAMING_STORE_THRESHOLD", (size_t)64 << 20);
+    return threshold;
+}
+
+void setStreamingStoreThreshold(size_t bytes)
+{
+    streamingStoreThreshold() = bytes;
+}
+
+size_t getStreamingStoreThreshold()
+{
+    return streamingStoreThreshold();
+}
+
+bool useStreamingStores(size_t bytes)
+{
+    size_t threshold = streamingStoreThreshold();
+    return threshold > 0 && bytes >= threshold;
+}
+
+// The loop is unrolled to write a full 64-byte cache line at a time, so the write-combining
+// buffers are flushed without reading the destination lines into the cache. If period is not 0,
+// src is a pattern of 2*period bytes (period must be a multiple of 64) that is repeated in dst.
+void streamingStoreRow(const uchar* src, uchar* dst, size_t len, size_t period)
+{
+    size_t i = 0;
+#if CV_SIMD128
+    const int PREFETCH_DIST = 512;
+    size_t ofs = 0;
+    i = std::min(len, (size_t)(alignPtr(dst, 16) - dst));
+    if( i > 0 )
+    {
+        memcpy(dst, src, i);
+        ofs = i;
+    }
+    for( ; i + 64 <= len; i += 64 )
+    {
+        const uchar* s = src + ofs;
+#if CV_SSE
+        if( !period )
+            _mm_prefetch((const char*)(s + PREFETCH_DIST), _MM_HINT_NTA);
+#endif
+        v_uint8x16 v0 = v_load(s), v1 = v_load(s + 16), v2 = v_load(s + 32), v3 = v_load(s + 48);
+        v_store_aligned_nocache(dst + i, v0);
+        v_store_aligned_nocache(dst + i + 16, v1);
+        v_store_aligned_nocache(dst + i + 32, v2);
+        v_store_aligned_nocache(dst + i + 48, v3);
+        ofs += 64;
+        if( period && ofs >= period )
+            ofs -= period;
+    }
+    for( ; i + 16 <= len; i += 16 )
+    {
+        v_store_aligned_nocache(dst + i, v_load(src + ofs));
+        ofs += 16;
+        if( period && ofs >= period )
+            ofs -= period;
+    }
+    if( i < len )
+        memcpy(dst + i, src + ofs, len - i);
+#else
+    if( period )
+    {
+        for( ; i < len; i += period )
+            memcpy(dst + i, src, std::min(period, len - i));
+    }
+    else
+        memcpy(dst, src, len);
+#endif
+}
+
+void streamingStoreFence()
+{
+#if CV_SSE2
+    _mm_sfence();
+#endif
+}
+
+namespace {
+
+class StreamingStoreInvoker : public ParallelLoopBody
+{
+public:
+    StreamingStoreInvoker(const uchar* _src, size_t _sstep, uchar* _dst, size_t _dstep, size_t _width, size_t _period)
+        : src(_src), sstep(_sstep), dst(_dst), dstep(_dstep), width(_width), period(_period) {}
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        for( int y = range.start; y < range.end; y++ )
+            streamingStoreRow(src + sstep*y, dst + dstep*y, width, period);
+        streamingStoreFence();
+    }
+
+private:
+    const uchar* src;
+    size_t sstep;
+    uchar* dst;
+    size_t dstep, width, period;
+};
+
+// each stripe writes a few megabytes; the continuous arrays are cut into the pseudo-rows
+// of about 256K to be split between the threads
+enum { STREAMING_STRIPE_SIZE = 4 << 20, STREAMING_ROW_SIZE = 256 << 10 };
+
+static void streamingStore(const uchar* src, size_t sstep, uchar* dst, size_t dstep,
+                           size_t width, size_t height, size_t period, size_t esz)
+{
+    size_t tailRows = 0;
+    if( height == 1 || (sstep == width && dstep == width) )
+    {
+        size_t total = width*height, rowSize = STREAMING_ROW_SIZE - STREAMING_ROW_SIZE % esz;
+        width = std::min(total, rowSize);
+        height = total/width;
+        sstep = period ? 0 : width;
+        dstep = width;
+        tailRows = total - width*height;
+    }
+
+    double nstripes = (double)(width*height)/STREAMING_STRIPE_SIZE;
+    parallel_for_(Range(0, (int)height), StreamingStoreInvoker(src, sstep, dst, dstep, width, period), nstripes);
+    if( tailRows > 0 )
+    {
+        streamingStoreRow(src + sstep*height, dst + dstep*height, tailRows, period);
+        streamingStoreFence();
+    }
+}
+
+}
+
+bool streamingCopy(const uchar* src, size_t sstep, uchar* dst, size_t dstep, Size sz)
+{
+    if( !useStreamingStores((size_t)sz.width*sz.height) )
+        return false;
+    streamingStore(src, sstep, dst, dstep, sz.width, sz.height, 0, 1);
+    return true;
+}
+
+bool streamingFill(uchar* dst, size_t dstep, Size sz, const uchar* elem, size_t esz)
+{
+    // the replicated pattern must stay small enough for L1
+    if( esz > 64 || !useStreamingStores((size_t)sz.width*sz.height) )
+        return false;
+    size_t period = esz*64;
+    AutoBuffer<uchar> _buf(period*2);
+    uchar* buf = _buf.data();
+    for( size_t i = 0; i < period*2; i += esz )
+        memcpy(buf + i, elem, esz);
+    streamingStore(buf, 0, dst, dstep, sz.width, sz.height, period, esz);
+    return true;
+}
+
 template<typename T> static void
 copyMask_(const uchar* _src, size_t sstep, const uchar* mask, size_t mstep, uchar* _dst, size_t dstep, Size size)
 {
@@ -360,6 +516,9 @@ void Mat::copyTo( OutputArray _dst ) const
             const uchar* sptr = src.data;
             uchar* dptr = dst.data;
 
+            if( streamingCopy(sptr, src.step, dptr, dst.step, sz) )
+                return;
+
 #if IPP_VERSION_X100 >= 201700
             CV_IPP_RUN_FAST(CV_INSTRUMENT_FUN_IPP(ippiCopy_8u_C1R_L, sptr, (int)src.step, dptr, (int)dst.step, ippiSizeL(sz.width, sz.height)) >= 0)
 #endif
@@ -381,9 +540,18 @@ void Mat::copyTo( OutputArray _dst ) const
         uchar* ptrs[2] = {};
         NAryMatIterator it(arrays, ptrs, 2);
         size_t sz = it.size*elemSize();
+        bool nocache = useStreamingStores(total()*elemSize());
 
         for( size_t i = 0; i < it.nplanes; i++, ++it )
-            memcpy(ptrs[1], ptrs[0], sz);
+        {
+            if( nocache )
+            {
+                streamingStoreRow(ptrs[0], ptrs[1], sz);
+                streamingStoreFence();
+            }
+            else
+                memcpy(ptrs[1], ptrs[0], sz);
+        }
     }
 }
 
@@ -510,6 +678,15 @@ Mat& Mat::operator = (const Scalar& s)
     if (this->empty())
         return *this;
 
+    if( dims <= 2 && channels() <= 4 && useStreamingStores(total()*elemSize()) )
+    {
+        double buf[4];
+        scalarToRawData(s, buf, type(), 0);
+        Size sz = getContinuousSize2D(*this, (int)elemSize());
+        streamingFill(data, step, sz, (const uchar*)buf, elemSize());
+        return *this;
+    }
+
     const Mat* arrays[] = { this };
     uchar* dptr;
     NAryMatIterator it(arrays, &dptr, 1);
@@ -631,6 +808,15 @@ Mat& Mat::setTo(InputArray _value, InputArray _mask)
     size_t esz = mcn > 1 ? elemSize1() : elemSize();
     BinaryFunc copymask = getCopyMaskFunc(esz);
 
+    if( mask.empty() && dims <= 2 && esz <= 64 && useStreamingStores(total()*esz) )
+    {
+        uchar scbuf[64];
+        convertAndUnrollScalar( value, type(), scbuf, 1 );
+        Size sz = getContinuousSize2D(*this, (int)esz);
+        streamingFill(data, step, sz, scbuf, esz);
+        return *this;
+    }
+
     const Mat* arrays[] = { this, !mask.empty() ? &mask : 0, 0 };
     uchar* ptrs[2]={0,0};
     NAryMatIterator it(arrays, ptrs);
@@ -797,7 +983,7 @@ namespace
 
 void copyMakeBorder_8u( const uchar* src, size_t srcstep, cv::Size srcroi,
                         uchar* dst, size_t dststep, cv::Size dstroi,
-                        int top, int left, int cn, int borderType )
+                        int top, int left, int cn, int borderType, bool nocache )
 {
     const int isz = (int)sizeof(int);
     int i, j, k, elemSize = 1;
@@ -839,7 +1025,12 @@ void copyMakeBorder_8u( const uchar* src, size_t srcstep, cv::Size srcroi,
     for( i = 0; i < srcroi.height; i++, dstInner += dststep, src += srcstep )
     {
         if( dstInner != src )
-            memcpy(dstInner, src, srcroi.width*elemSize);
+        {
+            if( nocache )
+                cv::streamingStoreRow(src, dstInner, srcroi.width*elemSize);
+            else
+                memcpy(dstInner, src, srcroi.width*elemSize);
+        }
 
         if( intMode )
         {
@@ -865,20 +1056,29 @@ void copyMakeBorder_8u( const uchar* src, size_t srcstep, cv::Size srcroi,
     for( i = 0; i < top; i++ )
     {
         j = cv::borderInterpolate(i - top, srcroi.height, borderType);
-        memcpy(dst + (i - top)*dststep, dst + j*dststep, dstroi.width);
+        if( nocache )
+            cv::streamingStoreRow(dst + j*dststep, dst + (i - top)*dststep, dstroi.width);
+        else
+            memcpy(dst + (i - top)*dststep, dst + j*dststep, dstroi.width);
     }
 
     for( i = 0; i < bottom; i++ )
     {
         j = cv::borderInterpolate(i + srcroi.height, srcroi.height, borderType);
-        memcpy(dst + (i + srcroi.height)*dststep, dst + j*dststep, dstroi.width);
+        if( nocache )
+            cv::streamingStoreRow(dst + j*dststep, dst + (i + srcroi.height)*dststep, dstroi.width);
+        else
+            memcpy(dst + (i + srcroi.height)*dststep, dst + j*dststep, dstroi.width);
     }
+
+    if( nocache )
+        cv::streamingStoreFence();
 }
 
 
 void copyMakeConstBorder_8u( const uchar* src, size_t srcstep, cv::Size srcroi,
                              uchar* dst, size_t dststep, cv::Size dstroi,
-                             int top, int left, int cn, const uchar* value )
+                             int top, int left, int cn, const uchar* value, bool nocache )
 {
     int i, j;
     cv::AutoBuffer<uchar> _constBuf(dstroi.width*cn);
@@ -902,17 +1102,35 @@ void copyMakeConstBorder_8u( const uchar* src, size_t srcstep, cv::Size srcroi,
     for( i = 0; i < srcroi.height; i++, dstInner += dststep, src += srcstep )
     {
         if( dstInner != src )
-            memcpy( dstInner, src, srcroi.width );
+        {
+            if( nocache )
+                cv::streamingStoreRow(src, dstInner, srcroi.width);
+            else
+                memcpy( dstInner, src, srcroi.width );
+        }
         memcpy( dstInner - left, constBuf, left );
         memcpy( dstInner + srcroi.width, constBuf, right );
     }
 
     for( i = 0; i < top; i++ )
-        memcpy(dst + i * dststep, constBuf, dstroi.width);
+    {
+        if( nocache )
+            cv::streamingStoreRow(constBuf, dst + i * dststep, dstroi.width);
+        else
+            memcpy(dst + i * dststep, constBuf, dstroi.width);
+    }
 
     dst += (top + srcroi.height) * dststep;
     for( i = 0; i < bottom; i++ )
-        memcpy(dst + i * dststep, constBuf, dstroi.width);
+    {
+        if( nocache )
+            cv::streamingStoreRow(constBuf, dst + i * dststep, dstroi.width);
+        else
+            memcpy(dst + i * dststep, constBuf, dstroi.width);
+    }
+
+    if( nocache )
+        cv::streamingStoreFence();
 }
 
 }
@@ -1059,12 +1277,16 @@ void cv::copyMakeBorder( InputArray _src, OutputArray _dst, int top, int bottom,
 
     borderType &= ~BORDER_ISOLATED;
 
-    CV_IPP_RUN_FAST(ipp_copyMakeBorder(src, dst, top, bottom, left, right, borderType, value))
+    bool nocache = useStreamingStores(dst.total()*dst.elemSize());
+    if( !nocache )
+    {
+        CV_IPP_RUN_FAST(ipp_copyMakeBorder(src, dst, top, bottom, left, right, borderType, value))
+    }
 
     if( borderType != BORDER_CONSTANT )
         copyMakeBorder_8u( src.ptr(), src.step, src.size(),
                            dst.ptr(), dst.step, dst.size(),
-                           top, left, (int)src.elemSize(), borderType );
+                           top, left, (int)src.elemSize(), borderType, nocache );
     else
     {
         int cn = src.channels(), cn1 = cn;
@@ -1077,7 +1299,7 @@ void cv::copyMakeBorder( InputArray _src, OutputArray _dst, int top, int bottom,
         scalarToRawData(value, buf.data(), CV_MAKETYPE(src.depth(), cn1), cn);
         copyMakeConstBorder_8u( src.ptr(), src.step, src.size(),
                                 dst.ptr(), dst.step, dst.size(),
-                                top, left, (int)src.elemSize(), (uchar*)buf.data() );
+                                top, left, (int)src.elemSize(), (uchar*)buf.data(), nocache );
     }
 }
 
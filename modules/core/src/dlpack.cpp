@@ -0,0 +1,310 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "opencv2/core/dlpack.hpp"
+
+namespace cv {
+
+// implemented in umatrix.cpp
+void setSize(UMat& m, int _dims, const int* _sz, const size_t* _steps, bool autoSteps);
+void finalizeHdr(UMat& m);
+
+namespace dlpack {
+
+namespace {
+
+static int depthFromDataType(const DataType& dtype)
+{
+    if( dtype.lanes != 1 )
+        CV_Error(Error::StsUnsupportedFormat, "DLPack: the vector element types (lanes > 1) are not supported");
+    switch( dtype.code )
+    {
+    case kDLUInt:
+        if( dtype.bits == 8 ) return CV_8U;
+        if( dtype.bits == 16 ) return CV_16U;
+        break;
+    case kDLInt:
+        if( dtype.bits == 8 ) return CV_8S;
+        if( dtype.bits == 16 ) return CV_16S;
+        if( dtype.bits == 32 ) return CV_32S;
+        break;
+    case kDLFloat:
+        if( dtype.bits == 16 ) return CV_16F;
+        if( dtype.bits == 32 ) return CV_32F;
+        if( dtype.bits == 64 ) return CV_64F;
+        break;
+    case kDLBool:
+        if( dtype.bits == 8 ) return CV_8U;
+        break;
+    }
+    CV_Error_(Error::StsUnsupportedFormat, ("DLPack: the element type (code=%d, bits=%d) is not supported",
+                                            (int)dtype.code, (int)dtype.bits));
+}
+
+static DataType dataTypeFromDepth(int depth)
+{
+    DataType dtype;
+    dtype.code = (uint8_t)(depth == CV_8U || depth == CV_16U ? kDLUInt :
+                           depth == CV_8S || depth == CV_16S || depth == CV_32S ? kDLInt : kDLFloat);
+    dtype.bits = (uint8_t)(CV_ELEM_SIZE1(depth)*8);
+    dtype.lanes = 1;
+    return dtype;
+}
+
+// the tensor layout in terms of Mat
+struct MatLayout
+{
+    int dims, type;
+    int sizes[CV_MAX_DIM];
+    size_t steps[CV_MAX_DIM];
+};
+
+static void getMatLayout(const Tensor& t, bool lastDimAsChannels, MatLayout& l)
+{
+    int depth = depthFromDataType(t.dtype);
+    size_t esz1 = CV_ELEM_SIZE1(depth);
+    int ndim = t.ndim;
+    CV_Assert( 0 <= ndim && ndim <= CV_MAX_DIM + 1 );
+    CV_Assert( ndim == 0 || t.shape );
+
+    // shape and strides (in bytes), the compact row-major ones if strides are not specified
+    int64 shape[CV_MAX_DIM + 1], strides[CV_MAX_DIM + 1];
+    for( int i = ndim - 1; i >= 0; i-- )
+    {
+        CV_Assert( 0 <= t.shape[i] && t.shape[i] <= INT_MAX );
+        shape[i] = t.shape[i];
+        strides[i] = t.strides ? t.strides[i]*(int64)esz1 :
+                     i == ndim - 1 ? (int64)esz1 : strides[i + 1]*shape[i + 1];
+    }
+
+    int cn = 1;
+    if( lastDimAsChannels && ndim == 3 && shape[2] <= CV_CN_MAX &&
+        (shape[2] == 1 || strides[2] == (int64)esz1) &&
+        (shape[1] <= 1 || strides[1] == shape[2]*(int64)esz1) )
+    {
+        cn = (int)shape[2];
+        ndim = 2;
+    }
+    if( ndim < 2 )
+    {
+        // the scalars and 1D tensors become the single-column matrices
+        shape[1] = 1;
+        strides[1] = (int64)esz1;
+        if( ndim == 0 )
+        {
+            shape[0] = 1;
+            strides[0] = (int64)esz1;
+        }
+        ndim = 2;
+    }
+    CV_Assert( ndim <= CV_MAX_DIM );
+
+    l.dims = ndim;
+    l.type = CV_MAKETYPE(depth, cn);
+    size_t esz = esz1*cn;
+    for( int i = ndim - 1; i >= 0; i-- )
+    {
+        l.sizes[i] = (int)shape[i];
+        if( i == ndim - 1 )
+        {
+            if( shape[i] > 1 && strides[i] != (int64)esz )
+                CV_Error(Error::BadStep, "DLPack: the innermost dimension of the tensor must be contiguous");
+            l.steps[i] = esz;
+        }
+        else if( shape[i] <= 1 )
+            l.steps[i] = l.steps[i + 1]*std::max(l.sizes[i + 1], 1);
+        else
+        {
+            if( strides[i] <= 0 )
+                CV_Error(Error::BadStep, "DLPack: the negative and zero strides are not supported");
+            l.steps[i] = (size_t)strides[i];
+        }
+    }
+}
+
+// the owner of the imported tensor: the deleter is called when the data is not referenced any more
+class DLPackAllocator CV_FINAL : public MatAllocator
+{
+public:
+    UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step,
+                       AccessFlag flags, UMatUsageFlags usageFlags) const CV_OVERRIDE
+    {
+        // the new buffers of the matrices that had the imported data, e.g. after create()
+        return Mat::getStdAllocator()->allocate(dims, sizes, type, data, step, flags, usageFlags);
+    }
+
+    bool allocate(UMatData* u, AccessFlag accessFlags, UMatUsageFlags usageFlags) const CV_OVERRIDE
+    {
+        return Mat::getStdAllocator()->allocate(u, accessFlags, usageFlags);
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if( !u )
+            return;
+        CV_Assert( u->urefcount == 0 );
+        CV_Assert( u->refcount == 0 );
+        ManagedTensor* tensor = (ManagedTensor*)u->userdata;
+        if( tensor && tensor->deleter )
+            tensor->deleter(tensor);
+        delete u;
+    }
+
+    UMatData* wrap(ManagedTensor* tensor, const Mat& m) const
+    {
+        UMatData* u = new UMatData(this);
+        u->data = u->origdata = (uchar*)m.datastart;
+        u->size = m.dataend - m.datastart;
+        u->userdata = tensor;
+        return u;
+    }
+};
+
+static const DLPackAllocator& getDLPackAllocator()
+{
+    CV_SINGLETON_LAZY_INIT_REF(DLPackAllocator, new DLPackAllocator())
+}
+
+static bool isHostAccessible(int deviceType)
+{
+    return deviceType == kDLCPU || deviceType == kDLCUDAHost ||
+           deviceType == kDLCUDAManaged || deviceType == kDLROCMHost;
+}
+
+struct ExportContext
+{
+    // the members are destroyed in the reverse order, so the mapped Mat is released before UMat
+    UMat umat;
+    Mat mat;
+    int64_t shape[CV_MAX_DIM + 1], strides[CV_MAX_DIM + 1];
+    ManagedTensor tensor;
+};
+
+static void deleteExportContext(ManagedTensor* tensor)
+{
+    delete (ExportContext*)tensor->manager_ctx;
+}
+
+static ManagedTensor* exportTensor(ExportContext* ctx, int dims, const int* sizes, const size_t* steps,
+                                   int type, void* data, uint64_t byteOffset, int deviceType)
+{
+    int depth = CV_MAT_DEPTH(type), cn = CV_MAT_CN(type);
+    size_t esz1 = CV_ELEM_SIZE1(depth);
+    int ndim = 0;
+    for( int i = 0; i < dims; i++, ndim++ )
+    {
+        ctx->shape[ndim] = sizes[i];
+        ctx->strides[ndim] = (int64_t)(i < dims - 1 ? steps[i]/esz1 : cn);
+    }
+    if( cn > 1 )
+    {
+        ctx->shape[ndim] = cn;
+        ctx->strides[ndim++] = 1;
+    }
+
+    ManagedTensor& t = ctx->tensor;
+    t.dl_tensor.data = data;
+    t.dl_tensor.device.device_type = deviceType;
+    t.dl_tensor.device.device_id = 0;
+    t.dl_tensor.ndim = ndim;
+    t.dl_tensor.dtype = dataTypeFromDepth(depth);
+    t.dl_tensor.shape = ctx->shape;
+    t.dl_tensor.strides = ctx->strides;
+    t.dl_tensor.byte_offset = byteOffset;
+    t.manager_ctx = ctx;
+    t.deleter = deleteExportContext;
+    return &t;
+}
+
+} // namespace
+
+Mat toMat(ManagedTensor* tensor, bool lastDimAsChannels)
+{
+    CV_Assert( tensor );
+    const Tensor& t = tensor->dl_tensor;
+    if( !isHostAccessible(t.device.device_type) )
+        CV_Error_(Error::StsNotImplemented, ("DLPack: the memory of the device type %d is not accessible by CPU",
+                                             (int)t.device.device_type));
+    MatLayout l;
+    getMatLayout(t, lastDimAsChannels, l);
+
+    Mat m(l.dims, l.sizes, l.type, (uchar*)t.data + t.byte_offset, l.steps);
+    if( m.empty() )
+    {
+        if( tensor->deleter )
+            tensor->deleter(tensor);
+        return Mat(l.dims, l.sizes, l.type);
+    }
+    const DLPackAllocator& allocator = getDLPackAllocator();
+    m.allocator = (MatAllocator*)&allocator;
+    m.u = allocator.wrap(tensor, m);
+    m.addref();
+    return m;
+}
+
+UMat toUMat(ManagedTensor* tensor, bool lastDimAsChannels)
+{
+    CV_Assert( tensor );
+    const Tensor& t = tensor->dl_tensor;
+    if( t.device.device_type == kDLOpenCL )
+    {
+#ifdef HAVE_OPENCL
+        MatLayout l;
+        getMatLayout(t, lastDimAsChannels, l);
+        CV_Assert( l.dims == 2 && t.byte_offset == 0 );
+        UMat dst;
+        // the buffer is retained by UMat, so the producer can release its reference right away
+        ocl::convertFromBuffer(t.data, l.steps[0], l.sizes[0], l.sizes[1], l.type, dst);
+        if( tensor->deleter )
+            tensor->deleter(tensor);
+        return dst;
+#else
+        CV_Error(Error::StsNotImplemented, "DLPack: OpenCV is built without OpenCL support");
+#endif
+    }
+
+    Mat m = toMat(tensor, lastDimAsChannels);
+    UMat dst;
+    if( ocl::useOpenCL() || !m.u )
+    {
+        m.copyTo(dst);
+        return dst;
+    }
+    // without OpenCL UMat keeps the data in the host memory, so it shares the imported buffer
+    dst.flags = (m.flags & Mat::TYPE_MASK) | UMat::MAGIC_VAL;
+    setSize(dst, m.dims, m.size.p, m.step.p, false);
+    finalizeHdr(dst);
+    dst.u = m.u;
+    dst.offset = m.data - m.datastart;
+    dst.addref();
+    return dst;
+}
+
+ManagedTensor* fromMat(const Mat& m)
+{
+    CV_Assert( m.dims <= CV_MAX_DIM );
+    ExportContext* ctx = new ExportContext;
+    ctx->mat = m;
+    return exportTensor(ctx, m.dims, m.size.p, m.step.p, m.type(), m.data, 0, kDLCPU);
+}
+
+ManagedTensor* fromUMat(const UMat& m)
+{
+    CV_Assert( m.dims <= CV_MAX_DIM );
+    ExportContext* ctx = new ExportContext;
+    ctx->umat = m;
+#ifdef HAVE_OPENCL
+    if( m.u && m.u->currAllocator == ocl::getOpenCLAllocator() )
+    {
+        void* handle = m.handle(ACCESS_RW);
+        if( handle )
+            return exportTensor(ctx, m.dims, m.size.p, m.step.p, m.type(), handle, m.offset, kDLOpenCL);
+    }
+#endif
+    ctx->mat = m.getMat(ACCESS_RW);
+    return exportTensor(ctx, m.dims, m.size.p, m.step.p, m.type(), ctx->mat.data, 0, kDLCPU);
+}
+
+}} // namespace
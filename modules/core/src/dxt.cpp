@@ -399,6 +399,73 @@ DFTInit( int n0, int nf, const int* factors, int* itab, int elem_size, void* _wa
     }
 }
 
+static void DCTInit( int n, int elem_size, void* _wave, int inv );
+
+// Factorization of the transform size, permutation table and twiddle factors.
+// The tables do not change once computed, so they are shared by all the transforms of the same size.
+struct DFTTables
+{
+    DFTTables( int n, int complex_elem_size, int inv_itab, bool dct )
+    {
+        nf = DFTFactorize( n, factors );
+        itab.resize(n);
+        wave.resize(n*complex_elem_size/sizeof(double));
+        DFTInit( n, nf, factors, &itab[0], complex_elem_size, &wave[0], inv_itab );
+        if( dct )
+        {
+            dct_wave.resize((n/2 + 1)*complex_elem_size/sizeof(double));
+            DCTInit( n, complex_elem_size, &dct_wave[0], inv_itab );
+        }
+    }
+
+    int nf;
+    int factors[34];
+    std::vector<int> itab;
+    std::vector<double> wave;
+    std::vector<double> dct_wave;
+};
+
+class DFTTablesCache
+{
+public:
+    static DFTTablesCache & getInstance()
+    {
+        CV_SINGLETON_LAZY_INIT_REF(DFTTablesCache, new DFTTablesCache())
+    }
+
+    Ptr<DFTTables> getTables(int n, int complex_elem_size, int inv_itab, bool dct)
+    {
+        // the tables for the very large transforms are not worth keeping,
+        // computing them is cheap compared to the transform itself
+        if( (size_t)n*complex_elem_size > MAX_TABLE_SIZE )
+            return makePtr<DFTTables>(n, complex_elem_size, inv_itab, dct);
+
+        int64 key = ((int64)n << 8) | (complex_elem_size << 2) | (inv_itab ? 2 : 0) | (dct ? 1 : 0);
+        AutoLock lock(mutex);
+        std::map<int64, Ptr<DFTTables> >::iterator f = tablesStorage.find(key);
+        if( f != tablesStorage.end() )
+            return f->second;
+
+        if( tablesStorage.size() >= MAX_TABLES )
+            tablesStorage.clear();
+        Ptr<DFTTables> tables = makePtr<DFTTables>(n, complex_elem_size, inv_itab, dct);
+        tablesStorage[key] = tables;
+        return tables;
+    }
+
+protected:
+    enum { MAX_TABLES = 64, MAX_TABLE_SIZE = 1 << 20 };
+
+    DFTTablesCache() {}
+    Mutex mutex;
+    std::map<int64, Ptr<DFTTables> > tablesStorage;
+};
+
+static Ptr<DFTTables> getDFTTables( int n, int complex_elem_size, int inv_itab, bool dct )
+{
+    return DFTTablesCache::getInstance().getTables(n, complex_elem_size, inv_itab, dct);
+}
+
 // Reference radix-2 implementation.
 template<typename T> struct DFT_R2
 {
@@ -542,11 +609,76 @@ template<typename T> struct DFT_VecR3
     }
 };
 
-template<typename T> struct DFT_VecR4
+// a single radix-4 stage, returns false if there is no vector code for it
+template<typename T> struct DFT_VecR4Stage
 {
-    int operator()(Complex<T>*, int, int, int&, const Complex<T>*) const { return 1; }
+    bool operator()(Complex<T>*, int, int, int, const Complex<T>*) const { return false; }
+};
+
+#if CV_SIMD128
+
+// The radix-4 stage with the universal intrinsics: the butterflies of VT::nlanes consecutive j
+// are computed at once, the real and the imaginary parts are deinterleaved. The first stages,
+// where there are less than VT::nlanes butterflies in a group, are left to the other code.
+template<typename T, typename VT> struct DFT_VecR4StageImpl
+{
+    bool operator()(Complex<T>* dst, const int c_n, const int n, const int dw0, const Complex<T>* wave) const
+    {
+        const int VECSZ = VT::nlanes, nx = n/4;
+        if( nx < VECSZ )
+            return false;
+
+        T CV_DECL_ALIGNED(CV_SIMD_WIDTH) wbuf[6][VECSZ];
+        for( int i = 0; i < c_n; i += n )
+        {
+            for( int j = 0; j < nx; j += VECSZ )
+            {
+                for( int k = 0; k < VECSZ; k++ )
+                {
+                    int dw = (j + k)*dw0;
+                    wbuf[0][k] = wave[dw].re; wbuf[1][k] = wave[dw].im;
+                    wbuf[2][k] = wave[dw*2].re; wbuf[3][k] = wave[dw*2].im;
+                    wbuf[4][k] = wave[dw*3].re; wbuf[5][k] = wave[dw*3].im;
+                }
+                VT w1r = v_load_aligned(wbuf[0]), w1i = v_load_aligned(wbuf[1]);
+                VT w2r = v_load_aligned(wbuf[2]), w2i = v_load_aligned(wbuf[3]);
+                VT w3r = v_load_aligned(wbuf[4]), w3i = v_load_aligned(wbuf[5]);
+
+                T* v0 = (T*)(dst + i + j);
+                T* v1 = (T*)(dst + i + j + nx*2);
+                VT ar, ai, br, bi, cr, ci, dr, di, t;
+                v_load_deinterleave(v0, ar, ai);
+                v_load_deinterleave(v0 + nx*2, br, bi);
+                v_load_deinterleave(v1, cr, ci);
+                v_load_deinterleave(v1 + nx*2, dr, di);
+
+                // b*w2, c*w1, d*w3
+                t = br*w2r - bi*w2i; bi = v_fma(br, w2i, bi*w2r); br = t;
+                t = cr*w1r - ci*w1i; ci = v_fma(cr, w1i, ci*w1r); cr = t;
+                t = dr*w3r - di*w3i; di = v_fma(dr, w3i, di*w3r); dr = t;
+
+                VT s0r = ar + br, s0i = ai + bi, s1r = ar - br, s1i = ai - bi;
+                VT s2r = cr + dr, s2i = ci + di, s3r = cr - dr, s3i = ci - di;
+
+                v_store_interleave(v0, s0r + s2r, s0i + s2i);
+                v_store_interleave(v1, s0r - s2r, s0i - s2i);
+                // s1 -/+ i*s3
+                v_store_interleave(v0 + nx*2, s1r + s3i, s1i - s3r);
+                v_store_interleave(v1 + nx*2, s1r - s3i, s1i + s3r);
+            }
+        }
+        vx_cleanup();
+        return true;
+    }
 };
 
+template<> struct DFT_VecR4Stage<float> : DFT_VecR4StageImpl<float, v_float32x4> {};
+#if CV_SIMD128_64F
+template<> struct DFT_VecR4Stage<double> : DFT_VecR4StageImpl<double, v_float64x2> {};
+#endif
+
+#endif
+
 #if CV_SSE3
 
 // multiplies *a and *b:
@@ -641,90 +773,6 @@ template<> struct DFT_VecR3<float> {
     }
 };
 
-// optimized radix-4 transform
-template<> struct DFT_VecR4<float>
-{
-    int operator()(Complex<float>* dst, int N, int n0, int& _dw0, const Complex<float>* wave) const
-    {
-        int n = 1, i, j, nx, dw, dw0 = _dw0;
-        __m128 z = _mm_setzero_ps(), x02=z, x13=z, w01=z, w23=z, y01, y23, t0, t1;
-        Cv32suf t; t.i = 0x80000000;
-        __m128 neg0_mask = _mm_load_ss(&t.f);
-        __m128 neg3_mask = _mm_shuffle_ps(neg0_mask, neg0_mask, _MM_SHUFFLE(0,1,2,3));
-
-        for( ; n*4 <= N; )
-        {
-            nx = n;
-            n *= 4;
-            dw0 /= 4;
-
-            for( i = 0; i < n0; i += n )
-            {
-                Complexf *v0, *v1;
-
-                v0 = dst + i;
-                v1 = v0 + nx*2;
-
-                x02 = _mm_loadl_pi(x02, (const __m64*)&v0[0]);
-                x13 = _mm_loadl_pi(x13, (const __m64*)&v0[nx]);
-                x02 = _mm_loadh_pi(x02, (const __m64*)&v1[0]);
-                x13 = _mm_loadh_pi(x13, (const __m64*)&v1[nx]);
-
-                y01 = _mm_add_ps(x02, x13);
-                y23 = _mm_sub_ps(x02, x13);
-                t1 = _mm_xor_ps(_mm_shuffle_ps(y01, y23, _MM_SHUFFLE(2,3,3,2)), neg3_mask);
-                t0 = _mm_movelh_ps(y01, y23);
-                y01 = _mm_add_ps(t0, t1);
-                y23 = _mm_sub_ps(t0, t1);
-
-                _mm_storel_pi((__m64*)&v0[0], y01);
-                _mm_storeh_pi((__m64*)&v0[nx], y01);
-                _mm_storel_pi((__m64*)&v1[0], y23);
-                _mm_storeh_pi((__m64*)&v1[nx], y23);
-
-                for( j = 1, dw = dw0; j < nx; j++, dw += dw0 )
-                {
-                    v0 = dst + i + j;
-                    v1 = v0 + nx*2;
-
-                    x13 = _mm_loadl_pi(x13, (const __m64*)&v0[nx]);
-                    w23 = _mm_loadl_pi(w23, (const __m64*)&wave[dw*2]);
-                    x13 = _mm_loadh_pi(x13, (const __m64*)&v1[nx]); // x1, x3 = r1 i1 r3 i3
-                    w23 = _mm_loadh_pi(w23, (const __m64*)&wave[dw*3]); // w2, w3 = wr2 wi2 wr3 wi3
-
-                    t0 = _mm_mul_ps(_mm_moveldup_ps(x13), w23);
-                    t1 = _mm_mul_ps(_mm_movehdup_ps(x13), _mm_shuffle_ps(w23, w23, _MM_SHUFFLE(2,3,0,1)));
-                    x13 = _mm_addsub_ps(t0, t1);
-                    // re(x1*w2), im(x1*w2), re(x3*w3), im(x3*w3)
-                    x02 = _mm_loadl_pi(x02, (const __m64*)&v1[0]); // x2 = r2 i2
-                    w01 = _mm_loadl_pi(w01, (const __m64*)&wave[dw]); // w1 = wr1 wi1
-                    x02 = _mm_shuffle_ps(x02, x02, _MM_SHUFFLE(0,0,1,1));
-                    w01 = _mm_shuffle_ps(w01, w01, _MM_SHUFFLE(1,0,0,1));
-                    x02 = _mm_mul_ps(x02, w01);
-                    x02 = _mm_addsub_ps(x02, _mm_movelh_ps(x02, x02));
-                    // re(x0) im(x0) re(x2*w1), im(x2*w1)
-                    x02 = _mm_loadl_pi(x02, (const __m64*)&v0[0]);
-
-                    y01 = _mm_add_ps(x02, x13);
-                    y23 = _mm_sub_ps(x02, x13);
-                    t1 = _mm_xor_ps(_mm_shuffle_ps(y01, y23, _MM_SHUFFLE(2,3,3,2)), neg3_mask);
-                    t0 = _mm_movelh_ps(y01, y23);
-                    y01 = _mm_add_ps(t0, t1);
-                    y23 = _mm_sub_ps(t0, t1);
-
-                    _mm_storel_pi((__m64*)&v0[0], y01);
-                    _mm_storeh_pi((__m64*)&v0[nx], y01);
-                    _mm_storel_pi((__m64*)&v1[0], y23);
-                    _mm_storeh_pi((__m64*)&v1[nx], y23);
-                }
-            }
-        }
-
-        _dw0 = dw0;
-        return n;
-    }
-};
-
 #endif
 
 #ifdef USE_IPP_DFT
@@ -963,19 +1011,17 @@ DFT(const OcvDftOptions & c, const Complex<T>* src, Complex<T>* dst)
     // 1. power-2 transforms
     if( (c.factors[0] & 1) == 0 )
     {
-        if( c.factors[0] >= 4 && c.haveSSE3)
-        {
-            DFT_VecR4<T> vr4;
-            n = vr4(dst, c.factors[0], c.n, dw0, wave);
-        }
-
         // radix-4 transform
+        DFT_VecR4Stage<T> vr4s;
         for( ; n*4 <= c.factors[0]; )
         {
             nx = n;
             n *= 4;
             dw0 /= 4;
 
+            if( vr4s(dst, c.n, n, dw0, wave) )
+                continue;
+
             for( i = 0; i < c.n; i += n )
             {
                 Complex<T> *v0, *v1;
@@ -1261,11 +1307,14 @@ RealDFT(const OcvDftOptions & c, const T* src, T* dst)
         T scale2 = scale*(T)0.5;
         int n2 = n >> 1;
 
-        c.factors[0] >>= 1;
+        // the factors may be shared by several threads, so they are not modified in place
+        int sub_factors[34];
+        memcpy( sub_factors, c.factors, c.nf*sizeof(sub_factors[0]) );
+        sub_factors[0] >>= 1;
 
         OcvDftOptions sub_c = c;
-        sub_c.factors += (c.factors[0] == 1);
-        sub_c.nf -= (c.factors[0] == 1);
+        sub_c.factors = sub_factors + (sub_factors[0] == 1);
+        sub_c.nf -= (sub_factors[0] == 1);
         sub_c.isComplex = false;
         sub_c.isInverse = false;
         sub_c.noPermute = false;
@@ -1274,8 +1323,6 @@ RealDFT(const OcvDftOptions & c, const T* src, T* dst)
 
         DFT(sub_c, (Complex<T>*)src, (Complex<T>*)dst);
 
-        c.factors[0] <<= 1;
-
         t = dst[0] - dst[1];
         dst[0] = (dst[0] + dst[1])*scale;
         dst[1] = t*scale;
@@ -1476,11 +1523,14 @@ CCSIDFT(const OcvDftOptions & c, const T* src, T* dst)
             }
         }
 
-        c.factors[0] >>= 1;
+        // the factors may be shared by several threads, so they are not modified in place
+        int sub_factors[34];
+        memcpy( sub_factors, c.factors, c.nf*sizeof(sub_factors[0]) );
+        sub_factors[0] >>= 1;
 
         OcvDftOptions sub_c = c;
-        sub_c.factors += (c.factors[0] == 1);
-        sub_c.nf -= (c.factors[0] == 1);
+        sub_c.factors = sub_factors + (sub_factors[0] == 1);
+        sub_c.nf -= (sub_factors[0] == 1);
         sub_c.isComplex = false;
         sub_c.isInverse = false;
         sub_c.noPermute = !inplace;
@@ -1489,8 +1539,6 @@ CCSIDFT(const OcvDftOptions & c, const T* src, T* dst)
 
         DFT(sub_c, (Complex<T>*)dst, (Complex<T>*)dst);
 
-        c.factors[0] <<= 1;
-
         for( j = 0; j < n; j += 2 )
         {
             t0 = dst[j]*scale;
@@ -2778,6 +2826,11 @@ inline DftDims determineDims(int rows, int cols, bool isRowWise, bool isContinuo
     return InvalidDim;
 }
 
+static bool isReentrantDFT1D( const Ptr<hal::DFT1D>& context );
+
+// the rows/columns of larger matrices are transformed in parallel
+static const double DFT_PARALLEL_MIN_SIZE = 1 << 15;
+
 class OcvDftImpl CV_FINAL : public hal::DFT2D
 {
 protected:
@@ -2785,6 +2838,8 @@ protected:
     Ptr<hal::DFT1D> contextB;
     bool needBufferA;
     bool needBufferB;
+    bool parallelA;
+    bool parallelB;
     bool inv;
     int width;
     int height;
@@ -2801,7 +2856,6 @@ protected:
     int src_channels;
     int dst_channels;
 
-    AutoBuffer<uchar> tmp_bufA;
     AutoBuffer<uchar> tmp_bufB;
     AutoBuffer<uchar> buf0;
     AutoBuffer<uchar> buf1;
@@ -2811,6 +2865,8 @@ public:
     {
         needBufferA = false;
         needBufferB = false;
+        parallelA = false;
+        parallelB = false;
         inv = false;
         width = 0;
         height = 0;
@@ -2931,8 +2987,7 @@ public:
                 }
                 needBufferA = isInplace;
                 contextA = hal::DFT1D::create(len, count, depth, f, &needBufferA);
-                if (needBufferA)
-                    tmp_bufA.allocate(len * complex_elem_size);
+                parallelA = isReentrantDFT1D(contextA);
             }
             else
             {
@@ -2941,6 +2996,7 @@ public:
                 f |= CV_HAL_DFT_STAGE_COLS;
                 needBufferB = isInplace;
                 contextB = hal::DFT1D::create(len, count, depth, f, &needBufferB);
+                parallelB = isReentrantDFT1D(contextB);
                 if (needBufferB)
                     tmp_bufB.allocate(len * complex_elem_size);
 
@@ -3029,6 +3085,97 @@ public:
 
 protected:
 
+    class RowDftInvoker : public ParallelLoopBody
+    {
+    public:
+        RowDftInvoker(const OcvDftImpl* _impl, const uchar* _src_data, size_t _src_step,
+                      uchar* _dst_data, size_t _dst_step, int _len, int _dptr_offset, int _dst_full_len)
+            : impl(_impl), src_data(_src_data), src_step(_src_step), dst_data(_dst_data), dst_step(_dst_step),
+              len(_len), dptr_offset(_dptr_offset), dst_full_len(_dst_full_len) {}
+
+        void operator()(const Range& range) const CV_OVERRIDE
+        {
+            AutoBuffer<uchar> tmp_buf;
+            if( impl->needBufferA )
+                tmp_buf.allocate(len * impl->complex_elem_size);
+
+            for( int i = range.start; i < range.end; i++ )
+            {
+                const uchar* sptr = src_data + src_step * i;
+                uchar* dptr0 = dst_data + dst_step * i;
+                uchar* dptr = dptr0;
+
+                if( impl->needBufferA )
+                    dptr = tmp_buf.data();
+
+                impl->contextA->apply(sptr, dptr);
+
+                if( impl->needBufferA )
+                    memcpy( dptr0, dptr + dptr_offset, dst_full_len );
+            }
+        }
+
+    private:
+        const OcvDftImpl* impl;
+        const uchar* src_data;
+        size_t src_step;
+        uchar* dst_data;
+        size_t dst_step;
+        int len, dptr_offset, dst_full_len;
+    };
+
+    // transforms the pairs of complex columns, starting from the column 'a' of the source and destination
+    class ColDftInvoker : public ParallelLoopBody
+    {
+    public:
+        ColDftInvoker(const OcvDftImpl* _impl, const uchar* _sptr0, size_t _src_step,
+                      uchar* _dptr0, size_t _dst_step, int _a, int _b)
+            : impl(_impl), sptr0(_sptr0), src_step(_src_step), dptr0(_dptr0), dst_step(_dst_step), a(_a), b(_b) {}
+
+        void operator()(const Range& range) const CV_OVERRIDE
+        {
+            int len = impl->height, complex_elem_size = impl->complex_elem_size;
+            AutoBuffer<uchar> _buf(len * complex_elem_size * 3);
+            uchar *buf0 = _buf.data(), *buf1 = buf0 + len * complex_elem_size;
+            uchar *dbuf0 = buf0, *dbuf1 = buf1;
+
+            if( impl->needBufferB )
+            {
+                dbuf1 = buf1 + len * complex_elem_size;
+                dbuf0 = buf1;
+            }
+
+            for( int i = a + range.start*2; i < std::min(b, a + range.end*2); i += 2 )
+            {
+                const uchar* sptr = sptr0 + (i - a)*complex_elem_size;
+                uchar* dptr = dptr0 + (i - a)*complex_elem_size;
+
+                if( i+1 < b )
+                {
+                    CopyFrom2Columns( sptr, src_step, buf0, buf1, len, complex_elem_size );
+                    impl->contextB->apply(buf1, dbuf1);
+                }
+                else
+                    CopyColumn( sptr, src_step, buf0, complex_elem_size, len, complex_elem_size );
+
+                impl->contextB->apply(buf0, dbuf0);
+
+                if( i+1 < b )
+                    CopyTo2Columns( dbuf0, dbuf1, dptr, dst_step, len, complex_elem_size );
+                else
+                    CopyColumn( dbuf0, complex_elem_size, dptr, dst_step, len, complex_elem_size );
+            }
+        }
+
+    private:
+        const OcvDftImpl* impl;
+        const uchar* sptr0;
+        size_t src_step;
+        uchar* dptr0;
+        size_t dst_step;
+        int a, b;
+    };
+
     void rowDft(const uchar* src_data, size_t src_step, uchar* dst_data, size_t dst_step, bool isComplex, bool isLastStage)
     {
         int len, count;
@@ -3058,23 +3205,14 @@ protected:
         if( nz <= 0 || nz > count )
             nz = count;
 
-        int i;
-        for( i = 0; i < nz; i++ )
-        {
-            const uchar* sptr = src_data + src_step * i;
-            uchar* dptr0 = dst_data + dst_step * i;
-            uchar* dptr = dptr0;
-
-            if( needBufferA )
-                dptr = tmp_bufA.data();
-
-            contextA->apply(sptr, dptr);
-
-            if( needBufferA )
-                memcpy( dptr0, dptr + dptr_offset, dst_full_len );
-        }
+        RowDftInvoker invoker(this, src_data, src_step, dst_data, dst_step, len, dptr_offset, dst_full_len);
+        double work = (double)len * nz;
+        if( parallelA && nz > 1 && work >= DFT_PARALLEL_MIN_SIZE )
+            parallel_for_(Range(0, nz), invoker, work / DFT_PARALLEL_MIN_SIZE);
+        else
+            invoker(Range(0, nz));
 
-        for( ; i < count; i++ )
+        for( int i = nz; i < count; i++ )
         {
             uchar* dptr0 = dst_data + dst_step * i;
             memset( dptr0, 0, dst_full_len );
@@ -3186,24 +3324,15 @@ protected:
             }
         }
 
-        for(int i = a; i < b; i += 2 )
+        int npairs = (b - a + 1)/2;
+        if( npairs > 0 )
         {
-            if( i+1 < b )
-            {
-                CopyFrom2Columns( sptr0, src_step, buf0.data(), buf1.data(), len, complex_elem_size );
-                contextB->apply(buf1.data(), dbuf1);
-            }
+            ColDftInvoker invoker(this, sptr0, src_step, dptr0, dst_step, a, b);
+            double work = (double)len * (b - a);
+            if( parallelB && npairs > 1 && work >= DFT_PARALLEL_MIN_SIZE )
+                parallel_for_(Range(0, npairs), invoker, work / DFT_PARALLEL_MIN_SIZE);
             else
-                CopyColumn( sptr0, src_step, buf0.data(), complex_elem_size, len, complex_elem_size );
-
-            contextB->apply(buf0.data(), dbuf0);
-
-            if( i+1 < b )
-                CopyTo2Columns( dbuf0, dbuf1, dptr0, dst_step, len, complex_elem_size );
-            else
-                CopyColumn( dbuf0, complex_elem_size, dptr0, dst_step, len, complex_elem_size );
-            sptr0 += 2*complex_elem_size;
-            dptr0 += 2*complex_elem_size;
+                invoker(Range(0, npairs));
         }
         if(isLastStage && mode == FwdRealToComplex)
             complementComplexOutput(depth, dst_data, dst_step, count, len, 2);
@@ -3215,8 +3344,7 @@ class OcvDftBasicImpl CV_FINAL : public hal::DFT1D
 public:
     OcvDftOptions opt;
     int _factors[34];
-    AutoBuffer<uchar> wave_buf;
-    AutoBuffer<int> itab_buf;
+    Ptr<DFTTables> tables;
 #ifdef USE_IPP_DFT
     AutoBuffer<uchar> ippbuf;
     AutoBuffer<uchar> ippworkbuf;
@@ -3229,8 +3357,6 @@ public:
     }
     void init(int len, int count, int depth, int flags, bool *needBuffer)
     {
-        int prev_len = opt.n;
-
         int stage = (flags & CV_HAL_DFT_STAGE_COLS) != 0 ? 1 : 0;
         int complex_elem_size = depth == CV_32F ? sizeof(Complex<float>) : sizeof(Complex<double>);
         opt.isInverse = (flags & CV_HAL_DFT_INVERSE) != 0;
@@ -3297,21 +3423,13 @@ public:
 
         if (!opt.useIpp)
         {
-            if (len != prev_len)
-            {
-                opt.nf = DFTFactorize( opt.n, opt.factors );
-            }
+            tables = getDFTTables( opt.n, complex_elem_size, stage == 0 && opt.isInverse && real_transform, false );
+            opt.nf = tables->nf;
+            memcpy( opt.factors, tables->factors, sizeof(tables->factors) );
+            opt.itab = &tables->itab[0];
+            opt.wave = &tables->wave[0];
+
             bool inplace_transform = opt.factors[0] == opt.factors[opt.nf-1];
-            if (len != prev_len || (!inplace_transform && opt.isInverse && real_transform))
-            {
-                wave_buf.allocate(opt.n*complex_elem_size);
-                opt.wave = wave_buf.data();
-                itab_buf.allocate(opt.n);
-                opt.itab = itab_buf.data();
-                DFTInit( opt.n, opt.nf, opt.factors, opt.itab, complex_elem_size,
-                         opt.wave, stage == 0 && opt.isInverse && real_transform );
-            }
-            // otherwise reuse the tables calculated on the previous stage
             if (needBuffer)
             {
                 if( (stage == 0 && ((*needBuffer && !inplace_transform) || (real_transform && (len & 1)))) ||
@@ -3373,6 +3491,13 @@ public:
     void free() {}
 };
 
+// OcvDftBasicImpl::apply() can be called from several threads at once, unless IPP is used
+static bool isReentrantDFT1D( const Ptr<hal::DFT1D>& context )
+{
+    const OcvDftBasicImpl* impl = dynamic_cast<const OcvDftBasicImpl*>(context.get());
+    return impl != 0 && !impl->opt.useIpp;
+}
+
 struct ReplacementDFT1D : public hal::DFT1D
 {
     cvhalDFT *context;
@@ -4219,14 +4344,46 @@ static bool ippi_DCT_32f(const uchar * src, size_t src_step, uchar * dst, size_t
 
 namespace cv {
 
+class DctInvoker : public ParallelLoopBody
+{
+public:
+    DctInvoker(DCTFunc _dct_func, const OcvDftOptions& _opt, const uchar* _src, size_t _sstep0, size_t _sstep1,
+               uchar* _dst, size_t _dstep0, size_t _dstep1, const void* _dct_wave, bool _inplace_transform, int _elem_size)
+        : dct_func(_dct_func), opt(_opt), src(_src), sstep0(_sstep0), sstep1(_sstep1), dst(_dst), dstep0(_dstep0),
+          dstep1(_dstep1), dct_wave(_dct_wave), inplace_transform(_inplace_transform), elem_size(_elem_size) {}
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        AutoBuffer<uchar> buf(opt.n*elem_size*2);
+        uchar* src_dft_buf = buf.data();
+        uchar* dst_dft_buf = inplace_transform ? src_dft_buf : src_dft_buf + opt.n*elem_size;
+
+        for( int i = range.start; i < range.end; i++ )
+        {
+            dct_func( opt, src + i*sstep0, sstep1, src_dft_buf, dst_dft_buf,
+                      dst + i*dstep0, dstep1, dct_wave);
+        }
+    }
+
+private:
+    DCTFunc dct_func;
+    const OcvDftOptions& opt;
+    const uchar* src;
+    size_t sstep0, sstep1;
+    uchar* dst;
+    size_t dstep0, dstep1;
+    const void* dct_wave;
+    bool inplace_transform;
+    int elem_size;
+};
+
 class OcvDctImpl CV_FINAL : public hal::DCT2D
 {
 public:
     OcvDftOptions opt;
 
     int _factors[34];
-    AutoBuffer<uint> wave_buf;
-    AutoBuffer<int> itab_buf;
+    Ptr<DFTTables> tables;
 
     DCTFunc dct_func;
     bool isRowTransform;
@@ -4275,10 +4432,8 @@ public:
     {
         CV_IPP_RUN(IPP_VERSION_X100 >= 700 && depth == CV_32F, ippi_DCT_32f(src, src_step, dst, dst_step, width, height, isInverse, isRowTransform))
 
-        AutoBuffer<uchar> dct_wave;
-        AutoBuffer<uchar> src_buf, dst_buf;
-        uchar *src_dft_buf = 0, *dst_dft_buf = 0;
         int prev_len = 0;
+        bool inplace_transform = false;
         int elem_size = (depth == CV_32F) ? sizeof(float) : sizeof(double);
         int complex_elem_size = elem_size*2;
 
@@ -4319,36 +4474,22 @@ public:
                 if( len > 1 && (len & 1) )
                     CV_Error( CV_StsNotImplemented, "Odd-size DCT\'s are not implemented" );
 
-                opt.nf = DFTFactorize( len, opt.factors );
-                bool inplace_transform = opt.factors[0] == opt.factors[opt.nf-1];
-
-                wave_buf.allocate(len*complex_elem_size);
-                opt.wave = wave_buf.data();
-                itab_buf.allocate(len);
-                opt.itab = itab_buf.data();
-                DFTInit( len, opt.nf, opt.factors, opt.itab, complex_elem_size, opt.wave, isInverse );
-
-                dct_wave.allocate((len/2 + 1)*complex_elem_size);
-                src_buf.allocate(len*elem_size);
-                src_dft_buf = src_buf.data();
-                if(!inplace_transform)
-                {
-                    dst_buf.allocate(len*elem_size);
-                    dst_dft_buf = dst_buf.data();
-                }
-                else
-                {
-                    dst_dft_buf = src_buf.data();
-                }
-                DCTInit( len, complex_elem_size, dct_wave.data(), isInverse);
+                tables = getDFTTables( len, complex_elem_size, isInverse, true );
+                opt.nf = tables->nf;
+                memcpy( opt.factors, tables->factors, sizeof(tables->factors) );
+                opt.itab = &tables->itab[0];
+                opt.wave = &tables->wave[0];
+                inplace_transform = opt.factors[0] == opt.factors[opt.nf-1];
                 prev_len = len;
             }
             // otherwise reuse the tables calculated on the previous stage
-            for(unsigned i = 0; i < static_cast<unsigned>(count); i++ )
-            {
-                dct_func( opt, sptr + i*sstep0, sstep1, src_dft_buf, dst_dft_buf,
-                          dptr + i*dstep0, dstep1, dct_wave.data());
-            }
+            DctInvoker invoker(dct_func, opt, sptr, sstep0, sstep1, dptr, dstep0, dstep1,
+                               &tables->dct_wave[0], inplace_transform, elem_size);
+            double work = (double)len * count;
+            if( count > 1 && work >= DFT_PARALLEL_MIN_SIZE )
+                parallel_for_(Range(0, count), invoker, work / DFT_PARALLEL_MIN_SIZE);
+            else
+                invoker(Range(0, count));
             src = dst;
             src_step = dst_step;
         }
@@ -51,6 +51,7 @@ namespace cv
 {
 
 static int CV_KMEANS_PARALLEL_GRANULARITY = (int)utils::getConfigurationParameterSizeT("OPENCV_KMEANS_PARALLEL_GRANULARITY", 1000);
+static int CV_KMEANS_MINI_BATCH_SIZE = (int)utils::getConfigurationParameterSizeT("OPENCV_KMEANS_MINI_BATCH_SIZE", 1024);
 
 static void generateRandomCenter(int dims, const Vec2f* box, float* center, RNG& rng)
 {
@@ -91,9 +92,12 @@ private:
 /*
 k-means center initialization using the following algorithm:
 Arthur & Vassilvitskii (2007) k-means++: The Advantages of Careful Seeding
+
+If the weights are specified, the samples are chosen with the probability proportional
+to the weight multiplied by the squared distance to the closest chosen center.
 */
 static void generateCentersPP(const Mat& data, Mat& _out_centers,
-                              int K, RNG& rng, int trials)
+                              int K, RNG& rng, int trials, const float* weights = 0)
 {
     CV_TRACE_FUNCTION();
     const int dims = data.cols, N = data.rows;
@@ -108,7 +112,7 @@ static void generateCentersPP(const Mat& data, Mat& _out_centers,
     for (int i = 0; i < N; i++)
     {
         dist[i] = hal::normL2Sqr_(data.ptr<float>(i), data.ptr<float>(centers[0]), dims);
-        sum0 += dist[i];
+        sum0 += weights ? weights[i]*dist[i] : dist[i];
     }
 
     for (int k = 1; k < K; k++)
@@ -122,7 +126,7 @@ static void generateCentersPP(const Mat& data, Mat& _out_centers,
             int ci = 0;
             for (; ci < N - 1; ci++)
             {
-                p -= dist[ci];
+                p -= weights ? weights[ci]*dist[ci] : dist[ci];
                 if (p <= 0)
                     break;
             }
@@ -133,7 +137,7 @@ static void generateCentersPP(const Mat& data, Mat& _out_centers,
             double s = 0;
             for (int i = 0; i < N; i++)
             {
-                s += tdist2[i];
+                s += weights ? weights[i]*tdist2[i] : tdist2[i];
             }
 
             if (s < bestSum)
@@ -159,6 +163,130 @@ static void generateCentersPP(const Mat& data, Mat& _out_centers,
     }
 }
 
+class KMeansParallelDistanceComputer : public ParallelLoopBody
+{
+public:
+    KMeansParallelDistanceComputer(float *dist_, int *closest_, const Mat& data_,
+                                   const std::vector<int>& candidates_, int c0_, int c1_) :
+        dist(dist_), closest(closest_), data(data_), candidates(candidates_), c0(c0_), c1(c1_)
+    { }
+
+    void operator()( const cv::Range& range ) const CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        const int begin = range.start;
+        const int end = range.end;
+        const int dims = data.cols;
+
+        for (int i = begin; i < end; i++)
+        {
+            const float* sample = data.ptr<float>(i);
+            float d = dist[i];
+            int c_best = closest[i];
+            for (int c = c0; c < c1; c++)
+            {
+                float t = hal::normL2Sqr_(sample, data.ptr<float>(candidates[c]), dims);
+                if (t < d)
+                {
+                    d = t;
+                    c_best = c;
+                }
+            }
+            dist[i] = d;
+            closest[i] = c_best;
+        }
+    }
+
+private:
+    KMeansParallelDistanceComputer& operator=(const KMeansParallelDistanceComputer&); // = delete
+
+    float *dist;
+    int *closest;
+    const Mat& data;
+    const std::vector<int>& candidates;
+    const int c0, c1;
+};
+
+/*
+k-means center initialization using the following algorithm:
+Bahmani, Moseley, Vattani, Kumar & Vassilvitskii (2012) Scalable K-Means++
+
+Instead of K*trials sequential passes over the data, a couple of rounds oversample about 2*K
+candidates per round, then the candidates weighted by the number of the closest samples are
+reduced to K centers with the weighted k-means++.
+*/
+static void generateCentersParallel(const Mat& data, Mat& _out_centers,
+                                    int K, RNG& rng, int trials)
+{
+    CV_TRACE_FUNCTION();
+    const int ROUNDS = 2;
+    const int dims = data.cols, N = data.rows;
+    const double oversampling = 2.0*K;
+    cv::AutoBuffer<float, 0> _dist(N);
+    cv::AutoBuffer<int, 0> _closest(N);
+    float* dist = _dist.data();
+    int* closest = _closest.data();
+    std::vector<int> candidates;
+
+    for (int i = 0; i < N; i++)
+    {
+        dist[i] = FLT_MAX;
+        closest[i] = 0;
+    }
+
+    candidates.push_back((unsigned)rng % N);
+
+    for (int round = 0, c0 = 0; ; round++)
+    {
+        const int c1 = (int)candidates.size();
+        parallel_for_(Range(0, N),
+                      KMeansParallelDistanceComputer(dist, closest, data, candidates, c0, c1),
+                      (double)divUp((size_t)dims * N * (c1 - c0), CV_KMEANS_PARALLEL_GRANULARITY));
+        if (round == ROUNDS)
+            break;
+
+        double phi = 0;
+        for (int i = 0; i < N; i++)
+            phi += dist[i];
+        if (phi <= 0)
+            break;
+
+        double scale = oversampling/phi;
+        for (int i = 0; i < N; i++)
+        {
+            if ((double)rng < dist[i]*scale)
+                candidates.push_back(i);
+        }
+        if ((int)candidates.size() == c1)
+            break;
+        c0 = c1;
+    }
+
+    const int C = (int)candidates.size();
+    if (C <= K)
+    {
+        for (int k = 0; k < K; k++)
+        {
+            const float* src = data.ptr<float>(k < C ? candidates[k] : (int)((unsigned)rng % N));
+            std::copy(src, src + dims, _out_centers.ptr<float>(k));
+        }
+        return;
+    }
+
+    Mat cdata(C, dims, CV_32F);
+    cv::AutoBuffer<float, 0> weights(C);
+    for (int c = 0; c < C; c++)
+    {
+        const float* src = data.ptr<float>(candidates[c]);
+        std::copy(src, src + dims, cdata.ptr<float>(c));
+        weights[c] = 0.f;
+    }
+    for (int i = 0; i < N; i++)
+        weights[closest[i]] += 1.f;
+
+    generateCentersPP(cdata, _out_centers, K, rng, trials, weights.data());
+}
+
 template<bool onlyDistance>
 class KMeansDistanceComputer : public ParallelLoopBody
 {
@@ -223,6 +351,225 @@ private:
     const Mat& centers;
 };
 
+/*
+Label assignment accelerated with the triangle inequality:
+Hamerly (2010) Making k-means even faster
+
+For every sample the upper bound of the distance to the assigned center and the lower bound
+of the distance to all the other centers are maintained. The bounds are loosened by the center
+shifts on each iteration and the distances are only recomputed when the bounds overlap.
+Unlike the Elkan's method, only two bounds per sample are stored, so it scales to large N*K.
+*/
+class KMeansBoundedDistanceComputer : public ParallelLoopBody
+{
+public:
+    KMeansBoundedDistanceComputer( double *distances_,
+                                   int *labels_,
+                                   float *upper_,
+                                   float *lower_,
+                                   const Mat& data_,
+                                   const Mat& centers_,
+                                   const float *shifts_,
+                                   const float *halfDists_,
+                                   bool fullScan_)
+        : distances(distances_),
+          labels(labels_),
+          upper(upper_),
+          lower(lower_),
+          data(data_),
+          centers(centers_),
+          shifts(shifts_),
+          halfDists(halfDists_),
+          fullScan(fullScan_)
+    {
+        // the lower bound is decreased by the largest shift of the other centers
+        const int K = centers.rows;
+        maxShiftIdx = 0;
+        maxShift = secondMaxShift = 0.f;
+        for (int k = 0; k < K && !fullScan; k++)
+        {
+            if (shifts[k] > maxShift)
+            {
+                secondMaxShift = maxShift;
+                maxShift = shifts[k];
+                maxShiftIdx = k;
+            }
+            else
+                secondMaxShift = std::max(secondMaxShift, shifts[k]);
+        }
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        const int begin = range.start;
+        const int end = range.end;
+        const int K = centers.rows;
+        const int dims = centers.cols;
+
+        for (int i = begin; i < end; ++i)
+        {
+            const float *sample = data.ptr<float>(i);
+            if (!fullScan)
+            {
+                const int a = labels[i];
+                float u = upper[i] + shifts[a];
+                float l = lower[i] - (a == maxShiftIdx ? secondMaxShift : maxShift);
+                float m = std::max(halfDists[a], l);
+                if (u > m)
+                {
+                    // tighten the upper bound
+                    double dist = hal::normL2Sqr_(sample, centers.ptr<float>(a), dims);
+                    u = (float)std::sqrt(dist);
+                }
+                if (u <= m)
+                {
+                    upper[i] = u;
+                    lower[i] = l;
+                    distances[i] = (double)u*u;
+                    continue;
+                }
+            }
+
+            int k_best = 0;
+            double min_dist = DBL_MAX, min_dist2 = DBL_MAX;
+
+            for (int k = 0; k < K; k++)
+            {
+                const float* center = centers.ptr<float>(k);
+                const double dist = hal::normL2Sqr_(sample, center, dims);
+
+                if (min_dist > dist)
+                {
+                    min_dist2 = min_dist;
+                    min_dist = dist;
+                    k_best = k;
+                }
+                else if (min_dist2 > dist)
+                    min_dist2 = dist;
+            }
+
+            distances[i] = min_dist;
+            labels[i] = k_best;
+            upper[i] = (float)std::sqrt(min_dist);
+            lower[i] = K > 1 ? (float)std::sqrt(min_dist2) : FLT_MAX;
+        }
+    }
+
+private:
+    KMeansBoundedDistanceComputer& operator=(const KMeansBoundedDistanceComputer&); // = delete
+
+    double *distances;
+    int *labels;
+    float *upper;
+    float *lower;
+    const Mat& data;
+    const Mat& centers;
+    const float *shifts;
+    const float *halfDists;
+    bool fullScan;
+    int maxShiftIdx;
+    float maxShift, secondMaxShift;
+};
+
+// computes the half of the distance from every center to the closest other center
+class KMeansCenterDistanceComputer : public ParallelLoopBody
+{
+public:
+    KMeansCenterDistanceComputer(float *halfDists_, const Mat& centers_) :
+        halfDists(halfDists_), centers(centers_)
+    { }
+
+    void operator()( const cv::Range& range ) const CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        const int K = centers.rows;
+        const int dims = centers.cols;
+
+        for (int k = range.start; k < range.end; k++)
+        {
+            const float* center = centers.ptr<float>(k);
+            float min_dist = FLT_MAX;
+            for (int j = 0; j < K; j++)
+            {
+                if (j != k)
+                    min_dist = std::min(min_dist, hal::normL2Sqr_(center, centers.ptr<float>(j), dims));
+            }
+            halfDists[k] = K > 1 ? 0.5f*std::sqrt(min_dist) : FLT_MAX;
+        }
+    }
+
+private:
+    KMeansCenterDistanceComputer& operator=(const KMeansCenterDistanceComputer&); // = delete
+
+    float *halfDists;
+    const Mat& centers;
+};
+
+static void generateCenters(const Mat& data, Mat& centers, int flags,
+                            const Vec2f* box, RNG& rng, int trials)
+{
+    const int K = centers.rows;
+    if (flags & KMEANS_PP_CENTERS)
+        generateCentersPP(data, centers, K, rng, trials);
+    else if (flags & KMEANS_PARALLEL_CENTERS)
+        generateCentersParallel(data, centers, K, rng, trials);
+    else
+    {
+        for (int k = 0; k < K; k++)
+            generateRandomCenter(data.cols, box, centers.ptr<float>(k), rng);
+    }
+}
+
+/*
+Mini-batch k-means:
+Sculley (2010) Web-scale k-means clustering
+
+On every iteration only a random batch of samples is assigned to the closest centers,
+then each center is moved towards its samples with the per-center learning rate 1/count.
+*/
+static void kmeansMiniBatch(const Mat& data, Mat& centers, int batchSize,
+                            int maxCount, double epsilon, RNG& rng)
+{
+    CV_TRACE_FUNCTION();
+    const int N = data.rows, dims = data.cols, K = centers.rows;
+    Mat batch(batchSize, dims, CV_32F), old_centers;
+    cv::AutoBuffer<int, 0> batchLabels(batchSize);
+    cv::AutoBuffer<double, 0> batchDists(batchSize);
+    cv::AutoBuffer<int64, 64> counters(K);
+
+    for (int k = 0; k < K; k++)
+        counters[k] = 0;
+
+    for (int iter = 0; iter < maxCount; iter++)
+    {
+        for (int b = 0; b < batchSize; b++)
+        {
+            const float* sample = data.ptr<float>(rng.uniform(0, N));
+            std::copy(sample, sample + dims, batch.ptr<float>(b));
+        }
+
+        parallel_for_(Range(0, batchSize), KMeansDistanceComputer<false>(batchDists.data(), batchLabels.data(), batch, centers), (double)divUp((size_t)(dims * batchSize * K), CV_KMEANS_PARALLEL_GRANULARITY));
+
+        centers.copyTo(old_centers);
+        for (int b = 0; b < batchSize; b++)
+        {
+            const int k = batchLabels[b];
+            const float* sample = batch.ptr<float>(b);
+            float* center = centers.ptr<float>(k);
+            float eta = 1.f/(float)(++counters[k]);
+            for (int j = 0; j < dims; j++)
+                center[j] += (sample[j] - center[j])*eta;
+        }
+
+        double max_center_shift = 0;
+        for (int k = 0; k < K; k++)
+            max_center_shift = std::max(max_center_shift, (double)hal::normL2Sqr_(centers.ptr<float>(k), old_centers.ptr<float>(k), dims));
+        if (max_center_shift <= epsilon)
+            break;
+    }
+}
+
 }
 
 double cv::kmeans( InputArray _data, int K,
@@ -284,6 +631,11 @@ double cv::kmeans( InputArray _data, int K,
         criteria.epsilon = FLT_EPSILON;
     criteria.epsilon *= criteria.epsilon;
 
+    // the mini-batch iterations are cheap, so they are limited by maxCount only (100 by default),
+    // not by the cap on the number of full iterations below
+    const int miniBatchCount = (criteria.type & TermCriteria::COUNT) ? std::max(criteria.maxCount, 1) : 100;
+    const int miniBatchSize = std::min(N, std::max(CV_KMEANS_MINI_BATCH_SIZE, K));
+
     if (criteria.type & TermCriteria::COUNT)
         criteria.maxCount = std::min(std::max(criteria.maxCount, 2), 100);
     else
@@ -295,8 +647,12 @@ double cv::kmeans( InputArray _data, int K,
         criteria.maxCount = 2;
     }
 
+    const bool useBounds = (flags & KMEANS_HAMERLY) != 0 && !(flags & KMEANS_MINI_BATCH);
+    cv::AutoBuffer<float, 0> upper(useBounds ? N : 0), lower(useBounds ? N : 0);
+    cv::AutoBuffer<float, 64> shifts(K), halfDists(K);
+
     cv::AutoBuffer<Vec2f, 64> box(dims);
-    if (!(flags & KMEANS_PP_CENTERS))
+    if (!(flags & (KMEANS_PP_CENTERS | KMEANS_PARALLEL_CENTERS)))
     {
         {
             const float* sample = data.ptr<float>(0);
@@ -319,127 +675,174 @@ double cv::kmeans( InputArray _data, int K,
     for (int a = 0; a < attempts; a++)
     {
         double compactness = 0;
+        bool boundsValid = false;
 
-        for (int iter = 0; ;)
+        if (flags & KMEANS_MINI_BATCH)
         {
-            double max_center_shift = iter == 0 ? DBL_MAX : 0.0;
-
-            swap(centers, old_centers);
-
-            if (iter == 0 && (a > 0 || !(flags & KMEANS_USE_INITIAL_LABELS)))
-            {
-                if (flags & KMEANS_PP_CENTERS)
-                    generateCentersPP(data, centers, K, rng, SPP_TRIALS);
-                else
-                {
-                    for (int k = 0; k < K; k++)
-                        generateRandomCenter(dims, box.data(), centers.ptr<float>(k), rng);
-                }
-            }
+            if (a > 0 || !(flags & KMEANS_USE_INITIAL_LABELS))
+                generateCenters(data, centers, flags, box.data(), rng, SPP_TRIALS);
             else
             {
-                // compute centers
+                // the initial centers are the means of the user-supplied clusters
                 centers = Scalar(0);
                 for (int k = 0; k < K; k++)
                     counters[k] = 0;
-
                 for (int i = 0; i < N; i++)
                 {
                     const float* sample = data.ptr<float>(i);
-                    int k = labels[i];
-                    float* center = centers.ptr<float>(k);
+                    float* center = centers.ptr<float>(labels[i]);
                     for (int j = 0; j < dims; j++)
                         center[j] += sample[j];
-                    counters[k]++;
+                    counters[labels[i]]++;
                 }
-
                 for (int k = 0; k < K; k++)
                 {
-                    if (counters[k] != 0)
-                        continue;
-
-                    // if some cluster appeared to be empty then:
-                    //   1. find the biggest cluster
-                    //   2. find the farthest from the center point in the biggest cluster
-                    //   3. exclude the farthest point from the biggest cluster and form a new 1-point cluster.
-                    int max_k = 0;
-                    for (int k1 = 1; k1 < K; k1++)
-                    {
-                        if (counters[max_k] < counters[k1])
-                            max_k = k1;
-                    }
+                    if (counters[k] == 0)
+                        data.row((unsigned)rng % N).copyTo(centers.row(k));
+                    else
+                        centers.row(k) *= 1./counters[k];
+                }
+            }
 
-                    double max_dist = 0;
-                    int farthest_i = -1;
-                    float* base_center = centers.ptr<float>(max_k);
-                    float* _base_center = temp.ptr<float>(); // normalized
-                    float scale = 1.f/counters[max_k];
-                    for (int j = 0; j < dims; j++)
-                        _base_center[j] = base_center[j]*scale;
+            kmeansMiniBatch(data, centers, miniBatchSize, miniBatchCount, criteria.epsilon, rng);
+
+            // the final assignment may leave some clusters empty
+            parallel_for_(Range(0, N), KMeansDistanceComputer<false>(dists.data(), labels, data, centers), (double)divUp((size_t)(dims * N * K), CV_KMEANS_PARALLEL_GRANULARITY));
+            compactness = sum(Mat(Size(N, 1), CV_64F, &dists[0]))[0];
+        }
+        else
+        {
+            for (int iter = 0; ;)
+            {
+                double max_center_shift = iter == 0 ? DBL_MAX : 0.0;
+
+                swap(centers, old_centers);
+
+                if (iter == 0 && (a > 0 || !(flags & KMEANS_USE_INITIAL_LABELS)))
+                {
+                    generateCenters(data, centers, flags, box.data(), rng, SPP_TRIALS);
+                }
+                else
+                {
+                    // compute centers
+                    centers = Scalar(0);
+                    for (int k = 0; k < K; k++)
+                        counters[k] = 0;
 
                     for (int i = 0; i < N; i++)
                     {
-                        if (labels[i] != max_k)
-                            continue;
                         const float* sample = data.ptr<float>(i);
-                        double dist = hal::normL2Sqr_(sample, _base_center, dims);
+                        int k = labels[i];
+                        float* center = centers.ptr<float>(k);
+                        for (int j = 0; j < dims; j++)
+                            center[j] += sample[j];
+                        counters[k]++;
+                    }
+
+                    for (int k = 0; k < K; k++)
+                    {
+                        if (counters[k] != 0)
+                            continue;
 
-                        if (max_dist <= dist)
+                        // if some cluster appeared to be empty then:
+                        //   1. find the biggest cluster
+                        //   2. find the farthest from the center point in the biggest cluster
+                        //   3. exclude the farthest point from the biggest cluster and form a new 1-point cluster.
+                        int max_k = 0;
+                        for (int k1 = 1; k1 < K; k1++)
                         {
-                            max_dist = dist;
-                            farthest_i = i;
+                            if (counters[max_k] < counters[k1])
+                                max_k = k1;
                         }
-                    }
 
-                    counters[max_k]--;
-                    counters[k]++;
-                    labels[farthest_i] = k;
+                        double max_dist = 0;
+                        int farthest_i = -1;
+                        float* base_center = centers.ptr<float>(max_k);
+                        float* _base_center = temp.ptr<float>(); // normalized
+                        float scale = 1.f/counters[max_k];
+                        for (int j = 0; j < dims; j++)
+                            _base_center[j] = base_center[j]*scale;
 
-                    const float* sample = data.ptr<float>(farthest_i);
-                    float* cur_center = centers.ptr<float>(k);
-                    for (int j = 0; j < dims; j++)
-                    {
-                        base_center[j] -= sample[j];
-                        cur_center[j] += sample[j];
-                    }
-                }
+                        for (int i = 0; i < N; i++)
+                        {
+                            if (labels[i] != max_k)
+                                continue;
+                            const float* sample = data.ptr<float>(i);
+                            double dist = hal::normL2Sqr_(sample, _base_center, dims);
+
+                            if (max_dist <= dist)
+                            {
+                                max_dist = dist;
+                                farthest_i = i;
+                            }
+                        }
 
-                for (int k = 0; k < K; k++)
-                {
-                    float* center = centers.ptr<float>(k);
-                    CV_Assert( counters[k] != 0 );
+                        counters[max_k]--;
+                        counters[k]++;
+                        labels[farthest_i] = k;
+                        if (useBounds)
+                        {
+                            // the bounds of the moved sample are no longer valid
+                            upper[farthest_i] = FLT_MAX;
+                            lower[farthest_i] = 0.f;
+                        }
 
-                    float scale = 1.f/counters[k];
-                    for (int j = 0; j < dims; j++)
-                        center[j] *= scale;
+                        const float* sample = data.ptr<float>(farthest_i);
+                        float* cur_center = centers.ptr<float>(k);
+                        for (int j = 0; j < dims; j++)
+                        {
+                            base_center[j] -= sample[j];
+                            cur_center[j] += sample[j];
+                        }
+                    }
 
-                    if (iter > 0)
+                    for (int k = 0; k < K; k++)
                     {
-                        double dist = 0;
-                        const float* old_center = old_centers.ptr<float>(k);
+                        float* center = centers.ptr<float>(k);
+                        CV_Assert( counters[k] != 0 );
+
+                        float scale = 1.f/counters[k];
                         for (int j = 0; j < dims; j++)
+                            center[j] *= scale;
+
+                        if (iter > 0)
                         {
-                            double t = center[j] - old_center[j];
-                            dist += t*t;
+                            double dist = 0;
+                            const float* old_center = old_centers.ptr<float>(k);
+                            for (int j = 0; j < dims; j++)
+                            {
+                                double t = center[j] - old_center[j];
+                                dist += t*t;
+                            }
+                            max_center_shift = std::max(max_center_shift, dist);
+                            shifts[k] = (float)std::sqrt(dist);
                         }
-                        max_center_shift = std::max(max_center_shift, dist);
                     }
                 }
-            }
 
-            bool isLastIter = (++iter == MAX(criteria.maxCount, 2) || max_center_shift <= criteria.epsilon);
+                bool isLastIter = (++iter == MAX(criteria.maxCount, 2) || max_center_shift <= criteria.epsilon);
 
-            if (isLastIter)
-            {
-                // don't re-assign labels to avoid creation of empty clusters
-                parallel_for_(Range(0, N), KMeansDistanceComputer<true>(dists.data(), labels, data, centers), (double)divUp((size_t)(dims * N), CV_KMEANS_PARALLEL_GRANULARITY));
-                compactness = sum(Mat(Size(N, 1), CV_64F, &dists[0]))[0];
-                break;
-            }
-            else
-            {
-                // assign labels
-                parallel_for_(Range(0, N), KMeansDistanceComputer<false>(dists.data(), labels, data, centers), (double)divUp((size_t)(dims * N * K), CV_KMEANS_PARALLEL_GRANULARITY));
+                if (isLastIter)
+                {
+                    // don't re-assign labels to avoid creation of empty clusters
+                    parallel_for_(Range(0, N), KMeansDistanceComputer<true>(dists.data(), labels, data, centers), (double)divUp((size_t)(dims * N), CV_KMEANS_PARALLEL_GRANULARITY));
+                    compactness = sum(Mat(Size(N, 1), CV_64F, &dists[0]))[0];
+                    break;
+                }
+                else if (useBounds)
+                {
+                    // assign labels, skipping the samples whose bounds prove that the label is unchanged
+                    bool fullScan = !boundsValid;
+                    if (!fullScan)
+                        parallel_for_(Range(0, K), KMeansCenterDistanceComputer(halfDists.data(), centers), (double)divUp((size_t)(dims * K * K), CV_KMEANS_PARALLEL_GRANULARITY));
+                    parallel_for_(Range(0, N), KMeansBoundedDistanceComputer(dists.data(), labels, upper.data(), lower.data(), data, centers, shifts.data(), halfDists.data(), fullScan), (double)divUp((size_t)(dims * N * K), CV_KMEANS_PARALLEL_GRANULARITY));
+                    boundsValid = true;
+                }
+                else
+                {
+                    // assign labels
+                    parallel_for_(Range(0, N), KMeansDistanceComputer<false>(dists.data(), labels, data, centers), (double)divUp((size_t)(dims * N * K), CV_KMEANS_PARALLEL_GRANULARITY));
+                }
             }
         }
 
@@ -1527,6 +1527,196 @@ static void _SVDcompute( InputArray _aarr, OutputArray _w,
 }
 
 
+/****************************************************************************************\
+*                          Randomized (truncated) SVD                                    *
+\****************************************************************************************/
+
+enum { RSVD_OVERSAMPLING = 10, RSVD_POWER_ITERATIONS = 2 };
+
+// Streams the row blocks of A = src - mean through gemm() in parallel stripes.
+// With U == 0 the stripes accumulate Wt = (A^T*A*Xt^T)^T, otherwise U = A*Xt^T is stored.
+// Integer data is converted and centered block by block, so the centered copy of
+// the whole matrix is never created.
+class RandomizedSVDInvoker : public ParallelLoopBody
+{
+public:
+    enum { BLOCK_ROWS = 256 };
+
+    RandomizedSVDInvoker(const Mat& _src, const Mat& _mean, int _ctype, const Mat& _Xt,
+                         std::vector<Mat>& _Wparts, Mat* _U, int _nstripes)
+        : src(_src), mean(_mean), ctype(_ctype), Xt(_Xt), Wparts(_Wparts), U(_U), nstripes(_nstripes)
+    {
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        int m = src.rows, nblocks = (m + BLOCK_ROWS - 1)/BLOCK_ROWS;
+        Mat buf, P, T;
+
+        for( int s = range.start; s < range.end; s++ )
+        {
+            int b0 = (int)((int64)nblocks*s/nstripes), b1 = (int)((int64)nblocks*(s + 1)/nstripes);
+            for( int b = b0; b < b1; b++ )
+            {
+                int r0 = b*BLOCK_ROWS, r1 = std::min(r0 + BLOCK_ROWS, m);
+                Mat A = getBlock(r0, r1, buf);
+                if( U )
+                {
+                    Mat Ublock = U->rowRange(r0, r1);
+                    gemm(A, Xt, 1, noArray(), 0, Ublock, GEMM_2_T);
+                }
+                else
+                {
+                    gemm(A, Xt, 1, noArray(), 0, P, GEMM_2_T);
+                    gemm(P, A, 1, noArray(), 0, T, GEMM_1_T);
+                    add(Wparts[s], T, Wparts[s], noArray(), CV_64F);
+                }
+            }
+        }
+    }
+
+protected:
+    Mat getBlock(int r0, int r1, Mat& buf) const
+    {
+        Mat A = src.rowRange(r0, r1);
+        if( A.type() == ctype && mean.empty() )
+            return A;
+        A.convertTo(buf, ctype);
+        if( mean.rows == 1 )
+        {
+            for( int i = 0; i < buf.rows; i++ )
+            {
+                Mat row = buf.row(i);
+                subtract(row, mean, row);
+            }
+        }
+        else if( !mean.empty() )
+        {
+            for( int i = 0; i < buf.rows; i++ )
+            {
+                Mat row = buf.row(i);
+                subtract(row, Scalar::all(mean.at<double>(r0 + i)), row);
+            }
+        }
+        return buf;
+    }
+
+    const Mat& src;
+    const Mat& mean;
+    int ctype;
+    const Mat& Xt;
+    std::vector<Mat>& Wparts;
+    Mat* U;
+    int nstripes;
+};
+
+// Gram-Schmidt with re-orthogonalization over the rows of Y. A row that vanishes
+// (the range of the matrix is exhausted) is replaced with a random direction.
+static void orthonormalizeRows(Mat& Y, RNG& rng)
+{
+    for( int i = 0; i < Y.rows; i++ )
+    {
+        Mat yi = Y.row(i);
+        for( int attempt = 0; attempt < 10; attempt++ )
+        {
+            double norm0 = norm(yi);
+            for( int pass = 0; pass < 2; pass++ )
+            {
+                for( int j = 0; j < i; j++ )
+                {
+                    Mat yj = Y.row(j);
+                    scaleAdd(yj, -yj.dot(yi), yi, yi);
+                }
+            }
+            double norm1 = norm(yi);
+            if( norm1 > norm0*1e-10 && norm1 > DBL_EPSILON )
+            {
+                yi *= 1./norm1;
+                break;
+            }
+            rng.fill(yi, RNG::NORMAL, 0, 1);
+        }
+    }
+}
+
+// Leading singular triplets of (src - mean) by randomized subspace iteration
+// (N. Halko, P.G. Martinsson, J.A. Tropp, "Finding structure with randomness", 2011).
+// The subspace is refined with A^T*A applied in a single sweep over the data, and
+// the singular values/right vectors are extracted by the Rayleigh-Ritz projection,
+// so only rank+oversampling vectors of length src.cols have to be orthogonalized.
+void randomizedSVD(const Mat& src, const Mat& _mean, int rank,
+                   OutputArray _w, OutputArray _u, OutputArray _vt)
+{
+    CV_INSTRUMENT_REGION();
+
+    int m = src.rows, n = src.cols, ctype = std::max(CV_32F, src.depth());
+    CV_Assert( src.channels() == 1 && 0 < rank && rank <= std::min(m, n) );
+    CV_Assert( _mean.empty() || _mean.size() == Size(n, 1) || _mean.size() == Size(1, m) );
+
+    Mat mean;
+    if( !_mean.empty() )
+        _mean.convertTo(mean, _mean.rows == 1 ? ctype : CV_64F);
+
+    int l = std::min(rank + (int)RSVD_OVERSAMPLING, std::min(m, n));
+    int nblocks = (m + RandomizedSVDInvoker::BLOCK_ROWS - 1)/RandomizedSVDInvoker::BLOCK_ROWS;
+    // each stripe keeps a l x n partial sum; limit the memory they take
+    int nstripes = std::max(1, std::min(std::min(getNumThreads(), nblocks),
+                                        (int)((256 << 20)/((size_t)l*n*sizeof(double)))));
+
+    // the fixed seed makes the result reproducible
+    RNG rng(0x1234567);
+    Mat Xt(l, n, CV_64F), Wt, Xc;
+    rng.fill(Xt, RNG::NORMAL, 0, 1);
+    orthonormalizeRows(Xt, rng);
+
+    std::vector<Mat> Wparts(nstripes);
+    for( int iter = 0; ; iter++ )
+    {
+        Xt.convertTo(Xc, ctype);
+        for( int s = 0; s < nstripes; s++ )
+            Wparts[s] = Mat(l, n, CV_64F, Scalar::all(0));
+        parallel_for_(Range(0, nstripes),
+                      RandomizedSVDInvoker(src, mean, ctype, Xc, Wparts, 0, nstripes));
+        Wt = Wparts[0];
+        for( int s = 1; s < nstripes; s++ )
+            Wt += Wparts[s];
+        if( iter == RSVD_POWER_ITERATIONS )
+            break;
+        Xt = Wt;
+        orthonormalizeRows(Xt, rng);
+    }
+
+    // X^T*A^T*A*X = E*diag(w^2)*E^T, V = X*E
+    Mat G = Xt*Wt.t(), evals, evecs;
+    G = (G + G.t())*0.5;
+    eigen(G, evals, evecs);
+
+    Mat w(rank, 1, CV_64F), vt = evecs.rowRange(0, rank)*Xt;
+    for( int i = 0; i < rank; i++ )
+        w.at<double>(i) = std::sqrt(std::max(evals.at<double>(i), 0.));
+    w.convertTo(_w, ctype);
+    if( _vt.needed() )
+        vt.convertTo(_vt, ctype);
+
+    if( _u.needed() )
+    {
+        // U = A*V*diag(1/w)
+        double wmax = w.at<double>(0);
+        for( int i = 0; i < rank; i++ )
+        {
+            double wi = w.at<double>(i);
+            Mat row = vt.row(i);
+            row *= wi > wmax*DBL_EPSILON ? 1./wi : 0.;
+        }
+        vt.convertTo(Xc, ctype);
+        _u.create(m, rank, ctype);
+        Mat u = _u.getMat();
+        parallel_for_(Range(0, nstripes),
+                      RandomizedSVDInvoker(src, mean, ctype, Xc, Wparts, &u, nstripes));
+    }
+}
+
+
 void SVD::compute( InputArray a, OutputArray w, OutputArray u, OutputArray vt, int flags )
 {
     CV_INSTRUMENT_REGION();
@@ -1534,6 +1724,44 @@ void SVD::compute( InputArray a, OutputArray w, OutputArray u, OutputArray vt, i
     _SVDcompute(a, w, u, vt, flags);
 }
 
+void SVD::compute( InputArray a, OutputArray w, OutputArray u, OutputArray vt, int flags, int rank )
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat src = a.getMat();
+    if( rank <= 0 || rank >= std::min(src.rows, src.cols) )
+    {
+        _SVDcompute(src, w, u, vt, flags);
+        return;
+    }
+
+    CV_Assert( src.type() == CV_32F || src.type() == CV_64F );
+    bool compute_uv = (flags & NO_UV) == 0;
+    if( !compute_uv )
+    {
+        u.release();
+        vt.release();
+    }
+
+    if( flags & RANDOMIZED )
+    {
+        if( compute_uv )
+            randomizedSVD(src, Mat(), rank, w, u, vt);
+        else
+            randomizedSVD(src, Mat(), rank, w, noArray(), noArray());
+        return;
+    }
+
+    // the full decomposition, truncated to the leading rank triplets
+    Mat w0, u0, vt0;
+    _SVDcompute(src, w0, u0, vt0, flags & ~FULL_UV);
+    w0.rowRange(0, rank).copyTo(w);
+    if( compute_uv && u.needed() )
+        u0.colRange(0, rank).copyTo(u);
+    if( compute_uv && vt.needed() )
+        vt0.rowRange(0, rank).copyTo(vt);
+}
+
 void SVD::compute( InputArray a, OutputArray w, int flags )
 {
     CV_INSTRUMENT_REGION();
@@ -9,58 +9,139 @@ namespace cv {
 
 ////////////////////////////////////// transpose /////////////////////////////////////////
 
-template<typename T> static void
-transpose_( const uchar* src, size_t sstep, uchar* dst, size_t dstep, Size sz )
-{
-    int i=0, j, m = sz.width, n = sz.height;
+#if CV_SIMD128
 
-    #if CV_ENABLE_UNROLLED
-    for(; i <= m - 4; i += 4 )
-    {
-        T* d0 = (T*)(dst + dstep*i);
-        T* d1 = (T*)(dst + dstep*(i+1));
-        T* d2 = (T*)(dst + dstep*(i+2));
-        T* d3 = (T*)(dst + dstep*(i+3));
+// Transposition of the square blocks of elements that fit into SIMD registers:
+// 16x16 for 8-bit, 8x8 for 16-bit, 4x4 for 32-bit and 2x2 for 64-bit elements.
+template<typename T> struct TransposeBlock
+{
+    enum { size = 0 };
+    static void run( const uchar*, ptrdiff_t, uchar*, ptrdiff_t ) {}
+};
 
-        for( j = 0; j <= n - 4; j += 4 )
+template<> struct TransposeBlock<uchar>
+{
+    enum { size = 16 };
+    static void run( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep )
+    {
+        v_uint8x16 a[16], b[16];
+        v_uint16x8 c[16];
+        v_uint32x4 d[8], e[8];
+        int k;
+        for( k = 0; k < 16; k++ )
+            a[k] = v_load(src + sstep*k);
+        for( k = 0; k < 16; k += 2 )
+            v_zip(a[k], a[k+1], b[k], b[k+1]);
+        for( k = 0; k < 16; k += 4 )
+        {
+            v_zip(v_reinterpret_as_u16(b[k]), v_reinterpret_as_u16(b[k+2]), c[k], c[k+1]);
+            v_zip(v_reinterpret_as_u16(b[k+1]), v_reinterpret_as_u16(b[k+3]), c[k+2], c[k+3]);
+        }
+        for( k = 0; k < 4; k++ )
         {
-            const T* s0 = (const T*)(src + i*sizeof(T) + sstep*j);
-            const T* s1 = (const T*)(src + i*sizeof(T) + sstep*(j+1));
-            const T* s2 = (const T*)(src + i*sizeof(T) + sstep*(j+2));
-            const T* s3 = (const T*)(src + i*sizeof(T) + sstep*(j+3));
-
-            d0[j] = s0[0]; d0[j+1] = s1[0]; d0[j+2] = s2[0]; d0[j+3] = s3[0];
-            d1[j] = s0[1]; d1[j+1] = s1[1]; d1[j+2] = s2[1]; d1[j+3] = s3[1];
-            d2[j] = s0[2]; d2[j+1] = s1[2]; d2[j+2] = s2[2]; d2[j+3] = s3[2];
-            d3[j] = s0[3]; d3[j+1] = s1[3]; d3[j+2] = s2[3]; d3[j+3] = s3[3];
+            v_zip(v_reinterpret_as_u32(c[k]), v_reinterpret_as_u32(c[k+4]), d[k*2], d[k*2+1]);
+            v_zip(v_reinterpret_as_u32(c[k+8]), v_reinterpret_as_u32(c[k+12]), e[k*2], e[k*2+1]);
         }
+        for( k = 0; k < 8; k++ )
+        {
+            v_store(dst + dstep*(k*2), v_reinterpret_as_u8(v_combine_low(d[k], e[k])));
+            v_store(dst + dstep*(k*2+1), v_reinterpret_as_u8(v_combine_high(d[k], e[k])));
+        }
+    }
+};
 
-        for( ; j < n; j++ )
+template<> struct TransposeBlock<ushort>
+{
+    enum { size = 8 };
+    static void run( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep )
+    {
+        v_uint16x8 a[8], b[8];
+        v_uint32x4 c[8];
+        int k;
+        for( k = 0; k < 8; k++ )
+            a[k] = v_load((const ushort*)(src + sstep*k));
+        for( k = 0; k < 8; k += 2 )
+            v_zip(a[k], a[k+1], b[k], b[k+1]);
+        for( k = 0; k < 8; k += 4 )
+        {
+            v_zip(v_reinterpret_as_u32(b[k]), v_reinterpret_as_u32(b[k+2]), c[k], c[k+1]);
+            v_zip(v_reinterpret_as_u32(b[k+1]), v_reinterpret_as_u32(b[k+3]), c[k+2], c[k+3]);
+        }
+        for( k = 0; k < 4; k++ )
         {
-            const T* s0 = (const T*)(src + i*sizeof(T) + j*sstep);
-            d0[j] = s0[0]; d1[j] = s0[1]; d2[j] = s0[2]; d3[j] = s0[3];
+            v_store((ushort*)(dst + dstep*(k*2)), v_reinterpret_as_u16(v_combine_low(c[k], c[k+4])));
+            v_store((ushort*)(dst + dstep*(k*2+1)), v_reinterpret_as_u16(v_combine_high(c[k], c[k+4])));
         }
     }
-    #endif
-    for( ; i < m; i++ )
+};
+
+template<> struct TransposeBlock<int>
+{
+    enum { size = 4 };
+    static void run( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep )
+    {
+        v_uint32x4 a0 = v_load((const unsigned*)src), a1 = v_load((const unsigned*)(src + sstep));
+        v_uint32x4 a2 = v_load((const unsigned*)(src + sstep*2)), a3 = v_load((const unsigned*)(src + sstep*3));
+        v_uint32x4 b0, b1, b2, b3;
+        v_transpose4x4(a0, a1, a2, a3, b0, b1, b2, b3);
+        v_store((unsigned*)dst, b0);
+        v_store((unsigned*)(dst + dstep), b1);
+        v_store((unsigned*)(dst + dstep*2), b2);
+        v_store((unsigned*)(dst + dstep*3), b3);
+    }
+};
+
+template<> struct TransposeBlock<Vec2i>
+{
+    enum { size = 2 };
+    static void run( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep )
     {
-        T* d0 = (T*)(dst + dstep*i);
-        j = 0;
-        #if CV_ENABLE_UNROLLED
-        for(; j <= n - 4; j += 4 )
-        {
-            const T* s0 = (const T*)(src + i*sizeof(T) + sstep*j);
-            const T* s1 = (const T*)(src + i*sizeof(T) + sstep*(j+1));
-            const T* s2 = (const T*)(src + i*sizeof(T) + sstep*(j+2));
-            const T* s3 = (const T*)(src + i*sizeof(T) + sstep*(j+3));
+        v_uint32x4 a0 = v_load((const unsigned*)src), a1 = v_load((const unsigned*)(src + sstep));
+        v_store((unsigned*)dst, v_combine_low(a0, a1));
+        v_store((unsigned*)(dst + dstep), v_combine_high(a0, a1));
+    }
+};
 
-            d0[j] = s0[0]; d0[j+1] = s1[0]; d0[j+2] = s2[0]; d0[j+3] = s3[0];
-        }
-        #endif
-        for( ; j < n; j++ )
+#endif
+
+// Transposes the matrix tile by tile, so that both the source and the destination rows
+// stay in cache while a tile is processed. The steps may be negative, this way
+// the transposition is combined with flipping the source or the destination vertically.
+template<typename T> static void
+transpose_( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz )
+{
+    const int TILE_SIZE = 32;
+    int m = sz.width, n = sz.height;
+
+    for( int i0 = 0; i0 < m; i0 += TILE_SIZE )
+    {
+        int i1 = std::min(i0 + TILE_SIZE, m);
+        for( int j0 = 0; j0 < n; j0 += TILE_SIZE )
         {
-            const T* s0 = (const T*)(src + i*sizeof(T) + j*sstep);
-            d0[j] = s0[0];
+            int i = i0, j, j1 = std::min(j0 + TILE_SIZE, n);
+#if CV_SIMD128
+            const int bsize = TransposeBlock<T>::size;
+            if( bsize > 0 )
+            {
+                for( ; i <= i1 - bsize; i += bsize )
+                {
+                    for( j = j0; j <= j1 - bsize; j += bsize )
+                        TransposeBlock<T>::run(src + i*sizeof(T) + sstep*j, sstep, dst + dstep*i + j*sizeof(T), dstep);
+                    for( ; j < j1; j++ )
+                    {
+                        const T* s0 = (const T*)(src + i*sizeof(T) + sstep*j);
+                        for( int k = 0; k < bsize; k++ )
+                            ((T*)(dst + dstep*(i+k)))[j] = s0[k];
+                    }
+                }
+            }
+#endif
+            for( ; i < i1; i++ )
+            {
+                T* d0 = (T*)(dst + dstep*i);
+                for( j = j0; j < j1; j++ )
+                    d0[j] = *(const T*)(src + i*sizeof(T) + sstep*j);
+            }
         }
     }
 }
@@ -77,11 +158,11 @@ transposeI_( uchar* data, size_t step, int n )
     }
 }
 
-typedef void (*TransposeFunc)( const uchar* src, size_t sstep, uchar* dst, size_t dstep, Size sz );
+typedef void (*TransposeFunc)( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz );
 typedef void (*TransposeInplaceFunc)( uchar* data, size_t step, int n );
 
 #define DEF_TRANSPOSE_FUNC(suffix, type) \
-static void transpose_##suffix( const uchar* src, size_t sstep, uchar* dst, size_t dstep, Size sz ) \
+static void transpose_##suffix( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz ) \
 { transpose_<type>(src, sstep, dst, dstep, sz); } \
 \
 static void transposeI_##suffix( uchar* data, size_t step, int n ) \
@@ -112,6 +193,43 @@ static TransposeInplaceFunc transposeInplaceTab[] =
     0, 0, 0, 0, 0, 0, 0, transposeI_32sC6, 0, 0, 0, 0, 0, 0, 0, transposeI_32sC8
 };
 
+class TransposeInvoker : public ParallelLoopBody
+{
+public:
+    TransposeInvoker( TransposeFunc _func, const uchar* _src, ptrdiff_t _sstep,
+                      uchar* _dst, ptrdiff_t _dstep, int _height, size_t _esz )
+        : func(_func), src(_src), sstep(_sstep), dst(_dst), dstep(_dstep), height(_height), esz(_esz) {}
+
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        func( src + range.start*esz, sstep, dst + dstep*range.start, dstep,
+              Size(range.end - range.start, height) );
+    }
+
+private:
+    TransposeFunc func;
+    const uchar* src;
+    ptrdiff_t sstep;
+    uchar* dst;
+    ptrdiff_t dstep;
+    int height;
+    size_t esz;
+};
+
+// Transposes the matrix of size 'sz' (the destination is sz.height x sz.width),
+// processing the stripes of the destination rows in parallel for large matrices
+static void transposeMat( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz, int esz )
+{
+    TransposeFunc func = transposeTab[esz];
+    CV_Assert( func != 0 );
+
+    double nstripes = (double)sz.width*sz.height*esz/(1 << 16);
+    if( nstripes > 1 && sz.width > 1 )
+        parallel_for_(Range(0, sz.width), TransposeInvoker(func, src, sstep, dst, dstep, sz.height, esz), nstripes);
+    else
+        func( src, sstep, dst, dstep, sz );
+}
+
 #ifdef HAVE_OPENCL
 
 static bool ocl_transpose( InputArray _src, OutputArray _dst )
@@ -275,9 +393,7 @@ void transpose( InputArray _src, OutputArray _dst )
     }
     else
     {
-        TransposeFunc func = transposeTab[esz];
-        CV_Assert( func != 0 );
-        func( src.ptr(), src.step, dst.ptr(), dst.step, src.size() );
+        transposeMat( src.ptr(), src.step, dst.ptr(), dst.step, src.size(), esz );
     }
 }
 
@@ -745,6 +861,29 @@ void flip( InputArray _src, OutputArray _dst, int flip_mode )
         flipHoriz( dst.ptr(), dst.step, dst.ptr(), dst.step, dst.size(), esz );
 }
 
+// Rotates the matrix by 90 degrees in a single pass: the transposition is done with the source
+// rows (clockwise) or the destination rows (counter-clockwise) taken in the reverse order.
+static bool rotate90( InputArray _src, OutputArray _dst, bool clockwise )
+{
+    int type = _src.type(), esz = CV_ELEM_SIZE(type);
+    if( _dst.isUMat() || esz > 32 || transposeTab[esz] == 0 || _src.empty() )
+        return false;
+
+    Mat src = _src.getMat();
+    _dst.create(src.cols, src.rows, type);
+    Mat dst = _dst.getMat();
+
+    // in-place operation and single-row/single-column STL vectors are handled by transpose() + flip()
+    if( dst.data == src.data || src.rows != dst.cols || src.cols != dst.rows )
+        return false;
+
+    if( clockwise )
+        transposeMat( src.ptr(src.rows - 1), -(ptrdiff_t)src.step, dst.ptr(), dst.step, src.size(), esz );
+    else
+        transposeMat( src.ptr(), src.step, dst.ptr(dst.rows - 1), -(ptrdiff_t)dst.step, src.size(), esz );
+    return true;
+}
+
 void rotate(InputArray _src, OutputArray _dst, int rotateMode)
 {
     CV_Assert(_src.dims() <= 2);
@@ -752,6 +891,8 @@ void rotate(InputArray _src, OutputArray _dst, int rotateMode)
     switch (rotateMode)
     {
     case ROTATE_90_CLOCKWISE:
+        if( rotate90(_src, _dst, true) )
+            break;
         transpose(_src, _dst);
         flip(_dst, _dst, 1);
         break;
@@ -759,6 +900,8 @@ void rotate(InputArray _src, OutputArray _dst, int rotateMode)
         flip(_src, _dst, -1);
         break;
     case ROTATE_90_COUNTERCLOCKWISE:
+        if( rotate90(_src, _dst, false) )
+            break;
         transpose(_src, _dst);
         flip(_dst, _dst, 0);
         break;
@@ -509,23 +509,8 @@ static bool ipp_meanStdDev(Mat& src, OutputArray _mean, OutputArray _sdv, Mat& m
 }
 #endif
 
-void meanStdDev(InputArray _src, OutputArray _mean, OutputArray _sdv, InputArray _mask)
+int sumSqr(const Mat& src, const Mat& mask, double* s, double* sq)
 {
-    CV_INSTRUMENT_REGION();
-
-    CV_Assert(!_src.empty());
-    CV_Assert( _mask.empty() || _mask.type() == CV_8UC1 );
-
-    CV_OCL_RUN(OCL_PERFORMANCE_CHECK(_src.isUMat()) && _src.dims() <= 2,
-               ocl_meanStdDev(_src, _mean, _sdv, _mask))
-
-    Mat src = _src.getMat(), mask = _mask.getMat();
-
-    CV_OVX_RUN(!ovx::skipSmallImages<VX_KERNEL_MEAN_STDDEV>(src.cols, src.rows),
-               openvx_meanStdDev(src, _mean, _sdv, mask))
-
-    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_meanStdDev(src, _mean, _sdv, mask));
-
     int k, cn = src.channels(), depth = src.depth();
 
     SumSqrFunc func = getSumSqrFunc(depth);
@@ -537,8 +522,7 @@ void meanStdDev(InputArray _src, OutputArray _mean, OutputArray _sdv, InputArray
     NAryMatIterator it(arrays, ptrs);
     int total = (int)it.size, blockSize = total, intSumBlockSize = 0;
     int j, count = 0, nz0 = 0;
-    AutoBuffer<double> _buf(cn*4);
-    double *s = (double*)_buf.data(), *sq = s + cn;
+    AutoBuffer<int> _ibuf(cn*2);
     int *sbuf = (int*)s, *sqbuf = (int*)sq;
     bool blockSum = depth <= CV_16S, blockSqSum = depth <= CV_8S;
     size_t esz = 0;
@@ -550,7 +534,7 @@ void meanStdDev(InputArray _src, OutputArray _mean, OutputArray _sdv, InputArray
     {
         intSumBlockSize = 1 << 15;
         blockSize = std::min(blockSize, intSumBlockSize);
-        sbuf = (int*)(sq + cn);
+        sbuf = _ibuf.data();
         if( blockSqSum )
             sqbuf = sbuf + cn;
         for( k = 0; k < cn; k++ )
@@ -589,6 +573,31 @@ void meanStdDev(InputArray _src, OutputArray _mean, OutputArray _sdv, InputArray
         }
     }
 
+    return nz0;
+}
+
+void meanStdDev(InputArray _src, OutputArray _mean, OutputArray _sdv, InputArray _mask)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert(!_src.empty());
+    CV_Assert( _mask.empty() || _mask.type() == CV_8UC1 );
+
+    CV_OCL_RUN(OCL_PERFORMANCE_CHECK(_src.isUMat()) && _src.dims() <= 2,
+               ocl_meanStdDev(_src, _mean, _sdv, _mask))
+
+    Mat src = _src.getMat(), mask = _mask.getMat();
+
+    CV_OVX_RUN(!ovx::skipSmallImages<VX_KERNEL_MEAN_STDDEV>(src.cols, src.rows),
+               openvx_meanStdDev(src, _mean, _sdv, mask))
+
+    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_meanStdDev(src, _mean, _sdv, mask));
+
+    int k, j, cn = src.channels();
+    AutoBuffer<double> _buf(cn*2);
+    double *s = _buf.data(), *sq = s + cn;
+    int nz0 = sumSqr(src, mask, s, sq);
+
     double scale = nz0 ? 1./nz0 : 0.;
     for( k = 0; k < cn; k++ )
     {
@@ -0,0 +1,367 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "parallel_impl.hpp"
+
+#include <opencv2/core/utils/numa.hpp>
+#include <opencv2/core/utils/numa.private.hpp>
+#include <opencv2/core/utils/configuration.private.hpp>
+#include <opencv2/core/utils/logger.hpp>
+
+#include <atomic>
+
+#if defined __linux__ && !defined __ANDROID__
+#  define CV_HAVE_NUMA 1
+#  include <fstream>
+#  include <pthread.h>
+#  include <sched.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+namespace cv { namespace utils {
+
+#ifdef CV_HAVE_NUMA
+
+namespace {
+
+enum { NUMA_MAX_NODES = 1024, MPOL_BIND_ = 2, MPOL_INTERLEAVE_ = 3 };
+
+// parses the lists like "0-3,8,10-11"
+static std::vector<int> readSysList(const std::string& filename)
+{
+    std::vector<int> items;
+    std::ifstream ifs(filename.c_str());
+    std::string s;
+    if( !ifs.is_open() || !std::getline(ifs, s) )
+        return items;
+
+    const char* p = s.c_str();
+    while( *p )
+    {
+        char* end = 0;
+        long a = strtol(p, &end, 10), b = a;
+        if( end == p )
+            break;
+        p = end;
+        if( *p == '-' )
+        {
+            b = strtol(p + 1, &end, 10);
+            p = end;
+        }
+        for( long i = a; i <= b; i++ )
+            items.push_back((int)i);
+        if( *p == ',' )
+            p++;
+    }
+    return items;
+}
+
+struct NumaTopology
+{
+    NumaTopology()
+    {
+        load("/sys/devices/system/node");
+    }
+
+    void load(const std::string& root)
+    {
+        nodeIds.clear();
+        nodeCPUs.clear();
+        std::vector<int> online = readSysList(root + "/online");
+        for( size_t i = 0; i < online.size(); i++ )
+        {
+            if( online[i] >= NUMA_MAX_NODES )
+                continue;
+            std::vector<int> cpus = readSysList(cv::format("%s/node%d/cpulist", root.c_str(), online[i]));
+            if( cpus.empty() )
+                continue;
+            nodeIds.push_back(online[i]);
+            nodeCPUs.push_back(cpus);
+        }
+        CPU_ZERO(&initialAffinity);
+        if( sched_getaffinity(0, sizeof(initialAffinity), &initialAffinity) != 0 )
+        {
+            for( size_t i = 0; i < nodeCPUs.size(); i++ )
+                for( size_t j = 0; j < nodeCPUs[i].size(); j++ )
+                    if( nodeCPUs[i][j] < CPU_SETSIZE )
+                        CPU_SET(nodeCPUs[i][j], &initialAffinity);
+        }
+    }
+
+    int nodeOfCPU(int cpu) const
+    {
+        for( size_t i = 0; i < nodeCPUs.size(); i++ )
+            if( std::find(nodeCPUs[i].begin(), nodeCPUs[i].end(), cpu) != nodeCPUs[i].end() )
+                return (int)i;
+        return -1;
+    }
+
+    // indices of the nodes in the system, the CPUs of each node
+    std::vector<int> nodeIds;
+    std::vector<std::vector<int> > nodeCPUs;
+    cpu_set_t initialAffinity;
+};
+
+static NumaTopology& getNumaTopology()
+{
+    CV_SINGLETON_LAZY_INIT_REF(NumaTopology, new NumaTopology())
+}
+
+// the pages that are not touched yet are placed according to the policy on the first touch
+static bool setMemoryPolicy(void* data, size_t size, int node)
+{
+    const NumaTopology& topology = getNumaTopology();
+    // without the topology (no sysfs, containers) there is nothing to bind to
+    if( topology.nodeIds.empty() || node >= (int)topology.nodeIds.size() )
+        return false;
+    unsigned long mask[NUMA_MAX_NODES/(sizeof(unsigned long)*8)] = {};
+    const int bits = (int)sizeof(unsigned long)*8;
+    if( node >= 0 )
+    {
+        int id = topology.nodeIds[node];
+        mask[id / bits] |= 1UL << (id % bits);
+    }
+    else
+    {
+        for( size_t i = 0; i < topology.nodeIds.size(); i++ )
+        {
+            int id = topology.nodeIds[i];
+            mask[id / bits] |= 1UL << (id % bits);
+        }
+    }
+    long res = syscall(SYS_mbind, data, size, node >= 0 ? MPOL_BIND_ : MPOL_INTERLEAVE_,
+                       mask, (unsigned long)NUMA_MAX_NODES, 0);
+    if( res != 0 )
+    {
+        static bool warned = false;
+        if( !warned )
+        {
+            warned = true;
+            CV_LOG_WARNING(NULL, "NUMA: mbind() failed, errno=" << errno << ". Memory placement is not applied");
+        }
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+void reloadNumaTopology(const std::string& sysfsNodeDir)
+{
+    getNumaTopology().load(sysfsNodeDir.empty() ? std::string("/sys/devices/system/node") : sysfsNodeDir);
+}
+
+int getNumaNodesCount()
+{
+    return std::max((int)getNumaTopology().nodeCPUs.size(), 1);
+}
+
+int getCurrentNumaNode()
+{
+    int cpu = sched_getcpu();
+    return cpu >= 0 ? getNumaTopology().nodeOfCPU(cpu) : -1;
+}
+
+bool bindCurrentThreadToNumaNode(int node)
+{
+    const NumaTopology& topology = getNumaTopology();
+    CV_Assert( node < getNumaNodesCount() );
+    cpu_set_t cpus;
+    if( node < 0 || topology.nodeCPUs.empty() )
+        cpus = topology.initialAffinity;
+    else
+    {
+        CPU_ZERO(&cpus);
+        const std::vector<int>& nodeCPUs = topology.nodeCPUs[node];
+        for( size_t i = 0; i < nodeCPUs.size(); i++ )
+            if( nodeCPUs[i] < CPU_SETSIZE )
+                CPU_SET(nodeCPUs[i], &cpus);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+}
+
+#else // CV_HAVE_NUMA
+
+void reloadNumaTopology(const std::string&) {}
+int getNumaNodesCount() { return 1; }
+int getCurrentNumaNode() { return -1; }
+bool bindCurrentThreadToNumaNode(int) { return false; }
+
+#endif // CV_HAVE_NUMA
+
+//////////////////////////////// worker threads ////////////////////////////////
+
+static int getDefaultNumaThreadBinding(int& node)
+{
+    std::string mode = utils::getConfigurationParameterString("OPENCV_NUMA_THREADS", "free");
+    node = 0;
+    if( mode == "spread" )
+        return NUMA_THREADS_SPREAD;
+    if( !mode.empty() && isdigit((uchar)mode[0]) )
+    {
+        node = std::min(atoi(mode.c_str()), getNumaNodesCount() - 1);
+        return NUMA_THREADS_NODE;
+    }
+    return NUMA_THREADS_FREE;
+}
+
+struct NumaThreadBindingState
+{
+    NumaThreadBindingState()
+    {
+        int node0 = 0;
+        int mode0 = getDefaultNumaThreadBinding(node0);
+        mode = mode0;
+        node = node0;
+        // the workers start with the generation 0, so the default free mode is not even applied
+        generation = mode0 != NUMA_THREADS_FREE ? 1 : 0;
+    }
+
+    std::atomic<int> mode, node;
+    std::atomic<unsigned> generation;
+};
+
+static NumaThreadBindingState& getNumaThreadBindingState()
+{
+    static NumaThreadBindingState state;
+    return state;
+}
+
+void setNumaThreadBinding(int mode, int node)
+{
+    CV_Assert( mode == NUMA_THREADS_FREE || mode == NUMA_THREADS_SPREAD || mode == NUMA_THREADS_NODE );
+    CV_Assert( mode != NUMA_THREADS_NODE || (0 <= node && node < getNumaNodesCount()) );
+    NumaThreadBindingState& state = getNumaThreadBindingState();
+    state.mode = mode;
+    state.node = node;
+    state.generation++;
+}
+
+} // namespace utils
+
+void applyNumaThreadBinding(unsigned& appliedGeneration, unsigned threadIdx, unsigned nthreads)
+{
+    utils::NumaThreadBindingState& state = utils::getNumaThreadBindingState();
+    unsigned generation = state.generation.load(std::memory_order_acquire);
+    if( generation == appliedGeneration )
+        return;
+    appliedGeneration = generation;
+
+    int mode = state.mode, node = -1;
+    if( mode == utils::NUMA_THREADS_NODE )
+        node = state.node;
+    else if( mode == utils::NUMA_THREADS_SPREAD )
+        node = (int)((uint64)threadIdx*utils::getNumaNodesCount()/std::max(nthreads, 1u));
+    if( !utils::bindCurrentThreadToNumaNode(node) && mode != utils::NUMA_THREADS_FREE )
+    {
+        CV_LOG_DEBUG(NULL, "NUMA: can't bind thread " << threadIdx << " to the node " << node);
+    }
+}
+
+namespace utils {
+
+//////////////////////////////// allocator ////////////////////////////////
+
+namespace {
+
+class NumaMatAllocator CV_FINAL : public MatAllocator
+{
+public:
+    // the placement is applied to the whole pages, so it's not worth it for the small buffers
+    enum { MIN_NUMA_SIZE = 1 << 20 };
+
+    NumaMatAllocator(int node_) : node(node_) {}
+
+    UMatData* allocate(int dims, const int* sizes, int type,
+                       void* data0, size_t* step, AccessFlag /*flags*/, UMatUsageFlags /*usageFlags*/) const CV_OVERRIDE
+    {
+        size_t total = CV_ELEM_SIZE(type);
+        for( int i = dims-1; i >= 0; i-- )
+        {
+            if( step )
+            {
+                if( data0 && step[i] != CV_AUTOSTEP )
+                {
+                    CV_Assert(total <= step[i]);
+                    total = step[i];
+                }
+                else
+                    step[i] = total;
+            }
+            total *= sizes[i];
+        }
+
+        UMatData* u = new UMatData(this);
+        uchar* data = (uchar*)data0;
+#ifdef CV_HAVE_NUMA
+        if( !data && total >= MIN_NUMA_SIZE && !getNumaTopology().nodeIds.empty() )
+        {
+            // fresh anonymous pages are not touched yet, so the policy places all of them
+            void* ptr = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if( ptr != MAP_FAILED )
+            {
+                setMemoryPolicy(ptr, total, node);
+                data = (uchar*)ptr;
+                u->allocatorFlags_ = 1;
+            }
+        }
+#endif
+        if( !data )
+            data = (uchar*)fastMalloc(total);
+        u->data = u->origdata = data;
+        u->size = total;
+        if(data0)
+            u->flags |= UMatData::USER_ALLOCATED;
+
+        return u;
+    }
+
+    bool allocate(UMatData* u, AccessFlag /*accessFlags*/, UMatUsageFlags /*usageFlags*/) const CV_OVERRIDE
+    {
+        if(!u) return false;
+        return true;
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if(!u)
+            return;
+
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        if( !(u->flags & UMatData::USER_ALLOCATED) )
+        {
+#ifdef CV_HAVE_NUMA
+            if( u->allocatorFlags_ == 1 )
+                munmap(u->origdata, u->size);
+            else
+#endif
+                fastFree(u->origdata);
+            u->origdata = 0;
+        }
+        delete u;
+    }
+
+protected:
+    int node;
+};
+
+}
+
+MatAllocator* getNumaAllocator(int node)
+{
+    int nnodes = getNumaNodesCount();
+    CV_Assert( node < nnodes );
+    // the allocators are never destroyed, since the matrices may outlive the static objects
+    static std::vector<MatAllocator*> allocators;
+    cv::AutoLock lock(cv::getInitializationMutex());
+    for( int i = (int)allocators.size() - 1; i < nnodes; i++ )
+        allocators.push_back(new NumaMatAllocator(i));
+    return allocators[std::max(node, -1) + 1];
+}
+
+}} // namespace
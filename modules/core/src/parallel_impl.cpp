@@ -202,6 +202,8 @@ public:
 
     Ptr<ParallelJob> job;
 
+    unsigned numa_binding_generation;  // see applyNumaThreadBinding()
+
     pthread_mutex_t mutex;
 #if !defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
     volatile bool isActive;
@@ -214,7 +216,8 @@ public:
         posix_thread(0),
         is_created(false),
         stop_thread(false),
-        has_wake_signal(false)
+        has_wake_signal(false),
+        numa_binding_generation(0)
 #if !defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
         , isActive(true)
 #endif
@@ -425,6 +428,7 @@ void WorkerThread::thread_body()
             ParallelJob* j = j_ptr;
             if (j)
             {
+                applyNumaThreadBinding(numa_binding_generation, id + 1, thread_pool.num_threads);
                 CV_LOG_VERBOSE(NULL, 5, "Thread: job size=" << j->range.size() << " done=" << j->current_task);
                 if (j->current_task < j->range.size())
                 {
@@ -12,6 +12,10 @@ void parallel_for_pthreads(const Range& range, const ParallelLoopBody& body, dou
 size_t parallel_pthreads_get_threads_num();
 void parallel_pthreads_set_threads_num(int num);
 
+// binds the calling worker thread according to utils::setNumaThreadBinding() if the setting
+// has changed since the last call; threadIdx is in [0, nthreads), 0 is the main thread
+void applyNumaThreadBinding(unsigned& appliedGeneration, unsigned threadIdx, unsigned nthreads);
+
 }
 
 #endif // OPENCV_CORE_PARALLEL_IMPL_HPP
@@ -97,6 +97,30 @@ PCA& PCA::operator()(InputArray _data, InputArray __mean, int flags, int maxComp
     int ctype = std::max(CV_32F, data.depth());
     mean.create( mean_sz, ctype );
 
+    if( (flags & PCA::RANDOMIZED) && out_count < count )
+    {
+        if( !_mean.empty() )
+        {
+            CV_Assert( _mean.size() == mean_sz );
+            _mean.convertTo(mean, ctype);
+        }
+        else
+            reduce( data, mean, (flags & CV_PCA_DATA_AS_COL) ? 1 : 0, REDUCE_AVG, ctype );
+
+        // the covariance matrix eigenvalues are the squared singular values of the centered
+        // data divided by the number of samples (CV_COVAR_SCALE)
+        Mat w, u;
+        if( flags & CV_PCA_DATA_AS_COL )
+        {
+            randomizedSVD( data, mean, out_count, w, u, noArray() );
+            transpose( u, eigenvectors );
+        }
+        else
+            randomizedSVD( data, mean, out_count, w, noArray(), eigenvectors );
+        multiply( w, w, eigenvalues, 1./in_count );
+        return *this;
+    }
+
     Mat covar( count, count, ctype );
 
     if( !_mean.empty() )
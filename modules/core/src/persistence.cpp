@@ -339,9 +339,257 @@ static inline void writeReal(uchar* p, double fval)
 #endif
 }
 
+// Conversion of the numbers collected by NumberList. The digits are accumulated 8 at a time;
+// when the mantissa and the power of 10 are exactly representable as doubles, the result is
+// computed with a single (correctly rounded) multiplication or division, otherwise strtod is used.
+
+static inline uint64 loadEightChars(const char* p)
+{
+#if CV_UNALIGNED_LITTLE_ENDIAN_MEM_ACCESS
+    uint64 v;
+    memcpy(&v, p, 8);
+    return v;
+#else
+    uint64 v = 0;
+    for( int i = 7; i >= 0; i-- )
+        v = (v << 8) | (uchar)p[i];
+    return v;
+#endif
+}
+
+static inline bool isEightDigits(uint64 v)
+{
+    return ((v & CV_BIG_UINT(0xF0F0F0F0F0F0F0F0)) |
+            (((v + CV_BIG_UINT(0x0606060606060606)) & CV_BIG_UINT(0xF0F0F0F0F0F0F0F0)) >> 4)) ==
+            CV_BIG_UINT(0x3333333333333333);
+}
+
+static inline unsigned parseEightDigits(uint64 v)
+{
+    const uint64 mask = CV_BIG_UINT(0x000000FF000000FF);
+    v -= CV_BIG_UINT(0x3030303030303030);
+    v = v*10 + (v >> 8);
+    v = ((v & mask)*CV_BIG_UINT(0x000F424000000064) + ((v >> 16) & mask)*CV_BIG_UINT(0x0000271000000001)) >> 32;
+    return (unsigned)v;
+}
+
+static inline const char* readDigits(const char* p, const char* end, uint64& m, int& ndigits)
+{
+    for( ; end - p >= 8; p += 8, ndigits += 8 )
+    {
+        uint64 v = loadEightChars(p);
+        if( !isEightDigits(v) )
+            break;
+        m = m*100000000 + parseEightDigits(v);
+    }
+    for( ; p < end && cv_isdigit(*p); p++, ndigits++ )
+        m = m*10 + (*p - '0');
+    return p;
+}
+
+static bool parseDecimal(const char* p, const char* end, double& value)
+{
+    static const double pow10[] =
+    {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const uint64 max_exact = CV_BIG_UINT(1) << 53;
+
+    bool neg = *p == '-';
+    if( *p == '-' || *p == '+' )
+        p++;
+    while( p < end && *p == '0' )
+        p++;
+
+    uint64 m = 0;
+    int ndigits = 0, exp10 = 0;
+    p = readDigits(p, end, m, ndigits);
+    if( p < end && *p == '.' )
+    {
+        const char* frac = ++p;
+        if( ndigits == 0 )
+            for( ; p < end && *p == '0'; p++ )
+                ;
+        p = readDigits(p, end, m, ndigits);
+        exp10 -= (int)(p - frac);
+    }
+    if( ndigits > 19 )
+        return false;
+    if( p < end && (*p == 'e' || *p == 'E') )
+    {
+        bool eneg = *++p == '-';
+        if( *p == '-' || *p == '+' )
+            p++;
+        const char* e = p;
+        int eval = 0;
+        for( ; p < end && cv_isdigit(*p); p++ )
+            if( p - e < 5 )
+                eval = eval*10 + (*p - '0');
+        if( p - e > 4 )
+            return false;
+        exp10 += eneg ? -eval : eval;
+    }
+    if( p != end )
+        return false;
+
+    if( m == 0 )
+    {
+        value = neg ? -0. : 0.;
+        return true;
+    }
+    for( ; m % 10 == 0; m /= 10 )
+        exp10++;
+    for( ; exp10 > 22 && m < max_exact/10; exp10-- )
+        m *= 10;
+    if( m > max_exact || exp10 < -22 || exp10 > 22 )
+        return false;
+
+    double v = (double)(int64)m;
+    v = exp10 < 0 ? v / pow10[-exp10] : v * pow10[exp10];
+    value = neg ? -v : v;
+    return true;
+}
+
+static bool parseInteger(const char* p, const char* end, int& value)
+{
+    bool neg = *p == '-';
+    if( *p == '-' || *p == '+' )
+        p++;
+    uint64 m = 0;
+    int ndigits = 0;
+    p = readDigits(p, end, m, ndigits);
+    if( p != end || ndigits > 9 )
+        return false;
+    value = neg ? -(int)m : (int)m;
+    return true;
+}
+
+char* NumberList::add( char* ptr, const char* delims )
+{
+    char* p = ptr;
+    bool real = false;
+
+    if( *p == '-' || *p == '+' )
+        p++;
+    char* digits = p;
+    while( cv_isdigit(*p) )
+        p++;
+    size_t nint = (size_t)(p - digits);
+    // octal numbers (and also reals with redundant leading zeros) are left to the parsers
+    if( nint > 1 && *digits == '0' )
+        return 0;
+
+    if( *p == '.' )
+    {
+        char* frac = ++p;
+        real = true;
+        while( cv_isdigit(*p) )
+            p++;
+        if( nint == 0 && p == frac )
+            return 0;
+    }
+    else if( nint == 0 )
+        return 0;
+
+    if( *p == 'e' || (real && *p == 'E') )
+    {
+        real = true;
+        p++;
+        if( *p == '-' || *p == '+' )
+            p++;
+        char* e = p;
+        while( cv_isdigit(*p) )
+            p++;
+        if( p == e )
+            return 0;
+    }
+
+    if( *p != '\0' && !strchr(delims, *p) )
+        return 0;
+
+    Item item;
+    item.textOfs = text.size();
+    item.nodeOfs = nodesSize;
+    item.real = real;
+    items.push_back(item);
+    text.insert(text.end(), ptr, p);
+    text.push_back('\0');
+    nodesSize += 1 + (real ? 8 : 4);
+    return p;
+}
+
+void NumberList::clear()
+{
+    items.clear();
+    text.clear();
+    nodesSize = 0;
+}
+
+// sequences with fewer numbers are converted in the calling thread
+static const int NUMBERS_PER_STRIPE = 1 << 13;
+
+class NumberListParser : public ParallelLoopBody
+{
+public:
+    NumberListParser( FileStorage_API* _fs, NumberList& _numbers, uchar* _nodes )
+        : fs(_fs), numbers(_numbers), nodes(_nodes) {}
+
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        const NumberList::Item* items = &numbers.items[0];
+        char* text = &numbers.text[0];
+        size_t n = numbers.items.size();
+
+        for( int i = range.start; i < range.end; i++ )
+        {
+            const NumberList::Item& item = items[i];
+            char* beg = text + item.textOfs;
+            char* end = text + ((size_t)i + 1 < n ? items[i + 1].textOfs : numbers.text.size()) - 1;
+            char* endptr = 0;
+            uchar* p = nodes + item.nodeOfs;
+
+            if( item.real )
+            {
+                double fval;
+                if( !parseDecimal(beg, end, fval) )
+                    fval = fs->strtod(beg, &endptr);
+                *p = (uchar)FileNode::REAL;
+                writeReal(p + 1, fval);
+            }
+            else
+            {
+                int ival;
+                if( !parseInteger(beg, end, ival) )
+                    ival = (int)strtol(beg, &endptr, 0);
+                *p = (uchar)FileNode::INT;
+                writeInt(p + 1, ival);
+            }
+        }
+    }
+
+protected:
+    FileStorage_API* fs;
+    NumberList& numbers;
+    uchar* nodes;
+};
+
+// Internal flag of sequences read from a binary storage, whose elements are not stored as nodes,
+// but refer to a raw block of numbers (see FileStorage::Impl::setRawCollection()).
+// Iterators over such a sequence point to the sequence node itself and have blockSize == 0.
+static const int RAW_COLLECTION = 64;
+
 class FileStorage::Impl : public FileStorage_API
 {
 public:
+    struct RawBlock
+    {
+        int depth;
+        const uchar* data;
+        size_t nelems;
+        size_t nodesBlockIdx; //!< block with the elements converted to nodes, empty until the first access
+    };
+
     void init()
     {
         flags = 0;
@@ -376,6 +624,9 @@ public:
 
         filename.clear();
         lineno = 0;
+
+        rawBlocks.clear();
+        binaryBuffer.release();
     }
 
     Impl(FileStorage* _fs)
@@ -446,7 +697,18 @@ public:
         }
     }
 
-    bool open( const char* filename_or_buf, int _flags, const char* encoding )
+    static bool isBinaryFile( const std::string& fname )
+    {
+        char sig[16] = {0};
+        FILE* f = fopen(fname.c_str(), "rb");
+        if( !f )
+            return false;
+        size_t count = fread(sig, 1, sizeof(sig), f);
+        fclose(f);
+        return isBinaryStorage(sig, count);
+    }
+
+    bool open( const char* filename_or_buf, int _flags, const char* encoding, size_t bufsize = 0 )
     {
         _flags &= ~FileStorage::BASE64;
 
@@ -479,6 +741,10 @@ public:
         if( mem_mode && append )
             CV_Error( CV_StsBadFlag, "FileStorage::APPEND and FileStorage::MEMORY are not currently compatible" );
 
+        bool binary = write_mode && (_flags & FileStorage::FORMAT_MASK) == FileStorage::FORMAT_BINARY;
+        if( binary && append )
+            CV_Error( CV_StsBadFlag, "FileStorage::APPEND is not supported by binary storages" );
+
         flags = _flags;
 
         if( !mem_mode )
@@ -501,9 +767,18 @@ public:
 
             if( !isGZ )
             {
-                file = fopen(filename.c_str(), !write_mode ? "rt" : !append ? "wt" : "a+t" );
-                if( !file )
-                    return false;
+                if( !write_mode && isBinaryFile(filename) )
+                {
+                    binaryBuffer = mapBinaryStorage(filename);
+                    if( !binaryBuffer )
+                        return false;
+                }
+                else
+                {
+                    file = fopen(filename.c_str(), !write_mode ? "rt" : binary ? "wb" : !append ? "wt" : "a+t" );
+                    if( !file )
+                        return false;
+                }
             }
             else
             {
@@ -512,11 +787,30 @@ public:
                 gzfile = gzopen(filename.c_str(), mode);
                 if( !gzfile )
                     return false;
+                if( !write_mode )
+                {
+                    char sig[16] = {0};
+                    int count = gzread(gzfile, sig, (unsigned)sizeof(sig));
+                    if( isBinaryStorage(sig, count > 0 ? (size_t)count : 0) )
+                    {
+                        std::vector<char> content(sig, sig + count);
+                        char block[1 << 16];
+                        while( (count = gzread(gzfile, block, (unsigned)sizeof(block))) > 0 )
+                            content.insert(content.end(), block, block + count);
+                        binaryBuffer = createBinaryStorageBuffer(&content[0], content.size());
+                        gzclose(gzfile);
+                        gzfile = 0;
+                    }
+                    else
+                        gzrewind(gzfile);
+                }
 #else
                 CV_Error(CV_StsNotImplemented, "There is no compressed file storage support in this configuration");
 #endif
             }
         }
+        else if( !write_mode && isBinaryStorage(filename_or_buf, bufsize) )
+            binaryBuffer = createBinaryStorageBuffer(filename_or_buf, bufsize);
 
         roots.clear();
         fs_data.clear();
@@ -649,6 +943,10 @@ public:
 
                 emitter = createYAMLEmitter(this);
             }
+            else if( fmt == FileStorage::FORMAT_BINARY )
+            {
+                emitter = createBinaryEmitter(this);
+            }
             else
             {
                 CV_Assert( fmt == FileStorage::FORMAT_JSON );
@@ -693,34 +991,39 @@ public:
         {
             const size_t buf_size0 = 40;
             buffer.resize(buf_size0);
-            if( mem_mode )
+            if( binaryBuffer )
+                fmt = FileStorage::FORMAT_BINARY;
+            else
             {
-                strbuf = (char*)filename_or_buf;
-                strbufsize = strlen(strbuf);
-            }
+                if( mem_mode )
+                {
+                    strbuf = (char*)filename_or_buf;
+                    strbufsize = strlen(strbuf);
+                }
 
-            const char* yaml_signature = "%YAML";
-            const char* json_signature = "{";
-            const char* xml_signature  = "<?xml";
-            char* buf = this->gets(16);
-            CV_Assert(buf);
-            char* bufPtr = cv_skip_BOM(buf);
-            size_t bufOffset = bufPtr - buf;
-
-            if(strncmp( bufPtr, yaml_signature, strlen(yaml_signature) ) == 0)
-                fmt = FileStorage::FORMAT_YAML;
-            else if(strncmp( bufPtr, json_signature, strlen(json_signature) ) == 0)
-                fmt = FileStorage::FORMAT_JSON;
-            else if(strncmp( bufPtr, xml_signature, strlen(xml_signature) ) == 0)
-                fmt = FileStorage::FORMAT_XML;
-            else if(strbufsize  == bufOffset)
-                CV_Error(CV_BADARG_ERR, "Input file is invalid");
-            else
-                CV_Error(CV_BADARG_ERR, "Unsupported file storage format");
+                const char* yaml_signature = "%YAML";
+                const char* json_signature = "{";
+                const char* xml_signature  = "<?xml";
+                char* buf = this->gets(16);
+                CV_Assert(buf);
+                char* bufPtr = cv_skip_BOM(buf);
+                size_t bufOffset = bufPtr - buf;
+
+                if(strncmp( bufPtr, yaml_signature, strlen(yaml_signature) ) == 0)
+                    fmt = FileStorage::FORMAT_YAML;
+                else if(strncmp( bufPtr, json_signature, strlen(json_signature) ) == 0)
+                    fmt = FileStorage::FORMAT_JSON;
+                else if(strncmp( bufPtr, xml_signature, strlen(xml_signature) ) == 0)
+                    fmt = FileStorage::FORMAT_XML;
+                else if(strbufsize  == bufOffset)
+                    CV_Error(CV_BADARG_ERR, "Input file is invalid");
+                else
+                    CV_Error(CV_BADARG_ERR, "Unsupported file storage format");
 
-            rewind();
-            strbufpos = bufOffset;
-            bufofs = 0;
+                rewind();
+                strbufpos = bufOffset;
+                bufofs = 0;
+            }
 
             try
             {
@@ -740,6 +1043,7 @@ public:
                     case FileStorage::FORMAT_XML: parser = createXMLParser(this); break;
                     case FileStorage::FORMAT_YAML: parser = createYAMLParser(this); break;
                     case FileStorage::FORMAT_JSON: parser = createJSONParser(this); break;
+                    case FileStorage::FORMAT_BINARY: parser = createBinaryParser(this, binaryBuffer); break;
                     default: parser = Ptr<FileStorageParser>();
                 }
 
@@ -757,6 +1061,26 @@ public:
 
                         for( i = 0; i < nroots; i++, ++it )
                             roots.push_back(*it);
+
+                        if( !rawBlocks.empty() )
+                        {
+                            // a guard block: the blocks with the elements of raw collections,
+                            // created on demand, are never reached by sequential iteration over the tree
+                            Ptr<std::vector<uchar> > guard = makePtr<std::vector<uchar> >(1);
+                            fs_data.push_back(guard);
+                            fs_data_ptrs.push_back(&guard->at(0));
+                            fs_data_blksz.push_back(1);
+
+                            // the blocks for the elements are registered now, so the concurrent
+                            // readers, that fill them on demand, never reallocate the block tables
+                            for( i = 0; i < rawBlocks.size(); i++ )
+                            {
+                                fs_data.push_back(Ptr<std::vector<uchar> >());
+                                fs_data_ptrs.push_back(0);
+                                fs_data_blksz.push_back(0);
+                                rawBlocks[i].nodesBlockIdx = fs_data_ptrs.size() - 1;
+                            }
+                        }
                     }
                 }
             }
@@ -792,6 +1116,33 @@ public:
             CV_Error( CV_StsError, "The storage is not opened" );
     }
 
+    void putBytes( const void* data, size_t len )
+    {
+        CV_Assert( write_mode );
+        const char* ptr = (const char*)data;
+        if( mem_mode )
+            std::copy(ptr, ptr + len, std::back_inserter(outbuf));
+        else if( file )
+        {
+            if( fwrite(ptr, 1, len, file) != len )
+                CV_Error( CV_StsError, "Can not write to the storage" );
+        }
+#if USE_ZLIB
+        else if( gzfile )
+        {
+            for( size_t ofs = 0; ofs < len; )
+            {
+                unsigned count = (unsigned)std::min(len - ofs, (size_t)INT_MAX);
+                if( gzwrite(gzfile, ptr + ofs, count) != (int)count )
+                    CV_Error( CV_StsError, "Can not write to the storage" );
+                ofs += count;
+            }
+        }
+#endif
+        else
+            CV_Error( CV_StsError, "The storage is not opened" );
+    }
+
     char* getsFromFile( char* buf, int count )
     {
         if( file )
@@ -1053,6 +1404,12 @@ public:
     {
         CV_Assert(write_mode);
 
+        if( fmt == FileStorage::FORMAT_BINARY )
+        {
+            emitter->writeRawData(dt.c_str(), _data, len);
+            return;
+        }
+
         size_t elemSize = fs::calcStructSize(dt.c_str(), 0);
         CV_Assert( len % elemSize == 0 );
         len /= elemSize;
@@ -1468,6 +1825,180 @@ public:
         writeInt(ptr, (int)rawSize);
     }
 
+    // Converts the collected numbers and appends them to the sequence. The sequence must be
+    // the collection being parsed, so that its elements occupy the end of the node storage.
+    void addNumbers( FileNode& collection, NumberList& numbers )
+    {
+        size_t n = numbers.size();
+        if( n == 0 )
+            return;
+        CV_Assert( n <= (size_t)INT_MAX );
+        convertToCollection( FileNode::SEQ, collection );
+
+        FileNode node(fs_ext, fs_data_ptrs.size() - 1, freeSpaceOfs);
+        uchar* ptr = reserveNodeSpace(node, numbers.nodesSize);
+        NumberListParser body(this, numbers, ptr);
+        int nstripes = (int)(n / NUMBERS_PER_STRIPE);
+        if( nstripes > 1 )
+            parallel_for_(Range(0, (int)n), body, nstripes);
+        else
+            body(Range(0, (int)n));
+
+        uchar* cp = collection.ptr() + 1;
+        if( collection.isNamed() )
+            cp += 4;
+        writeInt(cp + 4, readInt(cp + 4) + (int)n);
+        numbers.clear();
+    }
+
+    // Turns the just created empty sequence into a raw collection: the sequence elements
+    // are the numbers of the given depth stored in the binary storage buffer.
+    void setRawCollection( FileNode& collection, int depth, const uchar* data, size_t len )
+    {
+        size_t nelems = len / CV_ELEM_SIZE1(depth);
+        CV_Assert( collection.isSeq() && nelems <= (size_t)INT_MAX );
+
+        bool named = collection.isNamed();
+        uchar* ptr = reserveNodeSpace(collection, 1 + (named ? 4 : 0) + 12);
+        *ptr++ = (uchar)(FileNode::SEQ | RAW_COLLECTION | (named ? FileNode::NAMED : 0));
+        if( named )
+            ptr += 4;
+        writeInt(ptr, 8);
+        writeInt(ptr + 4, (int)nelems);
+        writeInt(ptr + 8, (int)rawBlocks.size());
+
+        RawBlock block;
+        block.depth = depth;
+        block.data = data;
+        block.nelems = nelems;
+        block.nodesBlockIdx = 0;
+        rawBlocks.push_back(block);
+    }
+
+    const RawBlock& getRawBlock( size_t blockIdx, size_t ofs ) const
+    {
+        const uchar* p = getNodePtr(blockIdx, ofs);
+        CV_Assert( (*p & RAW_COLLECTION) != 0 );
+        p += (*p & FileNode::NAMED) ? 5 : 1;
+        size_t rawIdx = (size_t)(unsigned)readInt(p + 8);
+        CV_Assert( rawIdx < rawBlocks.size() );
+        return rawBlocks[rawIdx];
+    }
+
+    // Element-wise access to a raw collection. On the first access all the elements
+    // are converted to the regular nodes of fixed size, stored in the block reserved after parsing.
+    FileNode getRawElement( size_t blockIdx, size_t ofs, size_t idx )
+    {
+        const size_t nodeSize = 9;
+        const RawBlock& block = getRawBlock(blockIdx, ofs);
+        CV_Assert( idx < block.nelems && block.nodesBlockIdx > 0 );
+
+        AutoLock lock(rawMutex);
+        if( !fs_data_ptrs[block.nodesBlockIdx] )
+        {
+            size_t esz = CV_ELEM_SIZE1(block.depth);
+            bool isInt = block.depth <= CV_32S;
+            Ptr<std::vector<uchar> > pv = makePtr<std::vector<uchar> >(block.nelems*nodeSize);
+            uchar* dst = &pv->at(0);
+            const uchar* src = block.data;
+            for( size_t i = 0; i < block.nelems; i++, src += esz, dst += nodeSize )
+            {
+                double v = readRawValue(block.depth, src);
+                dst[0] = (uchar)(isInt ? FileNode::INT : FileNode::REAL);
+                if( isInt )
+                    writeInt(dst + 1, cvRound(v));
+                else
+                    writeReal(dst + 1, v);
+            }
+            fs_data[block.nodesBlockIdx] = pv;
+            fs_data_blksz[block.nodesBlockIdx] = pv->size();
+            fs_data_ptrs[block.nodesBlockIdx] = &pv->at(0);
+        }
+        return FileNode(fs_ext, block.nodesBlockIdx, idx*nodeSize);
+    }
+
+    static double readRawValue( int depth, const uchar* p )
+    {
+        switch( depth )
+        {
+        case CV_8U: return *p;
+        case CV_8S: return *(const schar*)p;
+        case CV_16U: return *(const ushort*)p;
+        case CV_16S: return *(const short*)p;
+        case CV_32S: return *(const int*)p;
+        case CV_32F: return *(const float*)p;
+        case CV_64F: return *(const double*)p;
+        case CV_16F: return (float)*(const float16_t*)p;
+        default:
+            CV_Error( Error::StsUnsupportedFormat, "Unsupported type" );
+        }
+    }
+
+    // Reads elements of a raw collection, starting from the idx-th one, into the array of structures
+    // with the format 'dt'. Returns the number of elements read.
+    size_t readRawElements( size_t blockIdx, size_t ofs, size_t idx,
+                            const String& dt, uchar* data0, size_t maxsz ) const
+    {
+        const RawBlock& block = getRawBlock(blockIdx, ofs);
+        int fmt_pairs[CV_FS_MAX_FMT_PAIRS*2];
+        int fmt_pair_count = fs::decodeFormat( dt.c_str(), fmt_pairs, CV_FS_MAX_FMT_PAIRS );
+        size_t esz = fs::calcStructSize( dt.c_str(), 0 );
+        CV_Assert( maxsz % esz == 0 );
+
+        size_t cn = 0;
+        for( int k = 0; k < fmt_pair_count; k++ )
+            cn += fmt_pairs[k*2];
+        size_t nstructs = std::min(maxsz / esz, (block.nelems - std::min(idx, block.nelems)) / cn);
+        size_t src_esz = CV_ELEM_SIZE1(block.depth);
+        const uchar* src = block.data + idx*src_esz;
+
+        if( fmt_pair_count == 1 )
+        {
+            // plain array: convert it at once
+            int depth = fmt_pairs[1];
+            size_t dst_esz = CV_ELEM_SIZE1(depth);
+            const size_t maxChunk = (size_t)1 << 30;
+            for( size_t i = 0, total = nstructs*cn; i < total; i += maxChunk )
+            {
+                int n = (int)std::min(total - i, maxChunk);
+                Mat(1, n, block.depth, (void*)(src + i*src_esz)).convertTo(
+                    Mat(1, n, depth, data0 + i*dst_esz), depth);
+            }
+            return nstructs*cn;
+        }
+
+        for( size_t j = 0; j < nstructs; j++, data0 += esz )
+        {
+            size_t offset = 0;
+            for( int k = 0; k < fmt_pair_count; k++ )
+            {
+                int count = fmt_pairs[k*2], depth = fmt_pairs[k*2+1];
+                int elem_size = CV_ELEM_SIZE(depth);
+                offset = alignSize( offset, elem_size );
+                uchar* data = data0 + offset;
+                for( int i = 0; i < count; i++, data += elem_size, src += src_esz )
+                {
+                    double v = readRawValue(block.depth, src);
+                    switch( depth )
+                    {
+                    case CV_8U: *data = saturate_cast<uchar>(v); break;
+                    case CV_8S: *(schar*)data = saturate_cast<schar>(v); break;
+                    case CV_16U: *(ushort*)data = saturate_cast<ushort>(v); break;
+                    case CV_16S: *(short*)data = saturate_cast<short>(v); break;
+                    case CV_32S: *(int*)data = saturate_cast<int>(v); break;
+                    case CV_32F: *(float*)data = (float)v; break;
+                    case CV_64F: *(double*)data = v; break;
+                    case CV_16F: *(float16_t*)data = float16_t((float)v); break;
+                    default:
+                        CV_Error( Error::StsUnsupportedFormat, "Unsupported type" );
+                    }
+                }
+                offset = (size_t)(data - data0);
+            }
+        }
+        return nstructs*cn;
+    }
+
     void normalizeNodeOfs(size_t& blockIdx, size_t& ofs) const
     {
         while( ofs >= fs_data_blksz[blockIdx] )
@@ -1776,6 +2307,10 @@ public:
     str_hash_t str_hash;
     std::vector<char> str_hash_data;
 
+    std::vector<RawBlock> rawBlocks;
+    Ptr<BinaryStorageBuffer> binaryBuffer;
+    Mutex rawMutex; //!< guards the creation of the raw collection elements
+
     std::vector<char> strbufv;
     char* strbuf;
     size_t strbufsize;
@@ -1793,7 +2328,7 @@ FileStorage::FileStorage(const String& filename, int flags, const String& encodi
     : state(0)
 {
     p = makePtr<FileStorage::Impl>(this);
-    bool ok = p->open(filename.c_str(), flags, encoding.c_str());
+    bool ok = p->open(filename.c_str(), flags, encoding.c_str(), filename.size());
     if(ok)
         state = FileStorage::NAME_EXPECTED + FileStorage::INSIDE_MAP;
 }
@@ -1825,7 +2360,7 @@ bool FileStorage::open(const String& filename, int flags, const String& encoding
 {
     try
     {
-        bool ok = p->open(filename.c_str(), flags, encoding.c_str());
+        bool ok = p->open(filename.c_str(), flags, encoding.c_str(), filename.size());
         if(ok)
             state = FileStorage::NAME_EXPECTED + FileStorage::INSIDE_MAP;
         return ok;
@@ -2250,6 +2785,7 @@ std::string FileNode::string() const
     return std::string((const char*)(p + 4), sz - 1);
 }
 Mat FileNode::mat() const { Mat value; read(*this, value, Mat()); return value; }
+Mat FileNode::sharedMat() const { Mat value; fs::readMat(*this, value, Mat(), true); return value; }
 
 FileNodeIterator FileNode::begin() const { return FileNodeIterator(*this, false); }
 FileNodeIterator FileNode::end() const   { return FileNodeIterator(*this, true); }
@@ -2397,6 +2933,12 @@ FileNodeIterator::FileNodeIterator( const FileNode& node, bool seekEnd )
         {
             nodeNElems = node.size();
             const uchar* p0 = node.ptr(), *p = p0 + 1;
+            if( *p0 & RAW_COLLECTION )
+            {
+                idx = seekEnd ? nodeNElems : 0;
+                blockSize = 0;
+                return;
+            }
             if(*p0 & FileNode::NAMED )
                 p += 4;
             if( !seekEnd )
@@ -2436,6 +2978,8 @@ FileNodeIterator& FileNodeIterator::operator=(const FileNodeIterator& it)
 
 FileNode FileNodeIterator::operator *() const
 {
+    if( fs && idx < nodeNElems && blockSize == 0 )
+        return fs->getRawElement(blockIdx, ofs, idx);
     return FileNode(idx < nodeNElems ? fs : NULL, blockIdx, ofs);
 }
 
@@ -2444,6 +2988,8 @@ FileNodeIterator& FileNodeIterator::operator ++ ()
     if( idx == nodeNElems || !fs )
         return *this;
     idx++;
+    if( blockSize == 0 )
+        return *this;
     FileNode n(fs, blockIdx, ofs);
     ofs += n.rawSize();
     if( ofs >= blockSize )
@@ -2471,7 +3017,11 @@ FileNodeIterator& FileNodeIterator::operator += (int _ofs)
 
 FileNodeIterator& FileNodeIterator::readRaw( const String& fmt, void* _data0, size_t maxsz)
 {
-    if( fs && idx < nodeNElems )
+    if( fs && idx < nodeNElems && blockSize == 0 )
+    {
+        idx += fs->readRawElements(blockIdx, ofs, idx, fmt, (uchar*)_data0, maxsz);
+    }
+    else if( fs && idx < nodeNElems )
     {
         uchar* data0 = (uchar*)_data0;
         int fmt_pairs[CV_FS_MAX_FMT_PAIRS*2];
@@ -2649,6 +3199,66 @@ void read(const FileNode& node, std::string& val, const std::string& default_val
 
 FileStorage_API::~FileStorage_API() {}
 
+// keeps the binary storage buffer alive while there are matrices that refer to it
+class BinaryStorageAllocator CV_FINAL : public MatAllocator
+{
+public:
+    UMatData* allocate(const Ptr<BinaryStorageBuffer>& buf, uchar* data, size_t size) const
+    {
+        UMatData* u = new UMatData(this);
+        u->data = u->origdata = data;
+        u->size = size;
+        u->userdata = new Ptr<BinaryStorageBuffer>(buf);
+        return u;
+    }
+
+    UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step,
+                       AccessFlag flags, UMatUsageFlags usageFlags) const CV_OVERRIDE
+    {
+        return Mat::getStdAllocator()->allocate(dims, sizes, type, data, step, flags, usageFlags);
+    }
+
+    bool allocate(UMatData* u, AccessFlag accessFlags, UMatUsageFlags usageFlags) const CV_OVERRIDE
+    {
+        return Mat::getStdAllocator()->allocate(u, accessFlags, usageFlags);
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if( !u )
+            return;
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        delete (Ptr<BinaryStorageBuffer>*)u->userdata;
+        delete u;
+    }
+};
+
+static BinaryStorageAllocator& getBinaryStorageAllocator()
+{
+    CV_SINGLETON_LAZY_INIT_REF(BinaryStorageAllocator, new BinaryStorageAllocator())
+}
+
+Mat fs::wrapRawData( const FileNode& node, int dims, const int* sizes, int type )
+{
+    const uchar* p = node.ptr();
+    if( !p || !(*p & RAW_COLLECTION) || !node.fs->binaryBuffer )
+        return Mat();
+
+    const FileStorage::Impl::RawBlock& block = node.fs->getRawBlock(node.blockIdx, node.ofs);
+    size_t total = CV_MAT_CN(type);
+    for( int i = 0; i < dims; i++ )
+        total *= (size_t)sizes[i];
+    if( block.depth != CV_MAT_DEPTH(type) || block.nelems != total || total == 0 )
+        return Mat();
+
+    uchar* data = (uchar*)block.data;
+    Mat m(dims, sizes, type, data);
+    m.u = getBinaryStorageAllocator().allocate(node.fs->binaryBuffer, data, total*CV_ELEM_SIZE1(type));
+    m.addref();
+    return m;
+}
+
 namespace internal
 {
 
@@ -114,6 +114,35 @@ int decodeSimpleFormat( const char* dt );
 class FileStorageParser;
 class FileStorageEmitter;
 
+/** The text of consecutive numeric elements of a sequence, collected by the text parsers.
+ The numbers are converted (in parallel when there are many of them) and appended to the
+ sequence at once by FileStorage_API::addNumbers(), instead of creating the nodes one by one. */
+class NumberList
+{
+public:
+    NumberList() : nodesSize(0) {}
+
+    // Appends the number starting at ptr if it is a plain decimal integer or real number
+    // followed by '\0' or one of the characters of 'delims'. Returns the pointer right after
+    // the number, or 0 if the number should be handled by the regular parser code.
+    char* add( char* ptr, const char* delims );
+    size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+    // the collected numbers should be added to the sequence before collecting more
+    bool full() const { return items.size() >= (size_t)(1 << 20); }
+    void clear();
+
+    struct Item
+    {
+        size_t textOfs;  // the '\0'-terminated number in 'text'
+        size_t nodeOfs;  // the offset of the node created for the number
+        bool real;
+    };
+    std::vector<Item> items;
+    std::vector<char> text;
+    size_t nodesSize;
+};
+
 struct FStructData
 {
     FStructData() { indent = flags = 0; }
@@ -137,6 +166,7 @@ public:
     virtual FileStorage* getFS() = 0;
 
     virtual void puts( const char* str ) = 0;
+    virtual void putBytes( const void* data, size_t len ) = 0;
     virtual char* gets() = 0;
     virtual bool eof() = 0;
     virtual void setEof() = 0;
@@ -157,6 +187,8 @@ public:
     virtual FileNode addNode( FileNode& collection, const std::string& key,
                                int type, const void* value=0, int len=-1 ) = 0;
     virtual void finalizeCollection( FileNode& collection ) = 0;
+    virtual void setRawCollection( FileNode& collection, int depth, const uchar* data, size_t len ) = 0;
+    virtual void addNumbers( FileNode& collection, NumberList& numbers ) = 0;
     virtual double strtod(char* ptr, char** endptr) = 0;
 
     virtual char* parseBase64(char* ptr, int indent, FileNode& collection) = 0;
@@ -179,6 +211,10 @@ public:
     virtual void writeScalar(const char* key, const char* value) = 0;
     virtual void writeComment(const char* comment, bool eol_comment) = 0;
     virtual void startNextStream() = 0;
+    virtual void writeRawData(const char* /*dt*/, const void* /*data*/, size_t /*len*/)
+    {
+        CV_Error(cv::Error::StsNotImplemented, "The emitter does not support raw data blocks");
+    }
 };
 
 class FileStorageParser
@@ -197,6 +233,31 @@ Ptr<FileStorageParser> createXMLParser(FileStorage_API* fs);
 Ptr<FileStorageParser> createYAMLParser(FileStorage_API* fs);
 Ptr<FileStorageParser> createJSONParser(FileStorage_API* fs);
 
+/** The whole content of a binary storage opened for reading: either a copy-on-write mapping
+ of the file or a memory block owned by the object. Raw arrays of the storage point into it. */
+class BinaryStorageBuffer
+{
+public:
+    virtual ~BinaryStorageBuffer() {}
+    virtual const uchar* data() const = 0;
+    virtual size_t size() const = 0;
+};
+
+bool isBinaryStorage( const char* buf, size_t len );
+Ptr<BinaryStorageBuffer> mapBinaryStorage( const std::string& filename );
+Ptr<BinaryStorageBuffer> createBinaryStorageBuffer( const void* data, size_t len );
+Ptr<FileStorageEmitter> createBinaryEmitter(FileStorage_API* fs);
+Ptr<FileStorageParser> createBinaryParser(FileStorage_API* fs, const Ptr<BinaryStorageBuffer>& buf);
+
+namespace fs
+{
+// returns a header of the matrix that shares the memory with the raw (binary) node 'data_node',
+// or an empty matrix if the node data can not be used directly
+Mat wrapRawData( const FileNode& data_node, int dims, const int* sizes, int type );
+// reads the matrix as cv::read does, shareData allows to use the data of binary storages in place
+void readMat( const FileNode& node, Mat& m, const Mat& default_mat, bool shareData );
+}
+
 }
 
 #endif // SRC_PERSISTENCE_HPP
@@ -0,0 +1,610 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html
+
+#include "precomp.hpp"
+#include "persistence.hpp"
+
+#if defined _WIN32
+#define WIN32_LEAN_AND_MEAN
+#undef NOMINMAX
+#define NOMINMAX
+#include <windows.h>
+#define CV_FS_HAVE_MMAP 1
+#elif defined __linux__ || defined __APPLE__ || defined __HAIKU__ || defined __FreeBSD__
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define CV_FS_HAVE_MMAP 1
+#else
+#define CV_FS_HAVE_MMAP 0
+#endif
+
+/*
+ Layout of a binary storage (all the numbers are little-endian):
+
+   header: 12-byte signature "%OCV-BINARY\n", endianness marker 0x01020304 (uint32 in the native
+   byte order of the writer; only storages written on little-endian machines are supported)
+   then a stream of records, each starting with a tag byte:
+     FileNode::INT    [key] int32
+     FileNode::REAL   [key] float64
+     FileNode::STRING [key] uint32 length, characters (without the terminating zero)
+     FileNode::SEQ/MAP [key]            - opens a collection
+     CV_FS_BIN_END                      - closes the current collection
+     CV_FS_BIN_RAW    depth(uint8) uint64 nbytes, zero padding, payload
+     CV_FS_BIN_NEXT_STREAM              - starts the next top-level map
+   [key] is present when the tag has FileNode::NAMED flag: uint32 length, characters.
+
+ The payload of raw records is aligned (relative to the beginning of the storage) to
+ CV_FS_BIN_RAW_ALIGN bytes if it is large enough, otherwise to 8 bytes, so that it can be
+ used in place when the file is memory-mapped.
+*/
+
+enum
+{
+    CV_FS_BIN_RAW = 6,
+    CV_FS_BIN_END = 7,
+    CV_FS_BIN_NEXT_STREAM = 16,
+
+    CV_FS_BIN_HEADER_SIZE = 16,
+    CV_FS_BIN_RAW_ALIGN = 64,
+    CV_FS_BIN_RAW_ALIGN_THRESHOLD = 1024
+};
+
+static const char binary_signature[] = "%OCV-BINARY\n";
+static const unsigned binary_endianness_marker = 0x01020304;
+
+namespace cv
+{
+
+static inline size_t binaryRawAlignment( size_t nbytes )
+{
+    return nbytes >= (size_t)CV_FS_BIN_RAW_ALIGN_THRESHOLD ? (size_t)CV_FS_BIN_RAW_ALIGN : (size_t)8;
+}
+
+bool isBinaryStorage( const char* buf, size_t len )
+{
+    size_t siglen = sizeof(binary_signature) - 1;
+    return buf && len >= siglen && memcmp(buf, binary_signature, siglen) == 0;
+}
+
+class OwnedBinaryStorageBuffer : public BinaryStorageBuffer
+{
+public:
+    OwnedBinaryStorageBuffer( const void* _data, size_t _len ) : buf(0), len(_len)
+    {
+        buf = (uchar*)fastMalloc(std::max(len, (size_t)1));
+        if( len > 0 )
+            memcpy(buf, _data, len);
+    }
+    ~OwnedBinaryStorageBuffer() { fastFree(buf); }
+    const uchar* data() const { return buf; }
+    size_t size() const { return len; }
+
+protected:
+    uchar* buf;
+    size_t len;
+};
+
+#if CV_FS_HAVE_MMAP
+class MappedBinaryStorageBuffer : public BinaryStorageBuffer
+{
+public:
+    MappedBinaryStorageBuffer() : ptr(0), len(0)
+#ifdef _WIN32
+        , hfile(INVALID_HANDLE_VALUE), hmap(NULL)
+#endif
+    {}
+
+    ~MappedBinaryStorageBuffer()
+    {
+#ifdef _WIN32
+        if( ptr )
+            UnmapViewOfFile(ptr);
+        if( hmap )
+            CloseHandle(hmap);
+        if( hfile != INVALID_HANDLE_VALUE )
+            CloseHandle(hfile);
+#else
+        if( ptr )
+            munmap(ptr, len);
+#endif
+    }
+
+    bool map( const std::string& filename )
+    {
+#ifdef _WIN32
+        hfile = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if( hfile == INVALID_HANDLE_VALUE )
+            return false;
+        LARGE_INTEGER fsize;
+        if( !GetFileSizeEx(hfile, &fsize) || fsize.QuadPart == 0 )
+            return false;
+        len = (size_t)fsize.QuadPart;
+        hmap = CreateFileMappingA(hfile, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+        if( !hmap )
+            return false;
+        ptr = (uchar*)MapViewOfFile(hmap, FILE_MAP_COPY, 0, 0, 0);
+        return ptr != 0;
+#else
+        int fd = open(filename.c_str(), O_RDONLY);
+        if( fd < 0 )
+            return false;
+        struct stat st;
+        if( fstat(fd, &st) != 0 || st.st_size <= 0 )
+        {
+            close(fd);
+            return false;
+        }
+        len = (size_t)st.st_size;
+        // private writable mapping: matrices that point into the storage may be modified by the user
+        // without affecting the file
+        void* p = mmap(0, len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if( p == MAP_FAILED )
+            return false;
+        ptr = (uchar*)p;
+        return true;
+#endif
+    }
+
+    const uchar* data() const { return ptr; }
+    size_t size() const { return len; }
+
+protected:
+    uchar* ptr;
+    size_t len;
+#ifdef _WIN32
+    HANDLE hfile;
+    HANDLE hmap;
+#endif
+};
+#endif
+
+Ptr<BinaryStorageBuffer> mapBinaryStorage( const std::string& filename )
+{
+#if CV_FS_HAVE_MMAP
+    Ptr<MappedBinaryStorageBuffer> buf = makePtr<MappedBinaryStorageBuffer>();
+    if( buf->map(filename) )
+        return buf;
+#endif
+    FILE* f = fopen(filename.c_str(), "rb");
+    if( !f )
+        return Ptr<BinaryStorageBuffer>();
+    std::vector<char> content;
+    char block[1 << 16];
+    for(;;)
+    {
+        size_t count = fread(block, 1, sizeof(block), f);
+        if( count == 0 )
+            break;
+        content.insert(content.end(), block, block + count);
+    }
+    fclose(f);
+    return createBinaryStorageBuffer(content.empty() ? 0 : &content[0], content.size());
+}
+
+Ptr<BinaryStorageBuffer> createBinaryStorageBuffer( const void* data, size_t len )
+{
+    return makePtr<OwnedBinaryStorageBuffer>(data, len);
+}
+
+class BinaryEmitter : public FileStorageEmitter
+{
+public:
+    BinaryEmitter(FileStorage_API* _fs) : fs(_fs), pos(0)
+    {
+        uchar hdr[CV_FS_BIN_HEADER_SIZE];
+        memcpy(hdr, binary_signature, sizeof(binary_signature) - 1);
+        memcpy(hdr + 12, &binary_endianness_marker, 4);
+        put(hdr, sizeof(hdr));
+    }
+    virtual ~BinaryEmitter() {}
+
+    FStructData startWriteStruct( const FStructData& parent, const char* key,
+                                  int struct_flags, const char* /*type_name*/ )
+    {
+        struct_flags = (struct_flags & (FileNode::TYPE_MASK|FileNode::FLOW)) | FileNode::EMPTY;
+        if( !FileNode::isCollection(struct_flags) )
+            CV_Error( CV_StsBadArg,
+                     "Some collection type - FileNode::SEQ or FileNode::MAP, must be specified" );
+
+        putTag(struct_flags & FileNode::TYPE_MASK, parent, key);
+        return FStructData("", struct_flags, 0);
+    }
+
+    void endWriteStruct(const FStructData&)
+    {
+        uchar tag = (uchar)CV_FS_BIN_END;
+        put(&tag, 1);
+    }
+
+    void write(const char* key, int value)
+    {
+        uchar buf[4];
+        putTag(FileNode::INT, fs->getCurrentStruct(), key);
+        writeUInt32(buf, (unsigned)value);
+        put(buf, 4);
+    }
+
+    void write(const char* key, double value)
+    {
+        Cv64suf v;
+        uchar buf[8];
+        v.f = value;
+        putTag(FileNode::REAL, fs->getCurrentStruct(), key);
+        writeUInt32(buf, (unsigned)v.u);
+        writeUInt32(buf + 4, (unsigned)(v.u >> 32));
+        put(buf, 8);
+    }
+
+    void write(const char* key, const char* str, bool /*quote*/)
+    {
+        if( !str )
+            CV_Error( CV_StsNullPtr, "Null string pointer" );
+        size_t len = strlen(str);
+        uchar buf[4];
+        putTag(FileNode::STRING, fs->getCurrentStruct(), key);
+        writeUInt32(buf, (unsigned)len);
+        put(buf, 4);
+        put(str, len);
+    }
+
+    void writeScalar(const char* key, const char* value)
+    {
+        write(key, value, false);
+    }
+
+    void writeComment(const char*, bool)
+    {
+        // comments are not stored in binary storages
+    }
+
+    void startNextStream()
+    {
+        uchar tag = (uchar)CV_FS_BIN_NEXT_STREAM;
+        put(&tag, 1);
+    }
+
+    void writeRawData(const char* dt, const void* _data, size_t len)
+    {
+        int fmt_pairs[CV_FS_MAX_FMT_PAIRS*2];
+        int fmt_pair_count = fs::decodeFormat( dt, fmt_pairs, CV_FS_MAX_FMT_PAIRS );
+        size_t elemSize = fs::calcStructSize( dt, 0 );
+        CV_Assert( fmt_pair_count > 0 && len % elemSize == 0 );
+
+        if( len == 0 )
+            return;
+        if( !_data )
+            CV_Error( CV_StsNullPtr, "Null data pointer" );
+
+        if( fmt_pair_count == 1 )
+        {
+            // homogeneous array: one aligned block, the payload is copied as-is
+            uchar hdr[10];
+            hdr[0] = (uchar)CV_FS_BIN_RAW;
+            hdr[1] = (uchar)fmt_pairs[1];
+            writeUInt32(hdr + 2, (unsigned)len);
+            writeUInt32(hdr + 6, (unsigned)((uint64)len >> 32));
+            put(hdr, sizeof(hdr));
+
+            static const uchar zeros[CV_FS_BIN_RAW_ALIGN] = {0};
+            size_t align = binaryRawAlignment(len);
+            put(zeros, alignSize(pos, (int)align) - pos);
+            put(_data, len);
+            return;
+        }
+
+        // structures of different types are written element by element
+        const uchar* data0 = (const uchar*)_data;
+        for( len /= elemSize; len--; data0 += elemSize )
+        {
+            size_t offset = 0;
+            for( int k = 0; k < fmt_pair_count; k++ )
+            {
+                int count = fmt_pairs[k*2], depth = fmt_pairs[k*2+1];
+                int esz = CV_ELEM_SIZE(depth);
+                offset = alignSize(offset, esz);
+                const uchar* data = data0 + offset;
+                for( int i = 0; i < count; i++, data += esz )
+                {
+                    switch( depth )
+                    {
+                    case CV_8U: write(0, (int)*(const uchar*)data); break;
+                    case CV_8S: write(0, (int)*(const schar*)data); break;
+                    case CV_16U: write(0, (int)*(const ushort*)data); break;
+                    case CV_16S: write(0, (int)*(const short*)data); break;
+                    case CV_32S: write(0, *(const int*)data); break;
+                    case CV_32F: write(0, (double)*(const float*)data); break;
+                    case CV_64F: write(0, *(const double*)data); break;
+                    case CV_16F: write(0, (double)(float)*(const float16_t*)data); break;
+                    default:
+                        CV_Error( CV_StsUnsupportedFormat, "Unsupported type" );
+                    }
+                }
+                offset = (size_t)(data - data0);
+            }
+        }
+    }
+
+protected:
+    static void writeUInt32( uchar* p, unsigned val )
+    {
+        p[0] = (uchar)val;
+        p[1] = (uchar)(val >> 8);
+        p[2] = (uchar)(val >> 16);
+        p[3] = (uchar)(val >> 24);
+    }
+
+    void put( const void* data, size_t len )
+    {
+        if( len > 0 )
+        {
+            fs->putBytes(data, len);
+            pos += len;
+        }
+    }
+
+    void putTag( int tag, const FStructData& parent, const char* key )
+    {
+        if( key && *key == '\0' )
+            key = 0;
+        if( FileNode::isMap(parent.flags) != (key != 0) )
+            CV_Error( CV_StsBadArg, key ? "Sequence element should not have name" :
+                      "Map element should have a name" );
+        if( key && !cv_isalpha(key[0]) && key[0] != '_' )
+            CV_Error( CV_StsBadArg, "Key must start with a letter or _" );
+
+        uchar buf[5];
+        buf[0] = (uchar)(tag | (key ? FileNode::NAMED : 0));
+        put(buf, 1);
+        if( key )
+        {
+            size_t keylen = strlen(key);
+            if( keylen > CV_FS_MAX_LEN )
+                CV_Error( CV_StsBadArg, "The key is too long" );
+            writeUInt32(buf, (unsigned)keylen);
+            put(buf, 4);
+            put(key, keylen);
+        }
+        fs->setNonEmpty();
+    }
+
+    FileStorage_API* fs;
+    size_t pos;
+};
+
+class BinaryParser : public FileStorageParser
+{
+public:
+    BinaryParser(FileStorage_API* _fs, const Ptr<BinaryStorageBuffer>& _buf) : fs(_fs), buf(_buf)
+    {
+        data = buf->data();
+        end = data + buf->size();
+    }
+
+    virtual ~BinaryParser() {}
+
+    bool getBase64Row(char*, int, char*&, char*&)
+    {
+        return false;
+    }
+
+    bool parse(char*)
+    {
+        if( !isBinaryStorage((const char*)data, (size_t)(end - data)) ||
+            (size_t)(end - data) < CV_FS_BIN_HEADER_SIZE )
+            CV_PARSE_ERROR_CPP( "Invalid binary storage header" );
+        if( memcmp(data + 12, &binary_endianness_marker, 4) != 0 )
+            CV_PARSE_ERROR_CPP( "Unsupported binary storage byte order" );
+
+        FileNode root_collection(fs->getFS(), 0, 0);
+        std::vector<Level> stack;
+        const uchar* ptr = data + CV_FS_BIN_HEADER_SIZE;
+
+        while( ptr < end )
+        {
+            int tag = *ptr++;
+            if( tag == CV_FS_BIN_NEXT_STREAM )
+            {
+                closeAll(stack);
+                continue;
+            }
+            if( stack.empty() )
+            {
+                Level root;
+                root.node = fs->addNode(root_collection, std::string(), FileNode::MAP);
+                stack.push_back(root);
+            }
+
+            if( tag == CV_FS_BIN_END )
+            {
+                closeCollection(stack.back());
+                stack.pop_back();
+                continue;
+            }
+
+            Level& top = stack.back();
+            if( tag == CV_FS_BIN_RAW )
+            {
+                need(ptr, end, 9);
+                int depth = ptr[0];
+                uint64 nbytes = (uint64)readUInt32(ptr + 1) | ((uint64)readUInt32(ptr + 5) << 32);
+                ptr += 9;
+                if( depth > CV_16F || nbytes % CV_ELEM_SIZE1(depth) != 0 )
+                    CV_PARSE_ERROR_CPP( "Invalid raw data block" );
+                size_t pos = alignSize((size_t)(ptr - data), (int)binaryRawAlignment((size_t)nbytes));
+                if( pos > (size_t)(end - data) || nbytes > (uint64)(end - data) - pos )
+                    CV_PARSE_ERROR_CPP( "Unexpected end of binary storage" );
+                const uchar* payload = data + pos;
+                ptr = payload + nbytes;
+
+                if( top.nelems == 0 && !top.rawData && top.node.isSeq() )
+                {
+                    // keep the block as is; if it turns out to be the only content
+                    // of the sequence, the sequence will refer to it directly
+                    top.rawDepth = depth;
+                    top.rawData = payload;
+                    top.rawSize = (size_t)nbytes;
+                }
+                else
+                {
+                    flushRaw(top);
+                    addRawElements(top, depth, payload, (size_t)nbytes);
+                }
+                continue;
+            }
+
+            int type = tag & FileNode::TYPE_MASK;
+            std::string key;
+            if( tag & FileNode::NAMED )
+            {
+                need(ptr, end, 4);
+                size_t keylen = readUInt32(ptr);
+                ptr += 4;
+                need(ptr, end, keylen);
+                key.assign((const char*)ptr, keylen);
+                ptr += keylen;
+            }
+            if( !key.empty() && !top.node.isMap() )
+                CV_PARSE_ERROR_CPP( "Sequence element should not have name" );
+
+            flushRaw(top);
+            top.nelems++;
+            if( type == FileNode::INT )
+            {
+                need(ptr, end, 4);
+                int ival = (int)readUInt32(ptr);
+                ptr += 4;
+                fs->addNode(top.node, key, FileNode::INT, &ival, -1);
+            }
+            else if( type == FileNode::REAL )
+            {
+                need(ptr, end, 8);
+                Cv64suf v;
+                v.u = (uint64)readUInt32(ptr) | ((uint64)readUInt32(ptr + 4) << 32);
+                ptr += 8;
+                fs->addNode(top.node, key, FileNode::REAL, &v.f, -1);
+            }
+            else if( type == FileNode::STRING )
+            {
+                need(ptr, end, 4);
+                size_t len = readUInt32(ptr);
+                ptr += 4;
+                need(ptr, end, len);
+                std::string str((const char*)ptr, len);
+                ptr += len;
+                fs->addNode(top.node, key, FileNode::STRING, str.c_str(), (int)len);
+            }
+            else if( type == FileNode::SEQ || type == FileNode::MAP )
+            {
+                Level child;
+                child.node = fs->addNode(top.node, key, type);
+                stack.push_back(child);
+            }
+            else
+                CV_PARSE_ERROR_CPP( "Invalid tag in binary storage" );
+        }
+
+        closeAll(stack);
+        return true;
+    }
+
+protected:
+    struct Level
+    {
+        Level() : nelems(0), rawDepth(0), rawData(0), rawSize(0) {}
+
+        FileNode node;
+        size_t nelems;
+        int rawDepth;
+        const uchar* rawData;
+        size_t rawSize;
+    };
+
+    static unsigned readUInt32( const uchar* p )
+    {
+        return (unsigned)p[0] | ((unsigned)p[1] << 8) | ((unsigned)p[2] << 16) | ((unsigned)p[3] << 24);
+    }
+
+    void need( const uchar* ptr, const uchar* _end, size_t len )
+    {
+        if( (size_t)(_end - ptr) < len )
+            CV_PARSE_ERROR_CPP( "Unexpected end of binary storage" );
+    }
+
+    void addRawElements( Level& level, int depth, const uchar* ptr, size_t nbytes )
+    {
+        size_t esz = CV_ELEM_SIZE1(depth), n = nbytes / esz;
+        for( size_t i = 0; i < n; i++, ptr += esz )
+        {
+            int ival = 0;
+            double fval = 0;
+            int node_type = FileNode::INT;
+            switch( depth )
+            {
+            case CV_8U: ival = *ptr; break;
+            case CV_8S: ival = (schar)*ptr; break;
+            case CV_16U: ival = *(const ushort*)ptr; break;
+            case CV_16S: ival = *(const short*)ptr; break;
+            case CV_32S: ival = *(const int*)ptr; break;
+            case CV_32F: fval = *(const float*)ptr; node_type = FileNode::REAL; break;
+            case CV_64F: fval = *(const double*)ptr; node_type = FileNode::REAL; break;
+            default: fval = (float)*(const float16_t*)ptr; node_type = FileNode::REAL; break;
+            }
+            fs->addNode(level.node, std::string(), node_type,
+                        node_type == FileNode::INT ? (const void*)&ival : (const void*)&fval, -1);
+        }
+        level.nelems += n;
+    }
+
+    void flushRaw( Level& level )
+    {
+        if( level.rawData )
+        {
+            const uchar* ptr = level.rawData;
+            level.rawData = 0;
+            addRawElements(level, level.rawDepth, ptr, level.rawSize);
+        }
+    }
+
+    void closeCollection( Level& level )
+    {
+        if( level.rawData && level.nelems == 0 )
+            fs->setRawCollection(level.node, level.rawDepth, level.rawData, level.rawSize);
+        else
+        {
+            flushRaw(level);
+            fs->finalizeCollection(level.node);
+        }
+    }
+
+    void closeAll( std::vector<Level>& stack )
+    {
+        while( !stack.empty() )
+        {
+            closeCollection(stack.back());
+            stack.pop_back();
+        }
+    }
+
+    FileStorage_API* fs;
+    Ptr<BinaryStorageBuffer> buf;
+    const uchar* data;
+    const uchar* end;
+};
+
+Ptr<FileStorageEmitter> createBinaryEmitter(FileStorage_API* fs)
+{
+    return makePtr<BinaryEmitter>(fs);
+}
+
+Ptr<FileStorageParser> createBinaryParser(FileStorage_API* fs, const Ptr<BinaryStorageBuffer>& buf)
+{
+    return makePtr<BinaryParser>(fs, buf);
+}
+
+}
@@ -635,6 +635,7 @@ public:
             ptr++;
 
         fs->convertToCollection(FileNode::SEQ, node);
+        NumberList numbers;
 
         for (;;)
         {
@@ -642,8 +643,18 @@ public:
             if( !ptr || !*ptr )
                 break;
 
-            if ( *ptr != ']' )
+            // plain numbers are collected and added to the sequence in one go
+            char* endptr = numbers.add( ptr, " ,]\t\r\n" );
+            if ( endptr )
             {
+                ptr = endptr;
+                CV_PERSISTENCE_CHECK_END_OF_BUFFER_BUG_CPP();
+                if( numbers.full() )
+                    fs->addNumbers(node, numbers);
+            }
+            else if ( *ptr != ']' )
+            {
+                fs->addNumbers(node, numbers);
                 FileNode child = fs->addNode(node, std::string(), FileNode::NONE );
 
                 if ( *ptr == '[' )
@@ -674,6 +685,7 @@ public:
         else
             ptr++;
 
+        fs->addNumbers(node, numbers);
         fs->finalizeCollection(node);
         return ptr;
     }
@@ -19,8 +19,13 @@ void write( FileStorage& fs, const String& name, const Mat& m )
         fs << "cols" << m.cols;
         fs << "dt" << fs::encodeFormat( m.type(), dt );
         fs << "data" << "[:";
-        for( int i = 0; i < m.rows; i++ )
-            fs.writeRaw(dt, m.ptr(i), m.cols*m.elemSize());
+        if( m.isContinuous() )
+            fs.writeRaw(dt, m.ptr(), m.total()*m.elemSize());
+        else
+        {
+            for( int i = 0; i < m.rows; i++ )
+                fs.writeRaw(dt, m.ptr(i), m.cols*m.elemSize());
+        }
         fs << "]";
         fs.endWriteStruct();
     }
@@ -114,6 +119,11 @@ void write( FileStorage& fs, const String& name, const SparseMat& m )
 }
 
 void read(const FileNode& node, Mat& m, const Mat& default_mat)
+{
+    fs::readMat(node, m, default_mat, false);
+}
+
+void fs::readMat(const FileNode& node, Mat& m, const Mat& default_mat, bool shareData)
 {
     if( node.empty() )
     {
@@ -123,6 +133,7 @@ void read(const FileNode& node, Mat& m, const Mat& default_mat)
 
     std::string dt;
     int rows, cols, elem_type;
+    int sizes[CV_MAX_DIM] = {0}, dims;
 
     read(node["dt"], dt, std::string());
     CV_Assert( !dt.empty() );
@@ -133,23 +144,36 @@ void read(const FileNode& node, Mat& m, const Mat& default_mat)
     if( rows >= 0 )
     {
         read(node["cols"], cols, -1);
-        m.create(rows, cols, elem_type);
+        dims = 2;
+        sizes[0] = rows;
+        sizes[1] = cols;
     }
     else
     {
-        int sizes[CV_MAX_DIM] = {0}, dims;
         FileNode sizes_node = node["sizes"];
         CV_Assert( !sizes_node.empty() );
 
         dims = (int)sizes_node.size();
+        CV_Assert( dims <= CV_MAX_DIM );
         sizes_node.readRaw("i", sizes, dims*sizeof(sizes[0]));
-
-        m.create(dims, sizes, elem_type);
     }
 
     FileNode data_node = node["data"];
     CV_Assert(!data_node.empty());
 
+    // the data of binary storages is used in place or just copied, without the parsing
+    Mat shared = fs::wrapRawData(data_node, dims, sizes, elem_type);
+    if( !shared.empty() )
+    {
+        if( shareData )
+            m = shared;
+        else
+            shared.copyTo(m);
+        return;
+    }
+
+    m.create(dims, sizes, elem_type);
+
     size_t nelems = data_node.size();
     CV_Assert(nelems == m.total()*m.channels());
 
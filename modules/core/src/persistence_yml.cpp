@@ -640,6 +640,8 @@ public:
             int struct_type = c == '{' ? FileNode::MAP : FileNode::SEQ;
             int nelems = 0;
 
+            NumberList numbers;
+
             fs->convertToCollection(struct_type, node);
             d = c == '[' ? ']' : '}';
 
@@ -676,10 +678,23 @@ public:
                 {
                     if( *ptr == ']' )
                         break;
+
+                    // plain numbers are collected and added to the sequence in one go
+                    endptr = numbers.add( ptr, " ,]\r\n" );
+                    if( endptr )
+                    {
+                        ptr = endptr;
+                        CV_PERSISTENCE_CHECK_END_OF_BUFFER_BUG_CPP();
+                        if( numbers.full() )
+                            fs->addNumbers(node, numbers);
+                        continue;
+                    }
+                    fs->addNumbers(node, numbers);
                     elem = fs->addNode(node, std::string(), FileNode::NONE);
                 }
                 ptr = parseValue( ptr, elem, new_min_indent, true );
             }
+            fs->addNumbers(node, numbers);
             fs->finalizeCollection(node);
         }
         else
@@ -0,0 +1,555 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "opencv2/core/pixel_pipeline.hpp"
+
+namespace cv
+{
+
+enum { PIX_CONVERT = 0, PIX_LUT = 1, PIX_THRESHOLD = 2, PIX_NORMALIZE = 3, PIX_INRANGE = 4 };
+
+// the basic threshold types, the same as THRESH_* from imgproc
+enum { PIX_THRESH_BINARY = 0, PIX_THRESH_BINARY_INV = 1, PIX_THRESH_TRUNC = 2,
+       PIX_THRESH_TOZERO = 3, PIX_THRESH_TOZERO_INV = 4 };
+
+PixelOpPipeline::PixelOpPipeline()
+{
+}
+
+PixelOpPipeline& PixelOpPipeline::convertTo(int depth, double alpha, double beta)
+{
+    Stage s;
+    s.op = PIX_CONVERT;
+    s.depth = depth < 0 ? -1 : CV_MAT_DEPTH(depth);
+    s.param = 0;
+    s.alpha = alpha;
+    s.beta = beta;
+    stages.push_back(s);
+    return *this;
+}
+
+PixelOpPipeline& PixelOpPipeline::LUT(InputArray _lut)
+{
+    Mat lut = _lut.getMat();
+    CV_Assert( lut.total() == 256 && lut.isContinuous() && lut.channels() <= 4 );
+    Stage s;
+    s.op = PIX_LUT;
+    s.depth = lut.depth();
+    s.param = 0;
+    s.alpha = s.beta = 0;
+    lut.copyTo(s.lut);
+    stages.push_back(s);
+    return *this;
+}
+
+PixelOpPipeline& PixelOpPipeline::threshold(double thresh, double maxval, int type)
+{
+    CV_Assert( PIX_THRESH_BINARY <= type && type <= PIX_THRESH_TOZERO_INV );
+    Stage s;
+    s.op = PIX_THRESHOLD;
+    s.depth = -1;
+    s.param = type;
+    s.alpha = thresh;
+    s.beta = maxval;
+    stages.push_back(s);
+    return *this;
+}
+
+PixelOpPipeline& PixelOpPipeline::normalize(double alpha, double beta, int normType, int depth)
+{
+    CV_Assert( normType == NORM_INF || normType == NORM_L1 || normType == NORM_L2 || normType == NORM_MINMAX );
+    Stage s;
+    s.op = PIX_NORMALIZE;
+    s.depth = depth < 0 ? -1 : CV_MAT_DEPTH(depth);
+    s.param = normType;
+    s.alpha = alpha;
+    s.beta = beta;
+    stages.push_back(s);
+    return *this;
+}
+
+PixelOpPipeline& PixelOpPipeline::inRange(const Scalar& lowerb, const Scalar& upperb)
+{
+    Stage s;
+    s.op = PIX_INRANGE;
+    s.depth = CV_8U;
+    s.param = 0;
+    s.alpha = s.beta = 0;
+    s.lowerb = lowerb;
+    s.upperb = upperb;
+    stages.push_back(s);
+    return *this;
+}
+
+void PixelOpPipeline::clear()
+{
+    stages.clear();
+}
+
+int PixelOpPipeline::outputType(int srcType) const
+{
+    int depth = CV_MAT_DEPTH(srcType), cn = CV_MAT_CN(srcType);
+    CV_Assert( cn <= 4 );
+    for( size_t i = 0; i < stages.size(); i++ )
+    {
+        const Stage& s = stages[i];
+        if( s.op == PIX_LUT )
+        {
+            CV_Assert( (depth == CV_8U || depth == CV_8S) && (s.lut.channels() == 1 || s.lut.channels() == cn) );
+        }
+        if( s.op == PIX_INRANGE )
+            cn = 1;
+        if( s.depth >= 0 )
+            depth = s.depth;
+    }
+    return CV_MAKETYPE(depth, cn);
+}
+
+namespace {
+
+// the stage prepared for the given input type; all the data are processed as float
+struct PixelStage
+{
+    int op, cn, type;
+    float alpha, beta;
+    bool saturate;
+    float minval, maxval;
+    float lowerb[4], upperb[4];
+    std::vector<float> table;
+    int lutcn;
+};
+
+static bool getDepthRange(int depth, float& minval, float& maxval)
+{
+    switch( depth )
+    {
+    case CV_8U: minval = 0.f; maxval = (float)UCHAR_MAX; break;
+    case CV_8S: minval = (float)SCHAR_MIN; maxval = (float)SCHAR_MAX; break;
+    case CV_16U: minval = 0.f; maxval = (float)USHRT_MAX; break;
+    case CV_16S: minval = (float)SHRT_MIN; maxval = (float)SHRT_MAX; break;
+    // the largest float below 2^31, so the rounded value does not overflow
+    case CV_32S: minval = (float)INT_MIN; maxval = 2147483520.f; break;
+    default: minval = -FLT_MAX; maxval = FLT_MAX; return false;
+    }
+    return true;
+}
+
+static void runStages(const PixelStage* stages, int nstages, float* buf, int npix)
+{
+    for( int k = 0; k < nstages; k++ )
+    {
+        const PixelStage& s = stages[k];
+        int i = 0, n = npix*s.cn;
+        if( s.op == PIX_CONVERT )
+        {
+#if CV_SIMD
+            v_float32 va = vx_setall_f32(s.alpha), vb = vx_setall_f32(s.beta);
+            v_float32 vmin = vx_setall_f32(s.minval), vmax = vx_setall_f32(s.maxval);
+            for( ; i <= n - v_float32::nlanes; i += v_float32::nlanes )
+            {
+                v_float32 v = v_fma(vx_load(buf + i), va, vb);
+                if( s.saturate )
+                    v = v_cvt_f32(v_round(v_min(v_max(v, vmin), vmax)));
+                v_store(buf + i, v);
+            }
+#endif
+            for( ; i < n; i++ )
+            {
+                float v = buf[i]*s.alpha + s.beta;
+                if( s.saturate )
+                    v = (float)cvRound(std::min(std::max(v, s.minval), s.maxval));
+                buf[i] = v;
+            }
+        }
+        else if( s.op == PIX_THRESHOLD )
+        {
+            // alpha is the threshold, beta is the max value
+#if CV_SIMD
+            v_float32 vt = vx_setall_f32(s.alpha), vm = vx_setall_f32(s.beta), vz = vx_setzero_f32();
+            for( ; i <= n - v_float32::nlanes; i += v_float32::nlanes )
+            {
+                v_float32 v = vx_load(buf + i), gt = v > vt;
+                switch( s.type )
+                {
+                case PIX_THRESH_BINARY: v = v_select(gt, vm, vz); break;
+                case PIX_THRESH_BINARY_INV: v = v_select(gt, vz, vm); break;
+                case PIX_THRESH_TRUNC: v = v_select(gt, vt, v); break;
+                case PIX_THRESH_TOZERO: v = v_select(gt, v, vz); break;
+                default: v = v_select(gt, vz, v); break;
+                }
+                v_store(buf + i, v);
+            }
+#endif
+            for( ; i < n; i++ )
+            {
+                float v = buf[i];
+                bool gt = v > s.alpha;
+                switch( s.type )
+                {
+                case PIX_THRESH_BINARY: v = gt ? s.beta : 0.f; break;
+                case PIX_THRESH_BINARY_INV: v = gt ? 0.f : s.beta; break;
+                case PIX_THRESH_TRUNC: v = gt ? s.alpha : v; break;
+                case PIX_THRESH_TOZERO: v = gt ? v : 0.f; break;
+                default: v = gt ? 0.f : v; break;
+                }
+                buf[i] = v;
+            }
+        }
+        else if( s.op == PIX_LUT )
+        {
+            // the input values are integers of 8 bits; the signed ones are taken modulo 256 as cv::LUT does
+            const float* table = &s.table[0];
+            if( s.lutcn == 1 )
+            {
+#if CV_SIMD
+                v_int32 vmask = vx_setall_s32(255);
+                for( ; i <= n - v_float32::nlanes; i += v_float32::nlanes )
+                    v_store(buf + i, v_lut(table, v_round(vx_load(buf + i)) & vmask));
+#endif
+                for( ; i < n; i++ )
+                    buf[i] = table[cvRound(buf[i]) & 255];
+            }
+            else
+            {
+                for( ; i < n; i += s.cn )
+                    for( int c = 0; c < s.cn; c++ )
+                        buf[i + c] = table[(cvRound(buf[i + c]) & 255)*s.cn + c];
+            }
+        }
+        else if( s.op == PIX_INRANGE )
+        {
+            // the output has a single channel, so it's written over the input
+            if( s.cn == 1 )
+            {
+#if CV_SIMD
+                v_float32 vl = vx_setall_f32(s.lowerb[0]), vu = vx_setall_f32(s.upperb[0]);
+                v_float32 v255 = vx_setall_f32(255.f), vz = vx_setzero_f32();
+                for( ; i <= n - v_float32::nlanes; i += v_float32::nlanes )
+                {
+                    v_float32 v = vx_load(buf + i);
+                    v_store(buf + i, v_select((v >= vl) & (v <= vu), v255, vz));
+                }
+#endif
+                for( ; i < n; i++ )
+                    buf[i] = s.lowerb[0] <= buf[i] && buf[i] <= s.upperb[0] ? 255.f : 0.f;
+            }
+            else
+            {
+                for( int p = 0; p < npix; p++ )
+                {
+                    const float* v = buf + p*s.cn;
+                    bool inside = true;
+                    for( int c = 0; c < s.cn; c++ )
+                        inside = inside && s.lowerb[c] <= v[c] && v[c] <= s.upperb[c];
+                    buf[p] = inside ? 255.f : 0.f;
+                }
+            }
+        }
+    }
+}
+
+// the rows are processed by the pieces that fit into L1 together with the intermediate data
+enum { PIXEL_PIPELINE_CHUNK = 1024 };
+
+struct PixelPipelinePlan
+{
+    std::vector<PixelStage> stages;
+    int srcDepth, cn;
+    Size size;  // in pixels; the continuous arrays are processed as a single row
+    int chunksPerRow;
+
+    // the stages starting from tableStart take 8-bit input and do not mix the channels, so
+    // all of them are replaced with the single lookup into the table of 256 output values
+    // per channel; the stages before it (the head) are run on the float data, unless the
+    // head is a single scaling that can be done by the regular convertScale kernels
+    int tableStart, tableDepth;
+    Mat table;
+    BinaryFunc headConvert;
+    double headScale[2];
+
+    int total() const { return size.height*chunksPerRow; }
+
+    // converts the piece of the source to float, returns the number of pixels
+    int load(const Mat& src, int idx, float* buf, const uchar*& sptr) const
+    {
+        int y = idx/chunksPerRow, x = (idx - y*chunksPerRow)*PIXEL_PIPELINE_CHUNK;
+        int npix = std::min((int)PIXEL_PIPELINE_CHUNK, size.width - x);
+        sptr = src.ptr(y) + (size_t)x*src.elemSize();
+        getConvertFunc(srcDepth, CV_32F)(sptr, 0, 0, 0, (uchar*)buf, 0, Size(npix*cn, 1), 0);
+        return npix;
+    }
+};
+
+class PixelPipelineReduceInvoker : public ParallelLoopBody
+{
+public:
+    PixelPipelineReduceInvoker(const PixelPipelinePlan& _plan, int _nstages, const Mat& _src, double* _result)
+        : plan(_plan), nstages(_nstages), src(_src), result(_result)
+    {
+        result[0] = DBL_MAX; result[1] = -DBL_MAX;
+        result[2] = result[3] = 0;
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        AutoBuffer<float> _buf(PIXEL_PIPELINE_CHUNK*4);
+        float* buf = _buf.data();
+        double minv = DBL_MAX, maxv = -DBL_MAX, sumAbs = 0, sumSq = 0;
+        int cn = nstages < (int)plan.stages.size() ? plan.stages[nstages].cn : plan.cn;
+        for( int idx = range.start; idx < range.end; idx++ )
+        {
+            const uchar* sptr = 0;
+            int npix = plan.load(src, idx, buf, sptr);
+            runStages(&plan.stages[0], nstages, buf, npix);
+
+            for( int i = 0; i < npix*cn; i++ )
+            {
+                double v = buf[i];
+                minv = std::min(minv, v);
+                maxv = std::max(maxv, v);
+                sumAbs += std::abs(v);
+                sumSq += v*v;
+            }
+        }
+
+        AutoLock lock(mutex);
+        result[0] = std::min(result[0], minv);
+        result[1] = std::max(result[1], maxv);
+        result[2] += sumAbs;
+        result[3] += sumSq;
+    }
+
+private:
+    const PixelPipelinePlan& plan;
+    int nstages;
+    const Mat& src;
+    double* result;
+    mutable Mutex mutex;
+};
+
+template<typename T> static void
+lookupTable_(const uchar* src, uchar* _dst, const uchar* _table, int npix, int cn)
+{
+    T* dst = (T*)_dst;
+    const T* table = (const T*)_table;
+    if( cn == 1 )
+    {
+        for( int i = 0; i < npix; i++ )
+            dst[i] = table[src[i]];
+    }
+    else
+    {
+        for( int i = 0; i < npix*cn; i += cn )
+            for( int c = 0; c < cn; c++ )
+                dst[i + c] = table[src[i + c]*cn + c];
+    }
+}
+
+typedef void (*LookupTableFunc)(const uchar* src, uchar* dst, const uchar* table, int npix, int cn);
+
+class PixelPipelineInvoker : public ParallelLoopBody
+{
+public:
+    PixelPipelineInvoker(const PixelPipelinePlan& _plan, const Mat& _src, Mat& _dst)
+        : plan(_plan), src(_src), dst(_dst)
+    {
+        dcn = dst.channels();
+        cvtOut = getConvertFunc(CV_32F, dst.depth());
+        cvtTable = plan.tableStart > 0 ? getConvertFunc(CV_32F, plan.tableDepth) : 0;
+        size_t esz1 = dst.elemSize1();
+        lookup = esz1 == 1 ? lookupTable_<uchar> : esz1 == 2 ? lookupTable_<ushort> :
+                 esz1 == 4 ? lookupTable_<int> : lookupTable_<int64>;
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        AutoBuffer<float> _buf(PIXEL_PIPELINE_CHUNK*4);
+        AutoBuffer<uchar> _ubuf(PIXEL_PIPELINE_CHUNK*4);
+        float* buf = _buf.data();
+        uchar* ubuf = _ubuf.data();
+        int nstages = (int)plan.stages.size();
+        for( int idx = range.start; idx < range.end; idx++ )
+        {
+            int y = idx/plan.chunksPerRow, x = (idx - y*plan.chunksPerRow)*PIXEL_PIPELINE_CHUNK;
+            int npix = std::min((int)PIXEL_PIPELINE_CHUNK, plan.size.width - x);
+            const uchar* sptr = src.ptr(y) + (size_t)x*src.elemSize();
+            uchar* dptr = dst.ptr(y) + (size_t)x*dst.elemSize();
+
+            if( plan.tableStart < 0 )
+            {
+                plan.load(src, idx, buf, sptr);
+                runStages(&plan.stages[0], nstages, buf, npix);
+                cvtOut((const uchar*)buf, 0, 0, 0, dptr, 0, Size(npix*dcn, 1), 0);
+                continue;
+            }
+
+            const uchar* tptr = sptr;
+            int tcn = plan.stages[plan.tableStart].cn;
+            if( plan.headConvert )
+            {
+                plan.headConvert(sptr, 0, 0, 0, ubuf, 0, Size(npix*plan.cn, 1), (void*)plan.headScale);
+                tptr = ubuf;
+            }
+            else if( plan.tableStart > 0 )
+            {
+                plan.load(src, idx, buf, sptr);
+                runStages(&plan.stages[0], plan.tableStart, buf, npix);
+                cvtTable((const uchar*)buf, 0, 0, 0, ubuf, 0, Size(npix*tcn, 1), 0);
+                tptr = ubuf;
+            }
+            lookup(tptr, dptr, plan.table.ptr(), npix, tcn);
+        }
+    }
+
+private:
+    const PixelPipelinePlan& plan;
+    const Mat& src;
+    Mat& dst;
+    int dcn;
+    BinaryFunc cvtOut, cvtTable;
+    LookupTableFunc lookup;
+};
+
+}
+
+void PixelOpPipeline::apply(InputArray _src, OutputArray _dst) const
+{
+    CV_INSTRUMENT_REGION();
+
+    int dtype = outputType(_src.type());
+    Mat src = _src.getMat();
+    CV_Assert( src.dims <= 2 );
+    if( stages.empty() )
+    {
+        src.copyTo(_dst);
+        return;
+    }
+    _dst.create(src.size(), dtype);
+    Mat dst = _dst.getMat();
+    if( src.empty() )
+        return;
+    CV_Assert( src.data != dst.data );
+
+    PixelPipelinePlan plan;
+    plan.srcDepth = src.depth();
+    plan.cn = src.channels();
+    plan.size = getContinuousSize2D(src, dst);
+    plan.chunksPerRow = (plan.size.width + PIXEL_PIPELINE_CHUNK - 1)/PIXEL_PIPELINE_CHUNK;
+
+    int depth = src.depth(), cn = src.channels();
+    std::vector<int> normalizeStages, inputDepths;
+    std::vector<Vec2d> scales(stages.size());
+    for( size_t k = 0; k < stages.size(); k++ )
+    {
+        const Stage& s = stages[k];
+        inputDepths.push_back(depth);
+        scales[k] = Vec2d(s.alpha, s.beta);
+        PixelStage ps;
+        ps.op = s.op == PIX_NORMALIZE ? PIX_CONVERT : s.op;
+        ps.cn = cn;
+        ps.type = s.param;
+        ps.alpha = (float)s.alpha;
+        ps.beta = (float)s.beta;
+        ps.lutcn = 1;
+        bool isInt = getDepthRange(depth, ps.minval, ps.maxval);
+
+        if( s.op == PIX_THRESHOLD && isInt )
+        {
+            // the same rounding of the parameters as in cv::threshold for the integer types
+            int ithresh = cvFloor(s.alpha);
+            int imaxval = s.param == PIX_THRESH_TRUNC ? ithresh : cvRound(s.beta);
+            ps.alpha = (float)ithresh;
+            ps.beta = std::min(std::max((float)imaxval, ps.minval), ps.maxval);
+        }
+        else if( s.op == PIX_LUT )
+        {
+            ps.lutcn = s.lut.channels();
+            Mat table;
+            s.lut.convertTo(table, CV_32F);
+            ps.table.assign(table.ptr<float>(), table.ptr<float>() + 256*ps.lutcn);
+        }
+        else if( s.op == PIX_INRANGE )
+        {
+            // the bounds are rounded to the input type, as in cv::inRange
+            for( int c = 0; c < 4; c++ )
+            {
+                ps.lowerb[c] = isInt ? (float)cvRound(s.lowerb[c]) : (float)s.lowerb[c];
+                ps.upperb[c] = isInt ? (float)cvRound(s.upperb[c]) : (float)s.upperb[c];
+            }
+            cn = 1;
+        }
+
+        if( s.op == PIX_NORMALIZE )
+            normalizeStages.push_back((int)k);
+        if( s.depth >= 0 )
+            depth = s.depth;
+        ps.saturate = (ps.op == PIX_CONVERT) && getDepthRange(depth, ps.minval, ps.maxval);
+        plan.stages.push_back(ps);
+    }
+
+    // each normalize stage needs the norm of its input, which is computed by running
+    // the preceding stages over the whole image
+    for( size_t i = 0; i < normalizeStages.size(); i++ )
+    {
+        int k = normalizeStages[i];
+        const Stage& s = stages[k];
+        double r[4];
+        PixelPipelineReduceInvoker reduce(plan, k, src, r);
+        parallel_for_(Range(0, plan.total()), reduce, plan.total()/16.);
+
+        double scale, shift = 0;
+        if( s.param == NORM_MINMAX )
+        {
+            double dmin = std::min(s.alpha, s.beta), dmax = std::max(s.alpha, s.beta);
+            double smin = r[0], smax = r[1];
+            scale = (dmax - dmin)*(smax - smin > DBL_EPSILON ? 1./(smax - smin) : 0);
+            shift = dmin - smin*scale;
+        }
+        else
+        {
+            double norm = s.param == NORM_INF ? std::max(std::abs(r[0]), std::abs(r[1])) :
+                          s.param == NORM_L1 ? r[2] : std::sqrt(r[3]);
+            scale = norm > DBL_EPSILON ? s.alpha/norm : 0.;
+        }
+        plan.stages[k].alpha = (float)scale;
+        plan.stages[k].beta = (float)shift;
+        scales[k] = Vec2d(scale, shift);
+    }
+
+    int nstages = (int)plan.stages.size();
+    plan.tableStart = -1;
+    plan.headConvert = 0;
+    for( int k = nstages - 1; k >= 0; k-- )
+    {
+        const PixelStage& ps = plan.stages[k];
+        if( ps.op == PIX_INRANGE && ps.cn > 1 )
+            break;
+        if( inputDepths[k] == CV_8U || inputDepths[k] == CV_8S )
+            plan.tableStart = k;
+    }
+    if( plan.tableStart >= 0 )
+    {
+        int k = plan.tableStart, tcn = plan.stages[k].cn;
+        plan.tableDepth = inputDepths[k];
+        std::vector<float> values(256*tcn);
+        for( int i = 0; i < 256; i++ )
+            for( int c = 0; c < tcn; c++ )
+                values[i*tcn + c] = plan.tableDepth == CV_8U ? (float)i : (float)(schar)i;
+        runStages(&plan.stages[k], nstages - k, &values[0], 256);
+        Mat(1, 256, CV_32FC(tcn), &values[0]).convertTo(plan.table, dst.depth());
+
+        if( k == 1 && plan.stages[0].op == PIX_CONVERT )
+        {
+            plan.headConvert = getConvertScaleFunc(plan.srcDepth, plan.tableDepth);
+            plan.headScale[0] = scales[0][0];
+            plan.headScale[1] = scales[0][1];
+        }
+    }
+
+    PixelPipelineInvoker invoker(plan, src, dst);
+    parallel_for_(Range(0, plan.total()), invoker, plan.total()/16.);
+}
+
+} // cv
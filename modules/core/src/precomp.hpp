@@ -304,6 +304,15 @@ inline bool checkScalar(InputArray sc, int atype, _InputArray::KindFlag sckind,
 
 void convertAndUnrollScalar( const Mat& sc, int buftype, uchar* scbuf, size_t blocksize );
 
+// Streaming (non-temporal) stores for the outputs that would only evict the useful data from the cache,
+// see setStreamingStoreThreshold. streamingCopy/streamingFill return false if the array is too small
+// for that; streamingStoreRow must be followed by streamingStoreFence before the data is passed to another thread.
+bool useStreamingStores(size_t bytes);
+void streamingStoreRow(const uchar* src, uchar* dst, size_t len, size_t period = 0);
+void streamingStoreFence();
+bool streamingCopy(const uchar* src, size_t sstep, uchar* dst, size_t dstep, Size sz);
+bool streamingFill(uchar* dst, size_t dstep, Size sz, const uchar* elem, size_t esz);
+
 #ifdef CV_COLLECT_IMPL_DATA
 struct ImplCollector
 {
@@ -375,6 +384,11 @@ cv::Mutex& getInitializationMutex();
 #define CV_SINGLETON_LAZY_INIT(TYPE, INITIALIZER) CV_SINGLETON_LAZY_INIT_(TYPE, INITIALIZER, instance)
 #define CV_SINGLETON_LAZY_INIT_REF(TYPE, INITIALIZER) CV_SINGLETON_LAZY_INIT_(TYPE, INITIALIZER, *instance)
 
+// leading rank singular triplets of src with the mean row (1 x cols) or the mean
+// column (rows x 1) subtracted, see SVD::RANDOMIZED; mean may be empty
+void randomizedSVD(const Mat& src, const Mat& mean, int rank,
+                   OutputArray w, OutputArray u, OutputArray vt);
+
 int cv_snprintf(char* buf, int len, const char* fmt, ...);
 int cv_vsnprintf(char* buf, int len, const char* fmt, va_list args);
 }
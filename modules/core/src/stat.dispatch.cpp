@@ -3,6 +3,7 @@
 // of this distribution and at http://opencv.org/license.html.
 
 #include "precomp.hpp"
+#include "stat.hpp"
 
 #include "stat.simd.hpp"
 #include "stat.simd_declarations.hpp" // defines CV_CPU_DISPATCH_MODES_ALL=AVX2,...,BASELINE based on CMakeLists.txt content
@@ -25,4 +26,23 @@ int normHamming(const uchar* a, const uchar* b, int n)
         CV_CPU_DISPATCH_MODES_ALL);
 }
 
+void batchDistHamming(const uchar* src1, const uchar* src2, size_t step2,
+                      int nvecs, int len, int* dist, const uchar* mask)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_CPU_DISPATCH(batchDistHamming, (src1, src2, step2, nvecs, len, dist, mask),
+        CV_CPU_DISPATCH_MODES_ALL);
+}
+
+void batchDotProd_32f(const float* src1, size_t step1, int n1,
+                      const float* src2, size_t step2, int n2,
+                      int len, float* dst, size_t dststep)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_CPU_DISPATCH(batchDotProd_32f, (src1, step1, n1, src2, step2, n2, len, dst, dststep),
+        CV_CPU_DISPATCH_MODES_ALL);
+}
+
 }} //cv::hal
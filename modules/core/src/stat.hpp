@@ -38,6 +38,21 @@ template <typename T> Scalar ocl_part_sum(Mat m)
 typedef int (*SumFunc)(const uchar*, const uchar* mask, uchar*, int, int);
 SumFunc getSumFunc(int depth);
 
+// per-channel sums and sums of squares of the src elements selected by mask (may be empty),
+// accumulated in double; returns the number of the selected elements
+int sumSqr(const Mat& src, const Mat& mask, double* s, double* sq);
+
+namespace hal {
+// Hamming distances from src1 to each of the nvecs rows of src2 (step2 bytes apart);
+// masked out rows get INT_MAX
+void batchDistHamming(const uchar* src1, const uchar* src2, size_t step2,
+                      int nvecs, int len, int* dist, const uchar* mask);
+// dst(i, j) = src1.row(i).dot(src2.row(j)) for n1 x n2 rows of length len
+void batchDotProd_32f(const float* src1, size_t step1, int n1,
+                      const float* src2, size_t step2, int n2,
+                      int len, float* dst, size_t dststep);
+}
+
 }
 
 #endif // SRC_STAT_HPP
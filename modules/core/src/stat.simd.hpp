@@ -13,6 +13,11 @@ CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
 // forward declarations
 int normHamming(const uchar* a, int n);
 int normHamming(const uchar* a, const uchar* b, int n);
+void batchDistHamming(const uchar* src1, const uchar* src2, size_t step2,
+                      int nvecs, int len, int* dist, const uchar* mask);
+void batchDotProd_32f(const float* src1, size_t step1, int n1,
+                      const float* src2, size_t step2, int n2,
+                      int len, float* dst, size_t dststep);
 
 #ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
 
@@ -78,10 +83,8 @@ int normHamming(const uchar* a, int n)
     return result;
 }
 
-int normHamming(const uchar* a, const uchar* b, int n)
+static inline int normHamming_(const uchar* a, const uchar* b, int n)
 {
-    CV_AVX_GUARD;
-
     int i = 0;
     int result = 0;
 
@@ -129,6 +132,155 @@ int normHamming(const uchar* a, const uchar* b, int n)
     return result;
 }
 
+int normHamming(const uchar* a, const uchar* b, int n)
+{
+    CV_AVX_GUARD;
+
+    return normHamming_(a, b, n);
+}
+
+// Distances from one query to a batch of descriptors: the query is loaded once
+// per block and compared against 4 descriptors, so short descriptors (ORB, BRISK)
+// don't pay the per-call dispatch and reduction overhead of normHamming().
+void batchDistHamming(const uchar* src1, const uchar* src2, size_t step2,
+                      int nvecs, int len, int* dist, const uchar* mask)
+{
+    CV_AVX_GUARD;
+
+    int j = 0;
+    if( mask )
+    {
+        for( ; j < nvecs; j++ )
+            dist[j] = mask[j] ? normHamming_(src1, src2 + step2*j, len) : INT_MAX;
+        return;
+    }
+
+#if CV_SIMD
+    for( ; j <= nvecs - 4; j += 4 )
+    {
+        const uchar* b0 = src2 + step2*j;
+        const uchar* b1 = b0 + step2;
+        const uchar* b2 = b1 + step2;
+        const uchar* b3 = b2 + step2;
+        int i = 0;
+        int d0 = 0, d1 = 0, d2 = 0, d3 = 0;
+#if CV_SIMD_WIDTH > 16
+        if( len >= v_uint8::nlanes )
+        {
+            v_uint64 t0 = vx_setzero_u64(), t1 = vx_setzero_u64();
+            v_uint64 t2 = vx_setzero_u64(), t3 = vx_setzero_u64();
+            for( ; i <= len - v_uint8::nlanes; i += v_uint8::nlanes )
+            {
+                v_uint8 a = vx_load(src1 + i);
+                t0 += v_popcount(v_reinterpret_as_u64(a ^ vx_load(b0 + i)));
+                t1 += v_popcount(v_reinterpret_as_u64(a ^ vx_load(b1 + i)));
+                t2 += v_popcount(v_reinterpret_as_u64(a ^ vx_load(b2 + i)));
+                t3 += v_popcount(v_reinterpret_as_u64(a ^ vx_load(b3 + i)));
+            }
+            d0 = (int)v_reduce_sum(t0); d1 = (int)v_reduce_sum(t1);
+            d2 = (int)v_reduce_sum(t2); d3 = (int)v_reduce_sum(t3);
+        }
+#endif
+        if( i <= len - v_uint8x16::nlanes )
+        {
+            v_uint64x2 t0 = v_setzero_u64(), t1 = v_setzero_u64();
+            v_uint64x2 t2 = v_setzero_u64(), t3 = v_setzero_u64();
+            for( ; i <= len - v_uint8x16::nlanes; i += v_uint8x16::nlanes )
+            {
+                v_uint8x16 a = v_load(src1 + i);
+                t0 += v_popcount(v_reinterpret_as_u64(a ^ v_load(b0 + i)));
+                t1 += v_popcount(v_reinterpret_as_u64(a ^ v_load(b1 + i)));
+                t2 += v_popcount(v_reinterpret_as_u64(a ^ v_load(b2 + i)));
+                t3 += v_popcount(v_reinterpret_as_u64(a ^ v_load(b3 + i)));
+            }
+            d0 += (int)v_reduce_sum(t0); d1 += (int)v_reduce_sum(t1);
+            d2 += (int)v_reduce_sum(t2); d3 += (int)v_reduce_sum(t3);
+        }
+        for( ; i < len; i++ )
+        {
+            uchar a = src1[i];
+            d0 += popCountTable[a ^ b0[i]];
+            d1 += popCountTable[a ^ b1[i]];
+            d2 += popCountTable[a ^ b2[i]];
+            d3 += popCountTable[a ^ b3[i]];
+        }
+        dist[j] = d0; dist[j+1] = d1; dist[j+2] = d2; dist[j+3] = d3;
+    }
+    vx_cleanup();
+#endif
+    for( ; j < nvecs; j++ )
+        dist[j] = normHamming_(src1, src2 + step2*j, len);
+}
+
+// dst(i, j) = src1.row(i).dot(src2.row(j)). The block is computed by 2x4 tiles
+// of rows: every loaded element is used twice or four times, so the kernel
+// is bound by the FMA throughput rather than by the loads.
+void batchDotProd_32f(const float* src1, size_t step1, int n1,
+                      const float* src2, size_t step2, int n2,
+                      int len, float* dst, size_t dststep)
+{
+    CV_AVX_GUARD;
+
+    step1 /= sizeof(src1[0]);
+    step2 /= sizeof(src2[0]);
+    dststep /= sizeof(dst[0]);
+
+    for( int i = 0; i < n1; i += 2 )
+    {
+        const float* a0 = src1 + step1*i;
+        const float* a1 = i + 1 < n1 ? a0 + step1 : a0;
+        float* d0 = dst + dststep*i;
+        float* d1 = i + 1 < n1 ? d0 + dststep : d0;
+        int j = 0;
+
+#if CV_SIMD
+        for( ; j <= n2 - 4; j += 4 )
+        {
+            const float* b0 = src2 + step2*j;
+            const float* b1 = b0 + step2;
+            const float* b2 = b1 + step2;
+            const float* b3 = b2 + step2;
+            v_float32 s00 = vx_setzero_f32(), s01 = vx_setzero_f32(), s02 = vx_setzero_f32(), s03 = vx_setzero_f32();
+            v_float32 s10 = vx_setzero_f32(), s11 = vx_setzero_f32(), s12 = vx_setzero_f32(), s13 = vx_setzero_f32();
+            int k = 0;
+            for( ; k <= len - v_float32::nlanes; k += v_float32::nlanes )
+            {
+                v_float32 va0 = vx_load(a0 + k), va1 = vx_load(a1 + k), vb;
+                vb = vx_load(b0 + k); s00 = v_fma(va0, vb, s00); s10 = v_fma(va1, vb, s10);
+                vb = vx_load(b1 + k); s01 = v_fma(va0, vb, s01); s11 = v_fma(va1, vb, s11);
+                vb = vx_load(b2 + k); s02 = v_fma(va0, vb, s02); s12 = v_fma(va1, vb, s12);
+                vb = vx_load(b3 + k); s03 = v_fma(va0, vb, s03); s13 = v_fma(va1, vb, s13);
+            }
+            float r00 = v_reduce_sum(s00), r01 = v_reduce_sum(s01), r02 = v_reduce_sum(s02), r03 = v_reduce_sum(s03);
+            float r10 = v_reduce_sum(s10), r11 = v_reduce_sum(s11), r12 = v_reduce_sum(s12), r13 = v_reduce_sum(s13);
+            for( ; k < len; k++ )
+            {
+                float x0 = a0[k], x1 = a1[k];
+                r00 += x0*b0[k]; r01 += x0*b1[k]; r02 += x0*b2[k]; r03 += x0*b3[k];
+                r10 += x1*b0[k]; r11 += x1*b1[k]; r12 += x1*b2[k]; r13 += x1*b3[k];
+            }
+            d0[j] = r00; d0[j+1] = r01; d0[j+2] = r02; d0[j+3] = r03;
+            d1[j] = r10; d1[j+1] = r11; d1[j+2] = r12; d1[j+3] = r13;
+        }
+#endif
+        for( ; j < n2; j++ )
+        {
+            const float* b = src2 + step2*j;
+            float r0 = 0.f, r1 = 0.f;
+            for( int k = 0; k < len; k++ )
+            {
+                r0 += a0[k]*b[k];
+                r1 += a1[k]*b[k];
+            }
+            d0[j] = r0;
+            d1[j] = r1;
+        }
+    }
+#if CV_SIMD
+    vx_cleanup();
+#endif
+}
+
 #endif // CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
 
 CV_CPU_OPTIMIZATION_NAMESPACE_END
@@ -6,6 +6,7 @@
 
 #include <opencv2/core/utils/trace.hpp>
 #include <opencv2/core/utils/trace.private.hpp>
+#include <opencv2/core/utils/trace_buffer.hpp>
 #include <opencv2/core/utils/configuration.private.hpp>
 
 #include <opencv2/core/opencl/ocl_defs.hpp>
@@ -15,6 +16,7 @@
 #include <sstream>
 #include <ostream>
 #include <fstream>
+#include <atomic>
 
 #if 0
 #define CV_LOG(...) CV_LOG_INFO(NULL, __VA_ARGS__)
@@ -438,6 +440,268 @@ void RegionStatisticsStatus::checkResetSkipMode(int leaveDepth)
     }
 }
 
+//
+// Trace buffer: the complete events of the regions in the per-thread rings
+//
+
+static const int TRACE_BUFFER_MAX_DEPTH = 64;
+
+struct TraceBufferEvent
+{
+    // seqlock: 2*n + 1 while the n-th event of the thread is written into the slot, 2*n + 2 after that
+    std::atomic<uint64> seq;
+    std::atomic<const Region::LocationStaticStorage*> location;
+    std::atomic<int64> begin;
+    std::atomic<int64> duration;
+
+    TraceBufferEvent() : seq(0), location(NULL), begin(0), duration(0) {}
+};
+
+// the events are written by the owner thread only, the readers skip the slots being overwritten
+struct TraceBufferRing
+{
+    const int threadID;
+    const uint64 capacity; // power of 2
+    std::vector<TraceBufferEvent> events;
+    std::atomic<uint64> written;
+
+    TraceBufferRing(int threadID_, size_t capacity_) :
+        threadID(threadID_), capacity(capacity_), events(capacity_), written(0)
+    {}
+
+    void put(const Region::LocationStaticStorage* location, int64 begin, int64 duration)
+    {
+        uint64 n = written.load(std::memory_order_relaxed);
+        TraceBufferEvent& e = events[(size_t)(n & (capacity - 1))];
+        e.seq.store(2*n + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        e.location.store(location, std::memory_order_relaxed);
+        e.begin.store(begin, std::memory_order_relaxed);
+        e.duration.store(duration, std::memory_order_relaxed);
+        e.seq.store(2*n + 2, std::memory_order_release);
+        written.store(n + 1, std::memory_order_release);
+    }
+
+    // returns false if the n-th event is overwritten already
+    bool get(uint64 n, const Region::LocationStaticStorage*& location, int64& begin, int64& duration) const
+    {
+        const TraceBufferEvent& e = events[(size_t)(n & (capacity - 1))];
+        uint64 seq = e.seq.load(std::memory_order_acquire);
+        if (seq != 2*n + 2)
+            return false;
+        location = e.location.load(std::memory_order_relaxed);
+        begin = e.begin.load(std::memory_order_relaxed);
+        duration = e.duration.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return e.seq.load(std::memory_order_relaxed) == seq;
+    }
+};
+
+struct TraceBufferState
+{
+    cv::Mutex mutex;
+    std::vector< Ptr<TraceBufferRing> > rings; // of the current generation
+    size_t capacity;
+    int samplingInterval;
+    int64 minDuration;
+    bool dumpAtExit;
+    std::atomic<int> generation; // incremented by each start, the threads allocate the new rings then
+
+    TraceBufferState() : capacity(0), samplingInterval(1), minDuration(0), dumpAtExit(false), generation(0) {}
+};
+
+static std::atomic<bool> g_traceBufferActive(false);
+
+static TraceBufferState& getTraceBufferState()
+{
+    CV_SINGLETON_LAZY_INIT_REF(TraceBufferState, new TraceBufferState())
+}
+
+struct TraceBufferThreadLocal
+{
+    struct StackEntry
+    {
+        Region* region;
+        const Region::LocationStaticStorage* location;
+        int64 beginTimestamp; // -1 if the region is not sampled
+    };
+
+    Ptr<TraceBufferRing> ring;
+    int generation;
+    int samplingInterval;
+    int sampleCounter;
+    int64 minDuration;
+    int depth;
+    StackEntry stack[TRACE_BUFFER_MAX_DEPTH];
+
+    TraceBufferThreadLocal() : generation(-1), samplingInterval(1), sampleCounter(0), minDuration(0), depth(0) {}
+};
+
+static TLSData<TraceBufferThreadLocal>& getTraceBufferTLS()
+{
+    CV_SINGLETON_LAZY_INIT_REF(TLSData<TraceBufferThreadLocal>, new TLSData<TraceBufferThreadLocal>())
+}
+
+static void traceBufferAttachThread(TraceBufferThreadLocal& ctx)
+{
+    TraceBufferState& state = getTraceBufferState();
+    cv::AutoLock lock(state.mutex);
+    ctx.ring = makePtr<TraceBufferRing>(cv::utils::getThreadID(), state.capacity);
+    ctx.generation = state.generation.load();
+    ctx.samplingInterval = state.samplingInterval;
+    ctx.sampleCounter = 0;
+    ctx.minDuration = state.minDuration;
+    state.rings.push_back(ctx.ring);
+}
+
+static void traceBufferLeave(TraceBufferThreadLocal& ctx, Region& region)
+{
+    region.implFlags &= ~REGION_FLAG__TRACE_BUFFER;
+    CV_DbgAssert(ctx.depth > 0 && ctx.stack[ctx.depth - 1].region == &region);
+    if (ctx.depth <= 0)
+        return;
+    const TraceBufferThreadLocal::StackEntry& e = ctx.stack[--ctx.depth];
+    if (e.beginTimestamp < 0 || !ctx.ring)
+        return;
+    int64 duration = getTimestamp() - e.beginTimestamp;
+    if (duration >= ctx.minDuration)
+        ctx.ring->put(e.location, e.beginTimestamp, duration);
+}
+
+static void traceBufferEnter(Region& region, const Region::LocationStaticStorage& location)
+{
+    TraceBufferThreadLocal& ctx = getTraceBufferTLS().getRef();
+    if (ctx.generation != getTraceBufferState().generation.load(std::memory_order_relaxed))
+        traceBufferAttachThread(ctx);
+
+    if ((location.flags & REGION_FLAG_REGION_NEXT) && ctx.depth > 0)
+    {
+        TraceBufferThreadLocal::StackEntry& top = ctx.stack[ctx.depth - 1];
+        if ((top.location->flags & REGION_FLAG_FUNCTION) == 0)
+            traceBufferLeave(ctx, *top.region);
+    }
+    if (ctx.depth >= TRACE_BUFFER_MAX_DEPTH)
+        return;
+
+    bool sampled;
+    if (ctx.depth == 0)
+    {
+        sampled = ++ctx.sampleCounter >= ctx.samplingInterval;
+        if (sampled)
+            ctx.sampleCounter = 0;
+    }
+    else
+    {
+        const TraceBufferThreadLocal::StackEntry& parent = ctx.stack[ctx.depth - 1];
+        sampled = parent.beginTimestamp >= 0 && (parent.location->flags & REGION_FLAG_SKIP_NESTED) == 0;
+    }
+    TraceBufferThreadLocal::StackEntry& e = ctx.stack[ctx.depth++];
+    e.region = &region;
+    e.location = &location;
+    e.beginTimestamp = sampled ? getTimestamp() : -1;
+    region.implFlags |= REGION_FLAG__TRACE_BUFFER;
+}
+
+static void startTraceBuffer_(size_t eventsPerThread, int samplingInterval, int64 minDuration, bool dumpAtExit)
+{
+    CV_Assert(eventsPerThread > 0 && samplingInterval > 0 && minDuration >= 0);
+    TraceBufferState& state = getTraceBufferState();
+    cv::AutoLock lock(state.mutex);
+    size_t capacity = 1;
+    while (capacity < eventsPerThread)
+        capacity *= 2;
+    state.capacity = capacity;
+    state.samplingInterval = samplingInterval;
+    state.minDuration = minDuration;
+    state.dumpAtExit = dumpAtExit;
+    state.rings.clear();
+    state.generation++;
+    g_traceBufferActive = true;
+}
+
+static void writeJSONString(std::ostream& out, const char* s)
+{
+    out << '"';
+    for (; s && *s; s++)
+    {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\')
+            out << '\\' << (char)c;
+        else if (c < 0x20)
+        {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out << buf;
+        }
+        else
+            out << (char)c;
+    }
+    out << '"';
+}
+
+// nanoseconds as microseconds with the fraction
+static void writeMicroseconds(std::ostream& out, int64 ns)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%lld.%03d", (long long)(ns / 1000), (int)(ns % 1000));
+    out << buf;
+}
+
+static void exportTraceBuffer_(std::ostream& out)
+{
+    std::vector< Ptr<TraceBufferRing> > rings;
+    {
+        TraceBufferState& state = getTraceBufferState();
+        cv::AutoLock lock(state.mutex);
+        rings = state.rings;
+    }
+
+    out << "{\"traceEvents\":[";
+    const char* separator = "\n";
+    uint64 droppedEvents = 0;
+    for (size_t i = 0; i < rings.size(); i++)
+    {
+        const TraceBufferRing& ring = *rings[i];
+        out << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring.threadID
+            << ",\"args\":{\"name\":\"OpenCV thread " << ring.threadID << "\"}}";
+        separator = ",\n";
+
+        uint64 end = ring.written.load(std::memory_order_acquire);
+        uint64 start = end > ring.capacity ? end - ring.capacity : 0;
+        droppedEvents += start;
+        for (uint64 n = start; n < end; n++)
+        {
+            const Region::LocationStaticStorage* location = NULL;
+            int64 begin = 0, duration = 0;
+            if (!ring.get(n, location, begin, duration))
+            {
+                droppedEvents++;
+                continue;
+            }
+            out << ",\n{\"name\":";
+            writeJSONString(out, location->name);
+            out << ",\"cat\":\"" << ((location->flags & REGION_FLAG_APP_CODE) ? "app" : "opencv")
+                << "\",\"ph\":\"X\",\"ts\":";
+            writeMicroseconds(out, begin);
+            out << ",\"dur\":";
+            writeMicroseconds(out, duration);
+            out << ",\"pid\":1,\"tid\":" << ring.threadID << ",\"args\":{\"file\":";
+            writeJSONString(out, location->filename);
+            out << ",\"line\":" << location->line << "}}";
+        }
+    }
+    out << "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"droppedEvents\":" << droppedEvents << "}}\n";
+}
+
+static bool writeTraceBuffer_(const std::string& filename)
+{
+    std::ofstream out(filename.c_str());
+    if (!out.is_open())
+        return false;
+    exportTraceBuffer_(out);
+    return !out.fail();
+}
+
 Region::Region(const LocationStaticStorage& location) :
     pImpl(NULL),
     implFlags(0)
@@ -448,7 +712,10 @@ Region::Region(const LocationStaticStorage& location) :
     // - children count threshold
     // - region location
     // - depth (opencv nested calls)
-    if (!TraceManager::isActivated())
+    const bool traceActivated = TraceManager::isActivated();
+    if (g_traceBufferActive.load(std::memory_order_relaxed) && !cv::__termination)
+        traceBufferEnter(*this, location);
+    if (!traceActivated)
     {
         CV_LOG("Trace is disabled. Bailout");
         return;
@@ -599,6 +866,13 @@ void Region::destroy()
 {
     CV_DbgAssert(implFlags != 0);
 
+    if (implFlags & REGION_FLAG__TRACE_BUFFER)
+    {
+        traceBufferLeave(getTraceBufferTLS().getRef(), *this);
+        if (implFlags == 0)
+            return;
+    }
+
     TraceManagerThreadLocal& ctx = getTraceManager().tls.getRef();
     CV_LOG(_spaces(ctx.getCurrentDepth()*4) << "Region::destruct(): " << (void*)this << " pImpl=" << pImpl << " implFlags=" << implFlags << ' ' << (ctx.stackTopLocation() ? ctx.stackTopLocation()->name : "<unknown>"));
 
@@ -855,6 +1129,14 @@ TraceManager::TraceManager()
     if (activated)
         trace_storage.reset(new SyncTraceStorage(std::string(getParameterTraceLocation()) + ".txt"));
 
+    if (utils::getConfigurationParameterBool("OPENCV_TRACE_BUFFER", false))
+    {
+        startTraceBuffer_(utils::getConfigurationParameterSizeT("OPENCV_TRACE_BUFFER_SIZE", 65536),
+                          (int)utils::getConfigurationParameterSizeT("OPENCV_TRACE_BUFFER_SAMPLING", 1),
+                          (int64)utils::getConfigurationParameterSizeT("OPENCV_TRACE_BUFFER_MIN_DURATION", 0),
+                          true);
+    }
+
 #ifdef OPENCV_WITH_ITT
     if (isITTEnabled())
     {
@@ -895,6 +1177,20 @@ TraceManager::~TraceManager()
         CV_LOG_WARNING(NULL, "Trace: Total skipped events: " << totalSkippedEvents);
     }
 
+    if (getTraceBufferState().dumpAtExit)
+    {
+        g_traceBufferActive = false;
+        std::string filename = std::string(getParameterTraceLocation()) + ".json";
+        if (writeTraceBuffer_(filename))
+        {
+            CV_LOG_INFO(NULL, "Trace: buffer is written to " << filename);
+        }
+        else
+        {
+            CV_LOG_WARNING(NULL, "Trace: can't write buffer to " << filename);
+        }
+    }
+
     // This is a global static object, so process starts shutdown here
     // Turn off trace
     cv::__termination = true; // also set in DllMain() notifications handler for DLL_PROCESS_DETACH
@@ -1152,4 +1448,63 @@ void traceArg(const TraceArg&, double) {};
 
 #endif
 
-}}}} // namespace
+} // namespace details
+
+#ifdef OPENCV_TRACE
+
+void startTraceBuffer(size_t eventsPerThread, int samplingInterval, int64 minDurationNs)
+{
+    details::TraceManager::isActivated(); // initializes the timestamps base
+    details::startTraceBuffer_(eventsPerThread, samplingInterval, minDurationNs, false);
+}
+
+void stopTraceBuffer()
+{
+    details::g_traceBufferActive = false;
+}
+
+bool isTraceBufferActive()
+{
+    return details::g_traceBufferActive;
+}
+
+std::string exportTraceBuffer()
+{
+    std::ostringstream out;
+    details::exportTraceBuffer_(out);
+    return out.str();
+}
+
+void writeTraceBuffer(const std::string& filename)
+{
+    if (!details::writeTraceBuffer_(filename))
+        CV_Error_(Error::StsError, ("Trace: can't write buffer to '%s'", filename.c_str()));
+}
+
+#else
+
+void startTraceBuffer(size_t, int, int64)
+{
+    CV_LOG_WARNING(NULL, "Trace: OpenCV is built without the tracing support, the trace buffer is not available");
+}
+
+void stopTraceBuffer() {}
+
+bool isTraceBufferActive() { return false; }
+
+std::string exportTraceBuffer()
+{
+    return "{\"traceEvents\":[]}\n";
+}
+
+void writeTraceBuffer(const std::string& filename)
+{
+    std::ofstream out(filename.c_str());
+    if (!out.is_open())
+        CV_Error_(Error::StsError, ("Trace: can't write buffer to '%s'", filename.c_str()));
+    out << exportTraceBuffer();
+}
+
+#endif
+
+}}} // namespace
@@ -0,0 +1,179 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#include "test_precomp.hpp"
+#include "opencv2/core/accumulators.hpp"
+
+namespace opencv_test { namespace {
+
+TEST(Core_Accumulators, meanStdDev)
+{
+    RNG& rng = theRNG();
+    const int types[] = { CV_8UC1, CV_8UC3, CV_16SC2, CV_32FC1, CV_64FC4 };
+    for (size_t t = 0; t < sizeof(types)/sizeof(types[0]); t++)
+    {
+        Mat all(120, 50, types[t]), mask(all.size(), CV_8U);
+        rng.fill(all, RNG::UNIFORM, -100, 100);
+        rng.fill(mask, RNG::UNIFORM, 0, 2);
+
+        MeanStdDevAccumulator acc, acc2, maskedAcc;
+        for (int y = 0; y < all.rows; y += 20)
+        {
+            Range r(y, y + 20);
+            (y < 60 ? acc : acc2).add(all.rowRange(r));
+            maskedAcc.add(all.rowRange(r), mask.rowRange(r));
+        }
+        acc.merge(acc2);
+
+        Scalar mean0, sdv0;
+        meanStdDev(all, mean0, sdv0);
+        EXPECT_EQ((int64)all.total(), acc.count());
+        EXPECT_LE(cvtest::norm(mean0, acc.mean(), NORM_INF), 1e-9) << "type=" << types[t];
+        EXPECT_LE(cvtest::norm(sdv0, acc.stdDev(), NORM_INF), 1e-9) << "type=" << types[t];
+
+        meanStdDev(all, mean0, sdv0, mask);
+        EXPECT_EQ((int64)countNonZero(mask), maskedAcc.count());
+        EXPECT_LE(cvtest::norm(mean0, maskedAcc.mean(), NORM_INF), 1e-9) << "type=" << types[t];
+        EXPECT_LE(cvtest::norm(sdv0, maskedAcc.stdDev(), NORM_INF), 1e-9) << "type=" << types[t];
+    }
+}
+
+TEST(Core_Accumulators, meanStdDev_long_stream)
+{
+    // a small spread around a large offset: the running sums lose all the digits of the variance
+    MeanStdDevAccumulator acc;
+    Mat frame(16, 16, CV_64F);
+    for (int i = 0; i < 1000; i++)
+    {
+        frame = 1e9;
+        frame.at<double>(i % 16, 0) += (i % 2 == 0 ? 1 : -1);
+        acc.add(frame);
+    }
+    // 1000 of 256000 elements deviate by 1
+    EXPECT_NEAR(1e9, acc.mean()[0], 1e-6);
+    EXPECT_NEAR(1000./256000, acc.variance()[0], 1e-9);
+}
+
+TEST(Core_Accumulators, covariance)
+{
+    RNG& rng = theRNG();
+    Mat samples(300, 7, CV_32F);
+    rng.fill(samples, RNG::NORMAL, 1000, 5);
+
+    Mat covar0, mean0;
+    calcCovarMatrix(samples, covar0, mean0, COVAR_NORMAL | COVAR_ROWS | COVAR_SCALE, CV_64F);
+    mean0.convertTo(mean0, CV_64F);
+
+    for (int layout = 0; layout < 2; layout++)
+    {
+        CovarianceAccumulator acc, acc2;
+        for (int y = 0; y < samples.rows; y += 50)
+        {
+            Mat chunk = samples.rowRange(y, y + 50);
+            CovarianceAccumulator& a = y < 150 ? acc : acc2;
+            if (layout == 0)
+                a.add(chunk, COVAR_ROWS);
+            else
+                a.add(chunk.t(), COVAR_COLS);
+        }
+        acc.merge(acc2);
+
+        Mat covar, mean;
+        acc.getMean(mean);
+        acc.getCovariance(covar);
+        EXPECT_EQ(samples.rows, acc.count());
+        EXPECT_LE(cvtest::norm(mean0, mean, NORM_INF), 1e-9);
+        EXPECT_LE(cvtest::norm(covar0, covar, NORM_INF | NORM_RELATIVE), 1e-9);
+
+        acc.getCovariance(covar, 0, CV_32F);
+        EXPECT_EQ(CV_32F, covar.type());
+        Mat scatter0;
+        covar0.convertTo(scatter0, CV_32F, samples.rows);
+        EXPECT_LE(cvtest::norm(scatter0, covar, NORM_INF | NORM_RELATIVE), 1e-6);
+    }
+}
+
+TEST(Core_Accumulators, minMax)
+{
+    RNG& rng = theRNG();
+    Mat all(100, 40, CV_32F), mask(all.size(), CV_8U);
+    rng.fill(all, RNG::UNIFORM, -10, 10);
+    rng.fill(mask, RNG::UNIFORM, 0, 2);
+
+    MinMaxAccumulator acc, acc2, maskedAcc;
+    EXPECT_TRUE(acc.empty());
+    for (int k = 0; k < 10; k++)
+    {
+        Range r(k*10, k*10 + 10);
+        (k < 4 ? acc : acc2).add(all.rowRange(r));
+        maskedAcc.add(all.rowRange(r), mask.rowRange(r));
+    }
+    maskedAcc.add(all.rowRange(0, 10), Mat::zeros(10, 40, CV_8U));
+    acc.merge(acc2);
+
+    double minv, maxv;
+    Point minp, maxp;
+    minMaxLoc(all, &minv, &maxv, &minp, &maxp);
+    EXPECT_EQ(10, acc.chunks());
+    EXPECT_EQ(minv, acc.minVal());
+    EXPECT_EQ(maxv, acc.maxVal());
+    EXPECT_EQ(minp.y/10, acc.minChunk());
+    EXPECT_EQ(maxp.y/10, acc.maxChunk());
+    EXPECT_EQ(Point(minp.x, minp.y % 10), acc.minLoc());
+    EXPECT_EQ(Point(maxp.x, maxp.y % 10), acc.maxLoc());
+
+    minMaxLoc(all, &minv, &maxv, &minp, &maxp, mask);
+    EXPECT_EQ(11, maskedAcc.chunks());
+    EXPECT_EQ(minv, maskedAcc.minVal());
+    EXPECT_EQ(maxv, maskedAcc.maxVal());
+    EXPECT_EQ(minp.y/10, maskedAcc.minChunk());
+    EXPECT_EQ(maxp.y/10, maskedAcc.maxChunk());
+}
+
+TEST(Core_Accumulators, histogram)
+{
+    RNG& rng = theRNG();
+    const int depths[] = { CV_8U, CV_16U, CV_32F };
+    for (size_t d = 0; d < sizeof(depths)/sizeof(depths[0]); d++)
+    {
+        Mat all(200, 333, depths[d]), mask(all.size(), CV_8U);
+        rng.fill(all, RNG::UNIFORM, 0, 256);
+        rng.fill(mask, RNG::UNIFORM, 0, 2);
+        if (depths[d] == CV_32F)
+            all.at<float>(0, 0) = std::numeric_limits<float>::quiet_NaN();
+
+        // 10 bins over [20, 220)
+        HistogramAccumulator acc(10, 20, 220), acc2(10, 20, 220), maskedAcc(10, 20, 220);
+        for (int y = 0; y < all.rows; y += 50)
+        {
+            Range r(y, y + 50);
+            (y < 100 ? acc : acc2).add(all.rowRange(r));
+            maskedAcc.add(all.rowRange(r), mask.rowRange(r));
+        }
+        acc.merge(acc2);
+
+        Mat ref = Mat::zeros(1, 10, CV_64F), maskedRef = ref.clone(), all64;
+        all.convertTo(all64, CV_64F);
+        for (int y = 0; y < all.rows; y++)
+            for (int x = 0; x < all.cols; x++)
+            {
+                double v = all64.at<double>(y, x);
+                if (v >= 20 && v < 220)
+                {
+                    int b = cvFloor((v - 20)/20);
+                    ref.at<double>(b)++;
+                    if (mask.at<uchar>(y, x))
+                        maskedRef.at<double>(b)++;
+                }
+            }
+        EXPECT_EQ(0, cvtest::norm(ref, acc.hist(), NORM_INF)) << "depth=" << depths[d];
+        EXPECT_EQ(sum(ref)[0], (double)acc.count());
+        EXPECT_EQ(0, cvtest::norm(maskedRef, maskedAcc.hist(), NORM_INF)) << "depth=" << depths[d];
+
+        acc.reset();
+        EXPECT_EQ(0, acc.count());
+        EXPECT_EQ(0, countNonZero(acc.hist()));
+    }
+}
+
+}} // namespace
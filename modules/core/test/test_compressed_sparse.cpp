@@ -0,0 +1,166 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#include "test_precomp.hpp"
+#include "opencv2/core/compressed_sparse.hpp"
+
+namespace opencv_test { namespace {
+
+static Mat randomSparse(int rows, int cols, int type, double density, RNG& rng)
+{
+    Mat m = Mat::zeros(rows, cols, type), vals(rows, cols, type), mask(rows, cols, CV_32F);
+    rng.fill(vals, RNG::UNIFORM, -10, 10);
+    rng.fill(mask, RNG::UNIFORM, 0, 1);
+    vals.copyTo(m, mask < density);
+    return m;
+}
+
+// 5-point Laplacian of the n x n grid with the Dirichlet boundary plus the given diagonal shift
+static SparseMat laplacian2D(int n, double shift)
+{
+    int sizes[] = { n*n, n*n };
+    SparseMat m(2, sizes, CV_64F);
+    for (int y = 0; y < n; y++)
+        for (int x = 0; x < n; x++)
+        {
+            int i = y*n + x;
+            m.ref<double>(i, i) = 4 + shift;
+            if (x > 0) m.ref<double>(i, i - 1) = -1;
+            if (x < n - 1) m.ref<double>(i, i + 1) = -1;
+            if (y > 0) m.ref<double>(i, i - n) = -1;
+            if (y < n - 1) m.ref<double>(i, i + n) = -1;
+        }
+    return m;
+}
+
+TEST(Core_CompressedSparseMat, conversions)
+{
+    RNG& rng = theRNG();
+    Mat dense = randomSparse(37, 53, CV_32F, 0.1, rng);
+    SparseMat sm(dense);
+
+    for (int format = 0; format <= 1; format++)
+    {
+        SCOPED_TRACE(format);
+        CompressedSparseMat a(dense, format), b(sm, format);
+        EXPECT_EQ(countNonZero(dense), a.nnz());
+        EXPECT_EQ(a.nnz(), b.nnz());
+        EXPECT_EQ(CV_32F, a.type());
+        EXPECT_EQ(dense.size(), a.size());
+        EXPECT_EQ(0, cvtest::norm(a.indices, b.indices, NORM_INF));
+        EXPECT_EQ(0, cvtest::norm(a.pointers, b.pointers, NORM_INF));
+
+        Mat d1, d2, d3;
+        a.copyTo(d1);
+        EXPECT_EQ(0, cvtest::norm(dense, d1, NORM_INF));
+        a.toFormat(1 - format).copyTo(d2);
+        EXPECT_EQ(0, cvtest::norm(dense, d2, NORM_INF));
+        a.t().copyTo(d3);
+        EXPECT_EQ(0, cvtest::norm(dense.t(), d3, NORM_INF));
+
+        SparseMat sm2;
+        a.copyTo(sm2);
+        Mat d4;
+        sm2.copyTo(d4);
+        EXPECT_EQ(0, cvtest::norm(dense, d4, NORM_INF));
+
+        Mat diag = a.diag(), diagRef = dense(Rect(0, 0, 37, 37)).diag();
+        EXPECT_EQ(0, cvtest::norm(diagRef, diag, NORM_INF));
+    }
+
+    CompressedSparseMat a64(Mat(dense.t()), CompressedSparseMat::CSC), empty;
+    EXPECT_EQ(CV_32F, a64.type());
+    EXPECT_EQ(CV_64F, a64.toDepth(CV_64F).type());
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(0, empty.nnz());
+}
+
+TEST(Core_CompressedSparseMat, gemm)
+{
+    RNG& rng = theRNG();
+    const int types[] = { CV_32F, CV_64F };
+    for (int ti = 0; ti < 2; ti++)
+    for (int format = 0; format <= 1; format++)
+    for (int flags = 0; flags <= GEMM_1_T; flags += GEMM_1_T)
+    for (int ncols = 1; ncols <= 7; ncols += 6)
+    {
+        SCOPED_TRACE(cv::format("type=%d format=%d flags=%d ncols=%d", types[ti], format, flags, ncols));
+        Mat dense = randomSparse(120, 90, types[ti], 0.05, rng);
+        int inner = flags ? dense.rows : dense.cols, outer = flags ? dense.cols : dense.rows;
+        Mat B(inner, ncols, types[ti]), C(outer, ncols, types[ti]), dst, ref;
+        rng.fill(B, RNG::UNIFORM, -1, 1);
+        rng.fill(C, RNG::UNIFORM, -1, 1);
+
+        CompressedSparseMat A(dense, format);
+        sparseGemm(A, B, 0.5, C, -2, dst, flags);
+        cv::gemm(dense, B, 0.5, C, -2, ref, flags);
+        ASSERT_EQ(ref.type(), dst.type());
+        double eps = types[ti] == CV_32F ? 1e-4 : 1e-10;
+        EXPECT_LE(cvtest::norm(ref, dst, NORM_INF), eps);
+
+        sparseGemm(A, B, 1, noArray(), 0, dst, flags);
+        cv::gemm(dense, B, 1, noArray(), 0, ref, flags);
+        EXPECT_LE(cvtest::norm(ref, dst, NORM_INF), eps);
+    }
+}
+
+TEST(Core_CompressedSparseMat, solveCG)
+{
+    const int n = 40;
+    CompressedSparseMat A(laplacian2D(n, 0.01));
+    RNG& rng = theRNG();
+    Mat xref(n*n, 1, CV_64F), b, x;
+    rng.fill(xref, RNG::UNIFORM, -1, 1);
+    sparseGemm(A, xref, 1, noArray(), 0, b);
+
+    int iters = solveCG(A, b, x, TermCriteria(TermCriteria::COUNT + TermCriteria::EPS, 1000, 1e-10));
+    EXPECT_GT(iters, 0);
+    EXPECT_LT(iters, 1000);
+    ASSERT_EQ(CV_64FC1, x.type());
+    EXPECT_LE(cvtest::norm(xref, x, NORM_INF), 1e-6);
+
+    // the solution is used as the initial approximation
+    EXPECT_LE(solveCG(A, b, x, TermCriteria(TermCriteria::COUNT + TermCriteria::EPS, 1000, 1e-10)), 1);
+
+    Mat b32, x32;
+    b.convertTo(b32, CV_32F);
+    solveCG(A.toDepth(CV_32F), b32, x32);
+    ASSERT_EQ(CV_32FC1, x32.type());
+    Mat xref32;
+    xref.convertTo(xref32, CV_32F);
+    EXPECT_LE(cvtest::norm(xref32, x32, NORM_INF), 1e-3);
+}
+
+TEST(Core_CompressedSparseMat, solveBiCGSTAB)
+{
+    // convection-diffusion operator, not symmetric
+    const int n = 30;
+    SparseMat sm = laplacian2D(n, 1);
+    for (int i = 0; i < n*n; i++)
+        if (i % n > 0)
+            sm.ref<double>(i, i - 1) -= 0.3;
+    CompressedSparseMat A(sm);
+
+    RNG& rng = theRNG();
+    Mat xref(n*n, 1, CV_64F), b, x;
+    rng.fill(xref, RNG::UNIFORM, -1, 1);
+    sparseGemm(A, xref, 1, noArray(), 0, b);
+
+    int iters = solveBiCGSTAB(A, b, x, TermCriteria(TermCriteria::COUNT + TermCriteria::EPS, 1000, 1e-10));
+    EXPECT_GT(iters, 0);
+    EXPECT_LT(iters, 1000);
+    EXPECT_LE(cvtest::norm(xref, x, NORM_INF), 1e-6);
+}
+
+TEST(Core_CompressedSparseMat, bad_arg)
+{
+    Mat dense = Mat::eye(5, 4, CV_64F), B(3, 1, CV_64F, Scalar::all(1)), dst, x;
+    CompressedSparseMat A(dense);
+    EXPECT_ANY_THROW(sparseGemm(A, B, 1, noArray(), 0, dst));
+    EXPECT_ANY_THROW(sparseGemm(A, Mat(4, 1, CV_64F), 1, noArray(), 0, dst, GEMM_2_T));
+    EXPECT_ANY_THROW(solveCG(A, Mat(5, 1, CV_64F), x));
+    EXPECT_ANY_THROW(CompressedSparseMat(dense, 2));
+    EXPECT_ANY_THROW(CompressedSparseMat(5, 4, CompressedSparseMat::CSR, Mat(1, 5, CV_32S), Mat(), Mat()));
+}
+
+}} // namespace
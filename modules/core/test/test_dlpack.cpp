@@ -0,0 +1,167 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#include "test_precomp.hpp"
+#include "opencv2/core/dlpack.hpp"
+
+namespace opencv_test { namespace {
+
+// the producer side: a tensor over the external buffer that counts the deleter calls
+struct ExternalTensor
+{
+    dlpack::ManagedTensor tensor;
+    int64_t shape[4], strides[4];
+    int* deleted;
+
+    static void deleter(dlpack::ManagedTensor* t)
+    {
+        ExternalTensor* self = (ExternalTensor*)t->manager_ctx;
+        (*self->deleted)++;
+        delete self;
+    }
+
+    static dlpack::ManagedTensor* create(void* data, int ndim, const int64_t* shape, const int64_t* strides,
+                                         uint8_t code, uint8_t bits, int* deleted,
+                                         int deviceType = dlpack::kDLCPU)
+    {
+        ExternalTensor* self = new ExternalTensor;
+        dlpack::Tensor& t = self->tensor.dl_tensor;
+        t.data = data;
+        t.device.device_type = deviceType;
+        t.device.device_id = 0;
+        t.ndim = ndim;
+        t.dtype.code = code;
+        t.dtype.bits = bits;
+        t.dtype.lanes = 1;
+        std::copy(shape, shape + ndim, self->shape);
+        t.shape = self->shape;
+        if (strides)
+            std::copy(strides, strides + ndim, self->strides);
+        t.strides = strides ? self->strides : 0;
+        t.byte_offset = 0;
+        self->tensor.manager_ctx = self;
+        self->tensor.deleter = deleter;
+        self->deleted = deleted;
+        return &self->tensor;
+    }
+};
+
+TEST(Core_DLPack, import_mat)
+{
+    std::vector<float> buf(10*16);
+    for (size_t i = 0; i < buf.size(); i++)
+        buf[i] = (float)i;
+    int deleted = 0;
+
+    {
+        // 6x8 window of the 10x16 buffer
+        const int64_t shape[] = { 6, 8 }, strides[] = { 16, 1 };
+        dlpack::ManagedTensor* t = ExternalTensor::create(&buf[0] + 16 + 2, 2, shape, strides,
+                                                          dlpack::kDLFloat, 32, &deleted);
+        Mat m = dlpack::toMat(t), m2;
+        ASSERT_EQ(CV_32FC1, m.type());
+        EXPECT_EQ(Size(8, 6), m.size());
+        EXPECT_EQ(16*sizeof(float), m.step[0]);
+        EXPECT_EQ((uchar*)&buf[16 + 2], m.data);
+        EXPECT_EQ(16 + 2 + 16*3 + 5, m.at<float>(3, 5));
+
+        m2 = m;
+        m.release();
+        EXPECT_EQ(0, deleted);
+        m2.at<float>(0, 0) = -1;
+        EXPECT_EQ(-1, buf[16 + 2]);
+    }
+    EXPECT_EQ(1, deleted);
+
+    {
+        // compact HWC tensor becomes the 3-channel matrix
+        std::vector<uchar> img(4*5*3, 7);
+        const int64_t shape[] = { 4, 5, 3 };
+        Mat m = dlpack::toMat(ExternalTensor::create(&img[0], 3, shape, 0, dlpack::kDLUInt, 8, &deleted));
+        EXPECT_EQ(CV_8UC3, m.type());
+        EXPECT_EQ(Size(5, 4), m.size());
+        EXPECT_EQ(Vec3b(7, 7, 7), m.at<Vec3b>(3, 4));
+
+        Mat m3 = dlpack::toMat(ExternalTensor::create(&img[0], 3, shape, 0, dlpack::kDLUInt, 8, &deleted), false);
+        EXPECT_EQ(3, m3.dims);
+        EXPECT_EQ(CV_8UC1, m3.type());
+
+        const int64_t shape1[] = { 60 };
+        Mat v = dlpack::toMat(ExternalTensor::create(&img[0], 1, shape1, 0, dlpack::kDLInt, 8, &deleted));
+        EXPECT_EQ(CV_8SC1, v.type());
+        EXPECT_EQ(Size(1, 60), v.size());
+    }
+    EXPECT_EQ(4, deleted);
+}
+
+TEST(Core_DLPack, export_mat)
+{
+    Mat big(20, 30, CV_16SC2), m = big(Rect(3, 4, 10, 12));
+    randu(big, -100, 100);
+    dlpack::ManagedTensor* t = dlpack::fromMat(m);
+    const dlpack::Tensor& dt = t->dl_tensor;
+    ASSERT_EQ(3, dt.ndim);
+    EXPECT_EQ(dlpack::kDLCPU, dt.device.device_type);
+    EXPECT_EQ(dlpack::kDLInt, dt.dtype.code);
+    EXPECT_EQ(16, dt.dtype.bits);
+    EXPECT_EQ(12, dt.shape[0]);
+    EXPECT_EQ(10, dt.shape[1]);
+    EXPECT_EQ(2, dt.shape[2]);
+    EXPECT_EQ(60, dt.strides[0]);
+    EXPECT_EQ(2, dt.strides[1]);
+    EXPECT_EQ(1, dt.strides[2]);
+    EXPECT_EQ(m.data, dt.data);
+
+    // the tensor keeps the data alive after the matrices are released
+    Mat ref = m.clone();
+    big.release();
+    m.release();
+    Mat back = dlpack::toMat(t);
+    EXPECT_EQ(dt.data, back.data);
+    EXPECT_EQ(0, cvtest::norm(ref, back, NORM_INF));
+}
+
+TEST(Core_DLPack, umat)
+{
+    std::vector<int> buf(7*9);
+    for (size_t i = 0; i < buf.size(); i++)
+        buf[i] = (int)i;
+    int deleted = 0;
+    const int64_t shape[] = { 7, 9 };
+    {
+        UMat u = dlpack::toUMat(ExternalTensor::create(&buf[0], 2, shape, 0, dlpack::kDLInt, 32, &deleted));
+        ASSERT_EQ(CV_32SC1, u.type());
+        EXPECT_EQ(Size(9, 7), u.size());
+        Mat m = u.getMat(ACCESS_READ);
+        EXPECT_EQ(5*9 + 4, m.at<int>(5, 4));
+        m.release();
+
+        dlpack::ManagedTensor* t = dlpack::fromUMat(u);
+        Mat back = dlpack::toMat(t), ref;
+        u.copyTo(ref);
+        u.release();
+        EXPECT_EQ(0, cvtest::norm(ref, back, NORM_INF));
+    }
+    EXPECT_EQ(1, deleted);
+}
+
+TEST(Core_DLPack, bad_arg)
+{
+    std::vector<float> buf(64);
+    int deleted = 0;
+    const int64_t shape[] = { 4, 4 }, strides[] = { 8, 2 };
+    dlpack::ManagedTensor* t = ExternalTensor::create(&buf[0], 2, shape, strides, dlpack::kDLFloat, 32, &deleted);
+    EXPECT_ANY_THROW(dlpack::toMat(t));
+    t->dl_tensor.strides = 0;
+    t->dl_tensor.dtype.code = dlpack::kDLUInt;
+    EXPECT_ANY_THROW(dlpack::toMat(t));
+    t->dl_tensor.dtype.code = dlpack::kDLFloat;
+    t->dl_tensor.device.device_type = dlpack::kDLCUDA;
+    EXPECT_ANY_THROW(dlpack::toMat(t));
+    // the failed imports do not take the ownership
+    EXPECT_EQ(0, deleted);
+    t->deleter(t);
+    EXPECT_EQ(1, deleted);
+}
+
+}} // namespace
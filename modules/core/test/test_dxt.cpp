@@ -983,4 +983,85 @@ protected:
 TEST(Core_DFT, reverse) { Core_DXTReverseTest test(Core_DXTReverseTest::ModeDFT); test.safe_run(); }
 TEST(Core_DCT, reverse) { Core_DXTReverseTest test(Core_DXTReverseTest::ModeDCT); test.safe_run(); }
 
+typedef testing::TestWithParam<int> Core_DXT_parallel;
+
+// the rows/columns of the large matrices are processed in parallel,
+// the result must not depend on the number of threads
+TEST_P(Core_DXT_parallel, same_as_sequential)
+{
+    const int type = GetParam();
+    const int flags[] = { 0, DFT_ROWS, DFT_COMPLEX_OUTPUT, DFT_INVERSE | DFT_SCALE };
+    RNG& rng = theRNG();
+    int nthreads = getNumThreads();
+
+    for (size_t i = 0; i < sizeof(flags)/sizeof(flags[0]); i++)
+    {
+        Mat src(rng.uniform(150, 300)*2, rng.uniform(150, 300)*2, type);
+        randu(src, -1., 1.);
+
+        // the same size is transformed twice to reuse the cached tables
+        for (int iter = 0; iter < 2; iter++)
+        {
+            Mat dft_par, dft_seq, dct_par, dct_seq;
+            dft(src, dft_par, flags[i]);
+            if (src.channels() == 1)
+                dct(src, dct_par, flags[i] & ~DFT_COMPLEX_OUTPUT);
+
+            setNumThreads(1);
+            dft(src, dft_seq, flags[i]);
+            if (src.channels() == 1)
+                dct(src, dct_seq, flags[i] & ~DFT_COMPLEX_OUTPUT);
+            setNumThreads(nthreads);
+
+            EXPECT_EQ(0, cvtest::norm(dft_par, dft_seq, NORM_INF)) << "flags=" << flags[i];
+            if (src.channels() == 1)
+            {
+                EXPECT_EQ(0, cvtest::norm(dct_par, dct_seq, NORM_INF)) << "flags=" << flags[i];
+            }
+        }
+
+        Mat spectrum, restored;
+        dft(src, spectrum, flags[i] & DFT_ROWS);
+        dft(spectrum, restored, (flags[i] & DFT_ROWS) | DFT_INVERSE | DFT_SCALE);
+        EXPECT_LE(cvtest::norm(src, restored, NORM_INF), 1e-4) << "flags=" << flags[i];
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Core_DXT_parallel, testing::Values(CV_32FC1, CV_64FC1, CV_32FC2));
+
+// the power-of-2 lengths go through the vectorized radix-4 stages
+TEST(Core_DFT, power_of_two_lengths)
+{
+    for (int len = 2; len <= 1024; len *= 2)
+    {
+        Mat src(1, len, CV_64FC2), ref(1, len, CV_64FC2);
+        randu(src, -1., 1.);
+        for (int k = 0; k < len; k++)
+        {
+            double re = 0, im = 0;
+            for (int j = 0; j < len; j++)
+            {
+                Vec2d v = src.at<Vec2d>(j);
+                double a = -2*CV_PI*(double)((int64)j*k % len)/len, c = std::cos(a), s = std::sin(a);
+                re += v[0]*c - v[1]*s;
+                im += v[0]*s + v[1]*c;
+            }
+            ref.at<Vec2d>(k) = Vec2d(re, im);
+        }
+
+        for (int type = CV_32FC2; type <= CV_64FC2; type += CV_64FC2 - CV_32FC2)
+        {
+            SCOPED_TRACE(cv::format("len=%d type=%d", len, type));
+            Mat src1, dst, dst64, restored;
+            src.convertTo(src1, type);
+            dft(src1, dst);
+            dst.convertTo(dst64, CV_64F);
+            double eps = (type == CV_32FC2 ? 1e-5 : 1e-12)*len;
+            EXPECT_LE(cvtest::norm(ref, dst64, NORM_INF), eps);
+            dft(dst, restored, DFT_INVERSE | DFT_SCALE);
+            EXPECT_LE(cvtest::norm(src1, restored, NORM_INF), eps/len*10);
+        }
+    }
+}
+
 }} // namespace
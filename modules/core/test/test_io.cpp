@@ -588,6 +588,10 @@ static void test_filestorage_basic(int write_flags, const char* suffix_name, boo
     std::string name = (std::string(test_info->test_case_name()) + "--" + test_info->name() + suffix_name);
     if (!testReadWrite)
         name = string(cvtest::TS::ptr()->get_data_path()) + "io/" + name;
+    // the written files go to the temporary directory, not to the current one
+    const bool useTempFile = testReadWrite && !useMemory;
+    if (useTempFile)
+        name = cv::tempfile(suffix_name);
 
     {
         const size_t rawdata_N = 40;
@@ -743,6 +747,10 @@ static void test_filestorage_basic(int write_flags, const char* suffix_name, boo
         ASSERT_EQ(_rd_in.depth(), _rd_out.depth());
         EXPECT_EQ(0, cv::norm(_rd_in, _rd_out, NORM_INF));
     }
+    if (useTempFile)
+    {
+        EXPECT_EQ(0, remove(name.c_str()));
+    }
 }
 
 TEST(Core_InputOutput, filestorage_base64_basic_read_XML)
@@ -781,6 +789,14 @@ TEST(Core_InputOutput, DISABLED_filestorage_base64_basic_memory_JSON)
 {
     test_filestorage_basic(cv::FileStorage::WRITE_BASE64, ".json", true, true);
 }
+TEST(Core_InputOutput, filestorage_binary_basic_rw)
+{
+    test_filestorage_basic(cv::FileStorage::WRITE | cv::FileStorage::FORMAT_BINARY, ".bin", true);
+}
+TEST(Core_InputOutput, filestorage_binary_basic_memory)
+{
+    test_filestorage_basic(cv::FileStorage::WRITE | cv::FileStorage::FORMAT_BINARY, ".bin", true, true);
+}
 
 
 TEST(Core_InputOutput, filestorage_base64_valid_call)
@@ -1837,4 +1853,212 @@ TEST(Core_InputOutput, FileStorage_copy_constructor_17412_heap)
     EXPECT_EQ(0, remove(fname.c_str()));
 }
 
+static void test_filestorage_binary(const std::string& fname)
+{
+    Mat big(512, 300, CV_32FC2), roi;
+    randu(big, Scalar::all(-100), Scalar::all(100));
+    roi = big(Rect(10, 20, 100, 50));
+    std::vector<Point2f> pts;
+    for (int i = 0; i < 1000; i++)
+        pts.push_back(Point2f((float)i, (float)-i));
+    std::vector<uchar> bytes(37, (uchar)5);
+    std::vector<std::string> strs;
+    strs.push_back("first");
+    strs.push_back("");
+    strs.push_back("with spaces\nand new lines");
+
+    {
+        FileStorage fs(fname, FileStorage::WRITE | FileStorage::FORMAT_BINARY);
+        ASSERT_TRUE(fs.isOpened());
+        fs << "ival" << -7 << "fval" << 3.25 << "sval" << "hello";
+        fs << "big" << big << "roi" << roi;
+        fs << "pts" << pts << "bytes" << bytes << "strs" << strs;
+        fs << "nested" << "{" << "seq" << "[" << 1 << 2.5 << "x" << "{:" << "a" << 1 << "}" << "]" << "}";
+        fs << "empty" << "[" << "]";
+    }
+
+    Mat big1, big2, roi1, shared1, shared2;
+    {
+        FileStorage fs(fname, FileStorage::READ);
+        ASSERT_TRUE(fs.isOpened());
+        EXPECT_EQ(FileStorage::FORMAT_BINARY, fs.getFormat());
+        EXPECT_EQ(-7, (int)fs["ival"]);
+        EXPECT_EQ(3.25, (double)fs["fval"]);
+        EXPECT_EQ("hello", (std::string)fs["sval"]);
+
+        fs["big"] >> big1;
+        fs["big"] >> big2;
+        fs["roi"] >> roi1;
+        // cv::read gives private copies, sharedMat() uses the memory of the storage
+        EXPECT_NE(big1.data, big2.data);
+        shared1 = fs["big"].sharedMat();
+        shared2 = fs["big"].sharedMat();
+        EXPECT_EQ(shared1.data, shared2.data);
+        EXPECT_EQ(0u, (size_t)shared1.data % 64);
+
+        std::vector<Point2f> pts1;
+        fs["pts"] >> pts1;
+        EXPECT_EQ(0, cvtest::norm(Mat(pts), Mat(pts1), NORM_INF));
+
+        // element-wise access to the raw arrays
+        FileNode ptsNode = fs["pts"];
+        ASSERT_TRUE(ptsNode.isSeq());
+        EXPECT_EQ(2000u, ptsNode.size());
+        EXPECT_EQ(-5.f, (float)ptsNode[11]);
+        int count = 0;
+        double sum = 0;
+        for (FileNodeIterator it = ptsNode.begin(); it != ptsNode.end(); ++it, count++)
+            sum += (double)*it;
+        EXPECT_EQ(2000, count);
+        EXPECT_EQ(0., sum);
+
+        std::vector<int> bytes1;
+        fs["bytes"] >> bytes1;
+        ASSERT_EQ(bytes.size(), bytes1.size());
+        EXPECT_EQ(5, bytes1[36]);
+
+        std::vector<std::string> strs1;
+        fs["strs"] >> strs1;
+        EXPECT_EQ(strs, strs1);
+
+        FileNode seq = fs["nested"]["seq"];
+        ASSERT_EQ(4u, seq.size());
+        EXPECT_EQ(1, (int)seq[0]);
+        EXPECT_EQ(2.5, (double)seq[1]);
+        EXPECT_EQ("x", (std::string)seq[2]);
+        EXPECT_EQ(1, (int)seq[3]["a"]);
+        EXPECT_TRUE(fs["empty"].isSeq());
+        EXPECT_EQ(0u, fs["empty"].size());
+    }
+    // the matrices stay valid after the storage is released
+    EXPECT_EQ(0, cvtest::norm(big, big1, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(roi, roi1, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(big, shared1, NORM_INF));
+    shared1.setTo(Scalar::all(0));
+    EXPECT_EQ(0, cvtest::norm(shared2, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(big, big2, NORM_INF));
+
+    {
+        // copy-on-write: modifications do not go to the file
+        FileStorage fs(fname, FileStorage::READ);
+        Mat big3 = fs["big"].sharedMat();
+        EXPECT_EQ(0, cvtest::norm(big, big3, NORM_INF));
+    }
+
+    {
+        // the elements of the raw arrays are created on the first access, here from several threads
+        FileStorage fs(fname, FileStorage::READ);
+        FileNode ptsNode = fs["pts"], bytesNode = fs["bytes"];
+        std::vector<double> sums(16, 0.);
+        parallel_for_(Range(0, (int)sums.size()), [&](const Range& r) {
+            for (int k = r.start; k < r.end; k++)
+            {
+                FileNode node = k % 2 ? ptsNode : bytesNode;
+                for (FileNodeIterator it = node.begin(); it != node.end(); ++it)
+                    sums[k] += std::abs((double)*it);
+            }
+        });
+        for (size_t k = 0; k < sums.size(); k++)
+            EXPECT_EQ(k % 2 ? 999000. : 185., sums[k]) << k;
+    }
+}
+
+TEST(Core_InputOutput, filestorage_binary_mmap)
+{
+    std::string fname = cv::tempfile(".bin");
+    test_filestorage_binary(fname);
+    EXPECT_EQ(0, remove(fname.c_str()));
+}
+
+TEST(Core_InputOutput, filestorage_binary_gz)
+{
+    std::string fname = cv::tempfile(".bin.gz");
+    test_filestorage_binary(fname);
+    EXPECT_EQ(0, remove(fname.c_str()));
+}
+
+TEST(Core_InputOutput, filestorage_binary_no_append)
+{
+    std::string fname = cv::tempfile(".bin");
+    EXPECT_THROW(FileStorage(fname, FileStorage::APPEND | FileStorage::FORMAT_BINARY), cv::Exception);
+}
+
+static void test_filestorage_numeric_seq(const std::string& content)
+{
+    FileStorage fs(content, FileStorage::READ + FileStorage::MEMORY);
+    FileNode seq = fs["seq"];
+    ASSERT_TRUE(seq.isSeq());
+    ASSERT_EQ((size_t)15, seq.size());
+
+    EXPECT_TRUE(seq[0].isInt()); EXPECT_EQ(1, (int)seq[0]);
+    EXPECT_TRUE(seq[1].isInt()); EXPECT_EQ(-2, (int)seq[1]);
+    EXPECT_TRUE(seq[2].isInt()); EXPECT_EQ(123456789, (int)seq[2]);
+    EXPECT_TRUE(seq[3].isReal()); EXPECT_EQ(0.5, (double)seq[3]);
+    EXPECT_TRUE(seq[4].isReal()); EXPECT_EQ(-0.25, (double)seq[4]);
+    EXPECT_TRUE(seq[5].isReal()); EXPECT_EQ(1000., (double)seq[5]);
+    EXPECT_TRUE(seq[6].isReal()); EXPECT_EQ(2.5e-3, (double)seq[6]);
+    EXPECT_TRUE(seq[7].isReal()); EXPECT_EQ(0.1, (double)seq[7]);
+    EXPECT_TRUE(seq[8].isReal()); EXPECT_EQ(3.14159265358979323846, (double)seq[8]);
+    EXPECT_TRUE(seq[9].isReal()); EXPECT_EQ(1.7976931348623157e308, (double)seq[9]);
+    EXPECT_TRUE(seq[10].isReal()); EXPECT_EQ(4.9406564584124654e-324, (double)seq[10]);
+    EXPECT_TRUE(seq[11].isString()); EXPECT_EQ("str", (std::string)seq[11]);
+    EXPECT_TRUE(seq[12].isSeq()); EXPECT_EQ((size_t)2, seq[12].size()); EXPECT_EQ(5, (int)seq[12][1]);
+    EXPECT_TRUE(seq[13].isInt()); EXPECT_EQ(6, (int)seq[13]);
+    EXPECT_TRUE(seq[14].isReal()); EXPECT_EQ(-0.75, (double)seq[14]);
+}
+
+TEST(Core_InputOutput, FileStorage_YAML_numeric_seq)
+{
+    test_filestorage_numeric_seq(
+        "%YAML:1.0\n---\n"
+        "seq: [ 1, -2, +123456789, 0.5, -.25, 1e3, 2.5E-3, 1.0000000000000001e-01,\n"
+        "    3.14159265358979323846, 1.7976931348623157e+308, 4.9406564584124654e-324,\n"
+        "    str, [ 4, 5 ], 6, -7.5e-1 ]\n");
+
+    FileStorage fs("%YAML:1.0\n---\nseq: [ 012, 0x1F, .Inf, -.5e1 ]\n", FileStorage::READ + FileStorage::MEMORY);
+    FileNode seq = fs["seq"];
+    ASSERT_EQ((size_t)4, seq.size());
+    EXPECT_EQ(10, (int)seq[0]);
+    EXPECT_EQ(31, (int)seq[1]);
+    EXPECT_TRUE(cvIsInf((double)seq[2]));
+    EXPECT_EQ(-5., (double)seq[3]);
+}
+
+TEST(Core_InputOutput, FileStorage_JSON_numeric_seq)
+{
+    test_filestorage_numeric_seq(
+        "{\n    \"seq\": [ 1, -2, 123456789, 0.5, -0.25, 1e3, 2.5E-3, 1.0000000000000001e-01,\n"
+        "        3.14159265358979323846, 1.7976931348623157e+308, 4.9406564584124654e-324,\n"
+        "        \"str\", [ 4, 5 ], 6, -7.5e-1 ]\n}\n");
+}
+
+TEST(Core_InputOutput, FileStorage_large_numeric_seq)
+{
+    // large sequences are converted in parallel, the values must be read back exactly
+    cv::RNG& rng = cv::theRNG();
+    Mat m64f(300, 200, CV_64F), m32f(300, 200, CV_32F), m32s(300, 200, CV_32S);
+    rng.fill(m64f, RNG::UNIFORM, -1e6, 1e6);
+    rng.fill(m32f, RNG::NORMAL, 0, 1);
+    rng.fill(m32s, RNG::UNIFORM, INT_MIN, INT_MAX);
+    m64f.at<double>(1, 1) = 1e-300;
+
+    const char* suffixes[] = { ".yml", ".json" };
+    for( int i = 0; i < 2; i++ )
+    {
+        FileStorage fs(suffixes[i], FileStorage::WRITE + FileStorage::MEMORY);
+        fs << "m64f" << m64f << "m32f" << m32f << "m32s" << m32s;
+        std::string content = fs.releaseAndGetString();
+
+        fs.open(content, FileStorage::READ + FileStorage::MEMORY);
+        Mat r64f, r32f, r32s;
+        fs["m64f"] >> r64f;
+        fs["m32f"] >> r32f;
+        fs["m32s"] >> r32s;
+        EXPECT_EQ(0, cvtest::norm(m64f, r64f, NORM_INF)) << suffixes[i];
+        EXPECT_EQ(0, cvtest::norm(m32f, r32f, NORM_INF)) << suffixes[i];
+        EXPECT_EQ(0, cvtest::norm(m32s, r32s, NORM_INF)) << suffixes[i];
+        EXPECT_EQ(0, memcmp(m64f.data, r64f.data, m64f.total()*m64f.elemSize())) << suffixes[i];
+    }
+}
+
 }} // namespace
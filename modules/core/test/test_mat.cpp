@@ -1345,6 +1345,79 @@ TEST(Core_Mat, copyNx1ToVector)
     ASSERT_PRED_FORMAT2(cvtest::MatComparator(0, 0), ref_dst16, cv::Mat_<ushort>(dst16));
 }
 
+static void streamingStoreOps(const Mat& src, const Rect& roi, std::vector<Mat>& results)
+{
+    // writing into the ROIs of the bigger arrays keeps the destinations unaligned and not continuous
+    Mat big(src.rows + 7, src.cols + 13, src.type(), Scalar::all(255));
+    Mat dst = big(roi);
+    results.clear();
+
+    src.copyTo(dst);
+    results.push_back(big.clone());
+
+    dst.setTo(Scalar(1, 2, 3, 4));
+    results.push_back(big.clone());
+
+    dst = Scalar(5, 6, 7, 8);
+    results.push_back(big.clone());
+
+    dst = Scalar::all(0);
+    results.push_back(big.clone());
+
+    Mat big32f(big.size(), CV_MAKETYPE(CV_32F, src.channels()), Scalar::all(-1)), dst32f = big32f(roi);
+    src.convertTo(dst32f, CV_32F, 0.5, 1);
+    results.push_back(big32f.clone());
+
+    Mat bordered;
+    cv::copyMakeBorder(src, bordered, 3, 5, 7, 2, BORDER_REFLECT_101);
+    results.push_back(bordered);
+    cv::copyMakeBorder(src, bordered, 2, 1, 5, 9, BORDER_CONSTANT, Scalar(9, 8, 7, 6));
+    results.push_back(bordered);
+
+    Mat cont;
+    src.copyTo(cont);
+    results.push_back(cont);
+}
+
+TEST(Core_Mat, streaming_stores)
+{
+    const int types[] = { CV_8UC1, CV_8UC3, CV_16UC3, CV_32FC4, CV_64FC3 };
+    const Size sizes[] = { Size(1001, 67), Size(50000, 1), Size(7, 3000) };
+    size_t threshold0 = getStreamingStoreThreshold();
+    RNG& rng = theRNG();
+
+    for (size_t t = 0; t < sizeof(types)/sizeof(types[0]); t++)
+    {
+        for (size_t k = 0; k < sizeof(sizes)/sizeof(sizes[0]); k++)
+        {
+            SCOPED_TRACE(cv::format("type=%d size=%dx%d", types[t], sizes[k].width, sizes[k].height));
+            Mat src(sizes[k], types[t]);
+            rng.fill(src, RNG::UNIFORM, 0, 100);
+            Rect roi(3, 5, src.cols, src.rows);
+
+            std::vector<Mat> ref, res;
+            setStreamingStoreThreshold(0);
+            streamingStoreOps(src, roi, ref);
+            setStreamingStoreThreshold(1);
+            streamingStoreOps(src, roi, res);
+            setStreamingStoreThreshold(threshold0);
+
+            ASSERT_EQ(ref.size(), res.size());
+            for (size_t i = 0; i < ref.size(); i++)
+                EXPECT_EQ(0, cvtest::norm(ref[i], res[i], NORM_INF)) << "op=" << i;
+        }
+    }
+
+    int sz[] = { 5, 17, 301 };
+    Mat src3d(3, sz, CV_16SC2), dst3d, ref3d;
+    rng.fill(src3d, RNG::UNIFORM, -1000, 1000);
+    setStreamingStoreThreshold(1);
+    src3d.copyTo(dst3d);
+    setStreamingStoreThreshold(threshold0);
+    src3d.copyTo(ref3d);
+    EXPECT_EQ(0, cvtest::norm(ref3d, dst3d, NORM_INF));
+}
+
 TEST(Core_Matx, fromMat_)
 {
     Mat_<double> a = (Mat_<double>(2,2) << 10, 11, 12, 13);
@@ -1398,6 +1471,95 @@ TEST(Core_SVD, orthogonality)
     }
 }
 
+// a x b matrix with the singular values 100, 100*0.7, 100*0.7^2, ... plus a little noise
+static Mat makeLowRankMatrix(int a, int b, int type, RNG& rng)
+{
+    int r = std::min(a, b);
+    Mat u(a, r, CV_64F), v(b, r, CV_64F), w(r, 1, CV_64F), q, dummy;
+    rng.fill(u, RNG::NORMAL, 0, 1);
+    rng.fill(v, RNG::NORMAL, 0, 1);
+    SVD::compute(u, dummy, q, noArray());
+    u = q;
+    SVD::compute(v, dummy, q, noArray());
+    v = q;
+    for (int i = 0; i < r; i++)
+        w.at<double>(i) = 100*std::pow(0.7, i);
+    Mat noise(a, b, CV_64F), m = u*Mat::diag(w)*v.t();
+    rng.fill(noise, RNG::NORMAL, 0, 1e-4);
+    m += noise;
+    m.convertTo(m, type);
+    return m;
+}
+
+TEST(Core_SVD, truncated)
+{
+    RNG& rng = theRNG();
+    const int rank = 8;
+    for (int i = 0; i < 4; i++)
+    {
+        int type = i % 2 == 0 ? CV_32F : CV_64F;
+        Mat src = i < 2 ? makeLowRankMatrix(700, 120, type, rng) : makeLowRankMatrix(90, 600, type, rng);
+        double eps = type == CV_32F ? 1e-3 : 1e-6;
+
+        Mat w0, u0, vt0;
+        SVD::compute(src, w0, u0, vt0);
+
+        for (int flags = 0; flags <= SVD::RANDOMIZED; flags += SVD::RANDOMIZED)
+        {
+            Mat w, u, vt;
+            SVD::compute(src, w, u, vt, flags, rank);
+            ASSERT_EQ(Size(1, rank), w.size());
+            ASSERT_EQ(Size(rank, src.rows), u.size());
+            ASSERT_EQ(Size(src.cols, rank), vt.size());
+            EXPECT_EQ(type, u.type());
+
+            EXPECT_LE(cvtest::norm(w, w0.rowRange(0, rank), NORM_INF | NORM_RELATIVE), eps) << "flags=" << flags;
+            // the singular vectors are defined up to the sign
+            Mat cu, cv;
+            Mat(u.t()*u0.colRange(0, rank)).convertTo(cu, CV_64F);
+            Mat(vt*vt0.rowRange(0, rank).t()).convertTo(cv, CV_64F);
+            for (int k = 0; k < rank; k++)
+            {
+                EXPECT_NEAR(1., std::abs(cu.at<double>(k, k)), eps) << "flags=" << flags << " k=" << k;
+                EXPECT_NEAR(1., std::abs(cv.at<double>(k, k)), eps) << "flags=" << flags << " k=" << k;
+            }
+        }
+
+        Mat w;
+        SVD::compute(src, w, noArray(), noArray(), SVD::RANDOMIZED | SVD::NO_UV, rank);
+        EXPECT_LE(cvtest::norm(w, w0.rowRange(0, rank), NORM_INF | NORM_RELATIVE), eps);
+    }
+}
+
+TEST(Core_PCA, randomized)
+{
+    RNG& rng = theRNG();
+    const int maxComponents = 6;
+    Mat samples = makeLowRankMatrix(2000, 150, CV_64F, rng), data;
+    samples.convertTo(data, CV_8U, 100, 128);
+
+    for (int layout = 0; layout < 2; layout++)
+    {
+        Mat src = layout == 0 ? data : data.t();
+        int flags = layout == 0 ? PCA::DATA_AS_ROW : PCA::DATA_AS_COL;
+        PCA pca0(src, noArray(), flags, maxComponents);
+        PCA pca(src, noArray(), flags | PCA::RANDOMIZED, maxComponents);
+
+        ASSERT_EQ(pca0.mean.size(), pca.mean.size());
+        EXPECT_LE(cvtest::norm(pca0.mean, pca.mean, NORM_INF), 1e-4);
+        ASSERT_EQ(pca0.eigenvalues.size(), pca.eigenvalues.size());
+        ASSERT_EQ(pca0.eigenvectors.size(), pca.eigenvectors.size());
+        EXPECT_LE(cvtest::norm(pca0.eigenvalues, pca.eigenvalues, NORM_INF | NORM_RELATIVE), 1e-3);
+        Mat c = pca.eigenvectors*pca0.eigenvectors.t();
+        for (int k = 0; k < maxComponents; k++)
+            EXPECT_NEAR(1., std::abs(c.at<float>(k, k)), 1e-3) << "layout=" << layout << " k=" << k;
+
+        // the projections agree up to the signs of the components
+        Mat p0 = pca0.project(src), p = pca.project(src);
+        EXPECT_LE(cvtest::norm(abs(p0), abs(p), NORM_INF), 0.1);
+    }
+}
+
 
 TEST(Core_SparseMat, footprint)
 {
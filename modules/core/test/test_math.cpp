@@ -2977,6 +2977,72 @@ TEST(Core_KMeans, bad_input)
     }
 }
 
+static void generateBlobs(Mat& data, int N, int dims, int nblobs, RNG& rng)
+{
+    Mat blobCenters(nblobs, dims, CV_32F);
+    rng.fill(blobCenters, RNG::UNIFORM, -10, 10);
+    data.create(N, dims, CV_32F);
+    rng.fill(data, RNG::NORMAL, 0, 0.5);
+    for (int i = 0; i < N; i++)
+        data.row(i) += blobCenters.row(i % nblobs);
+}
+
+TEST(Core_KMeans, hamerly_same_as_lloyd)
+{
+    const int N = 5000, dims = 8, K = 16;
+    RNG rng(12345);
+    Mat data;
+    generateBlobs(data, N, dims, 10, rng);
+    Mat initialLabels(N, 1, CV_32S);
+    rng.fill(initialLabels, RNG::UNIFORM, 0, K);
+
+    const TermCriteria crit(TermCriteria::COUNT + TermCriteria::EPS, 30, 0);
+    Mat labels0 = initialLabels.clone(), labels1 = initialLabels.clone(), centers0, centers1;
+    double compactness0 = kmeans(data, K, labels0, crit, 1, KMEANS_USE_INITIAL_LABELS, centers0);
+    double compactness1 = kmeans(data, K, labels1, crit, 1, KMEANS_USE_INITIAL_LABELS | KMEANS_HAMERLY, centers1);
+
+    EXPECT_EQ(0, cvtest::norm(labels0, labels1, NORM_INF));
+    EXPECT_LE(cvtest::norm(centers0, centers1, NORM_INF), 1e-4);
+    EXPECT_NEAR(compactness0, compactness1, compactness0 * 1e-6);
+}
+
+typedef testing::TestWithParam<int> Core_KMeans_Flags;
+
+TEST_P(Core_KMeans_Flags, blobs)
+{
+    const int N = 20000, dims = 4, K = 8;
+    const int flags = GetParam();
+    RNG rng(5678);
+    Mat data;
+    generateBlobs(data, N, dims, K, rng);
+    theRNG().state = 42;
+
+    const TermCriteria crit(TermCriteria::COUNT + TermCriteria::EPS, 50, 1e-3);
+    Mat labels, centers, labels0, centers0;
+    double compactness0 = kmeans(data, K, labels0, crit, 3, KMEANS_PP_CENTERS, centers0);
+    double compactness = kmeans(data, K, labels, crit, 3, flags, centers);
+
+    ASSERT_EQ(N, labels.rows);
+    ASSERT_EQ(K, centers.rows);
+    double expected = 0;
+    for (int i = 0; i < N; i++)
+    {
+        int l = labels.at<int>(i);
+        ASSERT_GE(l, 0);
+        ASSERT_LT(l, K);
+        expected += cvtest::norm(data.row(i), centers.row(l), NORM_L2SQR);
+    }
+    EXPECT_NEAR(expected, compactness, expected * 1e-5);
+    EXPECT_LE(compactness, compactness0 * 1.1);
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Core_KMeans_Flags, testing::Values(
+    (int)KMEANS_PARALLEL_CENTERS,
+    (int)(KMEANS_PP_CENTERS | KMEANS_HAMERLY),
+    (int)(KMEANS_PARALLEL_CENTERS | KMEANS_HAMERLY),
+    (int)(KMEANS_PARALLEL_CENTERS | KMEANS_MINI_BATCH)
+));
+
 TEST(CovariationMatrixVectorOfMat, accuracy)
 {
     unsigned int col_problem_size = 8, row_problem_size = 8, vector_size = 16;
@@ -3095,6 +3161,50 @@ TEST(Core_Pow, special)
     }
 }
 
+// all the lengths up to a few vectors of the widest SIMD, to check the tails
+template<typename T> static void testSqrtFuncs(double eps)
+{
+    RNG& rng = theRNG();
+    for (int len = 1; len <= 130; len += len < 70 ? 1 : 59)
+    {
+        SCOPED_TRACE(len);
+        std::vector<T> x(len), y(len), dst(len), inplace;
+        for (int i = 0; i < len; i++)
+        {
+            x[i] = (T)rng.uniform(-1000., 1000.);
+            y[i] = (T)rng.uniform(1e-3, 1000.);
+        }
+
+        cv::hal::magnitude(&x[0], &y[0], &dst[0], len);
+        for (int i = 0; i < len; i++)
+        {
+            double r0 = std::sqrt((double)x[i]*x[i] + (double)y[i]*y[i]);
+            ASSERT_LE(std::abs(dst[i] - r0), eps*r0) << "magnitude, i=" << i;
+        }
+        inplace = x;
+        cv::hal::magnitude(&inplace[0], &y[0], &inplace[0], len);
+        for (int i = 0; i < len; i++)
+            ASSERT_EQ(dst[i], inplace[i]) << "in-place magnitude, i=" << i;
+
+        cv::hal::sqrt(&y[0], &dst[0], len);
+        for (int i = 0; i < len; i++)
+        {
+            double r0 = std::sqrt((double)y[i]);
+            ASSERT_LE(std::abs(dst[i] - r0), eps*r0) << "sqrt, i=" << i;
+        }
+
+        cv::hal::invSqrt(&y[0], &dst[0], len);
+        for (int i = 0; i < len; i++)
+        {
+            double r0 = 1./std::sqrt((double)y[i]);
+            ASSERT_LE(std::abs(dst[i] - r0), eps*r0) << "invSqrt, i=" << i;
+        }
+    }
+}
+
+TEST(Core_MathFuncs, sqrt_magnitude_32f) { testSqrtFuncs<float>(1e-6); }
+TEST(Core_MathFuncs, sqrt_magnitude_64f) { testSqrtFuncs<double>(1e-14); }
+
 TEST(Core_Cholesky, accuracy64f)
 {
     const int n = 5;
@@ -4005,5 +4115,63 @@ TEST(Core_FastMath, InlineIsInf)
     EXPECT_EQ( cvIsInf(0.0), 0);
 }
 
+TEST(Core_BatchDistance, L2_topK_same_as_full)
+{
+    RNG& rng = theRNG();
+    const int K = 5;
+    Mat query(150, 64, CV_32F), train(700, 64, CV_32F);
+    rng.fill(query, RNG::UNIFORM, -1, 1);
+    rng.fill(train, RNG::UNIFORM, -1, 1);
+    train.row(10).copyTo(query.row(0)); // zero distance
+
+    for (int normType = NORM_L2; normType <= NORM_L2SQR; normType += NORM_L2SQR - NORM_L2)
+    {
+        Mat fullDist, dist, nidx;
+        batchDistance(query, train, fullDist, CV_32F, noArray(), normType, 0);
+        // two passes over halves of the train set, to check the 'update' mode too
+        batchDistance(query, train.rowRange(0, 300), dist, CV_32F, nidx, normType, K, noArray(), 0);
+        batchDistance(query, train.rowRange(300, 700), dist, CV_32F, nidx, normType, K, noArray(), 300);
+
+        for (int i = 0; i < query.rows; i++)
+        {
+            std::vector<float> ref;
+            fullDist.row(i).copyTo(ref);
+            std::sort(ref.begin(), ref.end());
+            for (int k = 0; k < K; k++)
+            {
+                int j = nidx.at<int>(i, k);
+                ASSERT_TRUE(0 <= j && j < train.rows) << "i=" << i << " k=" << k;
+                EXPECT_NEAR(ref[k], dist.at<float>(i, k), 1e-4) << "i=" << i << " k=" << k;
+                EXPECT_NEAR(fullDist.at<float>(i, j), dist.at<float>(i, k), 1e-5) << "i=" << i << " k=" << k;
+            }
+        }
+        EXPECT_EQ(10, nidx.at<int>(0, 0));
+        EXPECT_EQ(0.f, dist.at<float>(0, 0));
+    }
+}
+
+TEST(Core_BatchDistance, hamming)
+{
+    RNG& rng = theRNG();
+    for (int len = 1; len <= 100; len += 11)
+    {
+        Mat query(20, len, CV_8U), train(67, len, CV_8U), mask(query.rows, train.rows, CV_8U);
+        rng.fill(query, RNG::UNIFORM, 0, 256);
+        rng.fill(train, RNG::UNIFORM, 0, 256);
+        rng.fill(mask, RNG::UNIFORM, 0, 2);
+
+        Mat dist, maskedDist;
+        batchDistance(query, train, dist, CV_32S, noArray(), NORM_HAMMING, 0);
+        batchDistance(query, train, maskedDist, CV_32S, noArray(), NORM_HAMMING, 0, mask);
+        for (int i = 0; i < query.rows; i++)
+            for (int j = 0; j < train.rows; j++)
+            {
+                int ref = cvRound(cv::norm(query.row(i), train.row(j), NORM_HAMMING));
+                ASSERT_EQ(ref, dist.at<int>(i, j)) << "len=" << len << " i=" << i << " j=" << j;
+                ASSERT_EQ(mask.at<uchar>(i, j) ? ref : INT_MAX, maskedDist.at<int>(i, j));
+            }
+    }
+}
+
 }} // namespace
 /* End of file. */
@@ -0,0 +1,123 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#include "test_precomp.hpp"
+#include "opencv2/core/pixel_pipeline.hpp"
+
+namespace opencv_test { namespace {
+
+// cv::threshold is a part of imgproc, so the reference is built from the core operations
+static Mat thresholdRef(const Mat& src, double thresh, double maxval, int type)
+{
+    Mat src1 = src.reshape(1), gt, dst;
+    cv::compare(src1, thresh, gt, CMP_GT);
+    switch (type)
+    {
+    case 0: dst = Mat(src1.size(), src1.type(), Scalar::all(0)); dst.setTo(maxval, gt); break;
+    case 1: dst = Mat(src1.size(), src1.type(), Scalar::all(maxval)); dst.setTo(0, gt); break;
+    case 2: dst = src1.clone(); dst.setTo(thresh, gt); break;
+    case 3: dst = Mat(src1.size(), src1.type(), Scalar::all(0)); src1.copyTo(dst, gt); break;
+    default: dst = src1.clone(); dst.setTo(0, gt); break;
+    }
+    return dst.reshape(src.channels());
+}
+
+TEST(Core_PixelOpPipeline, convert_lut_threshold)
+{
+    RNG& rng = theRNG();
+    Mat src(481, 643, CV_16UC3);
+    rng.fill(src, RNG::UNIFORM, 0, 4096);
+    Mat lut(1, 256, CV_8UC1);
+    for (int i = 0; i < 256; i++)
+        lut.at<uchar>(i) = saturate_cast<uchar>(std::sqrt(i/255.)*255);
+
+    for (int type = 0; type <= 4; type++)
+    {
+        SCOPED_TRACE(type);
+        PixelOpPipeline pipeline;
+        pipeline.convertTo(CV_8U, 1./16, 0.5).LUT(lut).threshold(100, 200, type);
+        EXPECT_EQ(CV_8UC3, pipeline.outputType(src.type()));
+
+        Mat dst;
+        pipeline.apply(src, dst);
+
+        Mat t1, t2, ref;
+        src.convertTo(t1, CV_8U, 1./16, 0.5);
+        cv::LUT(t1, lut, t2);
+        ref = thresholdRef(t2, 100, 200, type);
+        ASSERT_EQ(ref.type(), dst.type());
+        EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF));
+    }
+}
+
+TEST(Core_PixelOpPipeline, type_changes)
+{
+    RNG& rng = theRNG();
+    Mat big(300, 500, CV_8UC1), src = big(Rect(7, 3, 400, 250));
+    rng.fill(big, RNG::UNIFORM, 0, 256);
+    Mat lut(1, 256, CV_32FC1);
+    rng.fill(lut, RNG::UNIFORM, -10, 10);
+
+    PixelOpPipeline pipeline;
+    pipeline.LUT(lut).convertTo(CV_16S, 100).threshold(-250.5, 0, 2).convertTo(CV_32F, 0.01);
+    Mat dst;
+    pipeline.apply(src, dst);
+
+    Mat t1, t2, t3, ref;
+    cv::LUT(src, lut, t1);
+    t1.convertTo(t2, CV_16S, 100);
+    t3 = thresholdRef(t2, cvFloor(-250.5), 0, 2);
+    t3.convertTo(ref, CV_32F, 0.01);
+    ASSERT_EQ(CV_32FC1, dst.type());
+    EXPECT_LE(cvtest::norm(ref, dst, NORM_INF), 1e-5);
+}
+
+TEST(Core_PixelOpPipeline, normalize_inRange)
+{
+    RNG& rng = theRNG();
+    Mat src(200, 300, CV_32FC1);
+    rng.fill(src, RNG::UNIFORM, -3, 7);
+
+    const int normTypes[] = { NORM_MINMAX, NORM_INF, NORM_L1, NORM_L2 };
+    for (size_t i = 0; i < sizeof(normTypes)/sizeof(normTypes[0]); i++)
+    {
+        SCOPED_TRACE(normTypes[i]);
+        double alpha = normTypes[i] == NORM_MINMAX ? 10 : 1000, beta = 250;
+        PixelOpPipeline pipeline;
+        pipeline.convertTo(-1, 2, 1).normalize(alpha, beta, normTypes[i], CV_32F);
+        Mat dst, t1, ref;
+        pipeline.apply(src, dst);
+
+        src.convertTo(t1, -1, 2, 1);
+        cv::normalize(t1, ref, alpha, beta, normTypes[i], CV_32F);
+        EXPECT_LE(cvtest::norm(ref, dst, NORM_INF | NORM_RELATIVE), 1e-5);
+    }
+
+    Mat src3(150, 170, CV_8UC3), dst, ref, t1;
+    rng.fill(src3, RNG::UNIFORM, 0, 256);
+    PixelOpPipeline pipeline;
+    pipeline.normalize(0, 255, NORM_MINMAX).inRange(Scalar(10, 20, 30), Scalar(200, 210.4, 220.6));
+    pipeline.apply(src3, dst);
+    cv::normalize(src3, t1, 0, 255, NORM_MINMAX);
+    cv::inRange(t1, Scalar(10, 20, 30), Scalar(200, 210.4, 220.6), ref);
+    ASSERT_EQ(CV_8UC1, dst.type());
+    EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF));
+}
+
+TEST(Core_PixelOpPipeline, bad_arg)
+{
+    PixelOpPipeline pipeline;
+    Mat lut(1, 256, CV_8U, Scalar::all(1)), dst;
+    pipeline.convertTo(CV_16U).LUT(lut);
+    EXPECT_ANY_THROW(pipeline.apply(Mat(10, 10, CV_8UC1, Scalar::all(0)), dst));
+    EXPECT_ANY_THROW(pipeline.threshold(0, 0, 7));
+    EXPECT_ANY_THROW(pipeline.normalize(1, 0, NORM_HAMMING));
+
+    pipeline.clear();
+    EXPECT_TRUE(pipeline.empty());
+    Mat src(5, 5, CV_8UC2, Scalar(1, 2));
+    pipeline.apply(src, dst);
+    EXPECT_EQ(0, cvtest::norm(src, dst, NORM_INF));
+}
+
+}} // namespace
@@ -7,6 +7,11 @@
 #define CV_LOG_STRIP_LEVEL CV_LOG_LEVEL_VERBOSE + 1
 #include "opencv2/core/utils/logger.hpp"
 #include "opencv2/core/utils/buffer_area.private.hpp"
+#include "opencv2/core/utils/numa.private.hpp"
+#include "opencv2/core/utils/numa.hpp"
+#include "opencv2/core/utils/trace_buffer.hpp"
+
+#include <atomic>
 
 #include "test_utils_tls.impl.hpp"
 
@@ -496,5 +501,171 @@ TEST_P(BufferArea, bad)
 
 INSTANTIATE_TEST_CASE_P(/**/, BufferArea, testing::Values(true, false));
 
+TEST(Numa, allocator)
+{
+    const int nodes = cv::utils::getNumaNodesCount();
+    ASSERT_GE(nodes, 1);
+    for (int node = -1; node < nodes; node++)
+    {
+        SCOPED_TRACE(node);
+        MatAllocator* allocator = cv::utils::getNumaAllocator(node);
+        ASSERT_TRUE(allocator != NULL);
+
+        // both the small buffers and the large ones placed by the policy
+        Mat small, large, roi;
+        small.allocator = large.allocator = allocator;
+        small.create(10, 10, CV_32FC1);
+        large.create(1024, 1024, CV_32FC2);
+        small.setTo(1);
+        large.setTo(Scalar(2, 3));
+        EXPECT_EQ(100, cv::sum(small)[0]);
+        EXPECT_EQ(1024*1024*2, cv::sum(large)[0]);
+
+        roi = large(Rect(100, 100, 10, 10));
+        Mat copy = roi.clone();
+        large.release();
+        EXPECT_EQ(10*10*3, cv::sum(roi)[1]);
+        EXPECT_EQ(0, cvtest::norm(roi, copy, NORM_INF));
+    }
+    EXPECT_ANY_THROW(cv::utils::getNumaAllocator(nodes));
+}
+
+TEST(Numa, allocator_without_topology)
+{
+    // e.g. the containers without /sys/devices/system/node
+    cv::utils::reloadNumaTopology(cv::tempfile());
+    EXPECT_EQ(1, cv::utils::getNumaNodesCount());
+    for (int node = -1; node < 1; node++)
+    {
+        SCOPED_TRACE(node);
+        Mat large;
+        large.allocator = cv::utils::getNumaAllocator(node);
+        large.create(1024, 1024, CV_32FC2);
+        large.setTo(Scalar(2, 3));
+        EXPECT_EQ(1024*1024*3, cv::sum(large)[1]);
+    }
+    EXPECT_ANY_THROW(cv::utils::getNumaAllocator(1));
+    cv::utils::reloadNumaTopology();
+}
+
+TEST(Numa, thread_binding)
+{
+    const int nodes = cv::utils::getNumaNodesCount();
+    std::vector<int> data(1000, 0);
+    const int modes[] = { cv::utils::NUMA_THREADS_SPREAD, cv::utils::NUMA_THREADS_NODE, cv::utils::NUMA_THREADS_FREE };
+    for (int k = 0; k < 3; k++)
+    {
+        cv::utils::setNumaThreadBinding(modes[k], nodes - 1);
+        parallel_for_(Range(0, (int)data.size()), [&](const Range& r) {
+            for (int i = r.start; i < r.end; i++)
+                data[i]++;
+        });
+    }
+    for (size_t i = 0; i < data.size(); i++)
+        ASSERT_EQ(3, data[i]);
+    EXPECT_ANY_THROW(cv::utils::setNumaThreadBinding(cv::utils::NUMA_THREADS_NODE, nodes));
+
+    if (cv::utils::bindCurrentThreadToNumaNode(nodes - 1))
+    {
+        int current = cv::utils::getCurrentNumaNode();
+        EXPECT_TRUE(current == nodes - 1 || current < 0) << current;
+        EXPECT_TRUE(cv::utils::bindCurrentThreadToNumaNode(-1));
+    }
+}
+
+static int countEvents(const std::string& json, const std::string& name)
+{
+    const std::string key = "{\"name\":\"" + name + "\",";
+    int count = 0;
+    for (size_t pos = json.find(key); pos != std::string::npos; pos = json.find(key, pos + 1))
+        count++;
+    return count;
+}
+
+static void traceTestRegions(int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        CV_TRACE_REGION("test_outer");
+        {
+            CV_TRACE_REGION("test_inner");
+        }
+    }
+}
+
+TEST(Core_TraceBuffer, regions)
+{
+    cv::utils::trace::startTraceBuffer(1024);
+    if (!cv::utils::trace::isTraceBufferActive())
+        throw SkipTestException("OpenCV is built without the tracing support");
+    traceTestRegions(3);
+    {
+        CV_TRACE_REGION("test_step1");
+        CV_TRACE_REGION_NEXT("test_step2");
+    }
+    cv::utils::trace::stopTraceBuffer();
+    traceTestRegions(1);
+
+    std::string json = cv::utils::trace::exportTraceBuffer();
+    EXPECT_EQ(0u, json.find("{\"traceEvents\":["));
+    EXPECT_EQ(3, countEvents(json, "test_outer"));
+    EXPECT_EQ(3, countEvents(json, "test_inner"));
+    EXPECT_EQ(1, countEvents(json, "test_step1"));
+    EXPECT_EQ(1, countEvents(json, "test_step2"));
+    EXPECT_NE(std::string::npos, json.find("\"ph\":\"X\""));
+    EXPECT_NE(std::string::npos, json.find("\"droppedEvents\":0}"));
+
+    // the previous events are discarded by the new start, the oldest ones are overwritten
+    cv::utils::trace::startTraceBuffer(4);
+    traceTestRegions(5);
+    cv::utils::trace::stopTraceBuffer();
+    json = cv::utils::trace::exportTraceBuffer();
+    EXPECT_EQ(0, countEvents(json, "test_step1"));
+    EXPECT_EQ(4, countEvents(json, "test_outer") + countEvents(json, "test_inner"));
+    EXPECT_NE(std::string::npos, json.find("\"droppedEvents\":6}"));
+}
+
+TEST(Core_TraceBuffer, sampling)
+{
+    cv::utils::trace::startTraceBuffer(1024, 4);
+    if (!cv::utils::trace::isTraceBufferActive())
+        throw SkipTestException("OpenCV is built without the tracing support");
+    // the sampling is applied to the outermost regions, so the test ones must not be nested into the test body
+    std::thread(traceTestRegions, 8).join();
+    cv::utils::trace::stopTraceBuffer();
+    std::string json = cv::utils::trace::exportTraceBuffer();
+    EXPECT_EQ(2, countEvents(json, "test_outer"));
+    EXPECT_EQ(2, countEvents(json, "test_inner"));
+
+    cv::utils::trace::startTraceBuffer(1024, 1, (int64)1000000000);
+    traceTestRegions(8);
+    cv::utils::trace::stopTraceBuffer();
+    json = cv::utils::trace::exportTraceBuffer();
+    EXPECT_EQ(0, countEvents(json, "test_outer"));
+}
+
+TEST(Core_TraceBuffer, threads)
+{
+    cv::utils::trace::startTraceBuffer(1 << 16);
+    if (!cv::utils::trace::isTraceBufferActive())
+        throw SkipTestException("OpenCV is built without the tracing support");
+    const int N = 4000;
+    std::atomic<int> done(0);
+    std::thread reader([&]() {
+        // the export runs concurrently with the writers
+        while (!done)
+            cv::utils::trace::exportTraceBuffer();
+    });
+    parallel_for_(Range(0, N), [&](const Range& r) {
+        for (int i = r.start; i < r.end; i++)
+        {
+            CV_TRACE_REGION("test_parallel");
+        }
+    });
+    done = 1;
+    reader.join();
+    cv::utils::trace::stopTraceBuffer();
+    EXPECT_EQ(N, countEvents(cv::utils::trace::exportTraceBuffer(), "test_parallel"));
+}
 
 }} // namespace
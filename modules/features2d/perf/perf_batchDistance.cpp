@@ -129,6 +129,35 @@ PERF_TEST_P(Norm_CrossCheck, batchDistance_32F,
     if (isCrossCheck) SANITY_CHECK(ndix);
 }
 
+typedef tuple<NormType, int> Norm_Knn_t;
+typedef perf::TestBaseWithParam<Norm_Knn_t> Norm_Knn;
+
+PERF_TEST_P(Norm_Knn, batchDistance_knn,
+            testing::Combine(testing::Values((int)NORM_L2, (int)NORM_L2SQR, (int)NORM_HAMMING),
+                             testing::Values(1, 2, 16)
+                             )
+            )
+{
+    NormType normType = get<0>(GetParam());
+    int knn = get<1>(GetParam());
+    int sourceType = normType == NORM_HAMMING ? CV_8U : CV_32F;
+
+    Mat queryDescriptors(2000, normType == NORM_HAMMING ? 32 : 128, sourceType);
+    Mat trainDescriptors(20000, queryDescriptors.cols, sourceType);
+    Mat dist;
+    Mat ndix;
+
+    declare.in(queryDescriptors, trainDescriptors, WARMUP_RNG);
+    declare.time(100);
+
+    TEST_CYCLE()
+    {
+        batchDistance(queryDescriptors, trainDescriptors, dist, -1, ndix, normType, knn);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
 void generateData( Mat& query, Mat& train, const int sourceType )
 {
     const int dim = 500;
@@ -236,6 +236,13 @@ enum MorphShapes {
                       //!< into the rectangle Rect(0, 0, esize.width, 0.esize.height)
 };
 
+//! the method of #bilateralFilter
+enum BilateralFilterFlags {
+    BILATERAL_FILTER_EXACT = 0, //!< the filter with the d x d neighborhood of each pixel
+    BILATERAL_FILTER_GRID  = 1  //!< the bilateral grid approximation, its cost does not depend on sigmaSpace,
+                                //!< see #jointBilateralFilter
+};
+
 //! @} imgproc_filter
 
 //! @addtogroup imgproc_transform
@@ -963,7 +970,9 @@ class CV_EXPORTS_W CLAHE : public Algorithm
 public:
     /** @brief Equalizes the histogram of a grayscale image using Contrast Limited Adaptive Histogram Equalization.
 
-    @param src Source image of type CV_8UC1 or CV_16UC1.
+    The channels of the multi-channel images are equalized independently in a single pass.
+
+    @param src Source image of type CV_8UC(n) or CV_16UC(n), n <= 4.
     @param dst Destination image.
      */
     CV_WRAP virtual void apply(InputArray src, OutputArray dst) = 0;
@@ -987,9 +996,88 @@ public:
     //!@brief Returns Size defines the number of tiles in row and column.
     CV_WRAP virtual Size getTilesGridSize() const = 0;
 
+    /** @brief Sets the temporal smoothing of the tile histograms for the video streams.
+
+    When alpha > 0, the histograms of the tiles are kept between the calls of apply and the
+    histogram of each new frame is blended into them, \f$H \leftarrow \alpha H + (1 - \alpha) h\f$,
+    before the clipping. The Luts change smoothly then, which removes the flicker of the equalized
+    video. The state is started anew by the first frame, by a frame of another type or size, or after
+    collectGarbage.
+
+    The default implementation ignores the call, so the classes derived from CLAHE outside of
+    OpenCV keep working without the temporal mode.
+
+    @param alpha smoothing factor in [0, 1), 0 (default) disables the temporal mode.
+    */
+    CV_WRAP virtual void setTemporalSmoothing(double alpha) { CV_UNUSED(alpha); }
+
+    //! Returns the temporal smoothing factor, 0 if the implementation has no temporal mode.
+    CV_WRAP virtual double getTemporalSmoothing() const { return 0; }
+
     CV_WRAP virtual void collectGarbage() = 0;
 };
 
+/** @brief Histogram of the sliding window.
+
+The histogram is updated incrementally as the window moves: the histograms of the image columns
+of the window height are maintained, so moving the window one pixel to the right costs O(256)
+and moving it one row down costs O(image width) regardless of the window size (the approach of
+Perreault and Hebert, "Median Filtering in Constant Time"). It is the building block of the
+filters that need the histogram of the pixel neighborhood, e.g. the local percentiles, modes,
+entropy or equalization with the large windows:
+
+    LocalHistogram lh(img, Size(31, 31));
+    for (int y = 0; y < img.rows; y++)
+        for (int x = 0; x < img.cols; x++)
+        {
+            lh.moveTo(x, y);
+            const int* h = lh.hist();
+            ...
+        }
+
+Any order of the positions is allowed, but the raster one is the fastest.
+*/
+class CV_EXPORTS LocalHistogram
+{
+public:
+    LocalHistogram();
+
+    //! The constructor that calls init
+    LocalHistogram(InputArray src, Size ksize, int borderType = BORDER_REFLECT_101);
+
+    /** @brief Sets the image and the window.
+
+    @param src 8-bit single-channel image, it is copied.
+    @param ksize Window size, the window of the pixel (x, y) is centered at it.
+    @param borderType Pixel extrapolation method for the windows crossing the image border,
+    see #BorderTypes. #BORDER_WRAP is not supported, #BORDER_CONSTANT uses 0.
+    */
+    void init(InputArray src, Size ksize, int borderType = BORDER_REFLECT_101);
+
+    /** @brief Moves the window to the pixel (x, y).
+
+    The cheapest moves are to the right neighbor and to any pixel of the next row.
+    */
+    void moveTo(int x, int y);
+
+    //! Returns the 256-bin histogram of the current window, it has ksize.area() pixels in total.
+    const int* hist() const { return &hist_[0]; }
+
+    //! Returns the current position of the window.
+    Point pos() const { return pos_; }
+
+protected:
+    void updateColumns(int y);
+    void sumColumns(int x);
+
+    Mat ext_;
+    Mat colHist_;
+    std::vector<int> hist_;
+    Size ksize_;
+    Point pos_;
+    int colRow_;
+};
+
 //! @} imgproc_hist
 
 //! @addtogroup imgproc_subdiv2d
@@ -1431,14 +1519,32 @@ In-place operation is supported.
 
 @note The median filter uses #BORDER_REPLICATE internally to cope with border pixels, see #BorderTypes
 
-@param src input 1-, 3-, or 4-channel image; when ksize is 3 or 5, the image depth should be
-CV_8U, CV_16U, or CV_32F, for larger aperture sizes, it can only be CV_8U.
+@param src input image; the image depth should be CV_8U, CV_16U, CV_16S or CV_32F.
 @param dst destination array of the same size and type as src.
 @param ksize aperture linear size; it must be odd and greater than 1, for example: 3, 5, 7 ...
-@sa  bilateralFilter, blur, boxFilter, GaussianBlur
+@sa  bilateralFilter, blur, boxFilter, GaussianBlur, weightedMedianBlur
  */
 CV_EXPORTS_W void medianBlur( InputArray src, OutputArray dst, int ksize );
 
+/** @brief Blurs an image using the weighted median filter.
+
+The function computes the median of the \f$\texttt{ksize} \times \texttt{ksize}\f$ neighborhood
+of each pixel, where every pixel of the neighborhood is counted weights(x,y) times. The pixels with
+the zero weight, e.g. the invalid pixels of a depth map, are excluded; where all the weights of the
+neighborhood are zero, the source pixel is copied to the destination. With all the weights equal
+to 1 the result is the same as of medianBlur. Each channel of a multi-channel image is processed
+independently. In-place operation is supported.
+
+@note The filter uses #BORDER_REPLICATE for both the image and the weights.
+
+@param src input image; the image depth should be CV_8U, CV_16U, CV_16S or CV_32F.
+@param dst destination array of the same size and type as src.
+@param ksize aperture linear size; it must be odd and greater than 1, for example: 3, 5, 7 ...
+@param weights single-channel 8-bit weights of the same size as src, e.g. the mask of the valid pixels.
+@sa medianBlur
+ */
+CV_EXPORTS_W void weightedMedianBlur( InputArray src, OutputArray dst, int ksize, InputArray weights );
+
 /** @brief Blurs an image using a Gaussian filter.
 
 The function convolves the source image with the specified Gaussian kernel. In-place filtering is
@@ -1457,12 +1563,29 @@ possible future modifications of all this semantics, it is recommended to specif
 sigmaX, and sigmaY.
 @param borderType pixel extrapolation method, see #BorderTypes. #BORDER_WRAP is not supported.
 
-@sa  sepFilter2D, filter2D, blur, boxFilter, bilateralFilter, medianBlur
+@sa  sepFilter2D, filter2D, blur, boxFilter, bilateralFilter, medianBlur, stackBlur
  */
 CV_EXPORTS_W void GaussianBlur( InputArray src, OutputArray dst, Size ksize,
                                 double sigmaX, double sigmaY = 0,
                                 int borderType = BORDER_DEFAULT );
 
+/** @brief Blurs an image using the stack blur.
+
+The function approximates the Gaussian blur with the triangular kernel of the size ksize, i.e. with
+the weights \f$r+1-|i|, i=-r..r, r=\texttt{ksize}/2\f$ in each direction. Unlike GaussianBlur, its
+cost per pixel does not depend on the kernel size, so it is much faster for the large kernels. The
+standard deviation of the kernel is \f$\sqrt{((r+1)^2-1)/6}\f$, so for the given sigma use
+\f$r \approx \sqrt{6\sigma^2+1}-1\f$, e.g. ksize = 2*cvRound(sigma*2.45)-1 for the large sigmas.
+The border pixels are replicated. In-place operation is supported.
+
+@param src input image; the image can have any number of channels, which are processed
+independently, the depth should be CV_8U, CV_16U, CV_16S or CV_32F.
+@param dst output image of the same size and type as src.
+@param ksize stack-blurring kernel size. The ksize.width and ksize.height must be positive and odd.
+@sa GaussianBlur, blur
+*/
+CV_EXPORTS_W void stackBlur( InputArray src, OutputArray dst, Size ksize );
+
 /** @brief Applies the bilateral filter to an image.
 
 The function applies bilateral filtering to the input image, as described in
@@ -1495,6 +1618,36 @@ CV_EXPORTS_W void bilateralFilter( InputArray src, OutputArray dst, int d,
                                    double sigmaColor, double sigmaSpace,
                                    int borderType = BORDER_DEFAULT );
 
+/** @overload
+@param flags the filtering method, see #BilateralFilterFlags. d and borderType are not used by
+#BILATERAL_FILTER_GRID.
+*/
+CV_EXPORTS_W void bilateralFilter( InputArray src, OutputArray dst, int d,
+                                   double sigmaColor, double sigmaSpace,
+                                   int borderType, int flags );
+
+/** @brief Applies the joint (cross) bilateral filter to an image using the bilateral grid.
+
+The function smoothes src with the weights that depend on the distance between the pixels and on
+the difference of their values in the joint image, like bilateralFilter does when joint is src.
+The filter is approximated with the bilateral grid of Chen, Paris and Durand: the pixels are
+accumulated in a coarse 3D grid (x, y, joint value) with the cell size of sigmaSpace x sigmaSpace x
+sigmaColor, the grid is blurred and the result is interpolated at each pixel. So the cost does not
+depend on sigmaSpace and it is the lowest for the large sigmas, where the exact filter is the slowest.
+
+The 3-channel joint images are converted to grayscale, i.e. the color differences are measured
+as the differences of the luminance. In-place operation is supported.
+
+@param joint 8-bit or floating-point, 1-channel or 3-channel joint image of the same size as src.
+@param src Source 8-bit or floating-point, 1-channel or 3-channel image.
+@param dst Destination image of the same size and type as src.
+@param sigmaColor Filter sigma in the color space of the joint image.
+@param sigmaSpace Filter sigma in the coordinate space.
+@sa bilateralFilter
+ */
+CV_EXPORTS_W void jointBilateralFilter( InputArray joint, InputArray src, OutputArray dst,
+                                        double sigmaColor, double sigmaSpace );
+
 /** @brief Blurs an image using the box filter.
 
 The function smooths an image using the kernel:
@@ -2452,6 +2605,40 @@ CV_EXPORTS_W void convertMaps( InputArray map1, InputArray map2,
                                OutputArray dstmap1, OutputArray dstmap2,
                                int dstmap1type, bool nninterpolation = false );
 
+/** @brief Applies a geometrical transformation defined by a sparse grid of the map values.
+
+The function is the same as remap with the interleaved floating-point map, but the map is
+given only at the nodes of a regular grid with the step gridStep: grid(j, i) holds the
+\f$(map_x, map_y)\f$ values of the destination pixel (i\*gridStep, j\*gridStep). The map values
+of the other pixels are computed on the fly by the bilinear interpolation of the 4 nearest
+nodes:
+
+\f[\texttt{dst} (x,y) =  \texttt{src} (\texttt{grid} (x/\texttt{gridStep}, y/\texttt{gridStep}))\f]
+
+For the smooth maps, such as the ones of the lens undistortion, the map is reproduced with the
+subpixel accuracy by the grids with the steps up to 16-32 pixels, while the grid takes
+gridStep\f$^2\f$ times less memory than the dense CV_32FC2 map. This cuts the memory traffic
+spent on the map reads, which dominates remap of the large images with the dense maps. The
+grids are created, for example, by initUndistortRectifyMapGrid and
+fisheye::initUndistortRectifyMapGrid.
+
+@param src Source image.
+@param dst Destination image. It has the size dsize and the same type as src.
+@param grid The map values at the grid nodes, CV_32FC2 matrix of at least
+((dsize.width - 1)/gridStep + 2) columns and ((dsize.height - 1)/gridStep + 2) rows.
+@param dsize Size of the destination image.
+@param gridStep The distance between the grid nodes in the destination image, in pixels.
+@param interpolation Interpolation method, see remap.
+@param borderMode Pixel extrapolation method, see remap.
+@param borderValue Value used in case of a constant border. By default, it is 0.
+
+@sa  remap, convertMaps
+ */
+CV_EXPORTS_W void remapGrid( InputArray src, OutputArray dst, InputArray grid, Size dsize,
+                             int gridStep, int interpolation,
+                             int borderMode = BORDER_CONSTANT,
+                             const Scalar& borderValue = Scalar());
+
 /** @brief Calculates an affine matrix of 2D rotation.
 
 The function calculates the following matrix:
@@ -3543,6 +3730,36 @@ CV_EXPORTS_W int floodFill( InputOutputArray image, InputOutputArray mask,
                             Scalar loDiff = Scalar(), Scalar upDiff = Scalar(),
                             int flags = 4 );
 
+/** @brief Finds the regions grown from a set of seeds and computes their statistics.
+
+The function finds the same regions as floodFill in the floating range mode with loDiff = upDiff =
+diff, but for many seeds at once: the neighbor pixels are connected if the absolute difference of
+their values does not exceed diff in each channel, and each region is the connected component
+of its seed. Unlike floodFill, the image is not modified.
+
+The whole image is labeled in parallel: the horizontal stripes are labeled independently with
+the union-find structure, then the stripes are merged. So the cost does not depend on the number
+of seeds, which makes the function much faster than a loop of floodFill calls for many seeds or
+large regions.
+
+@param image Input 1- or 3-channel, 8-bit, 32-bit integer or floating-point image.
+@param seeds The seed points, std::vector<Point> or CV_32SC2 matrix.
+@param labels Output CV_32S label image of the image size. The regions get the labels 1, 2, ... in
+the order of their first seeds (the seeds that fall into the same region share the label), the
+pixels outside of the seeded regions are labeled 0.
+@param stats Statistics output for each label, including the label 0, see #ConnectedComponentsTypes.
+The data type is CV_32S.
+@param centroids Centroid output for each label, including the label 0. The data type is CV_64F.
+@param diff Maximal brightness/color difference between the neighbor pixels of a region.
+@param connectivity 4 or 8 for 4-way or 8-way connectivity respectively.
+@returns the number of labels, including the label 0.
+
+@sa floodFill, connectedComponentsWithStats
+ */
+CV_EXPORTS_W int floodFillRegions( InputArray image, InputArray seeds, OutputArray labels,
+                                   OutputArray stats, OutputArray centroids,
+                                   Scalar diff, int connectivity = 4 );
+
 //! Performs linear blending of two images:
 //! \f[ \texttt{dst}(i,j) = \texttt{weights1}(i,j)*\texttt{src1}(i,j) + \texttt{weights2}(i,j)*\texttt{src2}(i,j) \f]
 //! @param src1 It has a type of CV_8UC(n) or CV_32FC(n), where n is a positive integer.
@@ -3780,6 +3997,47 @@ is \f$W \times H\f$ and templ is \f$w \times h\f$ , then result is \f$(W-w+1) \t
 CV_EXPORTS_W void matchTemplate( InputArray image, InputArray templ,
                                  OutputArray result, int method, InputArray mask = noArray() );
 
+/** @brief Matches a set of templates against the images, e.g. against the frames of a video.
+
+The results are the same as the ones of #matchTemplate called for each template, up to the
+rounding, but the image is transformed to the frequency domain once per frame and the spectra of
+the templates are computed once and kept until the templates or the image size change. The
+templates are processed in parallel, and the normalization of the scores is computed from the
+integral images of the frame shared by all the templates.
+
+@sa createTemplateMatcher
+*/
+class CV_EXPORTS_W TemplateMatcher : public Algorithm
+{
+public:
+    /** @brief Sets the templates.
+
+    @param templs Templates of the same type, 8-bit or 32-bit floating-point with 1-4 channels.
+    */
+    CV_WRAP virtual void setTemplates(InputArrayOfArrays templs) = 0;
+
+    /** @brief Matches all the templates against the image.
+
+    @param image Image of the same type as the templates, not smaller than any of them.
+    @param results Comparison results, one single-channel 32-bit floating-point map per template,
+    see #matchTemplate.
+    */
+    CV_WRAP virtual void match(InputArray image, OutputArrayOfArrays results) = 0;
+
+    //! Sets the comparison method, see #TemplateMatchModes
+    CV_WRAP virtual void setMethod(int method) = 0;
+    CV_WRAP virtual int getMethod() const = 0;
+
+    //! Releases the cached spectra of the templates
+    CV_WRAP virtual void collectGarbage() = 0;
+};
+
+/** @brief Creates a smart pointer to a cv::TemplateMatcher and initializes it.
+
+@param method Comparison method, see #TemplateMatchModes. The masked matching is not supported.
+ */
+CV_EXPORTS_W Ptr<TemplateMatcher> createTemplateMatcher(int method = TM_CCOEFF_NORMED);
+
 //! @}
 
 //! @addtogroup imgproc_shape
@@ -35,4 +35,28 @@ PERF_TEST_P( TestBilateralFilter, BilateralFilter,
     SANITY_CHECK(dst, .01, ERROR_RELATIVE);
 }
 
+typedef TestBaseWithParam< tuple<Size, double, Mat_Type> > TestBilateralGrid;
+
+PERF_TEST_P( TestBilateralGrid, BilateralGrid,
+             Combine(
+                Values( sz1080p, sz2160p ), // image size
+                Values( 8., 32. ), // sigmaSpace
+                Values( CV_8UC1, CV_8UC3 ) // image type
+             )
+)
+{
+    Size sz = get<0>(GetParam());
+    double sigmaSpace = get<1>(GetParam());
+    int type = get<2>(GetParam());
+
+    Mat src(sz, type);
+    Mat dst(sz, type);
+
+    declare.in(src, WARMUP_RNG).out(dst).time(20);
+
+    TEST_CYCLE() bilateralFilter(src, dst, -1, 30., sigmaSpace, BORDER_DEFAULT, BILATERAL_FILTER_GRID);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
@@ -67,4 +67,27 @@ PERF_TEST_P(Size_Source_Fl, floodFill1, Combine(
     SANITY_CHECK_NOTHING();
 }
 
+typedef perf::TestBaseWithParam<tuple<MatType, int, int> > FloodFillRegions;
+
+PERF_TEST_P(FloodFillRegions, floodFillRegions, Combine(
+            testing::Values(CV_8UC1, CV_8UC3),
+            testing::Values(4, 8), //connectivity
+            testing::Values(10, 1000) //number of seeds
+            ))
+{
+    int type = get<0>(GetParam()), connectivity = get<1>(GetParam()), nseeds = get<2>(GetParam());
+    Size sz(1920, 1080);
+    Mat img(sz, type), labels, stats, centroids;
+    RNG rng(12345);
+    rng.fill(img, RNG::UNIFORM, 0, 256);
+    GaussianBlur(img, img, Size(0, 0), 3);
+    std::vector<Point> seeds;
+    for (int i = 0; i < nseeds; i++)
+        seeds.push_back(Point(rng.uniform(0, sz.width), rng.uniform(0, sz.height)));
+
+    TEST_CYCLE() floodFillRegions(img, seeds, labels, stats, centroids, Scalar::all(1), connectivity);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
@@ -165,4 +165,48 @@ PERF_TEST_P(Sz_ClipLimit, CLAHE,
     SANITY_CHECK(dst);
 }
 
+PERF_TEST_P(Size_Source, CLAHE_temporal,
+            testing::Combine(testing::Values(::perf::sz720p, ::perf::sz1080p),
+                             testing::Values(MatType(CV_8UC1), MatType(CV_8UC3)))
+            )
+{
+    const Size size = get<0>(GetParam());
+    const int type = get<1>(GetParam());
+
+    Mat src(size, type);
+    declare.in(src, WARMUP_RNG);
+
+    Ptr<CLAHE> clahe = createCLAHE(2.0);
+    clahe->setTemporalSmoothing(0.9);
+    Mat dst;
+
+    TEST_CYCLE() clahe->apply(src, dst);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(TestMatSize, LocalHistogram, testing::Values(::perf::szVGA, ::perf::sz720p))
+{
+    const Size size = GetParam();
+
+    Mat src(size, CV_8UC1);
+    declare.in(src, WARMUP_RNG);
+    Mat dst(size, CV_8UC1);
+
+    // local mode of the 31x31 windows
+    TEST_CYCLE()
+    {
+        LocalHistogram lh(src, Size(31, 31));
+        for (int y = 0; y < size.height; y++)
+            for (int x = 0; x < size.width; x++)
+            {
+                lh.moveTo(x, y);
+                const int* h = lh.hist();
+                dst.at<uchar>(y, x) = (uchar)(std::max_element(h, h + 256) - h);
+            }
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
@@ -81,4 +81,34 @@ PERF_TEST_P(ImgSize_TmplSize_Method, matchTemplateBig,
     SANITY_CHECK(result, eps);
 }
 
+typedef tuple<Size, int, MethodType> ImgSize_TmplCount_Method_t;
+typedef perf::TestBaseWithParam<ImgSize_TmplCount_Method_t> ImgSize_TmplCount_Method;
+
+PERF_TEST_P(ImgSize_TmplCount_Method, matchTemplateBatch,
+            testing::Combine(
+                testing::Values(cv::Size(640, 480), cv::Size(1280, 1024)),
+                testing::Values(1, 50),
+                testing::Values(MethodType(TM_SQDIFF), MethodType(TM_CCOEFF_NORMED))
+                )
+    )
+{
+    Size imgSz = get<0>(GetParam());
+    int count = get<1>(GetParam());
+    int method = get<2>(GetParam());
+
+    Mat img(imgSz, CV_8UC1);
+    declare.in(img, WARMUP_RNG);
+    std::vector<Mat> templs(count);
+    for (int i = 0; i < count; i++)
+        templs[i] = img(Rect((i*37) % (imgSz.width - 48), (i*53) % (imgSz.height - 48), 24 + i % 25, 24 + (i*7) % 25)).clone();
+
+    Ptr<TemplateMatcher> matcher = createTemplateMatcher(method);
+    matcher->setTemplates(templs);
+    std::vector<Mat> results;
+
+    TEST_CYCLE() matcher->match(img, results);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
@@ -39,4 +39,25 @@ PERF_TEST_P(Size_MatType, dilate, TYPICAL_MATS_MORPH)
     SANITY_CHECK(dst);
 }
 
+CV_ENUM(MorphShapes, MORPH_RECT, MORPH_CROSS, MORPH_ELLIPSE)
+
+typedef tuple<MatType, MorphShapes, int> MorphLarge_t;
+typedef perf::TestBaseWithParam<MorphLarge_t> MorphLarge;
+
+PERF_TEST_P(MorphLarge, erode, testing::Combine(testing::Values(CV_8UC1, CV_32FC1),
+                                                MorphShapes::all(), testing::Values(31, 101)))
+{
+    int type = get<0>(GetParam()), shape = get<1>(GetParam()), ksize = get<2>(GetParam());
+
+    Mat src(sz1080p, type);
+    Mat dst(sz1080p, type);
+    Mat kernel = getStructuringElement(shape, Size(ksize, ksize));
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() cv::erode(src, dst, kernel);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
@@ -67,4 +67,63 @@ PERF_TEST_P( TestRemap, Remap,
     SANITY_CHECK(dst);
 }
 
+typedef TestBaseWithParam< tuple<MatType, InterType> > TestRemapRotate;
+
+PERF_TEST_P( TestRemapRotate, Remap_rotate,
+             Combine(
+                Values( CV_8UC1, CV_8UC2, CV_8UC3, CV_8UC4, CV_16UC1, CV_16UC3, CV_16SC1, CV_32FC1, CV_32FC2, CV_32FC3, CV_32FC4 ),
+                Values( (int)INTER_LINEAR, (int)INTER_CUBIC, (int)INTER_LANCZOS4 )
+             )
+)
+{
+    const Size sz = sz1080p;
+    int src_type = get<0>(GetParam()), inter_type = get<1>(GetParam());
+
+    Mat src(sz, src_type), dst(sz, src_type), map(sz, CV_32FC2);
+    const float c = std::cos(0.3f), s = std::sin(0.3f);
+    for (int j = 0; j < map.rows; ++j)
+        for (int i = 0; i < map.cols; ++i)
+        {
+            float x = i - sz.width*0.5f, y = j - sz.height*0.5f;
+            map.at<Vec2f>(j, i) = Vec2f(c*x - s*y + sz.width*0.5f, s*x + c*y + sz.height*0.5f);
+        }
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() remap(src, dst, map, noArray(), inter_type, BORDER_CONSTANT);
+
+    SANITY_CHECK_NOTHING();
+}
+
+typedef TestBaseWithParam< tuple<MatType, int> > TestRemapGrid;
+
+PERF_TEST_P( TestRemapGrid, RemapGrid,
+             Combine(
+                Values( CV_8UC1, CV_8UC3 ),
+                Values( 1, 16 )
+             )
+)
+{
+    // gridStep=1 is the dense map
+    const Size sz(3840, 2160);
+    int src_type = get<0>(GetParam()), gridStep = get<1>(GetParam());
+
+    Mat src(sz, src_type), dst(sz, src_type);
+    Mat grid((sz.height - 1)/gridStep + 2, (sz.width - 1)/gridStep + 2, CV_32FC2);
+    for (int j = 0; j < grid.rows; ++j)
+        for (int i = 0; i < grid.cols; ++i)
+        {
+            // barrel distortion
+            float x = (i*gridStep - sz.width*0.5f)/sz.width, y = (j*gridStep - sz.height*0.5f)/sz.width;
+            float k = 1 - 0.2f*(x*x + y*y);
+            grid.at<Vec2f>(j, i) = Vec2f(x*k*sz.width + sz.width*0.5f, y*k*sz.width + sz.height*0.5f);
+        }
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() remapGrid(src, dst, grid, sz, gridStep, INTER_LINEAR, BORDER_CONSTANT);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
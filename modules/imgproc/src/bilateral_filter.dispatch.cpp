@@ -426,4 +426,65 @@ void bilateralFilter( InputArray _src, OutputArray _dst, int d,
         "Bilateral filtering is only implemented for 8u and 32f images" );
 }
 
+void bilateralFilter( InputArray _src, OutputArray _dst, int d,
+                      double sigmaColor, double sigmaSpace,
+                      int borderType, int flags )
+{
+    if( flags == BILATERAL_FILTER_GRID )
+        jointBilateralFilter( _src, _src, _dst, sigmaColor, sigmaSpace );
+    else
+    {
+        CV_Assert( flags == BILATERAL_FILTER_EXACT );
+        bilateralFilter( _src, _dst, d, sigmaColor, sigmaSpace, borderType );
+    }
+}
+
+void jointBilateralFilter( InputArray _joint, InputArray _src, OutputArray _dst,
+                           double sigmaColor, double sigmaSpace )
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert( !_src.empty() && _joint.size() == _src.size() );
+    int type = _src.type(), depth = CV_MAT_DEPTH(type), cn = CV_MAT_CN(type);
+    int jtype = _joint.type(), jdepth = CV_MAT_DEPTH(jtype), jcn = CV_MAT_CN(jtype);
+    if( (depth != CV_8U && depth != CV_32F) || (cn != 1 && cn != 3) ||
+        (jdepth != CV_8U && jdepth != CV_32F) || (jcn != 1 && jcn != 3) )
+        CV_Error( CV_StsUnsupportedFormat,
+        "Bilateral filtering is only implemented for 8u and 32f images with 1 or 3 channels" );
+
+    if( sigmaColor <= 0 )
+        sigmaColor = 1;
+    if( sigmaSpace <= 0 )
+        sigmaSpace = 1;
+
+    // the guide image is 32FC1; it is read only at the position of the pixel being written, so it
+    // may share the data with dst
+    Mat joint = _joint.getMat(), guide;
+    if( jcn == 3 )
+    {
+        cvtColor( joint, guide, COLOR_BGR2GRAY );
+        if( jdepth != CV_32F )
+            guide.convertTo( guide, CV_32F );
+    }
+    else if( jdepth != CV_32F )
+        joint.convertTo( guide, CV_32F );
+    else
+        guide = joint;
+
+    double guideMin = 0, guideMax = 255;
+    if( jdepth == CV_32F )
+        minMaxLoc( guide, &guideMin, &guideMax );
+    // the grid is not finer than the image and has at most 256 cells in the guide values
+    sigmaSpace = std::max(sigmaSpace, 1.);
+    sigmaColor = std::max(sigmaColor, (guideMax - guideMin)/256);
+
+    Mat src = _src.getMat();
+    _dst.create( src.size(), src.type() );
+    Mat dst = _dst.getMat();
+
+    CV_CPU_DISPATCH(bilateralGridFilter, (src, guide, dst, (float)sigmaColor, (float)sigmaSpace,
+                                          (float)guideMin, (float)guideMax),
+        CV_CPU_DISPATCH_MODES_ALL);
+}
+
 } // namespace
@@ -58,6 +58,8 @@ void bilateralFilterInvoker_8u(
 void bilateralFilterInvoker_32f(
         int cn, int radius, int maxk, int *space_ofs,
         const Mat& temp, Mat& dst, float scale_index, float *space_weight, float *expLUT);
+void bilateralGridFilter(const Mat& src, const Mat& guide, Mat& dst,
+        float sigmaColor, float sigmaSpace, float guideMin, float guideMax);
 
 #ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
 
@@ -1035,6 +1037,273 @@ void bilateralFilterInvoker_32f(
     parallel_for_(Range(0, dst.rows), body, dst.total()/(double)(1<<16));
 }
 
+
+/*
+ Bilateral grid (J. Chen, S. Paris, F. Durand, Real-time edge-aware image processing with the
+ bilateral grid, 2007). Every cell of the grid holds the sums of the source channels and the count
+ of the pixels, 4 floats, so all the stages process a cell with a single v_float32x4.
+*/
+
+namespace {
+
+struct BilateralGrid
+{
+    int width, height, depth; // the grid size in x, y and the guide value
+    std::vector<int> xbin, ybin;
+    AutoBuffer<float> buf0, buf1;
+
+    float* row(float* buf, int gy) const { return buf + (size_t)gy*width*depth*4; }
+};
+
+class BilateralGridSplat_Invoker : public ParallelLoopBody
+{
+public:
+    BilateralGridSplat_Invoker(const Mat& _src, const Mat& _guide, BilateralGrid& _grid,
+                               const std::vector<int>& _rowStart, float _scale, float _guideMin)
+        : src(_src), guide(_guide), grid(_grid), rowStart(_rowStart), scale(_scale), guideMin(_guideMin)
+    {
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        int cn = src.channels(), depth = grid.depth;
+        float* buf = grid.buf0.data();
+        memset(grid.row(buf, range.start), 0, (size_t)(range.end - range.start)*grid.width*depth*4*sizeof(float));
+
+        // the rows of the image that are split into these rows of the grid
+        for( int y = rowStart[range.start]; y < rowStart[range.end]; y++ )
+        {
+            float* gridRow = grid.row(buf, grid.ybin[y]);
+            const float* g = guide.ptr<float>(y);
+            const uchar* s8 = src.ptr(y);
+            const float* s32 = src.ptr<float>(y);
+            for( int x = 0; x < src.cols; x++ )
+            {
+                int gz = std::min(std::max(cvRound((g[x] - guideMin)*scale), 0), depth - 1);
+                float* cell = gridRow + ((size_t)grid.xbin[x]*depth + gz)*4;
+                v_float32x4 v;
+                if( src.depth() == CV_8U )
+                    v = cn == 1 ? v_float32x4(s8[x], 1.f, 0.f, 0.f) :
+                                  v_float32x4(s8[x*3], s8[x*3 + 1], s8[x*3 + 2], 1.f);
+                else
+                    v = cn == 1 ? v_float32x4(s32[x], 1.f, 0.f, 0.f) :
+                                  v_float32x4(s32[x*3], s32[x*3 + 1], s32[x*3 + 2], 1.f);
+                v_store(cell, v_load(cell) + v);
+            }
+        }
+    }
+
+private:
+    const Mat& src;
+    const Mat& guide;
+    BilateralGrid& grid;
+    const std::vector<int>& rowStart;
+    float scale, guideMin;
+};
+
+// dst[i] = src[i-2] + 4*src[i-1] + 6*src[i] + 4*src[i+1] + src[i+2], i = start..end-1, where every
+// element is a block of bsize floats and the blocks out of the line of len blocks are zero
+static void bilateralGridBlurLine(const float* src, float* dst, int len, int bsize, int start, int end)
+{
+    for( int i = start; i < end; i++ )
+    {
+        const float* s2 = i >= 2 ? src + (size_t)(i - 2)*bsize : 0;
+        const float* s1 = i >= 1 ? src + (size_t)(i - 1)*bsize : 0;
+        const float* s0 = src + (size_t)i*bsize;
+        const float* t1 = i + 1 < len ? src + (size_t)(i + 1)*bsize : 0;
+        const float* t2 = i + 2 < len ? src + (size_t)(i + 2)*bsize : 0;
+        float* d = dst + (size_t)i*bsize;
+        int j = 0;
+#if CV_SIMD
+        v_float32 v4 = vx_setall_f32(4.f), v6 = vx_setall_f32(6.f);
+        for( ; j <= bsize - v_float32::nlanes; j += v_float32::nlanes )
+        {
+            v_float32 v = vx_load(s0 + j)*v6;
+            if( s1 ) v = v_fma(vx_load(s1 + j), v4, v);
+            if( t1 ) v = v_fma(vx_load(t1 + j), v4, v);
+            if( s2 ) v += vx_load(s2 + j);
+            if( t2 ) v += vx_load(t2 + j);
+            v_store(d + j, v);
+        }
+#endif
+        // bsize is a multiple of 4
+        for( ; j < bsize; j += 4 )
+        {
+            v_float32x4 v = v_load(s0 + j)*v_setall_f32(6.f);
+            if( s1 ) v = v_fma(v_load(s1 + j), v_setall_f32(4.f), v);
+            if( t1 ) v = v_fma(v_load(t1 + j), v_setall_f32(4.f), v);
+            if( s2 ) v += v_load(s2 + j);
+            if( t2 ) v += v_load(t2 + j);
+            v_store(d + j, v);
+        }
+    }
+}
+
+class BilateralGridBlur_Invoker : public ParallelLoopBody
+{
+public:
+    BilateralGridBlur_Invoker(BilateralGrid& _grid, bool _vertical) : grid(_grid), vertical(_vertical) {}
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        int width = grid.width, depth = grid.depth;
+        if( vertical )
+        {
+            // buf0 -> buf1 along y
+            bilateralGridBlurLine(grid.buf0.data(), grid.buf1.data(), grid.height, width*depth*4,
+                                  range.start, range.end);
+            return;
+        }
+
+        // buf0 -> buf1 along the guide value, then buf1 -> buf0 along x
+        for( int gy = range.start; gy < range.end; gy++ )
+        {
+            float* src = grid.row(grid.buf0.data(), gy);
+            float* tmp = grid.row(grid.buf1.data(), gy);
+            for( int gx = 0; gx < width; gx++ )
+                bilateralGridBlurLine(src + (size_t)gx*depth*4, tmp + (size_t)gx*depth*4, depth, 4, 0, depth);
+            bilateralGridBlurLine(tmp, src, width, depth*4, 0, width);
+        }
+    }
+
+private:
+    BilateralGrid& grid;
+    bool vertical;
+};
+
+class BilateralGridSlice_Invoker : public ParallelLoopBody
+{
+public:
+    BilateralGridSlice_Invoker(const Mat& _guide, Mat& _dst, const BilateralGrid& _grid,
+                               float _invSigmaSpace, float _scale, float _guideMin)
+        : guide(_guide), dst(_dst), grid(_grid), invSigmaSpace(_invSigmaSpace), scale(_scale), guideMin(_guideMin)
+    {
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        int cols = dst.cols, cn = dst.channels(), depth = grid.depth;
+        size_t xstep = (size_t)depth*4, ystep = (size_t)grid.width*xstep;
+        AutoBuffer<int> _xofs(cols);
+        AutoBuffer<float> _xalpha(cols);
+        int* xofs = _xofs.data();
+        float* xalpha = _xalpha.data();
+        for( int x = 0; x < cols; x++ )
+        {
+            float fx = x*invSigmaSpace;
+            int ix = std::min(cvFloor(fx), grid.width - 2);
+            xofs[x] = ix;
+            xalpha[x] = fx - ix;
+        }
+        const float* buf = grid.buf1.data();
+
+        for( int y = range.start; y < range.end; y++ )
+        {
+            float fy = y*invSigmaSpace;
+            int iy = std::min(cvFloor(fy), grid.height - 2);
+            v_float32x4 ay = v_setall_f32(fy - iy);
+            const float* gridRow = buf + iy*ystep;
+            const float* g = guide.ptr<float>(y);
+            uchar* d8 = dst.ptr(y);
+            float* d32 = dst.ptr<float>(y);
+
+            for( int x = 0; x < cols; x++ )
+            {
+                float fz = (g[x] - guideMin)*scale;
+                int iz = std::min(std::max(cvFloor(fz), 0), depth - 2);
+                v_float32x4 ax = v_setall_f32(xalpha[x]), az = v_setall_f32(fz - iz);
+                const float* c = gridRow + xofs[x]*xstep + iz*4;
+
+                v_float32x4 v00 = v_load(c);
+                v_float32x4 v0 = v_fma(v_load(c + 4) - v00, az, v00);
+                v_float32x4 v10 = v_load(c + xstep);
+                v_float32x4 v1 = v_fma(v_load(c + xstep + 4) - v10, az, v10);
+                v_float32x4 vy0 = v_fma(v1 - v0, ax, v0);
+                c += ystep;
+                v00 = v_load(c);
+                v0 = v_fma(v_load(c + 4) - v00, az, v00);
+                v10 = v_load(c + xstep);
+                v1 = v_fma(v_load(c + xstep + 4) - v10, az, v10);
+                v_float32x4 vy1 = v_fma(v1 - v0, ax, v0);
+                v_float32x4 v = v_fma(vy1 - vy0, ay, vy0);
+
+                float CV_DECL_ALIGNED(16) sum[4];
+                v_store_aligned(sum, v);
+                float w = cn == 1 ? sum[1] : sum[3];
+                // every pixel contributes to the cells around it, so w > 0
+                float iw = 1.f/std::max(w, FLT_MIN);
+                if( dst.depth() == CV_8U )
+                {
+                    if( cn == 1 )
+                        d8[x] = saturate_cast<uchar>(sum[0]*iw);
+                    else
+                    {
+                        d8[x*3] = saturate_cast<uchar>(sum[0]*iw);
+                        d8[x*3 + 1] = saturate_cast<uchar>(sum[1]*iw);
+                        d8[x*3 + 2] = saturate_cast<uchar>(sum[2]*iw);
+                    }
+                }
+                else
+                {
+                    if( cn == 1 )
+                        d32[x] = sum[0]*iw;
+                    else
+                    {
+                        d32[x*3] = sum[0]*iw;
+                        d32[x*3 + 1] = sum[1]*iw;
+                        d32[x*3 + 2] = sum[2]*iw;
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    const Mat& guide;
+    Mat& dst;
+    const BilateralGrid& grid;
+    float invSigmaSpace, scale, guideMin;
+};
+
+} // namespace anon
+
+void bilateralGridFilter(const Mat& src, const Mat& guide, Mat& dst,
+        float sigmaColor, float sigmaSpace, float guideMin, float guideMax)
+{
+    CV_INSTRUMENT_REGION();
+
+    // the cells are sigmaSpace x sigmaSpace x sigmaColor; the grid has a margin of 1 cell for the
+    // interpolation, the blur treats the cells out of the grid as empty
+    BilateralGrid grid;
+    float invSigmaSpace = 1.f/sigmaSpace, scale = 1.f/sigmaColor;
+    grid.width = cvFloor((src.cols - 1)*invSigmaSpace) + 2;
+    grid.height = cvFloor((src.rows - 1)*invSigmaSpace) + 2;
+    grid.depth = cvFloor((guideMax - guideMin)*scale) + 2;
+    size_t gridSize = (size_t)grid.width*grid.height*grid.depth*4;
+    grid.buf0.allocate(gridSize);
+    grid.buf1.allocate(gridSize);
+
+    grid.xbin.resize(src.cols);
+    for( int x = 0; x < src.cols; x++ )
+        grid.xbin[x] = cvRound(x*invSigmaSpace);
+    grid.ybin.resize(src.rows);
+    std::vector<int> rowStart(grid.height + 1, src.rows);
+    for( int y = src.rows - 1; y >= 0; y-- )
+    {
+        grid.ybin[y] = cvRound(y*invSigmaSpace);
+        rowStart[grid.ybin[y]] = y;
+    }
+    for( int gy = grid.height - 1; gy >= 0; gy-- )
+        rowStart[gy] = std::min(rowStart[gy], rowStart[gy + 1]);
+
+    Range rows(0, grid.height);
+    parallel_for_(rows, BilateralGridSplat_Invoker(src, guide, grid, rowStart, scale, guideMin));
+    parallel_for_(rows, BilateralGridBlur_Invoker(grid, false));
+    parallel_for_(rows, BilateralGridBlur_Invoker(grid, true));
+    parallel_for_(Range(0, src.rows), BilateralGridSlice_Invoker(guide, dst, grid, invSigmaSpace, scale, guideMin),
+                  dst.total()/(double)(1<<16));
+}
+
 #endif
 CV_CPU_OPTIMIZATION_NAMESPACE_END
 } // namespace
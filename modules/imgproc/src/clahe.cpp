@@ -122,14 +122,18 @@ namespace
     class CLAHE_CalcLut_Body : public cv::ParallelLoopBody
     {
     public:
-        CLAHE_CalcLut_Body(const cv::Mat& src, const cv::Mat& lut, const cv::Size& tileSize, const int& tilesX, const int& clipLimit, const float& lutScale) :
-            src_(src), lut_(lut), tileSize_(tileSize), tilesX_(tilesX), clipLimit_(clipLimit), lutScale_(lutScale)
+        CLAHE_CalcLut_Body(const cv::Mat& src, const cv::Mat& lut, const cv::Size& tileSize, const int& tilesX, const int& clipLimit, const float& lutScale,
+                           const cv::Mat& hist = cv::Mat(), float alpha = 0.f) :
+            src_(src), lut_(lut), tileSize_(tileSize), tilesX_(tilesX), clipLimit_(clipLimit), lutScale_(lutScale), hist_(hist), alpha_(alpha)
         {
         }
 
         void operator ()(const cv::Range& range) const CV_OVERRIDE;
 
     private:
+        void calcLut(int* tileHist, T* tileLut) const;
+        void calcLut(const float* tileHist, T* tileLut) const;
+
         cv::Mat src_;
         mutable cv::Mat lut_;
 
@@ -137,14 +141,22 @@ namespace
         int tilesX_;
         int clipLimit_;
         float lutScale_;
+
+        // temporal mode: the smoothed histograms of the tiles, one row per tile
+        mutable cv::Mat hist_;
+        float alpha_;
     };
 
     template <class T, int histSize, int shift>
     void CLAHE_CalcLut_Body<T,histSize,shift>::operator ()(const cv::Range& range) const
     {
+        const int cn = src_.channels();
         T* tileLut = lut_.ptr<T>(range.start);
         const size_t lut_step = lut_.step / sizeof(T);
 
+        cv::AutoBuffer<int> _tileHist(histSize * cn);
+        int* tileHist = _tileHist.data();
+
         for (int k = range.start; k < range.end; ++k, tileLut += lut_step)
         {
             const int ty = k / tilesX_;
@@ -160,68 +172,140 @@ namespace
 
             const cv::Mat tile = src_(tileROI);
 
-            // calc histogram
+            // calc histogram, the channels are interleaved in the source and stored one after another in tileHist
 
-            cv::AutoBuffer<int> _tileHist(histSize);
-            int* tileHist = _tileHist.data();
-            std::fill(tileHist, tileHist + histSize, 0);
+            std::fill(tileHist, tileHist + histSize * cn, 0);
 
             int height = tileROI.height;
             const size_t sstep = src_.step / sizeof(T);
             for (const T* ptr = tile.ptr<T>(0); height--; ptr += sstep)
             {
-                int x = 0;
-                for (; x <= tileROI.width - 4; x += 4)
+                if (cn == 1)
                 {
-                    int t0 = ptr[x], t1 = ptr[x+1];
-                    tileHist[t0 >> shift]++; tileHist[t1 >> shift]++;
-                    t0 = ptr[x+2]; t1 = ptr[x+3];
-                    tileHist[t0 >> shift]++; tileHist[t1 >> shift]++;
-                }
+                    int x = 0;
+                    for (; x <= tileROI.width - 4; x += 4)
+                    {
+                        int t0 = ptr[x], t1 = ptr[x+1];
+                        tileHist[t0 >> shift]++; tileHist[t1 >> shift]++;
+                        t0 = ptr[x+2]; t1 = ptr[x+3];
+                        tileHist[t0 >> shift]++; tileHist[t1 >> shift]++;
+                    }
 
-                for (; x < tileROI.width; ++x)
-                    tileHist[ptr[x] >> shift]++;
+                    for (; x < tileROI.width; ++x)
+                        tileHist[ptr[x] >> shift]++;
+                }
+                else
+                {
+                    for (int x = 0; x < tileROI.width * cn; x += cn)
+                        for (int c = 0; c < cn; ++c)
+                            tileHist[c * histSize + (ptr[x + c] >> shift)]++;
+                }
             }
 
-            // clip histogram
-
-            if (clipLimit_ > 0)
+            for (int c = 0; c < cn; ++c)
             {
-                // how many pixels were clipped
-                int clipped = 0;
-                for (int i = 0; i < histSize; ++i)
+                if (hist_.empty())
                 {
-                    if (tileHist[i] > clipLimit_)
-                    {
-                        clipped += tileHist[i] - clipLimit_;
-                        tileHist[i] = clipLimit_;
-                    }
+                    calcLut(tileHist + c * histSize, tileLut + c * histSize);
+                    continue;
                 }
 
-                // redistribute clipped pixels
-                int redistBatch = clipped / histSize;
-                int residual = clipped - redistBatch * histSize;
+                // blend the histogram of the frame into the smoothed one, the state is
+                // initialized with the first frame (alpha_ < 0)
+                float* smoothed = hist_.ptr<float>(k) + c * histSize;
+                const int* h = tileHist + c * histSize;
+                if (alpha_ < 0)
+                {
+                    for (int i = 0; i < histSize; ++i)
+                        smoothed[i] = (float)h[i];
+                }
+                else
+                {
+                    const float beta = 1.f - alpha_;
+                    for (int i = 0; i < histSize; ++i)
+                        smoothed[i] = smoothed[i] * alpha_ + h[i] * beta;
+                }
+                calcLut(smoothed, tileLut + c * histSize);
+            }
+        }
+    }
 
-                for (int i = 0; i < histSize; ++i)
-                    tileHist[i] += redistBatch;
+    template <class T, int histSize, int shift>
+    void CLAHE_CalcLut_Body<T,histSize,shift>::calcLut(int* tileHist, T* tileLut) const
+    {
+        // clip histogram
 
-                if (residual != 0)
+        if (clipLimit_ > 0)
+        {
+            // how many pixels were clipped
+            int clipped = 0;
+            for (int i = 0; i < histSize; ++i)
+            {
+                if (tileHist[i] > clipLimit_)
                 {
-                    int residualStep = MAX(histSize / residual, 1);
-                    for (int i = 0; i < histSize && residual > 0; i += residualStep, residual--)
-                        tileHist[i]++;
+                    clipped += tileHist[i] - clipLimit_;
+                    tileHist[i] = clipLimit_;
                 }
             }
 
-            // calc Lut
+            // redistribute clipped pixels
+            int redistBatch = clipped / histSize;
+            int residual = clipped - redistBatch * histSize;
 
-            int sum = 0;
             for (int i = 0; i < histSize; ++i)
+                tileHist[i] += redistBatch;
+
+            if (residual != 0)
             {
-                sum += tileHist[i];
-                tileLut[i] = cv::saturate_cast<T>(sum * lutScale_);
+                int residualStep = MAX(histSize / residual, 1);
+                for (int i = 0; i < histSize && residual > 0; i += residualStep, residual--)
+                    tileHist[i]++;
             }
         }
+
+        // calc Lut
+
+        int sum = 0;
+        for (int i = 0; i < histSize; ++i)
+        {
+            sum += tileHist[i];
+            tileLut[i] = cv::saturate_cast<T>(sum * lutScale_);
+        }
+    }
+
+    template <class T, int histSize, int shift>
+    void CLAHE_CalcLut_Body<T,histSize,shift>::calcLut(const float* tileHist, T* tileLut) const
+    {
+        // the same redistribution as for the integer histograms, plus the fractional part of the
+        // clipped pixels spread evenly, so the first frame of the sequence gets the regular Lut
+        const float clipLimit = clipLimit_ > 0 ? (float)clipLimit_ : FLT_MAX;
+        float redistBatch = 0.f;
+        int residual = 0, residualStep = 1;
+        if (clipLimit_ > 0)
+        {
+            float clipped = 0.f;
+            for (int i = 0; i < histSize; ++i)
+                clipped += std::max(tileHist[i] - clipLimit, 0.f);
+
+            float batch = std::floor(clipped / histSize);
+            float rest = clipped - batch * histSize;
+            residual = cvFloor(rest);
+            redistBatch = batch + (rest - residual) / histSize;
+            if (residual > 0)
+                residualStep = MAX(histSize / residual, 1);
+        }
+
+        float sum = 0.f;
+        for (int i = 0; i < histSize; ++i)
+        {
+            sum += std::min(tileHist[i], clipLimit) + redistBatch;
+            if (residual > 0 && i % residualStep == 0)
+            {
+                sum += 1.f;
+                residual--;
+            }
+            tileLut[i] = cv::saturate_cast<T>(sum * lutScale_);
+        }
     }
 
     template <class T, int shift>
@@ -229,7 +313,8 @@ namespace
     {
     public:
         CLAHE_Interpolation_Body(const cv::Mat& src, const cv::Mat& dst, const cv::Mat& lut, const cv::Size& tileSize, const int& tilesX, const int& tilesY) :
-            src_(src), dst_(dst), lut_(lut), tileSize_(tileSize), tilesX_(tilesX), tilesY_(tilesY)
+            src_(src), dst_(dst), lut_(lut), tileSize_(tileSize), tilesX_(tilesX), tilesY_(tilesY),
+            cn_(src.channels()), histSize_(lut.cols / src.channels())
         {
             buf.allocate(src.cols << 2);
             ind1_p = buf.data();
@@ -268,6 +353,8 @@ namespace
         cv::Size tileSize_;
         int tilesX_;
         int tilesY_;
+        int cn_;
+        int histSize_;
 
         cv::AutoBuffer<int> buf;
         int * ind1_p, * ind2_p;
@@ -297,17 +384,39 @@ namespace
             const T* lutPlane1 = lut_.ptr<T>(ty1 * tilesX_);
             const T* lutPlane2 = lut_.ptr<T>(ty2 * tilesX_);
 
-            for (int x = 0; x < src_.cols; ++x)
+            if (cn_ == 1)
+            {
+                for (int x = 0; x < src_.cols; ++x)
+                {
+                    int srcVal = srcRow[x] >> shift;
+
+                    int ind1 = ind1_p[x] + srcVal;
+                    int ind2 = ind2_p[x] + srcVal;
+
+                    float res = (lutPlane1[ind1] * xa1_p[x] + lutPlane1[ind2] * xa_p[x]) * ya1 +
+                                (lutPlane2[ind1] * xa1_p[x] + lutPlane2[ind2] * xa_p[x]) * ya;
+
+                    dstRow[x] = cv::saturate_cast<T>(res) << shift;
+                }
+                continue;
+            }
+
+            // the Lut of the channel c starts at c * histSize_ in the row of the tile
+            for (int x = 0; x < src_.cols; ++x, srcRow += cn_, dstRow += cn_)
             {
-                int srcVal = srcRow[x] >> shift;
+                float xa = xa_p[x], xa1 = xa1_p[x];
+                for (int c = 0; c < cn_; ++c)
+                {
+                    int srcVal = (srcRow[c] >> shift) + c * histSize_;
 
-                int ind1 = ind1_p[x] + srcVal;
-                int ind2 = ind2_p[x] + srcVal;
+                    int ind1 = ind1_p[x] + srcVal;
+                    int ind2 = ind2_p[x] + srcVal;
 
-                float res = (lutPlane1[ind1] * xa1_p[x] + lutPlane1[ind2] * xa_p[x]) * ya1 +
-                            (lutPlane2[ind1] * xa1_p[x] + lutPlane2[ind2] * xa_p[x]) * ya;
+                    float res = (lutPlane1[ind1] * xa1 + lutPlane1[ind2] * xa) * ya1 +
+                                (lutPlane2[ind1] * xa1 + lutPlane2[ind2] * xa) * ya;
 
-                dstRow[x] = cv::saturate_cast<T>(res) << shift;
+                    dstRow[c] = cv::saturate_cast<T>(res) << shift;
+                }
             }
         }
     }
@@ -325,16 +434,25 @@ namespace
         void setTilesGridSize(cv::Size tileGridSize) CV_OVERRIDE;
         cv::Size getTilesGridSize() const CV_OVERRIDE;
 
+        void setTemporalSmoothing(double alpha) CV_OVERRIDE;
+        double getTemporalSmoothing() const CV_OVERRIDE;
+
         void collectGarbage() CV_OVERRIDE;
 
     private:
         double clipLimit_;
         int tilesX_;
         int tilesY_;
+        double alpha_;
 
         cv::Mat srcExt_;
         cv::Mat lut_;
 
+        // temporal mode state, valid for the frames of histType_ split into the tiles of histTileSize_
+        cv::Mat hist_;
+        int histType_;
+        cv::Size histTileSize_;
+
 #ifdef HAVE_OPENCL
         cv::UMat usrcExt_;
         cv::UMat ulut_;
@@ -342,7 +460,7 @@ namespace
     };
 
     CLAHE_Impl::CLAHE_Impl(double clipLimit, int tilesX, int tilesY) :
-        clipLimit_(clipLimit), tilesX_(tilesX), tilesY_(tilesY)
+        clipLimit_(clipLimit), tilesX_(tilesX), tilesY_(tilesY), alpha_(0.0), histType_(-1)
     {
     }
 
@@ -350,13 +468,14 @@ namespace
     {
         CV_INSTRUMENT_REGION();
 
-        CV_Assert( _src.type() == CV_8UC1 || _src.type() == CV_16UC1 );
+        const int type = _src.type(), depth = CV_MAT_DEPTH(type), cn = CV_MAT_CN(type);
+        CV_Assert( (depth == CV_8U || depth == CV_16U) && cn <= 4 );
 
 #ifdef HAVE_OPENCL
-        bool useOpenCL = cv::ocl::isOpenCLActivated() && _src.isUMat() && _src.dims()<=2 && _src.type() == CV_8UC1;
+        bool useOpenCL = cv::ocl::isOpenCLActivated() && _src.isUMat() && _src.dims()<=2 && type == CV_8UC1 && alpha_ == 0.0;
 #endif
 
-        int histSize = _src.type() == CV_8UC1 ? 256 : 65536;
+        int histSize = depth == CV_8U ? 256 : 65536;
 
         cv::Size tileSize;
         cv::_InputArray _srcForLut;
@@ -407,22 +526,39 @@ namespace
         _dst.create( src.size(), src.type() );
         cv::Mat dst = _dst.getMat();
         cv::Mat srcForLut = _srcForLut.getMat();
-        lut_.create(tilesX_ * tilesY_, histSize, _src.type());
+        lut_.create(tilesX_ * tilesY_, histSize * cn, depth);
+
+        // the smoothed histograms are kept between the frames of the same type and tiling,
+        // the first frame (or the one that does not match) starts the sequence anew
+        float alpha = 0.f;
+        if (alpha_ > 0.0)
+        {
+            alpha = static_cast<float>(alpha_);
+            if (hist_.rows != tilesX_ * tilesY_ || histType_ != type || histTileSize_ != tileSize)
+            {
+                hist_.create(tilesX_ * tilesY_, histSize * cn, CV_32F);
+                histType_ = type;
+                histTileSize_ = tileSize;
+                alpha = -1.f;
+            }
+        }
+        else
+            hist_.release();
 
         cv::Ptr<cv::ParallelLoopBody> calcLutBody;
-        if (_src.type() == CV_8UC1)
-            calcLutBody = cv::makePtr<CLAHE_CalcLut_Body<uchar, 256, 0> >(srcForLut, lut_, tileSize, tilesX_, clipLimit, lutScale);
-        else if (_src.type() == CV_16UC1)
-            calcLutBody = cv::makePtr<CLAHE_CalcLut_Body<ushort, 65536, 0> >(srcForLut, lut_, tileSize, tilesX_, clipLimit, lutScale);
+        if (depth == CV_8U)
+            calcLutBody = cv::makePtr<CLAHE_CalcLut_Body<uchar, 256, 0> >(srcForLut, lut_, tileSize, tilesX_, clipLimit, lutScale, hist_, alpha);
+        else if (depth == CV_16U)
+            calcLutBody = cv::makePtr<CLAHE_CalcLut_Body<ushort, 65536, 0> >(srcForLut, lut_, tileSize, tilesX_, clipLimit, lutScale, hist_, alpha);
         else
             CV_Error( CV_StsBadArg, "Unsupported type" );
 
         cv::parallel_for_(cv::Range(0, tilesX_ * tilesY_), *calcLutBody);
 
         cv::Ptr<cv::ParallelLoopBody> interpolationBody;
-        if (_src.type() == CV_8UC1)
+        if (depth == CV_8U)
             interpolationBody = cv::makePtr<CLAHE_Interpolation_Body<uchar, 0> >(src, dst, lut_, tileSize, tilesX_, tilesY_);
-        else if (_src.type() == CV_16UC1)
+        else if (depth == CV_16U)
             interpolationBody = cv::makePtr<CLAHE_Interpolation_Body<ushort, 0> >(src, dst, lut_, tileSize, tilesX_, tilesY_);
 
         cv::parallel_for_(cv::Range(0, src.rows), *interpolationBody);
@@ -449,10 +585,22 @@ namespace
         return cv::Size(tilesX_, tilesY_);
     }
 
+    void CLAHE_Impl::setTemporalSmoothing(double alpha)
+    {
+        CV_Assert( 0.0 <= alpha && alpha < 1.0 );
+        alpha_ = alpha;
+    }
+
+    double CLAHE_Impl::getTemporalSmoothing() const
+    {
+        return alpha_;
+    }
+
     void CLAHE_Impl::collectGarbage()
     {
         srcExt_.release();
         lut_.release();
+        hist_.release();
 #ifdef HAVE_OPENCL
         usrcExt_.release();
         ulut_.release();
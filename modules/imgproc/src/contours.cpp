@@ -40,6 +40,7 @@
 //M*/
 #include "precomp.hpp"
 #include "opencv2/core/hal/intrin.hpp"
+#include "opencv2/core/utils/configuration.private.hpp"
 
 using namespace cv;
 
@@ -1790,6 +1791,530 @@ cvFindContours( void*  img,  CvMemStorage*  storage,
     return cvFindContours_Impl(img, storage, firstContour, cntHeaderSize, mode, method, offset, 1);
 }
 
+/****************************************************************************************\
+*                   Parallel retrieving of the contours via run-length labeling          *
+\****************************************************************************************/
+
+/*
+   Every contour found by the Suzuki algorithm is either the outer border of an 8-connected
+   component of the nonzero pixels or the hole border of a bounded 4-connected component of
+   the zero pixels (the one surrounding the hole is the owner of the border). The border
+   depends on the pixels of its own component only, so the components can be traced
+   independently, and the hierarchy and the order of the contours follow from the
+   components: the contour is discovered by the raster scan at the first pixel of its
+   component (the outer border) or of its zero region (the hole border), the parent of the
+   outer border is the hole border of the zero region to the left of the first pixel, the
+   parent of the hole border is the outer border of its owner.
+
+   So the image is converted to the runs of the nonzero pixels in parallel horizontal bands,
+   the runs and the gaps between them are labeled with union-find inside the bands and then
+   stitched over the band boundaries, and the components are traced in parallel batches,
+   each one by the regular scanner in a small image with the runs of the batch only. The
+   result is identical to the sequential one, and the full-size copy of the image is not
+   needed.
+*/
+
+namespace cv {
+
+struct ContourRun
+{
+    int x0, x1; // [x0, x1)
+    ContourRun() : x0(0), x1(0) {}
+    ContourRun(int _x0, int _x1) : x0(_x0), x1(_x1) {}
+};
+
+static void findRowRuns(const uchar* row, int width, std::vector<ContourRun>& runs)
+{
+    const uint64 lsb = 0x0101010101010101ULL, msb = 0x8080808080808080ULL;
+    int x = 0;
+    for(;;)
+    {
+        uint64 v;
+        for( ; x <= width - 8; x += 8 )
+        {
+            memcpy(&v, row + x, sizeof(v));
+            if( v != 0 )
+                break;
+        }
+        for( ; x < width && row[x] == 0; x++ )
+            ;
+        if( x >= width )
+            break;
+        int x0 = x;
+        for( ; x <= width - 8; x += 8 )
+        {
+            memcpy(&v, row + x, sizeof(v));
+            if( ((v - lsb) & ~v & msb) != 0 ) // has a zero byte
+                break;
+        }
+        for( ; x < width && row[x] != 0; x++ )
+            ;
+        runs.push_back(ContourRun(x0, x));
+    }
+}
+
+static inline int findRunRoot(int* parent, int i)
+{
+    while( parent[i] != i )
+    {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+// the smaller index becomes the root, so the root of a set is its first element in the raster order
+static inline void uniteRuns(int* parent, int a, int b)
+{
+    a = findRunRoot(parent, a);
+    b = findRunRoot(parent, b);
+    if( a < b )
+        parent[b] = a;
+    else if( b < a )
+        parent[a] = b;
+}
+
+class ContourRunImage
+{
+public:
+    int width, height;
+    std::vector<ContourRun> runs;
+    std::vector<int> rowStart;  // height + 1 elements
+    // the gap k of the row y is the zero interval before the k-th run of the row (or after the last one)
+    std::vector<int> runParent, gapParent;
+
+    int gapIndex(int y, int k) const { return rowStart[y] + y + k; }
+
+    ContourRun gap(int y, int k) const
+    {
+        int r0 = rowStart[y], n = rowStart[y + 1] - r0;
+        return ContourRun(k > 0 ? runs[r0 + k - 1].x1 : 0, k < n ? runs[r0 + k].x0 : width);
+    }
+
+    void create(const Mat& img);
+
+    // connects the runs and the gaps of the row y with the ones of the row y - 1
+    void connectRows(int y)
+    {
+        const ContourRun* a = &runs[0] + rowStart[y - 1];
+        const ContourRun* b = &runs[0] + rowStart[y];
+        int na = rowStart[y] - rowStart[y - 1], nb = rowStart[y + 1] - rowStart[y];
+        int* rp = &runParent[0];
+        // the nonzero pixels are 8-connected
+        for( int i = 0, j = 0; i < na && j < nb; )
+        {
+            if( a[i].x0 <= b[j].x1 && b[j].x0 <= a[i].x1 )
+                uniteRuns(rp, rowStart[y - 1] + i, rowStart[y] + j);
+            if( a[i].x1 < b[j].x1 )
+                i++;
+            else
+                j++;
+        }
+        // the zero pixels are 4-connected
+        int* gp = &gapParent[0];
+        for( int i = 0, j = 0; i <= na && j <= nb; )
+        {
+            ContourRun ga = gap(y - 1, i), gb = gap(y, j);
+            if( ga.x0 < gb.x1 && gb.x0 < ga.x1 && ga.x0 < ga.x1 && gb.x0 < gb.x1 )
+                uniteRuns(gp, gapIndex(y - 1, i), gapIndex(y, j));
+            if( ga.x1 < gb.x1 )
+                i++;
+            else
+                j++;
+        }
+    }
+};
+
+void ContourRunImage::create(const Mat& img)
+{
+    width = img.cols;
+    height = img.rows;
+    int nbands = std::max(std::min(getNumThreads()*4, height/16), 1);
+    std::vector< std::vector<ContourRun> > bandRuns(nbands);
+    rowStart.assign(height + 1, 0);
+
+    parallel_for_(Range(0, nbands), [&](const Range& r) {
+        for( int band = r.start; band < r.end; band++ )
+        {
+            int y0 = height*band/nbands, y1 = height*(band + 1)/nbands;
+            std::vector<ContourRun>& br = bandRuns[band];
+            for( int y = y0; y < y1; y++ )
+            {
+                size_t n0 = br.size();
+                findRowRuns(img.ptr<uchar>(y), width, br);
+                rowStart[y + 1] = (int)(br.size() - n0);
+            }
+        }
+    }, nbands);
+
+    for( int y = 0; y < height; y++ )
+        rowStart[y + 1] += rowStart[y];
+    runs.resize(rowStart[height]);
+    runParent.resize(runs.size());
+    gapParent.resize(runs.size() + height);
+
+    // the labeling inside the bands
+    parallel_for_(Range(0, nbands), [&](const Range& r) {
+        for( int band = r.start; band < r.end; band++ )
+        {
+            int y0 = height*band/nbands, y1 = height*(band + 1)/nbands;
+            if( !bandRuns[band].empty() )
+                memcpy(&runs[rowStart[y0]], &bandRuns[band][0], bandRuns[band].size()*sizeof(runs[0]));
+            std::vector<ContourRun>().swap(bandRuns[band]);
+            for( int i = rowStart[y0]; i < rowStart[y1]; i++ )
+                runParent[i] = i;
+            for( int i = gapIndex(y0, 0); i < gapIndex(y1, 0); i++ )
+                gapParent[i] = i;
+            for( int y = y0 + 1; y < y1; y++ )
+                connectRows(y);
+        }
+    }, nbands);
+
+    // the stitching over the band boundaries
+    for( int band = 1; band < nbands; band++ )
+        connectRows(height*band/nbands);
+}
+
+// a contour in the order of the discovery by the raster scan
+struct ContourNode
+{
+    int64 key;      // y*width + x of the first pixel of the component or the zero region
+    int owner;      // the component
+    int parent;     // -1 for the frame
+    int firstChild, next, prev;
+    int index;      // in the output
+};
+
+static void traceContourBatch(const ContourRunImage& rimg, const std::vector<int>& compRuns,
+                              const std::vector<int>& compRunStart, const std::vector<Rect>& compRect,
+                              int c0, int c1, const std::vector< std::pair<int64, int> >& keys,
+                              int method, Point offset, const std::vector<char>& included,
+                              std::vector< std::vector<Point> >& points)
+{
+    Rect roi = compRect[c0];
+    for( int c = c0 + 1; c < c1; c++ )
+        roi |= compRect[c];
+
+    // the runs of the batch with the zero border
+    Mat img = Mat::zeros(roi.height + 2, roi.width + 2, CV_8UC1);
+    for( int i = compRunStart[c0]; i < compRunStart[c1]; i++ )
+    {
+        int r = compRuns[i];
+        int y = (int)(std::upper_bound(rimg.rowStart.begin(), rimg.rowStart.end(), r) - rimg.rowStart.begin()) - 1;
+        const ContourRun& run = rimg.runs[r];
+        memset(img.ptr<uchar>(y - roi.y + 1) + run.x0 - roi.x + 1, 1, run.x1 - run.x0);
+    }
+
+    MemStorage storage(cvCreateMemStorage());
+    CvMat cimg = cvMat(img);
+    Point scanOffset = roi.tl() - Point(1, 1);
+    CvContourScanner scanner = cvStartFindContours_Impl(&cimg, storage, sizeof(CvContour), CV_RETR_LIST,
+                                                        method, cvPoint(scanOffset + offset), 0);
+    try
+    {
+        for( size_t k = 0; k < keys.size(); k++ )
+        {
+            CvSeq* seq = cvFindNextContour(scanner);
+            CV_Assert( seq );
+            const _CvContourInfo* info = scanner->l_cinfo;
+            int64 key = (int64)(info->origin.y + scanOffset.y)*rimg.width + info->origin.x + scanOffset.x + info->is_hole;
+            CV_Assert( key == keys[k].first );
+            int id = keys[k].second;
+            if( included[id] )
+            {
+                points[id].resize(seq->total);
+                if( seq->total > 0 )
+                    cvCvtSeqToArray(seq, &points[id][0]);
+            }
+        }
+    }
+    catch(...)
+    {
+        cvEndFindContours(&scanner);
+        throw;
+    }
+    cvEndFindContours(&scanner);
+}
+
+// returns false if the result can differ from the sequential one, the output is not modified then
+static bool findContoursParallel(const Mat& image, OutputArrayOfArrays _contours, OutputArray _hierarchy,
+                                 int mode, int method, Point offset)
+{
+    CV_INSTRUMENT_REGION();
+
+    ContourRunImage rimg;
+    rimg.create(image);
+    const int width = rimg.width, height = rimg.height;
+    const int nruns = (int)rimg.runs.size(), ngaps = (int)rimg.gapParent.size();
+    int* rp = &rimg.runParent[0];
+    int* gp = &rimg.gapParent[0];
+
+    // the components of the nonzero pixels, in the order of their first pixels
+    std::vector<int> runLabel(nruns), compFirst;
+    std::vector<Rect> compRect;
+    for( int y = 0; y < height; y++ )
+        for( int i = rimg.rowStart[y]; i < rimg.rowStart[y + 1]; i++ )
+        {
+            const ContourRun& run = rimg.runs[i];
+            int p = rp[i];
+            if( p == i )
+            {
+                runLabel[i] = (int)compFirst.size();
+                compFirst.push_back(i);
+                compRect.push_back(Rect(run.x0, y, run.x1 - run.x0, 1));
+            }
+            else
+            {
+                rp[i] = p = rp[p]; // the parent is processed already, so rp[p] is the root
+                int c = runLabel[i] = runLabel[p];
+                Rect& r = compRect[c];
+                int x0 = std::min(r.x, run.x0), x1 = std::max(r.x + r.width, run.x1);
+                r.x = x0;
+                r.width = x1 - x0;
+                r.height = y - r.y + 1;
+            }
+        }
+    const int ncomps = (int)compFirst.size();
+    if( ncomps == 0 )
+    {
+        _contours.clear();
+        return true;
+    }
+
+    // the zero regions; the ones touching the image border are the frame
+    std::vector<int> gapLabel(ngaps, -1), regionFirstY, regionFirstK;
+    std::vector<char> regionIsFrame;
+    for( int y = 0; y < height; y++ )
+    {
+        int n = rimg.rowStart[y + 1] - rimg.rowStart[y];
+        for( int k = 0; k <= n; k++ )
+        {
+            ContourRun g = rimg.gap(y, k);
+            if( g.x0 >= g.x1 )
+                continue;
+            int i = rimg.gapIndex(y, k), p = gp[i], reg;
+            if( p == i )
+            {
+                reg = gapLabel[i] = (int)regionFirstY.size();
+                regionFirstY.push_back(y);
+                regionFirstK.push_back(k);
+                regionIsFrame.push_back(0);
+            }
+            else
+            {
+                gp[i] = p = gp[p];
+                reg = gapLabel[i] = gapLabel[p];
+            }
+            if( y == 0 || y == height - 1 || g.x0 == 0 || g.x1 == width )
+                regionIsFrame[reg] = 1;
+        }
+    }
+
+    // the contours in the discovery order: the outer borders and the hole borders are merged by the first pixels
+    const int nregions = (int)regionFirstY.size();
+    std::vector<ContourNode> nodes;
+    std::vector<int> outerNode(ncomps), holeNode(nregions, -1);
+    nodes.reserve(ncomps + nregions);
+    for( int c = 0, reg = 0; c < ncomps || reg < nregions; )
+    {
+        for( ; reg < nregions && regionIsFrame[reg]; reg++ )
+            ;
+        int64 ckey = std::numeric_limits<int64>::max(), rkey = std::numeric_limits<int64>::max();
+        if( c < ncomps )
+        {
+            int r = compFirst[c];
+            ckey = (int64)compRect[c].y*width + rimg.runs[r].x0;
+        }
+        if( reg < nregions )
+            rkey = (int64)regionFirstY[reg]*width + rimg.gap(regionFirstY[reg], regionFirstK[reg]).x0;
+        if( ckey == std::numeric_limits<int64>::max() && rkey == std::numeric_limits<int64>::max() )
+            break;
+        ContourNode node;
+        node.parent = node.firstChild = node.next = node.prev = node.index = -1;
+        if( ckey < rkey )
+        {
+            node.key = ckey;
+            node.owner = c;
+            outerNode[c++] = (int)nodes.size();
+        }
+        else
+        {
+            int y = regionFirstY[reg], k = regionFirstK[reg];
+            node.key = rkey;
+            node.owner = runLabel[rimg.rowStart[y] + k - 1]; // the run to the left of the region
+            holeNode[reg++] = (int)nodes.size();
+        }
+        nodes.push_back(node);
+    }
+    const int nnodes = (int)nodes.size();
+    // the sequential scanner marks the borders with 7-bit labels; when they wrap around, the parents of
+    // RETR_TREE are looked up among the borders with the same label and may be chosen differently
+    if( mode == RETR_TREE && nnodes > 126 )
+        return false;
+
+    // the hierarchy
+    std::vector<char> included(nnodes, 1);
+    for( int c = 0; c < ncomps; c++ )
+    {
+        int first = compFirst[c], y = compRect[c].y;
+        int k = first - rimg.rowStart[y];
+        int reg = gapLabel[rimg.gapIndex(y, k)];
+        int outer = outerNode[c];
+        if( reg >= 0 && !regionIsFrame[reg] && (mode == RETR_TREE || mode == RETR_EXTERNAL) )
+            nodes[outer].parent = holeNode[reg];
+    }
+    for( int reg = 0; reg < nregions; reg++ )
+    {
+        int hole = holeNode[reg];
+        if( hole < 0 )
+            continue;
+        if( mode == RETR_EXTERNAL )
+            included[hole] = 0;
+        else if( mode == RETR_CCOMP || mode == RETR_TREE )
+            nodes[hole].parent = outerNode[nodes[hole].owner];
+    }
+    if( mode == RETR_EXTERNAL )
+        for( int i = 0; i < nnodes; i++ )
+            if( included[i] )
+            {
+                included[i] = nodes[i].parent < 0;
+                nodes[i].parent = -1;
+            }
+
+    // the children are inserted at the head of the list, as cvInsertNodeIntoTree does
+    int firstRoot = -1;
+    for( int i = 0; i < nnodes; i++ )
+    {
+        if( !included[i] )
+            continue;
+        int& head = nodes[i].parent >= 0 ? nodes[nodes[i].parent].firstChild : firstRoot;
+        nodes[i].next = head;
+        if( head >= 0 )
+            nodes[head].prev = i;
+        head = i;
+    }
+
+    // the contours of the components, traced in the batches of the nearby components
+    std::vector<int> compRunStart(ncomps + 1, 0), compRuns(nruns);
+    for( int i = 0; i < nruns; i++ )
+        compRunStart[runLabel[i] + 1]++;
+    for( int c = 0; c < ncomps; c++ )
+        compRunStart[c + 1] += compRunStart[c];
+    {
+        std::vector<int> pos(compRunStart.begin(), compRunStart.end() - 1);
+        for( int i = 0; i < nruns; i++ )
+            compRuns[pos[runLabel[i]]++] = i;
+    }
+    std::vector<int> compNodeStart(ncomps + 1, 0), compNodes(nnodes);
+    for( int i = 0; i < nnodes; i++ )
+        compNodeStart[nodes[i].owner + 1]++;
+    for( int c = 0; c < ncomps; c++ )
+        compNodeStart[c + 1] += compNodeStart[c];
+    {
+        std::vector<int> pos(compNodeStart.begin(), compNodeStart.end() - 1);
+        for( int i = 0; i < nnodes; i++ )
+            compNodes[pos[nodes[i].owner]++] = i;
+    }
+
+    const double maxBatchArea = 1 << 16;
+    std::vector<int> batchStart(1, 0);
+    std::vector<char> compNeeded(ncomps, 0);
+    for( int i = 0; i < nnodes; i++ )
+        if( included[i] )
+            compNeeded[nodes[i].owner] = 1;
+    {
+        Rect roi;
+        for( int c = 0; c < ncomps; c++ )
+        {
+            if( c > batchStart.back() && (double)(roi | compRect[c]).area() > maxBatchArea )
+            {
+                batchStart.push_back(c);
+                roi = Rect();
+            }
+            roi = roi.empty() ? compRect[c] : (roi | compRect[c]);
+        }
+        batchStart.push_back(ncomps);
+    }
+    const int nbatches = (int)batchStart.size() - 1;
+
+    std::vector< std::vector<Point> > points(nnodes);
+    parallel_for_(Range(0, nbatches), [&](const Range& r) {
+        std::vector< std::pair<int64, int> > keys;
+        for( int b = r.start; b < r.end; b++ )
+        {
+            int c0 = batchStart[b], c1 = batchStart[b + 1];
+            // skip the components without the needed contours at the beginning and at the end of the batch
+            for( ; c0 < c1 && !compNeeded[c0]; c0++ )
+                ;
+            for( ; c1 > c0 && !compNeeded[c1 - 1]; c1-- )
+                ;
+            if( c0 >= c1 )
+                continue;
+            keys.clear();
+            for( int i = compNodeStart[c0]; i < compNodeStart[c1]; i++ )
+                keys.push_back(std::make_pair(nodes[compNodes[i]].key, compNodes[i]));
+            std::sort(keys.begin(), keys.end());
+            traceContourBatch(rimg, compRuns, compRunStart, compRect, c0, c1, keys, method, offset, included, points);
+        }
+    }, nbatches);
+
+    // the output is the pre-order traversal of the tree, as cvTreeToNodeSeq does
+    std::vector<int> order;
+    order.reserve(nnodes);
+    for( int i = firstRoot; i >= 0; )
+    {
+        nodes[i].index = (int)order.size();
+        order.push_back(i);
+        if( nodes[i].firstChild >= 0 )
+        {
+            i = nodes[i].firstChild;
+            continue;
+        }
+        while( i >= 0 && nodes[i].next < 0 )
+            i = nodes[i].parent;
+        if( i >= 0 )
+            i = nodes[i].next;
+    }
+
+    int total = (int)order.size();
+    _contours.create(total, 1, 0, -1, true);
+    for( int i = 0; i < total; i++ )
+    {
+        const std::vector<Point>& pts = points[order[i]];
+        _contours.create((int)pts.size(), 1, CV_32SC2, i, true);
+        Mat ci = _contours.getMat(i);
+        CV_Assert( ci.isContinuous() );
+        if( !pts.empty() )
+            memcpy(ci.ptr(), &pts[0], pts.size()*sizeof(pts[0]));
+    }
+
+    if( _hierarchy.needed() )
+    {
+        _hierarchy.create(1, total, CV_32SC4, -1, true);
+        Vec4i* hierarchy = _hierarchy.getMat().ptr<Vec4i>();
+        for( int i = 0; i < total; i++ )
+        {
+            const ContourNode& node = nodes[order[i]];
+            hierarchy[i] = Vec4i(node.next >= 0 ? nodes[node.next].index : -1,
+                                 node.prev >= 0 ? nodes[node.prev].index : -1,
+                                 node.firstChild >= 0 ? nodes[node.firstChild].index : -1,
+                                 node.parent >= 0 ? nodes[node.parent].index : -1);
+        }
+    }
+    return true;
+}
+
+static bool useParallelFindContours(const Mat& image, int mode, int method)
+{
+    static size_t minPixels = utils::getConfigurationParameterSizeT("OPENCV_IMGPROC_FIND_CONTOURS_PARALLEL_MIN_PIXELS", 1 << 18);
+    return image.type() == CV_8UC1 && image.dims == 2 &&
+           mode >= RETR_EXTERNAL && mode <= RETR_TREE &&
+           method >= CHAIN_APPROX_NONE && method <= CHAIN_APPROX_TC89_KCOS &&
+           image.total() >= minPixels && getNumThreads() > 1;
+}
+
+} // namespace cv
+
 void cv::findContours( InputArray _image, OutputArrayOfArrays _contours,
                    OutputArray _hierarchy, int mode, int method, Point offset )
 {
@@ -1802,6 +2327,13 @@ void cv::findContours( InputArray _image, OutputArrayOfArrays _contours,
     CV_Assert(_contours.empty() || (_contours.channels() == 2 && _contours.depth() == CV_32S));
 
     Mat image0 = _image.getMat(), image;
+    if( useParallelFindContours(image0, mode, method) )
+    {
+        if( _hierarchy.needed() )
+            _hierarchy.clear();
+        if( findContoursParallel(image0, _contours, _hierarchy, mode, method, offset) )
+            return;
+    }
     Point offset0(0, 0);
     if(method != CV_LINK_RUNS)
     {
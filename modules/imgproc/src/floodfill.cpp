@@ -41,6 +41,7 @@
 //M*/
 
 #include "precomp.hpp"
+#include "opencv2/core/hal/intrin.hpp"
 
 #if defined(__GNUC__) && (__GNUC__ == 4) && (__GNUC_MINOR__ == 8)
 # pragma GCC diagnostic ignored "-Warray-bounds"
@@ -635,6 +636,362 @@ int cv::floodFill( InputOutputArray _image, Point seedPoint,
     return floodFill(_image, Mat(), seedPoint, newVal, rect, loDiff, upDiff, flags);
 }
 
+/****************************************************************************************\
+*                          Seeded region labeling (parallel version)                     *
+\****************************************************************************************/
+
+namespace cv
+{
+
+// the union-find over the pixel indices; the parent index is always smaller than the child one,
+// so the roots are the smallest indices of their sets
+static inline int ffFindRoot( int* P, int i )
+{
+    while( P[i] != i )
+    {
+        P[i] = P[P[i]];
+        i = P[i];
+    }
+    return i;
+}
+
+// joins the set with the root r and the set of the pixel j, returns the new root
+static inline int ffMerge( int* P, int r, int j )
+{
+    j = ffFindRoot(P, j);
+    if( j < r )
+    {
+        P[r] = j;
+        return j;
+    }
+    if( r < j )
+        P[j] = r;
+    return r;
+}
+
+// m[x] = 255 if all the channels of a[x] and b[x] differ by at most d
+template<typename _Tp> static void
+ffEdges( const _Tp* a, const _Tp* b, int len, int cn, const double* d, uchar* m )
+{
+    for( int x = 0; x < len; x++, a += cn, b += cn )
+    {
+        bool ok = std::abs((double)a[0] - b[0]) <= d[0];
+        for( int k = 1; k < cn; k++ )
+            ok = ok && std::abs((double)a[k] - b[k]) <= d[k];
+        m[x] = ok ? 255 : 0;
+    }
+}
+
+template<> void
+ffEdges<uchar>( const uchar* a, const uchar* b, int len, int cn, const double* d, uchar* m )
+{
+    uchar d0 = saturate_cast<uchar>(d[0]), d1 = 0, d2 = 0;
+    if( cn == 3 )
+        d1 = saturate_cast<uchar>(d[1]), d2 = saturate_cast<uchar>(d[2]);
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_uint8::nlanes;
+    if( cn == 1 )
+    {
+        v_uint8 vd = vx_setall_u8(d0);
+        for( ; x <= len - VECSZ; x += VECSZ )
+            v_store(m + x, v_absdiff(vx_load(a + x), vx_load(b + x)) <= vd);
+    }
+    else
+    {
+        v_uint8 vd0 = vx_setall_u8(d0), vd1 = vx_setall_u8(d1), vd2 = vx_setall_u8(d2);
+        for( ; x <= len - VECSZ; x += VECSZ )
+        {
+            v_uint8 a0, a1, a2, b0, b1, b2;
+            v_load_deinterleave(a + x*3, a0, a1, a2);
+            v_load_deinterleave(b + x*3, b0, b1, b2);
+            v_store(m + x, (v_absdiff(a0, b0) <= vd0) & (v_absdiff(a1, b1) <= vd1) &
+                           (v_absdiff(a2, b2) <= vd2));
+        }
+    }
+    vx_cleanup();
+#endif
+    if( cn == 1 )
+    {
+        for( ; x < len; x++ )
+            m[x] = std::abs(a[x] - b[x]) <= d0 ? 255 : 0;
+    }
+    else
+    {
+        for( ; x < len; x++ )
+        {
+            const uchar *p = a + x*3, *q = b + x*3;
+            m[x] = std::abs(p[0] - q[0]) <= d0 && std::abs(p[1] - q[1]) <= d1 &&
+                   std::abs(p[2] - q[2]) <= d2 ? 255 : 0;
+        }
+    }
+}
+
+// connects row y with its left neighbors and, if connectUp, with the row y-1
+template<typename _Tp> static void
+ffConnectRow( const Mat& img, int y, bool connectUp, int connectivity,
+              const double* diff, uchar* buf, int* P )
+{
+    const int width = img.cols, cn = img.channels();
+    const _Tp* row = img.ptr<_Tp>(y);
+    uchar *h = buf, *v = h + width, *dl = v + width, *dr = dl + width;
+
+    // h[x], v[x], dl[x] and dr[x] are the connections of the pixel x with its left, upper,
+    // upper-left and upper-right neighbors
+    h[0] = 0;
+    ffEdges(row + cn, row, width - 1, cn, diff, h + 1);
+    if( connectUp )
+    {
+        const _Tp* prev = img.ptr<_Tp>(y - 1);
+        ffEdges(row, prev, width, cn, diff, v);
+        if( connectivity == 8 )
+        {
+            dl[0] = dr[width-1] = 0;
+            ffEdges(row + cn, prev, width - 1, cn, diff, dl + 1);
+            ffEdges(row, prev + cn, width - 1, cn, diff, dr);
+        }
+    }
+
+    int ofs = y*width, pofs = ofs - width, rprev = -1;
+    for( int x = 0; x < width; x++ )
+    {
+        int i = ofs + x, r = ffFindRoot(P, i);
+        if( h[x] )
+            r = ffMerge(P, r, rprev);
+        if( connectUp )
+        {
+            if( v[x] )
+                r = ffMerge(P, r, pofs + x);
+            if( connectivity == 8 )
+            {
+                if( dl[x] )
+                    r = ffMerge(P, r, pofs + x - 1);
+                if( dr[x] )
+                    r = ffMerge(P, r, pofs + x + 1);
+            }
+        }
+        rprev = r;
+    }
+}
+
+typedef void (*FFConnectRowFunc)( const Mat& img, int y, bool connectUp, int connectivity,
+                                  const double* diff, uchar* buf, int* P );
+
+class FFillLabelStripes : public ParallelLoopBody
+{
+public:
+    FFillLabelStripes( const Mat& _img, int _nstripes, int _connectivity, const double* _diff,
+                       FFConnectRowFunc _func, int* _P ) :
+        img(_img), nstripes(_nstripes), connectivity(_connectivity), diff(_diff), func(_func), P(_P)
+    {
+    }
+
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        AutoBuffer<uchar> _buf(img.cols*4);
+        const int width = img.cols;
+        for( int s = range.start; s < range.end; s++ )
+        {
+            int y0 = s*img.rows/nstripes, y1 = (s + 1)*img.rows/nstripes;
+            for( int y = y0; y < y1; y++ )
+            {
+                int* p = P + (size_t)y*width;
+                for( int x = 0; x < width; x++ )
+                    p[x] = y*width + x;
+                func(img, y, y > y0, connectivity, diff, _buf.data(), P);
+            }
+            // the parents precede the children, so a single pass makes all the pixels of the
+            // stripe point to their roots
+            for( int i = y0*width; i < y1*width; i++ )
+                P[i] = P[P[i]];
+        }
+    }
+
+private:
+    const Mat& img;
+    int nstripes, connectivity;
+    const double* diff;
+    FFConnectRowFunc func;
+    int* P;
+};
+
+// writes the labels and accumulates the statistics of each stripe
+class FFillLabelOutput : public ParallelLoopBody
+{
+public:
+    FFillLabelOutput( const int* _P, Mat& _labels, int _nstripes, int _nlabels,
+                      std::vector<int>& _istats, std::vector<double>& _sums ) :
+        P(_P), labels(_labels), nstripes(_nstripes), nlabels(_nlabels), istats(_istats), sums(_sums)
+    {
+    }
+
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        const int width = labels.cols;
+        for( int s = range.start; s < range.end; s++ )
+        {
+            int y0 = s*labels.rows/nstripes, y1 = (s + 1)*labels.rows/nstripes;
+            int* st = &istats[(size_t)s*nlabels*CC_STAT_MAX];
+            double* sm = &sums[(size_t)s*nlabels*2];
+            for( int l = 0; l < nlabels; l++ )
+            {
+                st[l*CC_STAT_MAX + CC_STAT_LEFT] = INT_MAX;
+                st[l*CC_STAT_MAX + CC_STAT_TOP] = INT_MAX;
+                st[l*CC_STAT_MAX + CC_STAT_WIDTH] = INT_MIN;
+                st[l*CC_STAT_MAX + CC_STAT_HEIGHT] = INT_MIN;
+                st[l*CC_STAT_MAX + CC_STAT_AREA] = 0;
+                sm[l*2] = sm[l*2 + 1] = 0;
+            }
+            for( int y = y0; y < y1; y++ )
+            {
+                int* lrow = labels.ptr<int>(y);
+                const int* p = P + (size_t)y*width;
+                for( int x = 0; x < width; x++ )
+                {
+                    // the roots of the seeded regions hold their negated labels
+                    int i = y*width + x, q = p[x];
+                    while( q >= 0 && q != i )
+                    {
+                        i = q;
+                        q = P[i];
+                    }
+                    int l = q < 0 ? -q : 0;
+                    lrow[x] = l;
+                    int* sl = st + l*CC_STAT_MAX;
+                    sl[CC_STAT_LEFT] = std::min(sl[CC_STAT_LEFT], x);
+                    sl[CC_STAT_TOP] = std::min(sl[CC_STAT_TOP], y);
+                    sl[CC_STAT_WIDTH] = std::max(sl[CC_STAT_WIDTH], x);
+                    sl[CC_STAT_HEIGHT] = y;
+                    sl[CC_STAT_AREA]++;
+                    sm[l*2] += x;
+                    sm[l*2 + 1] += y;
+                }
+            }
+        }
+    }
+
+private:
+    const int* P;
+    Mat& labels;
+    int nstripes, nlabels;
+    std::vector<int>& istats;
+    std::vector<double>& sums;
+};
+
+}
+
+int cv::floodFillRegions( InputArray _image, InputArray _seeds, OutputArray _labels,
+                          OutputArray _stats, OutputArray _centroids,
+                          Scalar diff, int connectivity )
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat img = _image.getMat(), seedsMat = _seeds.getMat();
+    int depth = img.depth(), cn = img.channels();
+    CV_Assert( !img.empty() && img.dims == 2 );
+    if( cn != 1 && cn != 3 )
+        CV_Error( CV_StsBadArg, "Number of channels in input image must be 1 or 3" );
+    if( connectivity == 0 )
+        connectivity = 4;
+    if( connectivity != 4 && connectivity != 8 )
+        CV_Error( CV_StsBadFlag, "Connectivity must be 4, 0(=4) or 8" );
+    CV_Assert( img.total() < (size_t)INT_MAX );
+
+    double d[3];
+    for( int i = 0; i < cn; i++ )
+    {
+        if( diff[i] < 0 )
+            CV_Error( CV_StsBadArg, "diff must be non-negative" );
+        d[i] = depth == CV_32F ? (double)(float)diff[i] : (double)cvFloor(diff[i]);
+    }
+
+    FFConnectRowFunc func = depth == CV_8U ? ffConnectRow<uchar> :
+                            depth == CV_32S ? ffConnectRow<int> :
+                            depth == CV_32F ? ffConnectRow<float> : 0;
+    if( !func )
+        CV_Error( CV_StsUnsupportedFormat, "" );
+
+    int npoints = seedsMat.empty() ? 0 : seedsMat.checkVector(2, CV_32S);
+    CV_Assert( npoints >= 0 );
+    const Point* seeds = seedsMat.ptr<Point>();
+    Size size = img.size();
+    for( int i = 0; i < npoints; i++ )
+        if( (unsigned)seeds[i].x >= (unsigned)size.width ||
+            (unsigned)seeds[i].y >= (unsigned)size.height )
+            CV_Error( CV_StsOutOfRange, "Seed point is outside of image" );
+
+    // label the whole image by the stripes in parallel, then merge the stripes
+    AutoBuffer<int> _P(img.total());
+    int* P = _P.data();
+    int nstripes = std::max(1, std::min(size.height/16, getNumThreads()*4));
+    parallel_for_(Range(0, nstripes), FFillLabelStripes(img, nstripes, connectivity, d, func, P));
+    {
+        // only the connections of the first row of each stripe with the previous one are new
+        AutoBuffer<uchar> _buf(size.width*4);
+        for( int s = 1; s < nstripes; s++ )
+            func(img, s*size.height/nstripes, true, connectivity, d, _buf.data(), P);
+    }
+
+    // the seeded regions get the labels 1, 2, ... in the order of their first seeds,
+    // the labels are stored negated in the roots
+    int nlabels = 1;
+    for( int k = 0; k < npoints; k++ )
+    {
+        int i = seeds[k].y*size.width + seeds[k].x, q = P[i];
+        while( q >= 0 && q != i )
+        {
+            i = q;
+            q = P[i];
+        }
+        if( q >= 0 )
+            P[i] = -nlabels++;
+    }
+
+    _labels.create(size, CV_32S);
+    Mat labels = _labels.getMat();
+    std::vector<int> istats((size_t)nstripes*nlabels*CC_STAT_MAX);
+    std::vector<double> sums((size_t)nstripes*nlabels*2);
+    parallel_for_(Range(0, nstripes), FFillLabelOutput(P, labels, nstripes, nlabels, istats, sums));
+
+    Mat stats(nlabels, CC_STAT_MAX, CV_32S), centroids(nlabels, 2, CV_64F);
+    for( int l = 0; l < nlabels; l++ )
+    {
+        int* st = stats.ptr<int>(l);
+        double* c = centroids.ptr<double>(l);
+        int left = INT_MAX, top = INT_MAX, right = INT_MIN, bottom = INT_MIN, area = 0;
+        double sx = 0, sy = 0;
+        for( int s = 0; s < nstripes; s++ )
+        {
+            const int* sst = &istats[((size_t)s*nlabels + l)*CC_STAT_MAX];
+            left = std::min(left, sst[CC_STAT_LEFT]);
+            top = std::min(top, sst[CC_STAT_TOP]);
+            right = std::max(right, sst[CC_STAT_WIDTH]);
+            bottom = std::max(bottom, sst[CC_STAT_HEIGHT]);
+            area += sst[CC_STAT_AREA];
+            sx += sums[((size_t)s*nlabels + l)*2];
+            sy += sums[((size_t)s*nlabels + l)*2 + 1];
+        }
+        if( area == 0 )
+        {
+            st[CC_STAT_LEFT] = st[CC_STAT_TOP] = st[CC_STAT_WIDTH] = st[CC_STAT_HEIGHT] = st[CC_STAT_AREA] = 0;
+            c[0] = c[1] = 0;
+            continue;
+        }
+        st[CC_STAT_LEFT] = left;
+        st[CC_STAT_TOP] = top;
+        st[CC_STAT_WIDTH] = right - left + 1;
+        st[CC_STAT_HEIGHT] = bottom - top + 1;
+        st[CC_STAT_AREA] = area;
+        c[0] = sx/area;
+        c[1] = sy/area;
+    }
+    if( _stats.needed() )
+        stats.copyTo(_stats);
+    if( _centroids.needed() )
+        centroids.copyTo(_centroids);
+    return nlabels;
+}
+
 
 CV_IMPL void
 cvFloodFill( CvArr* arr, CvPoint seed_point,
@@ -446,7 +446,7 @@ struct RemapVec_8u
     {
         int cn = _src.channels(), x = 0, sstep = (int)_src.step;
 
-        if( (cn != 1 && cn != 3 && cn != 4) || sstep >= 0x8000 )
+        if( cn > 4 || sstep >= 0x8000 )
             return 0;
 
         const uchar *S0 = _src.ptr(), *S1 = _src.ptr(1);
@@ -539,6 +539,36 @@ struct RemapVec_8u
                 v_pack_u_store(D + x, v_pack(v0, v2));
             }
         }
+        else if( cn == 2 )
+        {
+            // the left and right pixels of the 4 neighbourhoods are interleaved by channel,
+            // (l.c0, r.c0, l.c1, r.c1), and multiplied by the interleaved weights
+            for( ; x <= width - 4; x += 4, D += 8 )
+            {
+                v_int16x8 _xy0 = v_load(XY + x * 2);
+                v_int32x4 xy0 = v_dotprod( _xy0, xy2ofs );
+                v_store(iofs0, xy0);
+
+                v_uint8x16 u, v, dummy;
+                v_uint16x8 u01, u23, v01, v23;
+                v_zip(v_reinterpret_as_u8(CV_PICK_AND_PACK4(S0, iofs0)),
+                      v_reinterpret_as_u8(CV_PICK_AND_PACK4(S0 + 2, iofs0)), u, dummy);
+                v_zip(v_reinterpret_as_u8(CV_PICK_AND_PACK4(S1, iofs0)),
+                      v_reinterpret_as_u8(CV_PICK_AND_PACK4(S1 + 2, iofs0)), v, dummy);
+                v_expand(u, u01, u23);
+                v_expand(v, v01, v23);
+
+                const short* w0 = wtab + FXY[x] * 16;
+                const short* w1 = wtab + FXY[x + 1] * 16;
+                const short* w2 = wtab + FXY[x + 2] * 16;
+                const short* w3 = wtab + FXY[x + 3] * 16;
+                v_int32x4 result0 = v_dotprod(v_reinterpret_as_s16(u01), v_combine_low(v_load(w0), v_load(w1)),
+                                    v_dotprod(v_reinterpret_as_s16(v01), v_combine_low(v_load(w0 + 8), v_load(w1 + 8)), delta));
+                v_int32x4 result1 = v_dotprod(v_reinterpret_as_s16(u23), v_combine_low(v_load(w2), v_load(w3)),
+                                    v_dotprod(v_reinterpret_as_s16(v23), v_combine_low(v_load(w2 + 8), v_load(w3 + 8)), delta));
+                v_pack_u_store(D, v_pack(result0 >> INTER_REMAP_COEF_BITS, result1 >> INTER_REMAP_COEF_BITS));
+            }
+        }
         else if( cn == 3 )
         {
             for( ; x <= width - 5; x += 4, D += 12 )
@@ -644,6 +674,148 @@ typedef RemapNoVec RemapVec_8u;
 
 #endif
 
+#if CV_SIMD128
+
+// 4 source values as floats and the rounded results back, shared by the float and 16-bit kernels
+static inline v_float32x4 v_remap_load4( const float* p ) { return v_load(p); }
+static inline v_float32x4 v_remap_load4( const ushort* p ) { return v_cvt_f32(v_reinterpret_as_s32(v_load_expand(p))); }
+static inline v_float32x4 v_remap_load4( const short* p ) { return v_cvt_f32(v_load_expand(p)); }
+static inline void v_remap_store4( float* p, const v_float32x4& v ) { v_store(p, v); }
+static inline void v_remap_store4( ushort* p, const v_float32x4& v ) { v_pack_u_store(p, v_round(v)); }
+static inline void v_remap_store4( short* p, const v_float32x4& v ) { v_pack_store(p, v_round(v)); }
+
+struct RemapVec_32f
+{
+    int operator()( const Mat& _src, void* _dst, const short* XY,
+                    const ushort* FXY, const void* _wtab, int width ) const
+    {
+        int cn = _src.channels(), x = 0;
+
+        if( cn > 4 )
+            return 0;
+
+        const float* S0 = _src.ptr<float>();
+        size_t sstep = _src.step/sizeof(S0[0]);
+        const float* wtab = (const float*)_wtab;
+        float* D = (float*)_dst;
+
+        if( cn == 1 )
+        {
+            // the 2x2 neighbourhoods of 4 pixels are multiplied by their weights and transposed,
+            // so that the sums are computed vertically
+            for( ; x <= width - v_float32x4::nlanes; x += v_float32x4::nlanes )
+            {
+                v_float32x4 p0, p1, p2, p3;
+                const float* S = S0 + XY[x*2+1]*sstep + XY[x*2];
+                p0 = v_load_halves(S, S + sstep) * v_load(wtab + FXY[x]*4);
+                S = S0 + XY[x*2+3]*sstep + XY[x*2+2];
+                p1 = v_load_halves(S, S + sstep) * v_load(wtab + FXY[x+1]*4);
+                S = S0 + XY[x*2+5]*sstep + XY[x*2+4];
+                p2 = v_load_halves(S, S + sstep) * v_load(wtab + FXY[x+2]*4);
+                S = S0 + XY[x*2+7]*sstep + XY[x*2+6];
+                p3 = v_load_halves(S, S + sstep) * v_load(wtab + FXY[x+3]*4);
+                v_transpose4x4(p0, p1, p2, p3, p0, p1, p2, p3);
+                v_store(D + x, (p0 + p1) + (p2 + p3));
+            }
+        }
+        else
+            x = remapPixels(S0, sstep, D, XY, FXY, wtab, width, cn);
+
+        return x;
+    }
+
+    // computes the pixels one by one, all the channels at once. With 3 channels the 4th lane
+    // is the first channel of the next pixel: the source is still read inside the image, since
+    // remapBilinear reduces the inner area for 3-channel images, and the destination lane is
+    // overwritten by the next pixel, so the last one is left to the scalar code.
+    template<typename T>
+    static int remapPixels( const T* S0, size_t sstep, T* D, const short* XY,
+                            const ushort* FXY, const float* wtab, int width, int cn )
+    {
+        int x = 0;
+        if( cn == 2 )
+        {
+            // a row of the 2x2 neighbourhood is one 4-value load, the left and right halves
+            // of the sums are added, two pixels at once
+            for( ; x <= width - 2; x += 2 )
+            {
+                v_float32x4 s[2];
+                for( int j = 0; j < 2; j++ )
+                {
+                    const T* S = S0 + XY[(x+j)*2+1]*sstep + XY[(x+j)*2]*2;
+                    const float* w = wtab + FXY[x+j]*4;
+                    s[j] = v_remap_load4(S) * v_float32x4(w[0], w[0], w[1], w[1]);
+                    s[j] = v_fma(v_remap_load4(S + sstep), v_float32x4(w[2], w[2], w[3], w[3]), s[j]);
+                }
+                v_remap_store4(D + x*2, v_combine_low(s[0], s[1]) + v_combine_high(s[0], s[1]));
+            }
+            return x;
+        }
+        for( ; x < width - (cn == 3); x++ )
+        {
+            const T* S = S0 + XY[x*2+1]*sstep + XY[x*2]*cn;
+            const float* w = wtab + FXY[x]*4;
+            v_float32x4 s = v_remap_load4(S) * v_setall_f32(w[0]);
+            s = v_fma(v_remap_load4(S + cn), v_setall_f32(w[1]), s);
+            s = v_fma(v_remap_load4(S + sstep), v_setall_f32(w[2]), s);
+            s = v_fma(v_remap_load4(S + sstep + cn), v_setall_f32(w[3]), s);
+            v_remap_store4(D + x*cn, s);
+        }
+        return x;
+    }
+};
+
+// 16U and 16S images
+template<typename T>
+struct RemapVec_16
+{
+    int operator()( const Mat& _src, void* _dst, const short* XY,
+                    const ushort* FXY, const void* _wtab, int width ) const
+    {
+        int cn = _src.channels(), x = 0;
+
+        if( cn > 4 )
+            return 0;
+
+        const T* S0 = _src.ptr<T>();
+        size_t sstep = _src.step/sizeof(S0[0]);
+        const float* wtab = (const float*)_wtab;
+        T* D = (T*)_dst;
+
+        if( cn == 1 )
+        {
+            // the same as for the float images, the 2x2 neighbourhoods are gathered and converted
+            for( ; x <= width - v_float32x4::nlanes; x += v_float32x4::nlanes )
+            {
+                v_float32x4 p[4];
+                for( int j = 0; j < 4; j++ )
+                {
+                    const T* S = S0 + XY[(x+j)*2+1]*sstep + XY[(x+j)*2];
+                    p[j] = v_cvt_f32(v_int32x4(S[0], S[1], S[sstep], S[sstep+1])) * v_load(wtab + FXY[x+j]*4);
+                }
+                v_transpose4x4(p[0], p[1], p[2], p[3], p[0], p[1], p[2], p[3]);
+                v_remap_store4(D + x, (p[0] + p[1]) + (p[2] + p[3]));
+            }
+        }
+        else
+            x = RemapVec_32f::remapPixels(S0, sstep, D, XY, FXY, wtab, width, cn);
+
+        return x;
+    }
+};
+
+typedef RemapVec_16<ushort> RemapVec_16u;
+typedef RemapVec_16<short> RemapVec_16s;
+
+#else
+
+typedef RemapNoVec RemapVec_32f;
+typedef RemapNoVec RemapVec_16u;
+typedef RemapNoVec RemapVec_16s;
+
+#endif
+
+
 
 template<class CastOp, class VecOp, typename AT>
 static void remapBilinear( const Mat& _src, Mat& _dst, const Mat& _xy,
@@ -667,7 +839,8 @@ static void remapBilinear( const Mat& _src, Mat& _dst, const Mat& _xy,
     unsigned width1 = std::max(ssize.width-1, 0), height1 = std::max(ssize.height-1, 0);
     CV_Assert( !ssize.empty() );
 #if CV_SIMD128
-    if( _src.type() == CV_8UC3 )
+    // the vector code reads one more value after the 2x2 neighbourhood of 3-channel pixels
+    if( _src.type() == CV_8UC3 || _src.type() == CV_16UC3 || _src.type() == CV_16SC3 || _src.type() == CV_32FC3 )
         width1 = std::max(ssize.width-2, 0);
 #endif
 
@@ -856,7 +1029,170 @@ static void remapBilinear( const Mat& _src, Mat& _dst, const Mat& _xy,
 }
 
 
-template<class CastOp, typename AT, int ONE>
+struct RemapBicubicNoVec
+{
+    template<typename T, typename AT>
+    bool operator()( const T*, size_t, const AT*, int, T* ) const { return false; }
+};
+
+#if CV_SIMD128
+
+// computes the 4x4 weighted sum for a single inner pixel, returns false for
+// the unsupported number of channels
+struct RemapBicubicVec_8u
+{
+    bool operator()( const uchar* S, size_t sstep, const short* w, int cn, uchar* D ) const
+    {
+        if( cn == 1 )
+        {
+            v_uint8x16 p = v_reinterpret_as_u8(v_int32x4(*(const unaligned_int*)S,
+                                                         *(const unaligned_int*)(S + sstep),
+                                                         *(const unaligned_int*)(S + sstep*2),
+                                                         *(const unaligned_int*)(S + sstep*3)));
+            v_uint16x8 p01, p23;
+            v_expand(p, p01, p23);
+            v_int32x4 sum = v_dotprod(v_reinterpret_as_s16(p01), v_load(w)) +
+                            v_dotprod(v_reinterpret_as_s16(p23), v_load(w + 8));
+            *D = saturate_cast<uchar>((v_reduce_sum(sum) + (1 << (INTER_REMAP_COEF_BITS-1))) >> INTER_REMAP_COEF_BITS);
+            return true;
+        }
+        // the products of the 8-bit values and the 16-bit weights are computed by v_mul_expand,
+        // the 32-bit multiplication is much slower on some platforms
+        if( cn == 2 )
+        {
+            // a row is (p0, p1, p2, p3) with the weights (w0, w0, w1, w1, ...), the even
+            // lanes of the sums are the first channel
+            v_int32x4 s0 = v_setzero_s32(), s1 = v_setzero_s32(), p0, p1;
+            for( int i = 0; i < 4; i++, S += sstep, w += 4 )
+            {
+                v_int16x8 wr = v_load_low(w), w01, dummy;
+                v_zip(wr, wr, w01, dummy);
+                v_mul_expand(v_reinterpret_as_s16(v_load_expand(S)), w01, p0, p1);
+                s0 += p0; s1 += p1;
+            }
+            v_int32x4 sum = s0 + s1;
+            sum = (sum + v_combine_high(sum, sum) + v_setall_s32(1 << (INTER_REMAP_COEF_BITS-1))) >> INTER_REMAP_COEF_BITS;
+            D[0] = saturate_cast<uchar>(v_extract_n<0>(sum));
+            D[1] = saturate_cast<uchar>(v_extract_n<1>(sum));
+            return true;
+        }
+        if( cn == 4 )
+        {
+            v_int32x4 s0 = v_setzero_s32(), s1 = v_setzero_s32(), p0, p1;
+            for( int i = 0; i < 4; i++, S += sstep, w += 4 )
+            {
+                v_int16x8 w01 = v_combine_low(v_setall_s16(w[0]), v_setall_s16(w[1]));
+                v_int16x8 w23 = v_combine_low(v_setall_s16(w[2]), v_setall_s16(w[3]));
+                v_mul_expand(v_reinterpret_as_s16(v_load_expand(S)), w01, p0, p1);
+                s0 += p0; s1 += p1;
+                v_mul_expand(v_reinterpret_as_s16(v_load_expand(S + 8)), w23, p0, p1);
+                s0 += p0; s1 += p1;
+            }
+            v_int32x4 sum = s0 + s1 + v_setall_s32(1 << (INTER_REMAP_COEF_BITS-1));
+            v_int16x8 r = v_pack(sum >> INTER_REMAP_COEF_BITS, sum >> INTER_REMAP_COEF_BITS);
+            v_pack_u_store(D, r);
+            return true;
+        }
+        if( cn == 3 )
+        {
+            // the 12 values of a row are read as (p0, p1, p2.c0, p2.c1) and (p1.c1, p1.c2, p2, p3),
+            // the weights are spread over the lanes in the same way, zeros for the repeated values
+            v_int32x4 s0 = v_setzero_s32(), s1 = v_setzero_s32(), s2 = v_setzero_s32(), p0, p1;
+            for( int i = 0; i < 4; i++, S += sstep, w += 4 )
+            {
+                v_mul_expand(v_reinterpret_as_s16(v_load_expand(S)),
+                             v_int16x8(w[0], w[0], w[0], w[1], w[1], w[1], w[2], w[2]), p0, p1);
+                s0 += p0; s1 += p1;
+                v_mul_expand(v_reinterpret_as_s16(v_load_expand(S + 4)),
+                             v_int16x8(0, 0, 0, 0, w[2], w[3], w[3], w[3]), p0, p1);
+                s2 += p1;
+            }
+            int CV_DECL_ALIGNED(16) buf[12];
+            v_store_aligned(buf, s0);
+            v_store_aligned(buf + 4, s1);
+            v_store_aligned(buf + 8, s2);
+            for( int k = 0; k < 3; k++ )
+                D[k] = saturate_cast<uchar>((buf[k] + buf[k+3] + buf[k+6] + buf[k+9] +
+                                             (1 << (INTER_REMAP_COEF_BITS-1))) >> INTER_REMAP_COEF_BITS);
+            return true;
+        }
+        return false;
+    }
+};
+
+// float and 16-bit images, the sums are computed in float
+struct RemapBicubicVec_32f
+{
+    template<typename T>
+    bool operator()( const T* S, size_t sstep, const float* w, int cn, T* D ) const
+    {
+        if( cn == 1 )
+        {
+            v_float32x4 sum = v_remap_load4(S) * v_load(w);
+            sum = v_fma(v_remap_load4(S + sstep), v_load(w + 4), sum);
+            sum = v_fma(v_remap_load4(S + sstep*2), v_load(w + 8), sum);
+            sum = v_fma(v_remap_load4(S + sstep*3), v_load(w + 12), sum);
+            *D = saturate_cast<T>(v_reduce_sum(sum));
+            return true;
+        }
+        if( cn == 2 )
+        {
+            v_float32x4 sum = v_setzero_f32(), w01, w23;
+            for( int i = 0; i < 4; i++, S += sstep, w += 4 )
+            {
+                v_float32x4 wr = v_load(w);
+                v_zip(wr, wr, w01, w23);
+                sum = v_fma(v_remap_load4(S), w01, sum);
+                sum = v_fma(v_remap_load4(S + 4), w23, sum);
+            }
+            sum += v_combine_high(sum, sum);
+            D[0] = saturate_cast<T>(v_extract_n<0>(sum));
+            D[1] = saturate_cast<T>(v_extract_n<1>(sum));
+            return true;
+        }
+        if( cn == 3 )
+        {
+            // the same splitting of the rows as for the 8-bit images
+            v_float32x4 s0 = v_setzero_f32(), s1 = v_setzero_f32(), s2 = v_setzero_f32();
+            for( int i = 0; i < 4; i++, S += sstep, w += 4 )
+            {
+                s0 = v_fma(v_remap_load4(S), v_float32x4(w[0], w[0], w[0], w[1]), s0);
+                s1 = v_fma(v_remap_load4(S + 4), v_float32x4(w[1], w[1], w[2], w[2]), s1);
+                s2 = v_fma(v_remap_load4(S + 8), v_float32x4(w[2], w[3], w[3], w[3]), s2);
+            }
+            float CV_DECL_ALIGNED(16) buf[12];
+            v_store_aligned(buf, s0);
+            v_store_aligned(buf + 4, s1);
+            v_store_aligned(buf + 8, s2);
+            for( int k = 0; k < 3; k++ )
+                D[k] = saturate_cast<T>((buf[k] + buf[k+3]) + (buf[k+6] + buf[k+9]));
+            return true;
+        }
+        if( cn == 4 )
+        {
+            v_float32x4 sum = v_setzero_f32();
+            for( int i = 0; i < 4; i++, S += sstep, w += 4 )
+            {
+                sum = v_fma(v_remap_load4(S), v_setall_f32(w[0]), sum);
+                sum = v_fma(v_remap_load4(S + 4), v_setall_f32(w[1]), sum);
+                sum = v_fma(v_remap_load4(S + 8), v_setall_f32(w[2]), sum);
+                sum = v_fma(v_remap_load4(S + 12), v_setall_f32(w[3]), sum);
+            }
+            v_remap_store4(D, sum);
+            return true;
+        }
+        return false;
+    }
+};
+
+#else
+
+typedef RemapBicubicNoVec RemapBicubicVec_8u;
+typedef RemapBicubicNoVec RemapBicubicVec_32f;
+
+#endif
+
+template<class CastOp, class VecOp, typename AT, int ONE>
 static void remapBicubic( const Mat& _src, Mat& _dst, const Mat& _xy,
                           const Mat& _fxy, const void* _wtab,
                           int borderType, const Scalar& _borderValue )
@@ -870,6 +1206,7 @@ static void remapBicubic( const Mat& _src, Mat& _dst, const Mat& _xy,
     size_t sstep = _src.step/sizeof(S0[0]);
     T cval[CV_CN_MAX];
     CastOp castOp;
+    VecOp vecOp;
 
     for(int k = 0; k < cn; k++ )
         cval[k] = saturate_cast<T>(_borderValue[k & 3]);
@@ -897,6 +1234,8 @@ static void remapBicubic( const Mat& _src, Mat& _dst, const Mat& _xy,
             if( (unsigned)sx < width1 && (unsigned)sy < height1 )
             {
                 const T* S = S0 + sy*sstep + sx*cn;
+                if( vecOp(S, sstep, w, cn, D) )
+                    continue;
                 for(int k = 0; k < cn; k++ )
                 {
                     WT sum = S[0]*w[0] + S[cn]*w[1] + S[cn*2]*w[2] + S[cn*3]*w[3];
@@ -960,7 +1299,165 @@ static void remapBicubic( const Mat& _src, Mat& _dst, const Mat& _xy,
 }
 
 
-template<class CastOp, typename AT, int ONE>
+struct RemapLanczos4NoVec
+{
+    template<typename T, typename AT>
+    bool operator()( const T*, size_t, const AT*, int, T* ) const { return false; }
+};
+
+#if CV_SIMD128
+
+// computes the 8x8 weighted sum for a single inner pixel, returns false for
+// the unsupported number of channels
+struct RemapLanczos4Vec_8u
+{
+    bool operator()( const uchar* S, size_t sstep, const short* w, int cn, uchar* D ) const
+    {
+        const int delta = 1 << (INTER_REMAP_COEF_BITS-1);
+        if( cn == 1 )
+        {
+            v_int32x4 sum = v_setzero_s32();
+            for( int i = 0; i < 8; i++, S += sstep, w += 8 )
+                sum += v_dotprod(v_reinterpret_as_s16(v_load_expand(S)), v_load(w));
+            *D = saturate_cast<uchar>((v_reduce_sum(sum) + delta) >> INTER_REMAP_COEF_BITS);
+            return true;
+        }
+        if( cn > 4 )
+            return false;
+
+        v_int32x4 s0 = v_setzero_s32(), s1 = v_setzero_s32(), p0, p1;
+        if( cn == 3 )
+        {
+            // two pairs of the neighbour pixels are interleaved by channel, (p0.c0, p1.c0, p0.c1, ...)
+            // and (p2.c0, p3.c0, ...), and multiplied by the weight pairs. The 4th lane is the
+            // first channel of the next pixel and is not used.
+            for( int i = 0; i < 8; i++, S += sstep, w += 8 )
+                for( int j = 0; j < 8; j += 4 )
+                {
+                    v_uint8x16 a = v_reinterpret_as_u8(v_int32x4(*(const unaligned_int*)(S + j*3),
+                                                                 *(const unaligned_int*)(S + j*3 + 6), 0, 0));
+                    v_uint8x16 b = v_reinterpret_as_u8(v_int32x4(*(const unaligned_int*)(S + j*3 + 3),
+                                                                 *(const unaligned_int*)(S + j*3 + 9), 0, 0));
+                    v_uint8x16 ab, dummy;
+                    v_uint16x8 ab0, ab1;
+                    v_zip(a, b, ab, dummy);
+                    v_expand(ab, ab0, ab1);
+                    s0 = v_dotprod(v_reinterpret_as_s16(ab0), v_reinterpret_as_s16(v_setall_s32(*(const unaligned_int*)(w + j))), s0);
+                    s1 = v_dotprod(v_reinterpret_as_s16(ab1), v_reinterpret_as_s16(v_setall_s32(*(const unaligned_int*)(w + j + 2))), s1);
+                }
+        }
+        else
+        {
+            // the weights of a row are repeated for the channels, (w0, w0, w1, w1, ...) for
+            // 2 channels and (w0, w0, w0, w0, w1, ...) for 4 channels
+            for( int i = 0; i < 8; i++, S += sstep, w += 8 )
+            {
+                v_int16x8 w2[2], w4[4], wr = v_load(w);
+                v_zip(wr, wr, w2[0], w2[1]);
+                if( cn == 2 )
+                {
+                    for( int j = 0; j < 2; j++ )
+                    {
+                        v_mul_expand(v_reinterpret_as_s16(v_load_expand(S + j*8)), w2[j], p0, p1);
+                        s0 += p0; s1 += p1;
+                    }
+                    continue;
+                }
+                v_zip(w2[0], w2[0], w4[0], w4[1]);
+                v_zip(w2[1], w2[1], w4[2], w4[3]);
+                for( int j = 0; j < 4; j++ )
+                {
+                    v_mul_expand(v_reinterpret_as_s16(v_load_expand(S + j*8)), w4[j], p0, p1);
+                    s0 += p0; s1 += p1;
+                }
+            }
+        }
+        v_int32x4 sum = s0 + s1;
+        if( cn == 2 )
+            sum += v_combine_high(sum, sum);
+        sum = (sum + v_setall_s32(delta)) >> INTER_REMAP_COEF_BITS;
+        if( cn == 4 )
+        {
+            v_int16x8 r = v_pack(sum, sum);
+            v_pack_u_store(D, r);
+            return true;
+        }
+        D[0] = saturate_cast<uchar>(v_extract_n<0>(sum));
+        D[1] = saturate_cast<uchar>(v_extract_n<1>(sum));
+        if( cn == 3 )
+            D[2] = saturate_cast<uchar>(v_extract_n<2>(sum));
+        return true;
+    }
+};
+
+// float and 16-bit images, the sums are computed in float
+struct RemapLanczos4Vec_32f
+{
+    template<typename T>
+    bool operator()( const T* S, size_t sstep, const float* w, int cn, T* D ) const
+    {
+        if( cn > 4 )
+            return false;
+
+        v_float32x4 s0 = v_setzero_f32(), s1 = v_setzero_f32();
+        for( int i = 0; i < 8; i++, S += sstep, w += 8 )
+        {
+            v_float32x4 wr0 = v_load(w), wr1 = v_load(w + 4);
+            if( cn == 1 )
+            {
+                s0 = v_fma(v_remap_load4(S), wr0, s0);
+                s1 = v_fma(v_remap_load4(S + 4), wr1, s1);
+            }
+            else if( cn == 2 )
+            {
+                // two pixels per load, the weights are (w0, w0, w1, w1) and so on
+                v_float32x4 w2[4];
+                v_zip(wr0, wr0, w2[0], w2[1]);
+                v_zip(wr1, wr1, w2[2], w2[3]);
+                s0 = v_fma(v_remap_load4(S), w2[0], s0);
+                s1 = v_fma(v_remap_load4(S + 4), w2[1], s1);
+                s0 = v_fma(v_remap_load4(S + 8), w2[2], s0);
+                s1 = v_fma(v_remap_load4(S + 12), w2[3], s1);
+            }
+            else
+            {
+                // a pixel per load, with 3 channels the 4th lane is not used
+                for( int j = 0; j < 8; j += 2 )
+                {
+                    s0 = v_fma(v_remap_load4(S + j*cn), v_setall_f32(w[j]), s0);
+                    s1 = v_fma(v_remap_load4(S + (j+1)*cn), v_setall_f32(w[j+1]), s1);
+                }
+            }
+        }
+        v_float32x4 sum = s0 + s1;
+        if( cn == 1 )
+        {
+            *D = saturate_cast<T>(v_reduce_sum(sum));
+            return true;
+        }
+        if( cn == 4 )
+        {
+            v_remap_store4(D, sum);
+            return true;
+        }
+        if( cn == 2 )
+            sum += v_combine_high(sum, sum);
+        D[0] = saturate_cast<T>(v_extract_n<0>(sum));
+        D[1] = saturate_cast<T>(v_extract_n<1>(sum));
+        if( cn == 3 )
+            D[2] = saturate_cast<T>(v_extract_n<2>(sum));
+        return true;
+    }
+};
+
+#else
+
+typedef RemapLanczos4NoVec RemapLanczos4Vec_8u;
+typedef RemapLanczos4NoVec RemapLanczos4Vec_32f;
+
+#endif
+
+template<class CastOp, class VecOp, typename AT, int ONE>
 static void remapLanczos4( const Mat& _src, Mat& _dst, const Mat& _xy,
                            const Mat& _fxy, const void* _wtab,
                            int borderType, const Scalar& _borderValue )
@@ -974,6 +1471,7 @@ static void remapLanczos4( const Mat& _src, Mat& _dst, const Mat& _xy,
     size_t sstep = _src.step/sizeof(S0[0]);
     T cval[CV_CN_MAX];
     CastOp castOp;
+    VecOp vecOp;
 
     for(int k = 0; k < cn; k++ )
         cval[k] = saturate_cast<T>(_borderValue[k & 3]);
@@ -981,6 +1479,11 @@ static void remapLanczos4( const Mat& _src, Mat& _dst, const Mat& _xy,
     int borderType1 = borderType != BORDER_TRANSPARENT ? borderType : BORDER_REFLECT_101;
 
     unsigned width1 = std::max(ssize.width-7, 0), height1 = std::max(ssize.height-7, 0);
+#if CV_SIMD128
+    // the vector code reads one more value after the last pixel of a 3-channel row
+    if( cn == 3 && _src.depth() != CV_64F )
+        width1 = std::max(ssize.width-8, 0);
+#endif
 
     if( _dst.isContinuous() && _xy.isContinuous() && _fxy.isContinuous() )
     {
@@ -1001,6 +1504,8 @@ static void remapLanczos4( const Mat& _src, Mat& _dst, const Mat& _xy,
             const T* S = S0 + sy*sstep + sx*cn;
             if( (unsigned)sx < width1 && (unsigned)sy < height1 )
             {
+                if( vecOp(S, sstep, w, cn, D) )
+                    continue;
                 for(int k = 0; k < cn; k++ )
                 {
                     WT sum = 0;
@@ -1676,28 +2181,28 @@ void cv::remap( InputArray _src, OutputArray _dst,
     static RemapFunc linear_tab[] =
     {
         remapBilinear<FixedPtCast<int, uchar, INTER_REMAP_COEF_BITS>, RemapVec_8u, short>, 0,
-        remapBilinear<Cast<float, ushort>, RemapNoVec, float>,
-        remapBilinear<Cast<float, short>, RemapNoVec, float>, 0,
-        remapBilinear<Cast<float, float>, RemapNoVec, float>,
+        remapBilinear<Cast<float, ushort>, RemapVec_16u, float>,
+        remapBilinear<Cast<float, short>, RemapVec_16s, float>, 0,
+        remapBilinear<Cast<float, float>, RemapVec_32f, float>,
         remapBilinear<Cast<double, double>, RemapNoVec, float>, 0
     };
 
     static RemapFunc cubic_tab[] =
     {
-        remapBicubic<FixedPtCast<int, uchar, INTER_REMAP_COEF_BITS>, short, INTER_REMAP_COEF_SCALE>, 0,
-        remapBicubic<Cast<float, ushort>, float, 1>,
-        remapBicubic<Cast<float, short>, float, 1>, 0,
-        remapBicubic<Cast<float, float>, float, 1>,
-        remapBicubic<Cast<double, double>, float, 1>, 0
+        remapBicubic<FixedPtCast<int, uchar, INTER_REMAP_COEF_BITS>, RemapBicubicVec_8u, short, INTER_REMAP_COEF_SCALE>, 0,
+        remapBicubic<Cast<float, ushort>, RemapBicubicVec_32f, float, 1>,
+        remapBicubic<Cast<float, short>, RemapBicubicVec_32f, float, 1>, 0,
+        remapBicubic<Cast<float, float>, RemapBicubicVec_32f, float, 1>,
+        remapBicubic<Cast<double, double>, RemapBicubicNoVec, float, 1>, 0
     };
 
     static RemapFunc lanczos4_tab[] =
     {
-        remapLanczos4<FixedPtCast<int, uchar, INTER_REMAP_COEF_BITS>, short, INTER_REMAP_COEF_SCALE>, 0,
-        remapLanczos4<Cast<float, ushort>, float, 1>,
-        remapLanczos4<Cast<float, short>, float, 1>, 0,
-        remapLanczos4<Cast<float, float>, float, 1>,
-        remapLanczos4<Cast<double, double>, float, 1>, 0
+        remapLanczos4<FixedPtCast<int, uchar, INTER_REMAP_COEF_BITS>, RemapLanczos4Vec_8u, short, INTER_REMAP_COEF_SCALE>, 0,
+        remapLanczos4<Cast<float, ushort>, RemapLanczos4Vec_32f, float, 1>,
+        remapLanczos4<Cast<float, short>, RemapLanczos4Vec_32f, float, 1>, 0,
+        remapLanczos4<Cast<float, float>, RemapLanczos4Vec_32f, float, 1>,
+        remapLanczos4<Cast<double, double>, RemapLanczos4NoVec, float, 1>, 0
     };
 
     CV_Assert( !_map1.empty() );
@@ -2148,6 +2653,148 @@ void cv::convertMaps( InputArray _map1, InputArray _map2,
     }
 }
 
+namespace cv
+{
+
+class RemapGridInvoker :
+    public ParallelLoopBody
+{
+public:
+    RemapGridInvoker(const Mat &_src, Mat &_dst, const Mat &_grid, int _gridStep,
+                     int _interpolation, int _borderType, const Scalar &_borderValue) :
+        ParallelLoopBody(), src(_src), dst(_dst), grid(_grid), gridStep(_gridStep),
+        interpolation(_interpolation), borderType(_borderType), borderValue(_borderValue)
+    {
+    }
+
+    virtual void operator() (const Range& range) const CV_OVERRIDE
+    {
+        const int BLOCK_SZ = 64;
+        AutoBuffer<short, 0> __XY(BLOCK_SZ * BLOCK_SZ * 2), __A(BLOCK_SZ * BLOCK_SZ);
+        AutoBuffer<float, 0> __XYf(BLOCK_SZ * BLOCK_SZ * 2);
+        short *XY = __XY.data(), *A = __A.data();
+        float *XYf = __XYf.data();
+        const float scale = 1.f/gridStep;
+
+        int bh0 = std::min(BLOCK_SZ/2, dst.rows);
+        int bw0 = std::min(BLOCK_SZ*BLOCK_SZ/bh0, dst.cols);
+        bh0 = std::min(BLOCK_SZ*BLOCK_SZ/bw0, dst.rows);
+
+        for( int y = range.start; y < range.end; y += bh0 )
+        {
+            for( int x = 0; x < dst.cols; x += bw0 )
+            {
+                int bw = std::min( bw0, dst.cols - x);
+                int bh = std::min( bh0, range.end - y);
+
+                Mat _XY(bh, bw, CV_16SC2, XY);
+                Mat dpart(dst, Rect(x, y, bw, bh));
+
+                for( int y1 = 0; y1 < bh; y1++ )
+                {
+                    // interpolate the map between the grid rows, then along the row cell by cell
+                    int gy = (y + y1)/gridStep;
+                    float fy = (y + y1 - gy*gridStep)*scale;
+                    const Vec2f* g0 = grid.ptr<Vec2f>(gy);
+                    const Vec2f* g1 = grid.ptr<Vec2f>(gy + 1);
+                    float* xyf = XYf + y1*bw*2;
+
+                    for( int x1 = 0; x1 < bw; )
+                    {
+                        int gx = (x + x1)/gridStep, x2 = std::min(bw, (gx + 1)*gridStep - x);
+                        Vec2f p0 = g0[gx] + (g1[gx] - g0[gx])*fy;
+                        Vec2f p1 = g0[gx+1] + (g1[gx+1] - g0[gx+1])*fy;
+                        Vec2f d = (p1 - p0)*scale;
+                        p0 += d*(float)(x + x1 - gx*gridStep);
+                        for( int k = 0; x1 < x2; x1++, k++ )
+                        {
+                            xyf[x1*2] = p0[0] + d[0]*k;
+                            xyf[x1*2+1] = p0[1] + d[1]*k;
+                        }
+                    }
+                }
+
+                int n = bw*bh, i = 0;
+                if( interpolation == INTER_NEAREST )
+                {
+                    for( ; i < n*2; i++ )
+                        XY[i] = saturate_cast<short>(XYf[i]);
+                    remap( src, dpart, _XY, Mat(), interpolation, borderType, borderValue );
+                }
+                else
+                {
+                    #if CV_SIMD128
+                    {
+                        v_float32x4 v_scale = v_setall_f32((float)INTER_TAB_SIZE);
+                        v_int32x4 v_mask = v_setall_s32(INTER_TAB_SIZE - 1);
+                        int span = v_float32x4::nlanes;
+                        for( ; i <= n - span * 2; i += span * 2 )
+                        {
+                            v_float32x4 v_fx0, v_fy0, v_fx1, v_fy1;
+                            v_load_deinterleave(XYf + i*2, v_fx0, v_fy0);
+                            v_load_deinterleave(XYf + i*2 + span*2, v_fx1, v_fy1);
+                            v_int32x4 v_X0 = v_round(v_fx0 * v_scale), v_Y0 = v_round(v_fy0 * v_scale);
+                            v_int32x4 v_X1 = v_round(v_fx1 * v_scale), v_Y1 = v_round(v_fy1 * v_scale);
+
+                            v_int16x8 v_xy[2];
+                            v_xy[0] = v_pack(v_shr<INTER_BITS>(v_X0), v_shr<INTER_BITS>(v_X1));
+                            v_xy[1] = v_pack(v_shr<INTER_BITS>(v_Y0), v_shr<INTER_BITS>(v_Y1));
+                            v_store_interleave(XY + i*2, v_xy[0], v_xy[1]);
+
+                            v_int32x4 v_alpha0 = v_shl<INTER_BITS>(v_Y0 & v_mask) | (v_X0 & v_mask);
+                            v_int32x4 v_alpha1 = v_shl<INTER_BITS>(v_Y1 & v_mask) | (v_X1 & v_mask);
+                            v_store(A + i, v_pack(v_alpha0, v_alpha1));
+                        }
+                    }
+                    #endif
+                    for( ; i < n; i++ )
+                    {
+                        int X = saturate_cast<int>(XYf[i*2]*INTER_TAB_SIZE);
+                        int Y = saturate_cast<int>(XYf[i*2+1]*INTER_TAB_SIZE);
+                        XY[i*2] = saturate_cast<short>(X >> INTER_BITS);
+                        XY[i*2+1] = saturate_cast<short>(Y >> INTER_BITS);
+                        A[i] = (short)((Y & (INTER_TAB_SIZE-1))*INTER_TAB_SIZE + (X & (INTER_TAB_SIZE-1)));
+                    }
+                    Mat _matA(bh, bw, CV_16U, A);
+                    remap( src, dpart, _XY, _matA, interpolation, borderType, borderValue );
+                }
+            }
+        }
+    }
+
+private:
+    Mat src;
+    Mat dst;
+    Mat grid;
+    int gridStep, interpolation, borderType;
+    Scalar borderValue;
+};
+
+}
+
+void cv::remapGrid( InputArray _src, OutputArray _dst, InputArray _grid, Size dsize,
+                    int gridStep, int interpolation, int borderType, const Scalar& borderValue )
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat src = _src.getMat(), grid = _grid.getMat();
+    CV_Assert( !src.empty() && !dsize.empty() && gridStep > 0 );
+    CV_Assert( grid.type() == CV_32FC2 &&
+               grid.cols >= (dsize.width - 1)/gridStep + 2 &&
+               grid.rows >= (dsize.height - 1)/gridStep + 2 );
+    if( interpolation == INTER_AREA )
+        interpolation = INTER_LINEAR;
+
+    _dst.create( dsize, src.type() );
+    Mat dst = _dst.getMat();
+    if( dst.data == src.data )
+        src = src.clone();
+
+    Range range(0, dst.rows);
+    RemapGridInvoker invoker(src, dst, grid, gridStep, interpolation, borderType, borderValue);
+    parallel_for_(range, invoker, dst.total()/(double)(1<<16));
+}
+
 
 namespace cv
 {
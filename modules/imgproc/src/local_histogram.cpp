@@ -0,0 +1,101 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+namespace cv {
+
+LocalHistogram::LocalHistogram() : hist_(256, 0), pos_(-1, -1), colRow_(-1)
+{
+}
+
+LocalHistogram::LocalHistogram(InputArray src, Size ksize, int borderType) : hist_(256, 0), pos_(-1, -1), colRow_(-1)
+{
+    init(src, ksize, borderType);
+}
+
+void LocalHistogram::init(InputArray _src, Size ksize, int borderType)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert( _src.type() == CV_8UC1 && !_src.empty() );
+    CV_Assert( ksize.width > 0 && ksize.height > 0 );
+    CV_Assert( (borderType & ~BORDER_ISOLATED) != BORDER_WRAP );
+
+    // the window of the pixel (x, y) is ext_(Rect(x, y, ksize.width, ksize.height))
+    int ax = ksize.width / 2, ay = ksize.height / 2;
+    copyMakeBorder(_src, ext_, ay, ksize.height - 1 - ay, ax, ksize.width - 1 - ax,
+                   borderType & ~BORDER_ISOLATED, Scalar::all(0));
+    colHist_.create(ext_.cols, 256, CV_32S);
+    std::fill(hist_.begin(), hist_.end(), 0);
+    ksize_ = ksize;
+    pos_ = Point(-1, -1);
+    colRow_ = -1;
+}
+
+void LocalHistogram::updateColumns(int y)
+{
+    int* colHist = colHist_.ptr<int>();
+    const int width = ext_.cols;
+
+    if (colRow_ >= 0 && y == colRow_ + 1)
+    {
+        // one row down: remove the top row of the columns and add the new bottom one
+        const uchar* top = ext_.ptr<uchar>(colRow_);
+        const uchar* bottom = ext_.ptr<uchar>(y + ksize_.height - 1);
+        for (int c = 0; c < width; c++, colHist += 256)
+        {
+            colHist[top[c]]--;
+            colHist[bottom[c]]++;
+        }
+    }
+    else
+    {
+        colHist_.setTo(Scalar::all(0));
+        for (int r = y; r < y + ksize_.height; r++)
+        {
+            const uchar* row = ext_.ptr<uchar>(r);
+            for (int c = 0; c < width; c++)
+                colHist[c*256 + row[c]]++;
+        }
+    }
+    colRow_ = y;
+}
+
+void LocalHistogram::sumColumns(int x)
+{
+    int* hist = &hist_[0];
+    std::fill(hist, hist + 256, 0);
+    for (int c = x; c < x + ksize_.width; c++)
+    {
+        const int* colHist = colHist_.ptr<int>(c);
+        for (int i = 0; i < 256; i++)
+            hist[i] += colHist[i];
+    }
+}
+
+void LocalHistogram::moveTo(int x, int y)
+{
+    CV_Assert( !ext_.empty() );
+    CV_Assert( 0 <= x && x <= ext_.cols - ksize_.width && 0 <= y && y <= ext_.rows - ksize_.height );
+
+    if (y != colRow_)
+    {
+        updateColumns(y);
+        sumColumns(x);
+    }
+    else if (x == pos_.x + 1)
+    {
+        int* hist = &hist_[0];
+        const int* added = colHist_.ptr<int>(x + ksize_.width - 1);
+        const int* removed = colHist_.ptr<int>(x - 1);
+        for (int i = 0; i < 256; i++)
+            hist[i] += added[i] - removed[i];
+    }
+    else if (x != pos_.x)
+        sumColumns(x);
+    pos_ = Point(x, y);
+}
+
+} // namespace cv
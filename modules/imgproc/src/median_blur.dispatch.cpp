@@ -309,6 +309,34 @@ void medianBlur( InputArray _src0, OutputArray _dst, int ksize )
         CV_CPU_DISPATCH_MODES_ALL);
 }
 
+void weightedMedianBlur( InputArray _src0, OutputArray _dst, int ksize, InputArray _weights )
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert(!_src0.empty());
+    CV_Assert( (ksize % 2 == 1) && (_src0.dims() <= 2 ));
+
+    int depth = _src0.depth();
+    Mat weights = _weights.getMat();
+    CV_Assert( depth == CV_8U || depth == CV_16U || depth == CV_16S || depth == CV_32F );
+    CV_Assert( weights.type() == CV_8UC1 && weights.size() == _src0.size() );
+
+    Mat src = _src0.getMat();
+    _dst.create( src.size(), src.type() );
+    Mat dst = _dst.getMat();
+    if( dst.data == src.data )
+        src = src.clone();
+
+    if( ksize <= 1 )
+    {
+        src.copyTo(dst);
+        return;
+    }
+
+    CV_CPU_DISPATCH(medianBlurRanked, (src, weights, dst, ksize),
+        CV_CPU_DISPATCH_MODES_ALL);
+}
+
 }  // namespace
 
 /* End of file. */
@@ -77,6 +77,7 @@ namespace cv {
 CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
 // forward declarations
 void medianBlur(const Mat& src0, /*const*/ Mat& dst, int ksize);
+void medianBlurRanked(const Mat& src, const Mat& weights, Mat& dst, int ksize);
 
 #ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
 
@@ -943,8 +944,295 @@ medianBlur_SortNet( const Mat& _src, Mat& _dst, int m )
     }
 }
 
+/*
+ Median of any depth and aperture size.
+
+ The image is processed by tiles. The source values of a tile (with the border of ksize/2) are
+ sorted, and each of them is replaced by its index in the sorted sequence, so the keys are
+ distinct and take log2(tile area) bits independently of the depth. The median of the keys is
+ found with the two-tier histogram of Perreault and Hebert, like in medianBlur_8u_O1: the coarse
+ histograms of the columns are updated once per row, and the coarse histogram of the aperture
+ is updated by adding one column and subtracting another one. Since every key occurs only once,
+ the fine tier is not stored: the keys of the selected coarse bucket are scanned in order and
+ counted if they are inside the aperture. The pixels are counted with their weights, so the
+ weighted median comes at no extra cost.
+*/
+
+static inline unsigned medianSortKey(uchar v) { return v; }
+static inline unsigned medianSortKey(ushort v) { return v; }
+static inline unsigned medianSortKey(short v) { return (ushort)v ^ 0x8000; }
+static inline unsigned medianSortKey(float v)
+{
+    Cv32suf u;
+    u.f = v;
+    return (unsigned)u.i ^ (u.i < 0 ? 0xffffffffu : 0x80000000u);
+}
+
+// stable LSD radix sort of the indices 0..n-1 by the keys
+static const int* medianSortIndices(const unsigned* keys, int n, int bits, int* order, int* buf)
+{
+    for( int i = 0; i < n; i++ )
+        order[i] = i;
+    for( int shift = 0; shift < bits; shift += 8 )
+    {
+        int count[257] = { 0 };
+        for( int i = 0; i < n; i++ )
+            count[((keys[i] >> shift) & 255) + 1]++;
+        if( count[((keys[0] >> shift) & 255) + 1] == n )
+            continue;
+        for( int i = 1; i < 257; i++ )
+            count[i] += count[i - 1];
+        for( int i = 0; i < n; i++ )
+        {
+            int j = order[i];
+            buf[count[(keys[j] >> shift) & 255]++] = j;
+        }
+        std::swap(order, buf);
+    }
+    return order;
+}
+
+class MedianRankHistogram
+{
+public:
+    MedianRankHistogram(int _ksize, int _width, int _height)
+        : ksize(_ksize), width(_width), height(_height)
+    {
+        ncols = width + ksize - 1;
+        int n = ncols*(height + ksize - 1), bits = 1;
+        for( ; (1 << bits) < n; bits++ )
+            ;
+        fbits = bits/2;
+        ncoarse = ((n - 1) >> fbits) + 1;
+        colHist.allocate((size_t)ncols*ncoarse);
+        colTotal.allocate(ncols);
+        hist.allocate(ncoarse);
+        keyCol.allocate(n);
+        keyWeight.allocate(n);
+    }
+
+    // keys: (height + ksize - 1) x (width + ksize - 1) permutation of 0..n-1, weights: the same
+    // layout or NULL; result: width x height keys of the medians, -1 where the weights are all 0
+    void apply(const int* keys, const uchar* weights, int* result)
+    {
+        unsigned* ch = colHist.data();
+        unsigned* ct = colTotal.data();
+        unsigned* h = hist.data();
+        ushort* kc = keyCol.data();
+        ushort* kw = keyWeight.data();
+        int n = ncols*(height + ksize - 1);
+
+        memset(ch, 0, (size_t)ncols*ncoarse*sizeof(ch[0]));
+        memset(ct, 0, ncols*sizeof(ct[0]));
+        memset(kw, 0, n*sizeof(kw[0]));
+        for( int i = 0; i < n; i++ )
+            kc[keys[i]] = (ushort)(i % ncols);
+        for( int y = 0; y < ksize - 1; y++ )
+            updateRow(keys + y*ncols, weights ? weights + y*ncols : 0, true);
+
+        for( int y = 0; y < height; y++ )
+        {
+            // the columns hold the rows y..y+ksize-1
+            updateRow(keys + (y + ksize - 1)*ncols, weights ? weights + (y + ksize - 1)*ncols : 0, true);
+
+            unsigned total = 0;
+            memset(h, 0, ncoarse*sizeof(h[0]));
+            for( int x = 0; x < ksize; x++ )
+            {
+                addColumn(h, ch + (size_t)x*ncoarse, ncoarse, true);
+                total += ct[x];
+            }
+
+            for( int x = 0; x < width; x++ )
+            {
+                if( x > 0 )
+                {
+                    addColumn(h, ch + (size_t)(x + ksize - 1)*ncoarse, ncoarse, true);
+                    addColumn(h, ch + (size_t)(x - 1)*ncoarse, ncoarse, false);
+                    total += ct[x + ksize - 1] - ct[x - 1];
+                }
+                if( total == 0 )
+                {
+                    result[y*width + x] = -1;
+                    continue;
+                }
+
+                unsigned rank = (total - 1)/2, sum = 0;
+                int b = 0;
+                for( ; sum + h[b] <= rank; b++ )
+                    sum += h[b];
+                int k = b << fbits;
+                for( ;; k++ )
+                {
+                    if( (unsigned)(kc[k] - x) < (unsigned)ksize && (sum += kw[k]) > rank )
+                        break;
+                }
+                result[y*width + x] = k;
+            }
+
+            updateRow(keys + y*ncols, weights ? weights + y*ncols : 0, false);
+        }
+    }
+
+protected:
+    void updateRow(const int* keys, const uchar* weights, bool add)
+    {
+        unsigned* ch = colHist.data();
+        unsigned* ct = colTotal.data();
+        ushort* kw = keyWeight.data();
+        for( int x = 0; x < ncols; x++ )
+        {
+            int k = keys[x];
+            unsigned w = weights ? weights[x] : 1;
+            kw[k] = add ? (ushort)w : 0;
+            if( !add )
+                w = 0u - w;
+            ch[(size_t)x*ncoarse + (k >> fbits)] += w;
+            ct[x] += w;
+        }
+    }
+
+    // h += c or h -= c
+    static void addColumn(unsigned* h, const unsigned* c, int n, bool add)
+    {
+        int i = 0;
+#if CV_SIMD
+        if( add )
+            for( ; i <= n - v_uint32::nlanes; i += v_uint32::nlanes )
+                v_store(h + i, vx_load(h + i) + vx_load(c + i));
+        else
+            for( ; i <= n - v_uint32::nlanes; i += v_uint32::nlanes )
+                v_store(h + i, vx_load(h + i) - vx_load(c + i));
+#endif
+        for( ; i < n; i++ )
+            h[i] = add ? h[i] + c[i] : h[i] - c[i];
+    }
+
+    int ksize, width, height, ncols, fbits, ncoarse;
+    AutoBuffer<unsigned> colHist, colTotal, hist;
+    AutoBuffer<ushort> keyCol, keyWeight;
+};
+
+template<typename T> class MedianRankedInvoker : public ParallelLoopBody
+{
+public:
+    MedianRankedInvoker(const Mat& _src, const Mat& _weights, Mat& _dst, int _ksize, int _tileSize)
+        : src(_src), weights(_weights), dst(_dst), ksize(_ksize), tileSize(_tileSize)
+    {
+        ntilesX = (src.cols + tileSize - 1)/tileSize;
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        CV_INSTRUMENT_REGION();
+
+        int cn = src.channels(), r = ksize/2;
+        int maxcols = tileSize + ksize - 1, maxn = maxcols*maxcols;
+        AutoBuffer<unsigned> _skeys(maxn);
+        AutoBuffer<int> _keys(maxn), _order(maxn*2), _result(tileSize*tileSize), _xofs(maxcols);
+        AutoBuffer<uchar> _w(maxn);
+        AutoBuffer<T> _vals(maxn), _sorted(maxn);
+        Ptr<MedianRankHistogram> hist;
+        Size histSize;
+
+        for( int t = range.start; t < range.end; t++ )
+        {
+            int x0 = (t % ntilesX)*tileSize, y0 = (t / ntilesX)*tileSize;
+            int width = std::min(tileSize, src.cols - x0), height = std::min(tileSize, src.rows - y0);
+            int ncols = width + ksize - 1, nrows = height + ksize - 1, n = ncols*nrows;
+            if( histSize != Size(width, height) )
+            {
+                hist = makePtr<MedianRankHistogram>(ksize, width, height);
+                histSize = Size(width, height);
+            }
+
+            // the replicated border, as in medianBlur
+            int* xofs = _xofs.data();
+            for( int x = 0; x < ncols; x++ )
+                xofs[x] = std::min(std::max(x0 + x - r, 0), src.cols - 1);
+            uchar* w = 0;
+            if( !weights.empty() )
+            {
+                w = _w.data();
+                for( int y = 0; y < nrows; y++ )
+                {
+                    const uchar* wrow = weights.ptr(std::min(std::max(y0 + y - r, 0), src.rows - 1));
+                    for( int x = 0; x < ncols; x++ )
+                        w[y*ncols + x] = wrow[xofs[x]];
+                }
+            }
+
+            for( int c = 0; c < cn; c++ )
+            {
+                T* vals = _vals.data();
+                unsigned* skeys = _skeys.data();
+                for( int y = 0; y < nrows; y++ )
+                {
+                    const T* srow = src.ptr<T>(std::min(std::max(y0 + y - r, 0), src.rows - 1)) + c;
+                    for( int x = 0; x < ncols; x++ )
+                    {
+                        T v = srow[xofs[x]*cn];
+                        vals[y*ncols + x] = v;
+                        skeys[y*ncols + x] = medianSortKey(v);
+                    }
+                }
+
+                const int* order = medianSortIndices(skeys, n, (int)sizeof(T)*8, _order.data(), _order.data() + maxn);
+                int* keys = _keys.data();
+                T* sorted = _sorted.data();
+                for( int i = 0; i < n; i++ )
+                {
+                    keys[order[i]] = i;
+                    sorted[i] = vals[order[i]];
+                }
+
+                int* result = _result.data();
+                hist->apply(keys, w, result);
+                for( int y = 0; y < height; y++ )
+                {
+                    T* drow = dst.ptr<T>(y0 + y) + c;
+                    const T* crow = vals + (y + r)*ncols + r;
+                    for( int x = 0; x < width; x++ )
+                    {
+                        int k = result[y*width + x];
+                        drow[(x0 + x)*cn] = k >= 0 ? sorted[k] : crow[x];
+                    }
+                }
+            }
+        }
+    }
+
+protected:
+    const Mat& src;
+    const Mat& weights;
+    Mat& dst;
+    int ksize, tileSize, ntilesX;
+};
+
 } // namespace anon
 
+void medianBlurRanked(const Mat& src, const Mat& weights, Mat& dst, int ksize)
+{
+    CV_INSTRUMENT_REGION();
+
+    // the columns of a tile are stored in 16 bits
+    CV_Assert( ksize < 65536 - 256 );
+    int tileSize = std::min(std::max(ksize/2, 64), 256);
+
+    Range range(0, ((src.cols + tileSize - 1)/tileSize)*((src.rows + tileSize - 1)/tileSize));
+    int depth = src.depth();
+    if( depth == CV_8U )
+        parallel_for_(range, MedianRankedInvoker<uchar>(src, weights, dst, ksize, tileSize));
+    else if( depth == CV_16U )
+        parallel_for_(range, MedianRankedInvoker<ushort>(src, weights, dst, ksize, tileSize));
+    else if( depth == CV_16S )
+        parallel_for_(range, MedianRankedInvoker<short>(src, weights, dst, ksize, tileSize));
+    else if( depth == CV_32F )
+        parallel_for_(range, MedianRankedInvoker<float>(src, weights, dst, ksize, tileSize));
+    else
+        CV_Error(CV_StsUnsupportedFormat, "");
+}
+
 void medianBlur(const Mat& src0, /*const*/ Mat& dst, int ksize)
 {
     CV_INSTRUMENT_REGION();
@@ -978,12 +1266,20 @@ void medianBlur(const Mat& src0, /*const*/ Mat& dst, int ksize)
     }
     else
     {
+        int cn = src0.channels();
+        if( src0.depth() != CV_8U || !(cn == 1 || cn == 3 || cn == 4) )
+        {
+            if( dst.data != src0.data )
+                src = src0;
+            else
+                src0.copyTo(src);
+            medianBlurRanked( src, Mat(), dst, ksize );
+            return;
+        }
+
         // TODO AVX guard (external call)
         cv::copyMakeBorder( src0, src, 0, 0, ksize/2, ksize/2, BORDER_REPLICATE|BORDER_ISOLATED);
 
-        int cn = src0.channels();
-        CV_Assert( src.depth() == CV_8U && (cn == 1 || cn == 3 || cn == 4) );
-
         double img_size_mp = (double)(src0.total())/(1 << 20);
         if( ksize <= 3 + (img_size_mp < 1 ? 12 : img_size_mp < 4 ? 6 : 2)*
             (CV_SIMD ? 1 : 3))
@@ -87,6 +87,33 @@ Ptr<BaseFilter> getMorphologyFilter(int op, int type, InputArray _kernel, Point
 }
 
 
+static void morphRectangles(int op, const Mat& src, Mat& dst, const std::vector<Rect>& rects)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_CPU_DISPATCH(morphRectangles, (op, src, dst, rects),
+        CV_CPU_DISPATCH_MODES_ALL);
+}
+
+
+static Scalar getMorphologyBorderValue(int op, int depth, const Scalar& borderValue)
+{
+    if( borderValue != morphologyDefaultBorderValue() )
+        return borderValue;
+    CV_Assert( depth == CV_8U || depth == CV_16U || depth == CV_16S ||
+               depth == CV_32F || depth == CV_64F );
+    if( op == MORPH_ERODE )
+        return Scalar::all( depth == CV_8U ? (double)UCHAR_MAX :
+                            depth == CV_16U ? (double)USHRT_MAX :
+                            depth == CV_16S ? (double)SHRT_MAX :
+                            depth == CV_32F ? (double)FLT_MAX : DBL_MAX);
+    return Scalar::all( depth == CV_8U || depth == CV_16U ?
+                            0. :
+                        depth == CV_16S ? (double)SHRT_MIN :
+                        depth == CV_32F ? (double)-FLT_MAX : -DBL_MAX);
+}
+
+
 Ptr<FilterEngine> createMorphologyFilter(
         int op, int type, InputArray _kernel,
         Point anchor, int _rowBorderType, int _columnBorderType,
@@ -109,23 +136,8 @@ Ptr<FilterEngine> createMorphologyFilter(
         filter2D = getMorphologyFilter(op, type, kernel, anchor);
 
     Scalar borderValue = _borderValue;
-    if( (_rowBorderType == BORDER_CONSTANT || _columnBorderType == BORDER_CONSTANT) &&
-            borderValue == morphologyDefaultBorderValue() )
-    {
-        int depth = CV_MAT_DEPTH(type);
-        CV_Assert( depth == CV_8U || depth == CV_16U || depth == CV_16S ||
-                   depth == CV_32F || depth == CV_64F );
-        if( op == MORPH_ERODE )
-            borderValue = Scalar::all( depth == CV_8U ? (double)UCHAR_MAX :
-                                       depth == CV_16U ? (double)USHRT_MAX :
-                                       depth == CV_16S ? (double)SHRT_MAX :
-                                       depth == CV_32F ? (double)FLT_MAX : DBL_MAX);
-        else
-            borderValue = Scalar::all( depth == CV_8U || depth == CV_16U ?
-                                           0. :
-                                       depth == CV_16S ? (double)SHRT_MIN :
-                                       depth == CV_32F ? (double)-FLT_MAX : -DBL_MAX);
-    }
+    if( _rowBorderType == BORDER_CONSTANT || _columnBorderType == BORDER_CONSTANT )
+        borderValue = getMorphologyBorderValue(op, CV_MAT_DEPTH(type), borderValue);
 
     return makePtr<FilterEngine>(filter2D, rowFilter, columnFilter,
                                  type, type, type, _rowBorderType, _columnBorderType, borderValue );
@@ -431,6 +443,66 @@ static bool ippMorph(int op, int src_type, int dst_type,
 
 // ===== 3. Fallback implementation
 
+// Splits the structuring element into the rectangles, if each of its rows is a single run of
+// the non-zero elements, as in MORPH_RECT, MORPH_CROSS and MORPH_ELLIPSE. For every distinct
+// run, the rectangle spans the neighbouring rows that contain it. Returns false if the
+// rectangles are not expected to be faster than the row/column or 2D filter.
+static bool getMorphologyRectangles(const Mat& kernel, std::vector<Rect>& rects)
+{
+    if( kernel.type() != CV_8U || std::max(kernel.cols, kernel.rows) < 16 )
+        return false;
+
+    std::vector<Range> runs(kernel.rows);
+    int nz = 0;
+    for( int i = 0; i < kernel.rows; i++ )
+    {
+        const uchar* k = kernel.ptr(i);
+        int j = 0, j1;
+        for( ; j < kernel.cols && !k[j]; j++ )
+            ;
+        for( j1 = j; j < kernel.cols && k[j]; j++ )
+            ;
+        runs[i] = Range(j1, j);
+        nz += j - j1;
+        for( ; j < kernel.cols; j++ )
+            if( k[j] )
+                return false;
+    }
+
+    rects.clear();
+    for( int i = 0; i < kernel.rows; i++ )
+    {
+        const Range& r = runs[i];
+        if( r.empty() )
+            continue;
+        bool found = false;
+        for( size_t k = 0; k < rects.size() && !found; k++ )
+            found = rects[k].x == r.start && rects[k].width == r.size() &&
+                    rects[k].y <= i && i < rects[k].y + rects[k].height;
+        if( found )
+            continue;
+        int i0 = i, i1 = i + 1;
+        for( ; i0 > 0 && runs[i0 - 1].start <= r.start && r.end <= runs[i0 - 1].end; i0-- )
+            ;
+        for( ; i1 < kernel.rows && runs[i1].start <= r.start && r.end <= runs[i1].end; i1++ )
+            ;
+        rects.push_back(Rect(r.start, i0, r.size(), i1 - i0));
+    }
+
+    // the approximate number of the vector operations per pixel; the passes of the rectangles
+    // access memory more, so they are used when the filters need several times more operations
+    int cost = 0;
+    for( size_t k = 0; k < rects.size(); k++ )
+    {
+        int w = rects[k].width, log2w = 0;
+        for( ; (2 << log2w) <= w; log2w++ )
+            ;
+        cost += log2w + (w > 1) + (rects[k].height > 1)*3 + (k > 0) + 2;
+    }
+    int filterCost = nz == kernel.rows*kernel.cols ? kernel.rows + kernel.cols : nz;
+    return cost*9 < filterCost*2;
+}
+
 static void ocvMorph(int op, int src_type, int dst_type,
                      uchar * src_data, size_t src_step,
                      uchar * dst_data, size_t dst_step,
@@ -444,6 +516,28 @@ static void ocvMorph(int op, int src_type, int dst_type,
     Mat kernel(Size(kernel_width, kernel_height), kernel_type, kernel_data, kernel_step);
     Point anchor(anchor_x, anchor_y);
     Vec<double, 4> borderVal(borderValue);
+
+    std::vector<Rect> rects;
+    if( src_type == dst_type && getMorphologyRectangles(kernel, rects) )
+    {
+        Scalar value = getMorphologyBorderValue(op, CV_MAT_DEPTH(src_type), borderVal);
+        size_t esz = CV_ELEM_SIZE(src_type);
+        Mat dst(Size(width, height), dst_type, dst_data, dst_step), padded;
+        for( int i = 0; i < iterations; i++ )
+        {
+            // the pixels outside of the ROI are taken from the whole image like in FilterEngine
+            Size wsz = i == 0 ? Size(roi_width, roi_height) : Size(roi_width2, roi_height2);
+            Point ofs = i == 0 ? Point(roi_x, roi_y) : Point(roi_x2, roi_y2);
+            size_t step = i == 0 ? src_step : dst_step;
+            uchar* data = (i == 0 ? src_data : dst_data) - ofs.y*step - ofs.x*esz;
+            Mat src = Mat(wsz, src_type, data, step)(Rect(ofs, Size(width, height)));
+            copyMakeBorder(src, padded, anchor.y, kernel.rows - anchor.y - 1,
+                           anchor.x, kernel.cols - anchor.x - 1, borderType, value);
+            morphRectangles(op, padded, dst, rects);
+        }
+        return;
+    }
+
     Ptr<FilterEngine> f = createMorphologyFilter(op, src_type, kernel, anchor, borderType, borderType, borderVal);
     Mat src(Size(width, height), src_type, src_data, src_step);
     Mat dst(Size(width, height), dst_type, dst_data, dst_step);
@@ -54,6 +54,7 @@ CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
 Ptr<BaseRowFilter> getMorphologyRowFilter(int op, int type, int ksize, int anchor);
 Ptr<BaseColumnFilter> getMorphologyColumnFilter(int op, int type, int ksize, int anchor);
 Ptr<BaseFilter> getMorphologyFilter(int op, int type, const Mat& kernel, Point anchor);
+void morphRectangles(int op, const Mat& src, Mat& dst, const std::vector<Rect>& rects);
 
 #ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
 
@@ -106,6 +107,11 @@ struct MorphNoVec
     int operator()(uchar**, int, uchar*, int) const { return 0; }
 };
 
+struct MorphLineNoVec
+{
+    template<typename T> int operator()(const T*, const T*, T*, int) const { return 0; }
+};
+
 #if CV_SIMD
 
 template<class VecUpdate> struct MorphRowVec
@@ -406,6 +412,27 @@ template<class VecUpdate> struct MorphVec
     }
 };
 
+// element-wise min/max of two lines
+template<class VecUpdate> struct MorphLineVec
+{
+    typedef typename VecUpdate::vtype vtype;
+    typedef typename vtype::lane_type stype;
+    int operator()(const stype* a, const stype* b, stype* dst, int width) const
+    {
+        int i = 0;
+        VecUpdate updateOp;
+
+        for( ; i <= width - 2*vtype::nlanes; i += 2*vtype::nlanes )
+        {
+            v_store(dst + i, updateOp(vx_load(a + i), vx_load(b + i)));
+            v_store(dst + i + vtype::nlanes, updateOp(vx_load(a + i + vtype::nlanes), vx_load(b + i + vtype::nlanes)));
+        }
+        for( ; i <= width - vtype::nlanes; i += vtype::nlanes )
+            v_store(dst + i, updateOp(vx_load(a + i), vx_load(b + i)));
+        return i;
+    }
+};
+
 template <typename T> struct VMin
 {
     typedef T vtype;
@@ -444,6 +471,15 @@ typedef MorphVec<VMax<v_int16> > DilateVec16s;
 typedef MorphVec<VMin<v_float32> > ErodeVec32f;
 typedef MorphVec<VMax<v_float32> > DilateVec32f;
 
+typedef MorphLineVec<VMin<v_uint8> > ErodeLineVec8u;
+typedef MorphLineVec<VMax<v_uint8> > DilateLineVec8u;
+typedef MorphLineVec<VMin<v_uint16> > ErodeLineVec16u;
+typedef MorphLineVec<VMax<v_uint16> > DilateLineVec16u;
+typedef MorphLineVec<VMin<v_int16> > ErodeLineVec16s;
+typedef MorphLineVec<VMax<v_int16> > DilateLineVec16s;
+typedef MorphLineVec<VMin<v_float32> > ErodeLineVec32f;
+typedef MorphLineVec<VMax<v_float32> > DilateLineVec32f;
+
 #else
 
 typedef MorphRowNoVec ErodeRowVec8u;
@@ -475,6 +511,15 @@ typedef MorphNoVec DilateVec16s;
 typedef MorphNoVec ErodeVec32f;
 typedef MorphNoVec DilateVec32f;
 
+typedef MorphLineNoVec ErodeLineVec8u;
+typedef MorphLineNoVec DilateLineVec8u;
+typedef MorphLineNoVec ErodeLineVec16u;
+typedef MorphLineNoVec DilateLineVec16u;
+typedef MorphLineNoVec ErodeLineVec16s;
+typedef MorphLineNoVec DilateLineVec16s;
+typedef MorphLineNoVec ErodeLineVec32f;
+typedef MorphLineNoVec DilateLineVec32f;
+
 #endif
 
 typedef MorphRowNoVec ErodeRowVec64f;
@@ -483,6 +528,8 @@ typedef MorphColumnNoVec ErodeColumnVec64f;
 typedef MorphColumnNoVec DilateColumnVec64f;
 typedef MorphNoVec ErodeVec64f;
 typedef MorphNoVec DilateVec64f;
+typedef MorphLineNoVec ErodeLineVec64f;
+typedef MorphLineNoVec DilateLineVec64f;
 
 
 template<class Op, class VecOp> struct MorphRowFilter : public BaseRowFilter
@@ -704,6 +751,139 @@ template<class Op, class VecOp> struct MorphFilter : BaseFilter
     VecOp vecOp;
 };
 
+/*
+ Erosion/dilation by a union of rectangles, the cost per pixel does not depend on the rectangle
+ height and grows as log2 of its width.
+
+ The vertical pass is the van Herk/Gil-Werman algorithm: the input rows are split into blocks of
+ ksize rows, and the result is the min/max of the suffix of one block and the prefix of the next
+ one, 3 operations per pixel, each of them is vectorized along the row.
+ In the horizontal pass the same recurrences run along the row and can not be vectorized,
+ so the window is covered by two overlapping windows of 2^k elements instead, which are built
+ by doubling.
+*/
+template<class Op, class VecOp> struct MorphRectanglesInvoker : ParallelLoopBody
+{
+    typedef typename Op::rtype T;
+
+    MorphRectanglesInvoker(const Mat& _src, Mat& _dst, const std::vector<Rect>& _rects)
+        : src(_src), dst(_dst), rects(_rects)
+    {
+    }
+
+    void line(const T* a, const T* b, T* d, int width) const
+    {
+        Op op;
+        int i = vecOp(a, b, d, width);
+        for( ; i < width; i++ )
+            d[i] = op(a[i], b[i]);
+    }
+
+    // d[i] = op(s[i], s[i + cn], ..., s[i + (ksize-1)*cn]), i < width
+    void horizontal(const T* s, T* d, int width, int ksize, int cn, T* buf) const
+    {
+        int len = width + (ksize - 1)*cn, k = 1;
+        const T* m = s;
+        for( ; k*2 <= ksize; k *= 2 )
+        {
+            len -= k*cn;
+            line(m, m + k*cn, buf, len);
+            m = buf;
+        }
+        line(m, m + (ksize - k)*cn, d, width);
+    }
+
+    // d[i] = op(s[i], s[i + 1], ..., s[i + ksize - 1]), i < count, on the rows of `width` elements;
+    // the rows are processed by the stripes of columns to keep the buffers in cache
+    void vertical(const T** s, T** d, int count, int width, int ksize, int stripe, T* buf) const
+    {
+        T* acc = buf + stripe*ksize;
+        for( int x = 0; x < width; x += stripe )
+        {
+            int w = std::min(width - x, stripe);
+            for( int y = 0; y < count; y += ksize )
+            {
+                // suffixes of the block [y, y + ksize)
+                T* sfx = buf + (ksize - 1)*stripe;
+                memcpy(sfx, s[y + ksize - 1] + x, w*sizeof(T));
+                for( int k = ksize - 2; k >= 0; k--, sfx -= stripe )
+                    line(s[y + k] + x, sfx, sfx - stripe, w);
+                memcpy(d[y] + x, buf, w*sizeof(T));
+                // prefixes of the next block
+                for( int k = 1; k < ksize && y + k < count; k++ )
+                {
+                    const T* row = s[y + ksize - 1 + k] + x;
+                    if( k > 1 )
+                        line(row, acc, acc, w);
+                    else
+                        memcpy(acc, row, w*sizeof(T));
+                    line(buf + k*stripe, acc, d[y + k] + x, w);
+                }
+            }
+        }
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        CV_INSTRUMENT_REGION();
+
+        int cn = src.channels(), width = dst.cols*cn, maxw = 1, maxh = 1;
+        for( size_t i = 0; i < rects.size(); i++ )
+        {
+            maxw = std::max(maxw, rects[i].width);
+            maxh = std::max(maxh, rects[i].height);
+        }
+        // the vertical pass goes first, by the blocks of rows that fit into cache, and
+        // the horizontal one takes its output
+        int vwidth = width + (maxw - 1)*cn, stripe = std::max(((1 << 16)/(int)(maxh*sizeof(T))) & -64, 64);
+        int block = std::max(maxh*std::max((1 << 17)/(maxh*vwidth*(int)sizeof(T)), 1), 16);
+        AutoBuffer<T> _vbuf((size_t)block*vwidth + (size_t)stripe*(maxh + 1) + vwidth + maxw*cn + width);
+        T* vbuf = _vbuf.data();
+        T* sbuf = vbuf + (size_t)block*vwidth;
+        T* lbuf = sbuf + (size_t)stripe*(maxh + 1);
+        T* tbuf = lbuf + vwidth + maxw*cn;
+        std::vector<const T*> srows(block + maxh - 1);
+        std::vector<T*> vrows(block);
+        for( int y = 0; y < block; y++ )
+            vrows[y] = vbuf + (size_t)y*vwidth;
+
+        for( int y0 = range.start; y0 < range.end; y0 += block )
+        {
+            int count = std::min(range.end - y0, block);
+            for( size_t i = 0; i < rects.size(); i++ )
+            {
+                const Rect& r = rects[i];
+                const T** rows = &srows[0];
+                for( int y = 0; y < count + r.height - 1; y++ )
+                    srows[y] = src.ptr<T>(y0 + r.y + y) + r.x*cn;
+                if( r.height > 1 )
+                {
+                    vertical(rows, &vrows[0], count, width + (r.width - 1)*cn, r.height, stripe, sbuf);
+                    rows = (const T**)&vrows[0];
+                }
+
+                for( int y = 0; y < count; y++ )
+                {
+                    // the first rectangle is written to dst, the others are combined with it
+                    T* d = dst.ptr<T>(y0 + y);
+                    T* h = i == 0 ? d : tbuf;
+                    if( r.width > 1 )
+                        horizontal(rows[y], h, width, r.width, cn, lbuf);
+                    else
+                        memcpy(h, rows[y], width*sizeof(T));
+                    if( i > 0 )
+                        line(d, tbuf, d, width);
+                }
+            }
+        }
+    }
+
+    const Mat& src;
+    Mat& dst;
+    const std::vector<Rect>& rects;
+    VecOp vecOp;
+};
+
 } // namespace anon
 
 /////////////////////////////////// External Interface /////////////////////////////////////
@@ -841,6 +1021,50 @@ Ptr<BaseFilter> getMorphologyFilter(int op, int type, const Mat& kernel, Point a
     CV_Error_( CV_StsNotImplemented, ("Unsupported data type (=%d)", type));
 }
 
+void morphRectangles(int op, const Mat& src, Mat& dst, const std::vector<Rect>& rects)
+{
+    CV_INSTRUMENT_REGION();
+
+    int depth = src.depth(), maxh = 1;
+    CV_Assert( op == MORPH_ERODE || op == MORPH_DILATE );
+    for( size_t i = 0; i < rects.size(); i++ )
+        maxh = std::max(maxh, rects[i].height);
+    // the row stripes are high enough to keep the overhead of the vertical pass small
+    double nstripes = std::max(std::min((double)getNumThreads()*2, dst.rows/(4.*maxh)), 1.);
+    Range range(0, dst.rows);
+
+    if( op == MORPH_ERODE )
+    {
+        if( depth == CV_8U )
+            parallel_for_(range, MorphRectanglesInvoker<MinOp<uchar>, ErodeLineVec8u>(src, dst, rects), nstripes);
+        else if( depth == CV_16U )
+            parallel_for_(range, MorphRectanglesInvoker<MinOp<ushort>, ErodeLineVec16u>(src, dst, rects), nstripes);
+        else if( depth == CV_16S )
+            parallel_for_(range, MorphRectanglesInvoker<MinOp<short>, ErodeLineVec16s>(src, dst, rects), nstripes);
+        else if( depth == CV_32F )
+            parallel_for_(range, MorphRectanglesInvoker<MinOp<float>, ErodeLineVec32f>(src, dst, rects), nstripes);
+        else if( depth == CV_64F )
+            parallel_for_(range, MorphRectanglesInvoker<MinOp<double>, ErodeLineVec64f>(src, dst, rects), nstripes);
+        else
+            CV_Error_( CV_StsNotImplemented, ("Unsupported data type (=%d)", src.type()));
+    }
+    else
+    {
+        if( depth == CV_8U )
+            parallel_for_(range, MorphRectanglesInvoker<MaxOp<uchar>, DilateLineVec8u>(src, dst, rects), nstripes);
+        else if( depth == CV_16U )
+            parallel_for_(range, MorphRectanglesInvoker<MaxOp<ushort>, DilateLineVec16u>(src, dst, rects), nstripes);
+        else if( depth == CV_16S )
+            parallel_for_(range, MorphRectanglesInvoker<MaxOp<short>, DilateLineVec16s>(src, dst, rects), nstripes);
+        else if( depth == CV_32F )
+            parallel_for_(range, MorphRectanglesInvoker<MaxOp<float>, DilateLineVec32f>(src, dst, rects), nstripes);
+        else if( depth == CV_64F )
+            parallel_for_(range, MorphRectanglesInvoker<MaxOp<double>, DilateLineVec64f>(src, dst, rects), nstripes);
+        else
+            CV_Error_( CV_StsNotImplemented, ("Unsupported data type (=%d)", src.type()));
+    }
+}
+
 #endif
 CV_CPU_OPTIMIZATION_NAMESPACE_END
 } // namespace
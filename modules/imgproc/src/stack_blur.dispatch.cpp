@@ -0,0 +1,38 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html
+
+#include "precomp.hpp"
+
+#include "stack_blur.simd.hpp"
+#include "stack_blur.simd_declarations.hpp" // defines CV_CPU_DISPATCH_MODES_ALL=AVX2,...,BASELINE based on CMakeLists.txt content
+
+namespace cv {
+
+void stackBlur(InputArray _src, OutputArray _dst, Size ksize)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert( !_src.empty() && _src.dims() <= 2 );
+    CV_Assert( ksize.width > 0 && ksize.height > 0 && ksize.width % 2 == 1 && ksize.height % 2 == 1 );
+    int depth = _src.depth();
+    if( depth != CV_8U && depth != CV_16U && depth != CV_16S && depth != CV_32F )
+        CV_Error( CV_StsUnsupportedFormat, "stackBlur is only implemented for 8u, 16u, 16s and 32f images" );
+
+    Mat src = _src.getMat();
+    _dst.create( src.size(), src.type() );
+    Mat dst = _dst.getMat();
+
+    if( ksize.width == 1 && ksize.height == 1 )
+    {
+        src.copyTo(dst);
+        return;
+    }
+    if( dst.data == src.data )
+        src = src.clone();
+
+    CV_CPU_DISPATCH(stackBlur, (src, dst, ksize.width/2, ksize.height/2),
+        CV_CPU_DISPATCH_MODES_ALL);
+}
+
+} // namespace
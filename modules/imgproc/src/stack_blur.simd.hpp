@@ -0,0 +1,179 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html
+
+#include "precomp.hpp"
+#include "opencv2/core/hal/intrin.hpp"
+
+/*
+ Stack blur (M. Klingemann). The kernel of the radius r has the weights r+1-|i|, i = -r..r, that
+ is the convolution of two boxes of the size r+1. The weighted sum S of the window is updated in
+ constant time per pixel with the sums of the values that enter (In) and leave (Out) it:
+
+    S(i+1) = S(i) + In(i) - Out(i),  In(i) = x(i+1) + ... + x(i+r+1),  Out(i) = x(i-r) + ... + x(i)
+
+ The rows are blurred horizontally into a ring buffer of 2*ry+3 float rows, from which the vertical
+ pass is computed for all the columns at once. The image is split into horizontal bands processed
+ in parallel; the border is replicated.
+*/
+
+namespace cv {
+CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
+// forward declarations
+void stackBlur(const Mat& src, Mat& dst, int rx, int ry);
+
+#ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+namespace {
+
+template<typename T> class StackBlurInvoker : public ParallelLoopBody
+{
+public:
+    StackBlurInvoker(const Mat& _src, Mat& _dst, int _rx, int _ry, int _nbands)
+        : src(_src), dst(_dst), rx(_rx), ry(_ry), nbands(_nbands)
+    {
+    }
+
+    // the normalized horizontal blur of the source row y, with the replicated border
+    void blurRow(int y, float* dst_, T* line) const
+    {
+        int cn = src.channels(), width = src.cols*cn;
+        const T* s = src.ptr<T>(std::min(std::max(y, 0), src.rows - 1));
+        if( rx == 0 )
+        {
+            for( int i = 0; i < width; i++ )
+                dst_[i] = (float)s[i];
+            return;
+        }
+
+        // rx pixels on the left and rx + 2 on the right
+        T* l = line + rx*cn;
+        memcpy(l, s, width*sizeof(T));
+        for( int i = 0; i < rx*cn; i++ )
+            line[i] = s[i % cn];
+        for( int i = 0; i < (rx + 2)*cn; i++ )
+            l[width + i] = s[width - cn + i % cn];
+
+        double scale = 1./((rx + 1)*(rx + 1));
+        for( int c = 0; c < cn; c++ )
+        {
+            const T* x = l + c;
+            float* d = dst_ + c;
+            double S = 0, In = 0, Out = 0;
+            for( int j = -rx; j <= rx; j++ )
+                S += (double)x[j*cn]*(rx + 1 - std::abs(j));
+            for( int j = 1; j <= rx + 1; j++ )
+                In += x[j*cn];
+            for( int j = -rx; j <= 0; j++ )
+                Out += x[j*cn];
+            for( int i = 0; i < width; i += cn )
+            {
+                d[i] = (float)(S*scale);
+                S += In - Out;
+                double x1 = x[i + cn];
+                In += x[i + (rx + 2)*cn] - x1;
+                Out += x1 - x[i - rx*cn];
+            }
+        }
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        CV_INSTRUMENT_REGION();
+
+        int cn = src.channels(), width = src.cols*cn, nrows = 2*ry + 3;
+        AutoBuffer<float> _ring((size_t)nrows*width), _acc(width*4);
+        AutoBuffer<T> _line((src.cols + 2*rx + 2)*cn);
+        float* ring = _ring.data();
+        float *S = _acc.data(), *In = S + width, *Out = In + width, *out = Out + width;
+        T* line = _line.data();
+        float scale = 1.f/((ry + 1)*(ry + 1));
+
+        for( int band = range.start; band < range.end; band++ )
+        {
+            int y0 = (int)((int64)src.rows*band/nbands), y1 = (int)((int64)src.rows*(band + 1)/nbands);
+
+            // the ring holds the rows y-ry..y+ry+2, the row k is at (k - y0 + ry) % nrows
+            for( int k = 0; k < nrows; k++ )
+                blurRow(y0 - ry + k, ring + (size_t)k*width, line);
+            memset(S, 0, width*3*sizeof(float));
+            for( int j = -ry; j <= ry + 1; j++ )
+            {
+                const float* r = ring + (size_t)(j + ry)*width;
+                float w = (float)(ry + 1 - std::abs(j));
+                for( int i = 0; i < width; i++ )
+                {
+                    if( j <= ry )
+                        S[i] += r[i]*w;
+                    if( j > 0 )
+                        In[i] += r[i];
+                    else
+                        Out[i] += r[i];
+                }
+            }
+
+            for( int y = y0; y < y1; y++ )
+            {
+                const float* r0 = ring + (size_t)((y - ry - y0 + ry) % nrows)*width;        // y - ry
+                const float* r1 = ring + (size_t)((y + 1 - y0 + ry) % nrows)*width;         // y + 1
+                const float* r2 = ring + (size_t)((y + ry + 2 - y0 + ry) % nrows)*width;    // y + ry + 2
+                int i = 0;
+#if CV_SIMD
+                v_float32 vscale = vx_setall_f32(scale);
+                for( ; i <= width - v_float32::nlanes; i += v_float32::nlanes )
+                {
+                    v_float32 s = vx_load(S + i), in = vx_load(In + i), o = vx_load(Out + i);
+                    v_float32 x0 = vx_load(r0 + i), x1 = vx_load(r1 + i), x2 = vx_load(r2 + i);
+                    v_store(out + i, s*vscale);
+                    v_store(S + i, s + in - o);
+                    v_store(In + i, in + x2 - x1);
+                    v_store(Out + i, o + x1 - x0);
+                }
+#endif
+                for( ; i < width; i++ )
+                {
+                    out[i] = S[i]*scale;
+                    S[i] += In[i] - Out[i];
+                    In[i] += r2[i] - r1[i];
+                    Out[i] += r1[i] - r0[i];
+                }
+                Mat(1, width, CV_32F, out).convertTo(Mat(1, width, DataType<T>::depth, dst.ptr<T>(y)), DataType<T>::depth);
+
+                // the row y - ry is not needed any more, it is replaced with y + ry + 3
+                if( y + 1 < y1 )
+                    blurRow(y + ry + 3, (float*)r0, line);
+            }
+        }
+    }
+
+private:
+    const Mat& src;
+    Mat& dst;
+    int rx, ry, nbands;
+};
+
+} // namespace anon
+
+void stackBlur(const Mat& src, Mat& dst, int rx, int ry)
+{
+    CV_INSTRUMENT_REGION();
+
+    // the bands overlap by 2*ry+3 rows
+    int nbands = std::max(1, std::min(getNumThreads()*2, src.rows/(4*(ry + 1))));
+    Range range(0, nbands);
+    int depth = src.depth();
+    if( depth == CV_8U )
+        parallel_for_(range, StackBlurInvoker<uchar>(src, dst, rx, ry, nbands));
+    else if( depth == CV_16U )
+        parallel_for_(range, StackBlurInvoker<ushort>(src, dst, rx, ry, nbands));
+    else if( depth == CV_16S )
+        parallel_for_(range, StackBlurInvoker<short>(src, dst, rx, ry, nbands));
+    else if( depth == CV_32F )
+        parallel_for_(range, StackBlurInvoker<float>(src, dst, rx, ry, nbands));
+    else
+        CV_Error(CV_StsUnsupportedFormat, "");
+}
+
+#endif
+CV_CPU_OPTIMIZATION_NAMESPACE_END
+} // namespace
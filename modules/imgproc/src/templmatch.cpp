@@ -41,6 +41,7 @@
 
 #include "precomp.hpp"
 #include "opencl_kernels_imgproc.hpp"
+#include "opencv2/core/hal/intrin.hpp"
 
 ////////////////////////////////////////////////// matchTemplate //////////////////////////////////////////////////////////
 
@@ -903,32 +904,197 @@ static void matchTemplateMask( InputArray _img, InputArray _templ, OutputArray _
     }
 }
 
-static void common_matchTemplate( Mat& img, Mat& templ, Mat& result, int method, int cn )
+// Turns the cross-correlation in result into the score of the method, the window sums of the image
+// are taken from its integrals. If centered is true, result holds the correlation of the image with
+// the zero-mean template, which is the TM_CCOEFF numerator as is, and the other methods get the
+// correlation with the template mean added back here in double precision.
+class MatchTemplateNorm_Invoker : public ParallelLoopBody
 {
-    if( method == CV_TM_CCORR )
-        return;
+public:
+    MatchTemplateNorm_Invoker(const Mat& sum, const Mat& sqsum, Mat& result, Size templSize, int method, int cn,
+                              bool centered, const Scalar& templMean, const Scalar& templMeanC,
+                              double templNorm, double templSum2) :
+        sum_(sum), sqsum_(sqsum), result_(result), templSize_(templSize), method_(method), cn_(cn),
+        centered_(centered), templMean_(templMean), templMeanC_(templMeanC),
+        templNorm_(templNorm), templSum2_(templSum2)
+    {
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        const int method = method_, cn = cn_;
+        int numType = method == CV_TM_CCORR || method == CV_TM_CCORR_NORMED ? 0 :
+                      method == CV_TM_CCOEFF || method == CV_TM_CCOEFF_NORMED ? 1 : 2;
+        bool isNormed = method == CV_TM_CCORR_NORMED ||
+                        method == CV_TM_SQDIFF_NORMED ||
+                        method == CV_TM_CCOEFF_NORMED;
+
+        double invArea = 1./((double)templSize_.height * templSize_.width);
+        const Scalar& templMean = templMean_;
+        const double templNorm = templNorm_, templSum2 = templSum2_;
+
+        const double *q0 = 0, *q1 = 0, *q2 = 0, *q3 = 0;
+        if( sqsum_.data )
+        {
+            q0 = (const double*)sqsum_.data;
+            q1 = q0 + templSize_.width*cn;
+            q2 = (const double*)(sqsum_.data + templSize_.height*sqsum_.step);
+            q3 = q2 + templSize_.width*cn;
+        }
+
+        CV_Assert(sum_.data != NULL);
+        const double* p0 = (const double*)sum_.data;
+        const double* p1 = p0 + templSize_.width*cn;
+        const double* p2 = (const double*)(sum_.data + templSize_.height*sum_.step);
+        const double* p3 = p2 + templSize_.width*cn;
+
+        int sumstep = (int)(sum_.step / sizeof(double));
+        int sqstep = sqsum_.data ? (int)(sqsum_.step / sizeof(double)) : 0;
 
+        int i, j, k;
+
+        for( i = range.start; i < range.end; i++ )
+        {
+            float* rrow = result_.ptr<float>(i);
+            int idx = i * sumstep;
+            int idx2 = i * sqstep;
+            j = 0;
+
+#if CV_SIMD_64F
+            if( cn == 1 )
+            {
+                // the same computations as below, in the same order, so the results are identical
+                const int VECSZ = v_float64::nlanes;
+                v_float64 v_zero = vx_setzero_f64(), v_one = vx_setall_f64(1.), v_minus_one = vx_setall_f64(-1.);
+                v_float64 v_invArea = vx_setall_f64(invArea), v_tmean = vx_setall_f64(templMean[0]);
+                v_float64 v_tmeanC = vx_setall_f64(templMeanC_[0]), v_tnorm = vx_setall_f64(templNorm);
+                v_float64 v_tsum2 = vx_setall_f64(templSum2), v_eps = vx_setall_f64(10 * FLT_EPSILON);
+                v_float64 v_half = vx_setall_f64(0.5), v_bound = vx_setall_f64(1.125);
+                v_float64 v_other = vx_setall_f64(method != CV_TM_SQDIFF_NORMED ? 0. : 1.);
+                for( ; j <= result_.cols - VECSZ; j += VECSZ, idx += VECSZ, idx2 += VECSZ )
+                {
+                    v_float64 num = v_cvt_f64(vx_load_low(rrow + j)), wndMean2 = v_zero, wndSum2 = v_zero;
+                    v_float64 wsum = vx_load(p0 + idx) - vx_load(p1 + idx) - vx_load(p2 + idx) + vx_load(p3 + idx);
+
+                    if( centered_ && numType != 1 )
+                        num += wsum * v_tmeanC;
+
+                    if( numType == 1 )
+                    {
+                        wndMean2 = wsum * wsum * v_invArea;
+                        if( !centered_ )
+                            num -= wsum * v_tmean;
+                    }
+
+                    if( isNormed || numType == 2 )
+                    {
+                        wndSum2 = vx_load(q0 + idx2) - vx_load(q1 + idx2) - vx_load(q2 + idx2) + vx_load(q3 + idx2);
+                        if( numType == 2 )
+                            num = v_max(wndSum2 - (num + num) + v_tsum2, v_zero);
+                    }
+
+                    if( isNormed )
+                    {
+                        v_float64 diff2 = v_max(wndSum2 - wndMean2, v_zero);
+                        v_float64 t = v_select(diff2 <= v_min(v_half, v_eps * wndSum2), v_zero, v_sqrt(diff2) * v_tnorm);
+                        v_float64 anum = v_abs(num);
+                        num = v_select(anum < t, num / t,
+                              v_select(anum < t * v_bound, v_select(num > v_zero, v_one, v_minus_one), v_other));
+                    }
+
+                    v_store_low(rrow + j, v_cvt_f32(num));
+                }
+            }
+#endif
+
+            for( ; j < result_.cols; j++, idx += cn, idx2 += cn )
+            {
+                double num = rrow[j], t;
+                double wndMean2 = 0, wndSum2 = 0;
+
+                if( centered_ && numType != 1 )
+                {
+                    for( k = 0; k < cn; k++ )
+                        num += (p0[idx+k] - p1[idx+k] - p2[idx+k] + p3[idx+k])*templMeanC_[k];
+                }
+
+                if( numType == 1 )
+                {
+                    for( k = 0; k < cn; k++ )
+                    {
+                        t = p0[idx+k] - p1[idx+k] - p2[idx+k] + p3[idx+k];
+                        wndMean2 += t*t;
+                        if( !centered_ )
+                            num -= t*templMean[k];
+                    }
+
+                    wndMean2 *= invArea;
+                }
+
+                if( isNormed || numType == 2 )
+                {
+                    for( k = 0; k < cn; k++ )
+                    {
+                        t = q0[idx2+k] - q1[idx2+k] - q2[idx2+k] + q3[idx2+k];
+                        wndSum2 += t;
+                    }
+
+                    if( numType == 2 )
+                    {
+                        num = wndSum2 - 2*num + templSum2;
+                        num = MAX(num, 0.);
+                    }
+                }
+
+                if( isNormed )
+                {
+                    double diff2 = MAX(wndSum2 - wndMean2, 0);
+                    if (diff2 <= std::min(0.5, 10 * FLT_EPSILON * wndSum2))
+                        t = 0; // avoid rounding errors
+                    else
+                        t = std::sqrt(diff2)*templNorm;
+
+                    if( fabs(num) < t )
+                        num /= t;
+                    else if( fabs(num) < t*1.125 )
+                        num = num > 0 ? 1 : -1;
+                    else
+                        num = method != CV_TM_SQDIFF_NORMED ? 0 : 1;
+                }
+
+                rrow[j] = (float)num;
+            }
+        }
+    }
+
+private:
+    Mat sum_, sqsum_;
+    mutable Mat result_;
+    Size templSize_;
+    int method_, cn_;
+    bool centered_;
+    Scalar templMean_, templMeanC_;
+    double templNorm_, templSum2_;
+};
+
+static void normalizeMatchTemplate( const Mat& sum, const Mat& sqsum, const Mat& templ, Mat& result,
+                                    int method, int cn, bool centered )
+{
     int numType = method == CV_TM_CCORR || method == CV_TM_CCORR_NORMED ? 0 :
                   method == CV_TM_CCOEFF || method == CV_TM_CCOEFF_NORMED ? 1 : 2;
-    bool isNormed = method == CV_TM_CCORR_NORMED ||
-                    method == CV_TM_SQDIFF_NORMED ||
-                    method == CV_TM_CCOEFF_NORMED;
 
     double invArea = 1./((double)templ.rows * templ.cols);
 
-    Mat sum, sqsum;
     Scalar templMean, templSdv;
-    double *q0 = 0, *q1 = 0, *q2 = 0, *q3 = 0;
     double templNorm = 0, templSum2 = 0;
 
-    if( method == CV_TM_CCOEFF )
+    if( method == CV_TM_CCOEFF || (centered && method == CV_TM_CCORR) )
     {
-        integral(img, sum, CV_64F);
         templMean = mean(templ);
     }
     else
     {
-        integral(img, sum, sqsum, CV_64F);
+        CV_Assert(sqsum.data != NULL);
         meanStdDev( templ, templMean, templSdv );
 
         templNorm = templSdv[0]*templSdv[0] + templSdv[1]*templSdv[1] + templSdv[2]*templSdv[2] + templSdv[3]*templSdv[3];
@@ -940,92 +1106,37 @@ static void common_matchTemplate( Mat& img, Mat& templ, Mat& result, int method,
         }
 
         templSum2 = templNorm + templMean[0]*templMean[0] + templMean[1]*templMean[1] + templMean[2]*templMean[2] + templMean[3]*templMean[3];
-
-        if( numType != 1 )
-        {
-            templMean = Scalar::all(0);
-            templNorm = templSum2;
-        }
-
-        templSum2 /= invArea;
-        templNorm = std::sqrt(templNorm);
-        templNorm /= std::sqrt(invArea); // care of accuracy here
-
-        CV_Assert(sqsum.data != NULL);
-        q0 = (double*)sqsum.data;
-        q1 = q0 + templ.cols*cn;
-        q2 = (double*)(sqsum.data + templ.rows*sqsum.step);
-        q3 = q2 + templ.cols*cn;
     }
 
-    CV_Assert(sum.data != NULL);
-    double* p0 = (double*)sum.data;
-    double* p1 = p0 + templ.cols*cn;
-    double* p2 = (double*)(sum.data + templ.rows*sum.step);
-    double* p3 = p2 + templ.cols*cn;
-
-    int sumstep = sum.data ? (int)(sum.step / sizeof(double)) : 0;
-    int sqstep = sqsum.data ? (int)(sqsum.step / sizeof(double)) : 0;
-
-    int i, j, k;
-
-    for( i = 0; i < result.rows; i++ )
+    Scalar templMeanC = templMean;
+    if( numType != 1 )
     {
-        float* rrow = result.ptr<float>(i);
-        int idx = i * sumstep;
-        int idx2 = i * sqstep;
-
-        for( j = 0; j < result.cols; j++, idx += cn, idx2 += cn )
-        {
-            double num = rrow[j], t;
-            double wndMean2 = 0, wndSum2 = 0;
-
-            if( numType == 1 )
-            {
-                for( k = 0; k < cn; k++ )
-                {
-                    t = p0[idx+k] - p1[idx+k] - p2[idx+k] + p3[idx+k];
-                    wndMean2 += t*t;
-                    num -= t*templMean[k];
-                }
-
-                wndMean2 *= invArea;
-            }
+        templMean = Scalar::all(0);
+        templNorm = templSum2;
+    }
 
-            if( isNormed || numType == 2 )
-            {
-                for( k = 0; k < cn; k++ )
-                {
-                    t = q0[idx2+k] - q1[idx2+k] - q2[idx2+k] + q3[idx2+k];
-                    wndSum2 += t;
-                }
+    templSum2 /= invArea;
+    templNorm = std::sqrt(templNorm);
+    templNorm /= std::sqrt(invArea); // care of accuracy here
 
-                if( numType == 2 )
-                {
-                    num = wndSum2 - 2*num + templSum2;
-                    num = MAX(num, 0.);
-                }
-            }
+    parallel_for_(Range(0, result.rows),
+                  MatchTemplateNorm_Invoker(sum, sqsum, result, templ.size(), method, cn, centered,
+                                            templMean, templMeanC, templNorm, templSum2),
+                  result.total()/(double)(1 << 16));
+}
 
-            if( isNormed )
-            {
-                double diff2 = MAX(wndSum2 - wndMean2, 0);
-                if (diff2 <= std::min(0.5, 10 * FLT_EPSILON * wndSum2))
-                    t = 0; // avoid rounding errors
-                else
-                    t = std::sqrt(diff2)*templNorm;
+static void common_matchTemplate( Mat& img, Mat& templ, Mat& result, int method, int cn )
+{
+    if( method == CV_TM_CCORR )
+        return;
 
-                if( fabs(num) < t )
-                    num /= t;
-                else if( fabs(num) < t*1.125 )
-                    num = num > 0 ? 1 : -1;
-                else
-                    num = method != CV_TM_SQDIFF_NORMED ? 0 : 1;
-            }
+    Mat sum, sqsum;
+    if( method == CV_TM_CCOEFF )
+        integral(img, sum, CV_64F);
+    else
+        integral(img, sum, sqsum, CV_64F);
 
-            rrow[j] = (float)num;
-        }
-    }
+    normalizeMatchTemplate(sum, sqsum, templ, result, method, cn, false);
 }
 }
 
@@ -1192,6 +1303,188 @@ void cv::matchTemplate( InputArray _img, InputArray _templ, OutputArray _result,
     common_matchTemplate(img, templ, result, method, cn);
 }
 
+namespace cv
+{
+
+class TemplateMatcherImpl CV_FINAL : public TemplateMatcher
+{
+public:
+    explicit TemplateMatcherImpl(int method) : method_(method), dftSize_(0, 0), dftDepth_(-1)
+    {
+        CV_Assert( CV_TM_SQDIFF <= method && method <= CV_TM_CCOEFF_NORMED );
+    }
+
+    void setTemplates(InputArrayOfArrays templs) CV_OVERRIDE;
+    void match(InputArray image, OutputArrayOfArrays results) CV_OVERRIDE;
+
+    void setMethod(int method) CV_OVERRIDE
+    {
+        CV_Assert( CV_TM_SQDIFF <= method && method <= CV_TM_CCOEFF_NORMED );
+        method_ = method;
+    }
+    int getMethod() const CV_OVERRIDE { return method_; }
+
+    void collectGarbage() CV_OVERRIDE
+    {
+        spectra_.clear();
+        imgSpectrum_.release();
+        sum_.release();
+        sqsum_.release();
+        dftSize_ = Size(0, 0);
+        dftDepth_ = -1;
+    }
+
+private:
+    void calcSpectra(Size dftSize, int dftDepth);
+
+    int method_;
+    std::vector<Mat> templs_;
+    Size maxTemplSize_;
+
+    // the spectra of the zero-mean templates of dftSize_, the channels are stacked vertically;
+    // they depend on the image only through dftSize_, so they are kept across the frames
+    std::vector<Mat> spectra_;
+    Size dftSize_;
+    int dftDepth_;
+
+    // per frame buffers
+    Mat imgSpectrum_, sum_, sqsum_;
+};
+
+void TemplateMatcherImpl::setTemplates(InputArrayOfArrays _templs)
+{
+    CV_INSTRUMENT_REGION();
+
+    std::vector<Mat> templs;
+    _templs.getMatVector(templs);
+    CV_Assert( !templs.empty() );
+
+    int type = templs[0].type(), depth = CV_MAT_DEPTH(type);
+    CV_Assert( depth == CV_8U || depth == CV_32F );
+    templs_.resize(templs.size());
+    maxTemplSize_ = Size(0, 0);
+    for( size_t i = 0; i < templs.size(); i++ )
+    {
+        CV_Assert( templs[i].type() == type && templs[i].dims <= 2 && !templs[i].empty() );
+        templs[i].copyTo(templs_[i]);
+        maxTemplSize_.width = std::max(maxTemplSize_.width, templs[i].cols);
+        maxTemplSize_.height = std::max(maxTemplSize_.height, templs[i].rows);
+    }
+    collectGarbage();
+}
+
+void TemplateMatcherImpl::calcSpectra(Size dftSize, int dftDepth)
+{
+    int cn = templs_[0].channels();
+    spectra_.resize(templs_.size());
+
+    parallel_for_(Range(0, (int)templs_.size()), [&](const Range& range)
+    {
+        Mat plane;
+        for( int i = range.start; i < range.end; i++ )
+        {
+            const Mat& templ = templs_[i];
+            Scalar templMean = mean(templ);
+            Mat& spectrum = spectra_[i];
+            spectrum.create(dftSize.height*cn, dftSize.width, dftDepth);
+            spectrum = Scalar::all(0);
+            for( int k = 0; k < cn; k++ )
+            {
+                Mat dst(spectrum, Rect(0, k*dftSize.height, dftSize.width, dftSize.height));
+                if( cn > 1 )
+                    extractChannel(templ, plane, k);
+                else
+                    plane = templ;
+                plane.convertTo(dst(Rect(0, 0, templ.cols, templ.rows)), dftDepth, 1, -templMean[k]);
+                dft(dst, dst, 0, templ.rows);
+            }
+        }
+    });
+
+    dftSize_ = dftSize;
+    dftDepth_ = dftDepth;
+}
+
+void TemplateMatcherImpl::match(InputArray _img, OutputArrayOfArrays _results)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert( !templs_.empty() );
+    Mat img = _img.getMat();
+    int type = img.type(), depth = CV_MAT_DEPTH(type), cn = CV_MAT_CN(type);
+    CV_Assert( type == templs_[0].type() && img.dims <= 2 );
+    CV_Assert( maxTemplSize_.width <= img.cols && maxTemplSize_.height <= img.rows );
+
+    // Unlike crossCorr(), the whole image is transformed at once: the circular correlation does
+    // not wrap around at the valid positions already when the transform is as big as the image,
+    // so the image spectrum serves all the templates. The image and the templates are made
+    // zero-mean before the transform to keep the precision.
+    Size dftSize(getOptimalDFTSize(img.cols), getOptimalDFTSize(img.rows));
+    int dftDepth = depth == CV_8U ? CV_32F : CV_64F;
+    if( dftSize != dftSize_ || dftDepth != dftDepth_ || spectra_.size() != templs_.size() )
+        calcSpectra(dftSize, dftDepth);
+
+    Scalar imgMean = mean(img);
+    imgSpectrum_.create(dftSize.height*cn, dftSize.width, dftDepth);
+    imgSpectrum_ = Scalar::all(0);
+    Mat plane;
+    for( int k = 0; k < cn; k++ )
+    {
+        Mat dst(imgSpectrum_, Rect(0, k*dftSize.height, dftSize.width, dftSize.height));
+        if( cn > 1 )
+            extractChannel(img, plane, k);
+        else
+            plane = img;
+        plane.convertTo(dst(Rect(0, 0, img.cols, img.rows)), dftDepth, 1, -imgMean[k]);
+        dft(dst, dst, 0, img.rows);
+    }
+
+    integral(img, sum_, sqsum_, CV_64F);
+
+    int n = (int)templs_.size();
+    _results.create(n, 1, CV_32F);
+    std::vector<Mat> results(n);
+    for( int i = 0; i < n; i++ )
+    {
+        Size corrSize(img.cols - templs_[i].cols + 1, img.rows - templs_[i].rows + 1);
+        _results.create(corrSize, CV_32F, i);
+        results[i] = _results.getMat(i);
+    }
+
+    parallel_for_(Range(0, n), [&](const Range& range)
+    {
+        Mat corr(dftSize, dftDepth), prod;
+        for( int i = range.start; i < range.end; i++ )
+        {
+            for( int k = 0; k < cn; k++ )
+            {
+                Mat imgPlane(imgSpectrum_, Rect(0, k*dftSize.height, dftSize.width, dftSize.height));
+                Mat templPlane(spectra_[i], Rect(0, k*dftSize.height, dftSize.width, dftSize.height));
+                if( k == 0 )
+                    mulSpectrums(imgPlane, templPlane, corr, 0, true);
+                else
+                {
+                    mulSpectrums(imgPlane, templPlane, prod, 0, true);
+                    corr += prod;
+                }
+            }
+            Mat& result = results[i];
+            dft(corr, corr, DFT_INVERSE + DFT_SCALE, result.rows);
+            corr(Rect(0, 0, result.cols, result.rows)).convertTo(result, CV_32F);
+        }
+    });
+
+    for( int i = 0; i < n; i++ )
+        normalizeMatchTemplate(sum_, sqsum_, templs_[i], results[i], method_, cn, true);
+}
+
+} // namespace cv
+
+cv::Ptr<cv::TemplateMatcher> cv::createTemplateMatcher(int method)
+{
+    return makePtr<TemplateMatcherImpl>(method);
+}
+
 CV_IMPL void
 cvMatchTemplate( const CvArr* _img, const CvArr* _templ, CvArr* _result, int method )
 {
@@ -289,4 +289,65 @@ namespace opencv_test { namespace {
         test.safe_run();
     }
 
+    static Mat makePiecewiseImage(int type)
+    {
+        Mat img(120, 160, CV_MAKETYPE(CV_8U, CV_MAT_CN(type)), Scalar::all(60)), noise(img.size(), CV_32FC(img.channels()));
+        rectangle(img, Rect(30, 20, 80, 60), Scalar(190, 150, 110), -1);
+        circle(img, Point(120, 85), 25, Scalar(20, 230, 90), -1);
+        Mat res;
+        img.convertTo(res, CV_32F);
+        randn(noise, 0, 8);
+        res += noise;
+        res.convertTo(res, type, CV_MAT_DEPTH(type) == CV_32F ? 1./255 : 1);
+        return res;
+    }
+
+    TEST(Imgproc_BilateralFilter, grid)
+    {
+        const int types[] = { CV_8UC1, CV_8UC3, CV_32FC1, CV_32FC3 };
+        for (int i = 0; i < 4; i++)
+        {
+            SCOPED_TRACE(types[i]);
+            Mat src = makePiecewiseImage(types[i]), dst, ref;
+            double scale = CV_MAT_DEPTH(types[i]) == CV_32F ? 1./255 : 1;
+            cv::bilateralFilter(src, ref, -1, 40*scale, 6);
+            cv::bilateralFilter(src, dst, -1, 40*scale, 6, BORDER_DEFAULT, BILATERAL_FILTER_GRID);
+            ASSERT_EQ(src.type(), dst.type());
+            EXPECT_GT(cv::PSNR(ref, dst, 255*scale), 30);
+
+            // in-place
+            Mat dst2 = src.clone();
+            cv::bilateralFilter(dst2, dst2, -1, 40*scale, 6, BORDER_DEFAULT, BILATERAL_FILTER_GRID);
+            EXPECT_EQ(0, cvtest::norm(dst, dst2, NORM_INF));
+        }
+        Mat src = makePiecewiseImage(CV_8UC1), dst;
+        EXPECT_ANY_THROW(cv::bilateralFilter(src, dst, -1, 40, 6, BORDER_DEFAULT, 2));
+        EXPECT_ANY_THROW(cv::jointBilateralFilter(src, Mat(src.size(), CV_16UC1), dst, 40, 6));
+    }
+
+    TEST(Imgproc_BilateralFilter, joint)
+    {
+        // the noisy image is smoothed within the regions of the clean guide, the edges are kept
+        Mat guide(100, 100, CV_8UC1, Scalar(50)), src(guide.size(), CV_32FC1), noise(guide.size(), CV_32FC1), dst;
+        guide(Rect(50, 0, 50, 100)).setTo(200);
+        guide.convertTo(src, CV_32F, 1./255);
+        randn(noise, 0, 0.1);
+        src += noise;
+        cv::jointBilateralFilter(guide, src, dst, 20, 10);
+        ASSERT_EQ(CV_32FC1, dst.type());
+
+        Mat ref;
+        guide.convertTo(ref, CV_32F, 1./255);
+        EXPECT_LT(cvtest::norm(ref(Rect(0, 0, 44, 100)), dst(Rect(0, 0, 44, 100)), NORM_INF), 0.05);
+        EXPECT_LT(cvtest::norm(ref(Rect(56, 0, 44, 100)), dst(Rect(56, 0, 44, 100)), NORM_INF), 0.05);
+        // the pixels next to the edge are not mixed with the other side
+        EXPECT_LT(cvtest::norm(ref(Rect(48, 0, 4, 100)), dst(Rect(48, 0, 4, 100)), NORM_INF), 0.1);
+
+        Mat guide3;
+        cvtColor(guide, guide3, COLOR_GRAY2BGR);
+        Mat dst3;
+        cv::jointBilateralFilter(guide3, src, dst3, 20, 10);
+        EXPECT_LT(cvtest::norm(dst, dst3, NORM_INF), 1e-3);
+    }
+
 }} // namespace
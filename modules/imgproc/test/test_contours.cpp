@@ -485,6 +485,57 @@ TEST(Imgproc_FindContours, border)
     ASSERT_EQ(0, cvtest::norm(img, img_draw_contours, NORM_INF));
 }
 
+TEST(Imgproc_FindContours, parallel)
+{
+    // the parallel implementation is used for the large images when there are several threads,
+    // its result must be the same as the one of the sequential scan
+    const int nthreads = cv::getNumThreads();
+    RNG& rng = theRNG();
+    for (int k = 0; k < 6; k++)
+    {
+        Mat img(480, 640, CV_8UC1);
+        if (k < 3)
+        {
+            // noise of various density
+            Mat noise(img.size(), CV_32F);
+            rng.fill(noise, RNG::UNIFORM, 0, 1);
+            img = noise < (k == 0 ? 0.1 : k == 1 ? 0.5 : 0.9);
+        }
+        else if (k < 5)
+        {
+            // smooth blobs, like the segmentation masks
+            Mat noise(img.size(), CV_32F);
+            rng.fill(noise, RNG::UNIFORM, 0, 1);
+            GaussianBlur(noise, noise, Size(), k == 3 ? 3 : 8);
+            img = noise > 0.5;
+        }
+        else
+        {
+            // nested rings touching the border
+            img.setTo(0);
+            for (int r = 300; r > 0; r -= 7)
+                circle(img, Point(320, 240), r, Scalar::all((r/7) % 2 ? 255 : 0), -1);
+            rectangle(img, Rect(0, 0, 640, 480), Scalar::all(255), 1);
+        }
+        for (int mode = RETR_EXTERNAL; mode <= RETR_TREE; mode++)
+        for (int method = CHAIN_APPROX_NONE; method <= CHAIN_APPROX_TC89_KCOS; method++)
+        {
+            SCOPED_TRACE(cv::format("image=%d mode=%d method=%d", k, mode, method));
+            std::vector<std::vector<Point> > contours, contoursRef;
+            std::vector<Vec4i> hierarchy, hierarchyRef;
+            cv::setNumThreads(1);
+            findContours(img, contoursRef, hierarchyRef, mode, method, Point(3, -2));
+            cv::setNumThreads(std::max(nthreads, 4));
+            findContours(img, contours, hierarchy, mode, method, Point(3, -2));
+            cv::setNumThreads(nthreads);
+
+            ASSERT_EQ(contoursRef.size(), contours.size());
+            EXPECT_TRUE(contoursRef == contours);
+            EXPECT_TRUE(hierarchyRef == hierarchy);
+        }
+    }
+}
+
 TEST(Imgproc_PointPolygonTest, regression_10222)
 {
     vector<Point> contour;
@@ -2055,6 +2055,61 @@ TEST(Imgproc_Morphology, iterated)
     }
 }
 
+// min/max of the shifted copies of the image
+static Mat referenceMorphology(int op, const Mat& src, const Mat& kernel, Point anchor, int borderType)
+{
+    Mat padded, dst;
+    Scalar value = Scalar::all(op == MORPH_ERODE ? DBL_MAX : -DBL_MAX);
+    cv::copyMakeBorder(src, padded, anchor.y, kernel.rows - anchor.y - 1,
+                       anchor.x, kernel.cols - anchor.x - 1, borderType, value);
+    for( int i = 0; i < kernel.rows; i++ )
+        for( int j = 0; j < kernel.cols; j++ )
+        {
+            if( !kernel.at<uchar>(i, j) )
+                continue;
+            Mat shifted = padded(Rect(j, i, src.cols, src.rows));
+            if( dst.empty() )
+                shifted.copyTo(dst);
+            else if( op == MORPH_ERODE )
+                dst = cv::min(dst, shifted);
+            else
+                dst = cv::max(dst, shifted);
+        }
+    return dst;
+}
+
+TEST(Imgproc_Morphology, large_kernels)
+{
+    RNG& rng = theRNG();
+    const int depths[] = { CV_8U, CV_16U, CV_16S, CV_32F, CV_64F };
+    const int borderTypes[] = { BORDER_CONSTANT, BORDER_REPLICATE, BORDER_REFLECT_101 };
+    for( int iter = 0; iter < 40; iter++ )
+    {
+        int type = CV_MAKETYPE(depths[iter % 5], rng.uniform(1, 5));
+        int shape = iter % 3, op = rng.uniform(0, 2);
+        int borderType = borderTypes[rng.uniform(0, 3)];
+        Size ksize(rng.uniform(1, 80), rng.uniform(1, 80));
+        if( shape != MORPH_RECT )
+            ksize.width = ksize.height = std::max(ksize.width, 21);
+        else if( iter % 2 )
+            ksize.width = std::max(ksize.width, 32);
+        Point anchor(rng.uniform(0, ksize.width), rng.uniform(0, ksize.height));
+        Mat kernel = getStructuringElement(shape, ksize, shape == MORPH_CROSS ? anchor : Point(-1, -1));
+        SCOPED_TRACE(cv::format("type=%d shape=%d ksize=%dx%d op=%d border=%d", type, shape,
+                                ksize.width, ksize.height, op, borderType));
+
+        // the pixels around ROI are used by both implementations
+        Mat whole(rng.uniform(1, 150) + 20, rng.uniform(1, 150) + 20, type), dst;
+        randu(whole, 0, 100);
+        Mat src = whole(Rect(10, 10, whole.cols - 20, whole.rows - 20));
+        if( op == MORPH_ERODE )
+            cv::erode(src, dst, kernel, anchor, 1, borderType);
+        else
+            cv::dilate(src, dst, kernel, anchor, 1, borderType);
+        ASSERT_EQ(0.0, cvtest::norm(referenceMorphology(op, src, kernel, anchor, borderType), dst, NORM_INF));
+    }
+}
+
 TEST(Imgproc_Sobel, borderTypes)
 {
     int kernelSize = 3;
@@ -2292,6 +2347,145 @@ TEST(Imgproc_MedianBlur, hires_regression_13409)
     ASSERT_EQ(0.0, cvtest::norm(dst_hires(Rect(516, 516, 1016, 1016)), dst_ref(Rect(4, 4, 1016, 1016)), NORM_INF));
 }
 
+// the lower weighted median of the ksize x ksize neighborhoods with the replicated border
+static Mat referenceWeightedMedian(const Mat& src, int ksize, const Mat& weights)
+{
+    Mat src64, dst64(src.size(), CV_64FC(src.channels())), dst;
+    src.convertTo(src64, CV_64F);
+    int r = ksize/2, cn = src.channels();
+    std::vector<std::pair<double, int> > buf;
+    for (int y = 0; y < src.rows; y++)
+        for (int x = 0; x < src.cols; x++)
+            for (int c = 0; c < cn; c++)
+            {
+                buf.clear();
+                int total = 0;
+                for (int dy = -r; dy <= r; dy++)
+                    for (int dx = -r; dx <= r; dx++)
+                    {
+                        int yy = std::min(std::max(y + dy, 0), src.rows - 1), xx = std::min(std::max(x + dx, 0), src.cols - 1);
+                        int w = weights.empty() ? 1 : weights.at<uchar>(yy, xx);
+                        buf.push_back(std::make_pair(src64.ptr<double>(yy)[xx*cn + c], w));
+                        total += w;
+                    }
+                double v = src64.ptr<double>(y)[x*cn + c];
+                if (total > 0)
+                {
+                    std::sort(buf.begin(), buf.end());
+                    int rank = (total - 1)/2, i = 0;
+                    for (; rank >= buf[i].second; i++)
+                        rank -= buf[i].second;
+                    v = buf[i].first;
+                }
+                dst64.ptr<double>(y)[x*cn + c] = v;
+            }
+    dst64.convertTo(dst, src.type());
+    return dst;
+}
+
+TEST(Imgproc_MedianBlur, large_kernels)
+{
+    RNG& rng = theRNG();
+    const int types[] = { CV_16UC1, CV_16SC1, CV_32FC1, CV_32FC3, CV_8UC2 };
+    const int ksizes[] = { 7, 9, 15, 31 };
+    for (int iter = 0; iter < 20; iter++)
+    {
+        int type = types[iter % 5], ksize = ksizes[rng.uniform(0, 4)];
+        Size size(rng.uniform(1, 150), rng.uniform(1, 100));
+        SCOPED_TRACE(cv::format("type=%d ksize=%d size=%dx%d", type, ksize, size.width, size.height));
+
+        Mat src(size, type), dst;
+        if (CV_MAT_DEPTH(type) == CV_32F)
+            rng.fill(src, RNG::UNIFORM, -1000, 1000);
+        else
+            rng.fill(src, RNG::UNIFORM, CV_MAT_DEPTH(type) == CV_16S ? -20 : 0, 20);
+        cv::medianBlur(src, dst, ksize);
+        EXPECT_EQ(0, cvtest::norm(referenceWeightedMedian(src, ksize, Mat()), dst, NORM_INF));
+
+        // in-place
+        Mat dst2 = src.clone();
+        cv::medianBlur(dst2, dst2, ksize);
+        EXPECT_EQ(0, cvtest::norm(dst, dst2, NORM_INF));
+    }
+}
+
+TEST(Imgproc_MedianBlur, weighted)
+{
+    RNG& rng = theRNG();
+    const int types[] = { CV_8UC1, CV_16UC1, CV_16SC1, CV_32FC1, CV_16UC3 };
+    for (int iter = 0; iter < 20; iter++)
+    {
+        int type = types[iter % 5], ksize = 2*rng.uniform(1, 8) + 1;
+        Size size(rng.uniform(1, 120), rng.uniform(1, 80));
+        SCOPED_TRACE(cv::format("type=%d ksize=%d size=%dx%d", type, ksize, size.width, size.height));
+
+        Mat src(size, type), weights(size, CV_8UC1), invalid(size, CV_8UC1), dst;
+        rng.fill(src, RNG::UNIFORM, 0, 1000);
+        rng.fill(weights, RNG::UNIFORM, 0, 256);
+        // the invalid pixels, as in a depth map
+        rng.fill(invalid, RNG::UNIFORM, 0, 4);
+        weights.setTo(0, invalid == 0);
+        if (iter % 4 == 0)
+            weights = weights != 0;
+        cv::weightedMedianBlur(src, dst, ksize, weights);
+        EXPECT_EQ(0, cvtest::norm(referenceWeightedMedian(src, ksize, weights), dst, NORM_INF));
+    }
+
+    // all the weights are 1, and all the weights are 0
+    Mat src(50, 60, CV_32FC1), dst, ref;
+    randu(src, -1, 1);
+    cv::weightedMedianBlur(src, dst, 9, Mat::ones(src.size(), CV_8UC1));
+    cv::medianBlur(src, ref, 9);
+    EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF));
+    cv::weightedMedianBlur(src, dst, 9, Mat::zeros(src.size(), CV_8UC1));
+    EXPECT_EQ(0, cvtest::norm(src, dst, NORM_INF));
+
+    EXPECT_ANY_THROW(cv::weightedMedianBlur(src, dst, 9, Mat::ones(10, 10, CV_8UC1)));
+    EXPECT_ANY_THROW(cv::weightedMedianBlur(src, dst, 9, Mat::ones(src.size(), CV_32FC1)));
+}
+
+static Mat stackBlurKernel(int ksize)
+{
+    int r = ksize/2;
+    Mat k(ksize, 1, CV_64F);
+    for (int i = 0; i < ksize; i++)
+        k.at<double>(i) = (r + 1 - std::abs(i - r))/(double)((r + 1)*(r + 1));
+    return k;
+}
+
+TEST(Imgproc_StackBlur, accuracy)
+{
+    RNG& rng = theRNG();
+    const int types[] = { CV_8UC1, CV_8UC3, CV_16UC1, CV_16SC2, CV_32FC1, CV_32FC4 };
+    for (int iter = 0; iter < 30; iter++)
+    {
+        int type = types[iter % 6], depth = CV_MAT_DEPTH(type);
+        Size size(rng.uniform(1, 200), rng.uniform(1, 150));
+        Size ksize(2*rng.uniform(0, 50) + 1, 2*rng.uniform(0, 50) + 1);
+        SCOPED_TRACE(cv::format("type=%d size=%dx%d ksize=%dx%d", type, size.width, size.height, ksize.width, ksize.height));
+
+        Mat src(size, type), dst, src64, ref64, ref;
+        rng.fill(src, RNG::UNIFORM, depth == CV_16S ? -30000 : 0, depth == CV_8U ? 256 : depth == CV_32F ? 1 : 30000);
+        cv::stackBlur(src, dst, ksize);
+        ASSERT_EQ(type, dst.type());
+
+        src.convertTo(src64, CV_64F);
+        cv::sepFilter2D(src64, ref64, CV_64F, stackBlurKernel(ksize.width), stackBlurKernel(ksize.height),
+                        Point(-1, -1), 0, BORDER_REPLICATE);
+        ref64.convertTo(ref, type);
+        EXPECT_LE(cvtest::norm(ref, dst, NORM_INF), depth == CV_32F ? 1e-4 : 1);
+
+        // in-place
+        Mat dst2 = src.clone();
+        cv::stackBlur(dst2, dst2, ksize);
+        EXPECT_EQ(0, cvtest::norm(dst, dst2, NORM_INF));
+    }
+
+    Mat src(10, 10, CV_8UC1), dst;
+    EXPECT_ANY_THROW(cv::stackBlur(src, dst, Size(4, 3)));
+    EXPECT_ANY_THROW(cv::stackBlur(Mat(10, 10, CV_64FC1), dst, Size(3, 3)));
+}
+
 TEST(Imgproc_Sobel, s16_regression_13506)
 {
     Mat src = (Mat_<short>(8, 16) << 127, 138, 130, 102, 118,  97,  76,  84, 124,  90, 146,  63, 130,  87, 212,  85,
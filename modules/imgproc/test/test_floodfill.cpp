@@ -541,5 +541,59 @@ TEST(Imgproc_FloodFill, maskValue)
     ASSERT_EQ(1, cvtest::norm(mask.rowRange(1, n-1).colRange(1, n-1), NORM_INF));
 }
 
+TEST(Imgproc_FloodFillRegions, accuracy)
+{
+    RNG& rng = theRNG();
+    const int types[] = { CV_8UC1, CV_8UC3, CV_32SC1, CV_32FC1, CV_32FC3 };
+    for (int iter = 0; iter < 20; iter++)
+    {
+        int type = types[iter % 5], connectivity = iter % 2 ? 8 : 4;
+        Size size(rng.uniform(1, 150), rng.uniform(1, 150));
+        SCOPED_TRACE(cv::format("type=%d connectivity=%d size=%dx%d", type, connectivity, size.width, size.height));
+        Mat img8(size, CV_MAKETYPE(CV_8U, CV_MAT_CN(type))), img;
+        randu(img8, 0, 7);
+        img8.convertTo(img, type);
+        std::vector<Point> seeds;
+        for (int i = 0; i < 20; i++)
+            seeds.push_back(Point(rng.uniform(0, size.width), rng.uniform(0, size.height)));
+
+        Mat labels, stats, centroids;
+        int nlabels = floodFillRegions(img, seeds, labels, stats, centroids, Scalar::all(2), connectivity);
+        ASSERT_EQ(size, labels.size());
+        ASSERT_EQ(CV_32SC1, labels.type());
+        ASSERT_EQ(nlabels, stats.rows);
+        ASSERT_EQ(nlabels, centroids.rows);
+        EXPECT_EQ(size.area(), cvtest::norm(labels >= 0, NORM_L1)/255);
+
+        std::vector<int> seen(nlabels, 0);
+        for (size_t i = 0; i < seeds.size(); i++)
+        {
+            int l = labels.at<int>(seeds[i]);
+            ASSERT_GT(l, 0);
+            seen[l] = 1;
+            Mat work = img.clone(), mask = Mat::zeros(size.height + 2, size.width + 2, CV_8U);
+            Rect rect;
+            int area = floodFill(work, mask, seeds[i], Scalar(), &rect, Scalar::all(2), Scalar::all(2),
+                                 connectivity | FLOODFILL_MASK_ONLY | (255 << 8));
+            Mat region = labels == l;
+            ASSERT_EQ(0, cvtest::norm(mask(Rect(1, 1, size.width, size.height)), region, NORM_INF));
+            EXPECT_EQ(area, stats.at<int>(l, CC_STAT_AREA));
+            EXPECT_EQ(rect, Rect(stats.at<int>(l, CC_STAT_LEFT), stats.at<int>(l, CC_STAT_TOP),
+                                 stats.at<int>(l, CC_STAT_WIDTH), stats.at<int>(l, CC_STAT_HEIGHT)));
+            Moments m = moments(region, true);
+            EXPECT_NEAR(m.m10/m.m00, centroids.at<double>(l, 0), 1e-6);
+            EXPECT_NEAR(m.m01/m.m00, centroids.at<double>(l, 1), 1e-6);
+        }
+        for (int l = 1; l < nlabels; l++)
+            EXPECT_EQ(1, seen[l]);
+        EXPECT_EQ(countNonZero(labels == 0), stats.at<int>(0, CC_STAT_AREA));
+    }
+
+    Mat img(10, 10, CV_8UC1, Scalar::all(0)), labels;
+    EXPECT_ANY_THROW(floodFillRegions(img, std::vector<Point>(1, Point(10, 0)), labels, noArray(), noArray(), Scalar()));
+    EXPECT_EQ(1, floodFillRegions(img, std::vector<Point>(), labels, noArray(), noArray(), Scalar()));
+    EXPECT_EQ(0, countNonZero(labels));
+}
+
 }} // namespace
 /* End of file. */
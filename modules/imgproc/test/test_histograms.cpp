@@ -1994,5 +1994,142 @@ TEST(Imgproc_Hist_Calc, badarg)
 }
 
 
+TEST(Imgproc_CLAHE, multichannel)
+{
+    RNG& rng = theRNG();
+    const int types[] = { CV_8UC3, CV_8UC4, CV_16UC2 };
+    for (int i = 0; i < 3; i++)
+    {
+        SCOPED_TRACE(types[i]);
+        // odd size, so the image is extended to the whole number of tiles
+        Mat src(101, 131, types[i]);
+        rng.fill(src, RNG::UNIFORM, 0, CV_MAT_DEPTH(types[i]) == CV_8U ? 200 : 50000);
+        GaussianBlur(src, src, Size(9, 9), 3);
+
+        Ptr<CLAHE> clahe = createCLAHE(3.0, Size(4, 5));
+        Mat dst;
+        clahe->apply(src, dst);
+        ASSERT_EQ(src.type(), dst.type());
+        ASSERT_EQ(src.size(), dst.size());
+
+        std::vector<Mat> planes;
+        split(src, planes);
+        for (size_t c = 0; c < planes.size(); c++)
+        {
+            Mat ref, plane;
+            clahe->apply(planes[c], ref);
+            extractChannel(dst, plane, (int)c);
+            EXPECT_EQ(0, cvtest::norm(ref, plane, NORM_INF)) << c;
+        }
+    }
+}
+
+TEST(Imgproc_CLAHE, temporal_smoothing)
+{
+    RNG& rng = theRNG();
+    Mat frame1(96, 128, CV_8UC1), frame2;
+    rng.fill(frame1, RNG::UNIFORM, 0, 256);
+    GaussianBlur(frame1, frame1, Size(7, 7), 2);
+    frame1.convertTo(frame2, -1, 0.5, 100);
+
+    Ptr<CLAHE> clahe = createCLAHE(2.0, Size(4, 4)), clahe0 = createCLAHE(2.0, Size(4, 4));
+    clahe->setTemporalSmoothing(0.9);
+    EXPECT_EQ(0.9, clahe->getTemporalSmoothing());
+    Mat dst, ref1, ref2;
+    clahe0->apply(frame1, ref1);
+    clahe0->apply(frame2, ref2);
+
+    // the first frame starts the sequence
+    clahe->apply(frame1, dst);
+    EXPECT_LE(cvtest::norm(ref1, dst, NORM_INF), 1);
+
+    // the next frame is equalized with the histograms of mostly the previous one
+    clahe->apply(frame2, dst);
+    EXPECT_GT(cvtest::norm(ref2, dst, NORM_INF), 10);
+
+    // and the state converges to the histograms of the static scene, up to the rounding
+    for (int i = 0; i < 200; i++)
+        clahe->apply(frame2, dst);
+    EXPECT_LE(cvtest::norm(ref2, dst, NORM_INF), 2);
+
+    // the frame of the other size starts the sequence anew, as well as collectGarbage does
+    Mat small1 = frame1(Rect(0, 0, 64, 64)).clone(), ref3;
+    clahe0->apply(small1, ref3);
+    clahe->apply(small1, dst);
+    EXPECT_LE(cvtest::norm(ref3, dst, NORM_INF), 1);
+    clahe->apply(frame1, dst);
+    clahe->collectGarbage();
+    clahe->apply(frame2, dst);
+    EXPECT_LE(cvtest::norm(ref2, dst, NORM_INF), 1);
+
+    EXPECT_THROW(clahe->setTemporalSmoothing(1.0), cv::Exception);
+    EXPECT_THROW(clahe->setTemporalSmoothing(-0.5), cv::Exception);
+}
+
+// the temporal mode is optional for the user implementations of the interface
+class UserCLAHE CV_FINAL : public CLAHE
+{
+public:
+    void apply(InputArray src, OutputArray dst) CV_OVERRIDE { src.copyTo(dst); }
+    void setClipLimit(double) CV_OVERRIDE {}
+    double getClipLimit() const CV_OVERRIDE { return 0; }
+    void setTilesGridSize(Size) CV_OVERRIDE {}
+    Size getTilesGridSize() const CV_OVERRIDE { return Size(); }
+    void collectGarbage() CV_OVERRIDE {}
+};
+
+TEST(Imgproc_CLAHE, temporal_smoothing_default)
+{
+    Ptr<CLAHE> clahe = makePtr<UserCLAHE>();
+    clahe->setTemporalSmoothing(0.5);
+    EXPECT_EQ(0.0, clahe->getTemporalSmoothing());
+}
+
+TEST(Imgproc_LocalHistogram, accuracy)
+{
+    RNG& rng = theRNG();
+    Mat src(23, 37, CV_8UC1);
+    rng.fill(src, RNG::UNIFORM, 0, 256);
+    // a few values only, so the bins have many pixels
+    src &= 0xF0;
+
+    const int borders[] = { BORDER_REFLECT_101, BORDER_REPLICATE, BORDER_CONSTANT };
+    const Size ksizes[] = { Size(1, 1), Size(5, 7), Size(8, 3), Size(31, 41) };
+    for (int b = 0; b < 3; b++)
+    for (int k = 0; k < 4; k++)
+    {
+        Size ksize = ksizes[k];
+        SCOPED_TRACE(cv::format("border=%d ksize=%dx%d", borders[b], ksize.width, ksize.height));
+        Mat ext;
+        cv::copyMakeBorder(src, ext, ksize.height/2, (ksize.height - 1)/2, ksize.width/2, (ksize.width - 1)/2, borders[b]);
+
+        LocalHistogram lh(src, ksize, borders[b]);
+        // the raster order, then the random positions
+        const int total = (int)src.total();
+        for (int i = 0; i < total + 100; i++)
+        {
+            int x = i < total ? i % src.cols : rng.uniform(0, src.cols);
+            int y = i < total ? i / src.cols : rng.uniform(0, src.rows);
+            lh.moveTo(x, y);
+            ASSERT_EQ(Point(x, y), lh.pos());
+
+            int ref[256] = { 0 };
+            Mat win = ext(Rect(x, y, ksize.width, ksize.height));
+            for (int r = 0; r < win.rows; r++)
+                for (int c = 0; c < win.cols; c++)
+                    ref[win.at<uchar>(r, c)]++;
+            const int* h = lh.hist();
+            for (int v = 0; v < 256; v++)
+                ASSERT_EQ(ref[v], h[v]) << "x=" << x << " y=" << y << " v=" << v;
+        }
+    }
+
+    LocalHistogram lh(src, Size(3, 3));
+    EXPECT_THROW(lh.moveTo(src.cols, 0), cv::Exception);
+    EXPECT_THROW(lh.init(Mat(5, 5, CV_16UC1), Size(3, 3)), cv::Exception);
+    EXPECT_THROW(lh.init(src, Size(3, 3), BORDER_WRAP), cv::Exception);
+}
+
+
 }} // namespace
 /* End Of File */
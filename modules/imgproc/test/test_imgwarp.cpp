@@ -1507,6 +1507,134 @@ TEST(Imgproc_GetAffineTransform, singularity)
     ASSERT_EQ(0.0, cvtest::norm(trans, NORM_INF));
 }
 
+// the reference for the vectorized bilinear, bicubic and Lanczos paths: the coordinates are
+// quantized to 1/INTER_TAB_SIZE like remap() does, the weights are computed in double
+static void referenceRemap(const Mat& src, const Mat& map, Mat& dst, int inter)
+{
+    const int cn = src.channels(), ksize = inter == INTER_LANCZOS4 ? 8 : inter == INTER_CUBIC ? 4 : 2;
+    Mat src64;
+    src.convertTo(src64, CV_64F);
+    Mat dst64(map.size(), CV_64FC(cn));
+    for (int y = 0; y < map.rows; y++)
+        for (int x = 0; x < map.cols; x++)
+        {
+            Vec2f p = map.at<Vec2f>(y, x);
+            int ix = cvRound(p[0]*INTER_TAB_SIZE), iy = cvRound(p[1]*INTER_TAB_SIZE);
+            double fx = (ix & (INTER_TAB_SIZE-1))/(double)INTER_TAB_SIZE;
+            double fy = (iy & (INTER_TAB_SIZE-1))/(double)INTER_TAB_SIZE;
+            int sx = (ix >> INTER_BITS) - (ksize/2 - 1), sy = (iy >> INTER_BITS) - (ksize/2 - 1);
+            double wx[8], wy[8];
+            if (ksize == 2)
+            {
+                wx[0] = 1 - fx; wx[1] = fx;
+                wy[0] = 1 - fy; wy[1] = fy;
+            }
+            else if (ksize == 8)
+            {
+                double sx8 = 0, sy8 = 0;
+                for (int i = 0; i < 8; i++)
+                {
+                    double tx = CV_PI*(fx + 3 - i), ty = CV_PI*(fy + 3 - i);
+                    wx[i] = tx == 0 ? 1 : 4*std::sin(tx)*std::sin(tx/4)/(tx*tx);
+                    wy[i] = ty == 0 ? 1 : 4*std::sin(ty)*std::sin(ty/4)/(ty*ty);
+                    sx8 += wx[i]; sy8 += wy[i];
+                }
+                for (int i = 0; i < 8; i++)
+                {
+                    wx[i] /= sx8; wy[i] /= sy8;
+                }
+            }
+            else
+            {
+                const double A = -0.75;
+                for (int i = 0; i < 4; i++)
+                {
+                    double tx = std::abs(fx + 1 - i), ty = std::abs(fy + 1 - i);
+                    wx[i] = tx <= 1 ? ((A + 2)*tx - (A + 3))*tx*tx + 1 : ((A*tx - 5*A)*tx + 8*A)*tx - 4*A;
+                    wy[i] = ty <= 1 ? ((A + 2)*ty - (A + 3))*ty*ty + 1 : ((A*ty - 5*A)*ty + 8*A)*ty - 4*A;
+                }
+            }
+            double* d = dst64.ptr<double>(y, x);
+            for (int k = 0; k < cn; k++)
+            {
+                double sum = 0;
+                for (int i = 0; i < ksize; i++)
+                    for (int j = 0; j < ksize; j++)
+                    {
+                        int yy = std::min(std::max(sy + i, 0), src.rows - 1);
+                        int xx = std::min(std::max(sx + j, 0), src.cols - 1);
+                        sum += src64.ptr<double>(yy, xx)[k]*wy[i]*wx[j];
+                    }
+                d[k] = sum;
+            }
+        }
+    dst64.convertTo(dst, src.type());
+}
+
+TEST(Imgproc_Remap, simd_paths)
+{
+    RNG& rng = theRNG();
+    const int types[] = { CV_8UC1, CV_8UC2, CV_8UC3, CV_8UC4, CV_16UC1, CV_16UC2, CV_16UC3, CV_16UC4,
+                          CV_16SC1, CV_16SC2, CV_16SC3, CV_16SC4, CV_32FC1, CV_32FC2, CV_32FC3, CV_32FC4 };
+    const int inters[] = { INTER_LINEAR, INTER_CUBIC, INTER_LANCZOS4 };
+    for (int ti = 0; ti < 16; ti++)
+    for (int ii = 0; ii < 3; ii++)
+    {
+        int type = types[ti], inter = inters[ii];
+        SCOPED_TRACE(cv::format("type=%d inter=%d", type, inter));
+        Size ssize(rng.uniform(20, 100), rng.uniform(20, 100)), dsize(rng.uniform(1, 120), rng.uniform(1, 60));
+        Mat src(ssize, type), map(dsize, CV_32FC2), dst, ref;
+        int depth = CV_MAT_DEPTH(type);
+        randu(src, depth == CV_16S ? -32768 : 0, depth == CV_16U ? 65536 : depth == CV_16S ? 32768 : 256);
+        // mostly inner pixels with a few ones near the border
+        randu(map, -1, std::min(ssize.width, ssize.height) + 1);
+
+        cv::remap(src, dst, map, noArray(), inter, BORDER_REPLICATE);
+        referenceRemap(src, map, ref, inter);
+        double eps = depth == CV_32F ? 1e-3 : 1;
+        EXPECT_LE(cvtest::norm(ref, dst, NORM_INF), eps);
+    }
+}
+
+TEST(Imgproc_RemapGrid, affine)
+{
+    // the affine map is reproduced by the bilinear interpolation of the grid exactly
+    const Size ssize(200, 150), dsize(173, 131);
+    const int gridStep = 12;
+    const double M[] = { 0.9, 0.2, 5.3, -0.15, 1.05, 8.7 };
+    Mat map(dsize, CV_32FC2), grid((dsize.height - 1)/gridStep + 2, (dsize.width - 1)/gridStep + 2, CV_32FC2);
+    for (int y = 0; y < map.rows; y++)
+        for (int x = 0; x < map.cols; x++)
+            map.at<Vec2f>(y, x) = Vec2f((float)(M[0]*x + M[1]*y + M[2]), (float)(M[3]*x + M[4]*y + M[5]));
+    for (int y = 0; y < grid.rows; y++)
+        for (int x = 0; x < grid.cols; x++)
+            grid.at<Vec2f>(y, x) = Vec2f((float)(M[0]*x*gridStep + M[1]*y*gridStep + M[2]),
+                                         (float)(M[3]*x*gridStep + M[4]*y*gridStep + M[5]));
+
+    Mat src(ssize, CV_8UC3), dst, ref;
+    randu(src, 0, 256);
+    GaussianBlur(src, src, Size(0, 0), 1.5);
+    const int inters[] = { INTER_LINEAR, INTER_CUBIC };
+    for (int i = 0; i < 2; i++)
+    {
+        SCOPED_TRACE(inters[i]);
+        cv::remap(src, ref, map, noArray(), inters[i], BORDER_CONSTANT, Scalar::all(100));
+        cv::remapGrid(src, dst, grid, dsize, gridStep, inters[i], BORDER_CONSTANT, Scalar::all(100));
+        ASSERT_EQ(dsize, dst.size());
+        EXPECT_LE(cvtest::norm(ref, dst, NORM_INF), 1);
+    }
+
+    // the integer shift, so that the nearest neighbors are the same
+    for (int y = 0; y < grid.rows; y++)
+        for (int x = 0; x < grid.cols; x++)
+            grid.at<Vec2f>(y, x) = Vec2f((float)(x*gridStep + 7), (float)(y*gridStep - 3));
+    cv::remapGrid(src, dst, grid, dsize, gridStep, INTER_NEAREST, BORDER_REPLICATE);
+    cv::copyMakeBorder(src, ref, 3, 0, 0, 0, BORDER_REPLICATE);
+    EXPECT_EQ(0, cvtest::norm(ref(Rect(7, 0, dsize.width, dsize.height)), dst, NORM_INF));
+
+    EXPECT_ANY_THROW(cv::remapGrid(src, dst, grid.rowRange(0, grid.rows - 1), dsize, gridStep, INTER_LINEAR));
+}
+
 TEST(Imgproc_Remap, DISABLED_memleak)
 {
     Mat src;
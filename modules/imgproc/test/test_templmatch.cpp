@@ -334,4 +334,69 @@ void CV_TemplMatchTest::prepare_to_validation( int /*test_case_idx*/ )
 
 TEST(Imgproc_MatchTemplate, accuracy) { CV_TemplMatchTest test; test.safe_run(); }
 
+TEST(Imgproc_MatchTemplate, batch)
+{
+    RNG& rng = theRNG();
+    const int types[] = { CV_8UC1, CV_8UC3, CV_32FC1 };
+    for (int ti = 0; ti < 3; ti++)
+    {
+        int type = types[ti];
+        Mat img(120, 157, type);
+        rng.fill(img, RNG::UNIFORM, 0, 256);
+        GaussianBlur(img, img, Size(5, 5), 2);
+
+        // the parts of the image, a random and a flat template of the different sizes
+        std::vector<Mat> templs;
+        templs.push_back(img(Rect(30, 20, 16, 16)).clone());
+        templs.push_back(img(Rect(100, 70, 25, 9)).clone());
+        templs.push_back(Mat(11, 31, type));
+        rng.fill(templs.back(), RNG::UNIFORM, 0, 256);
+        // (matchTemplate gets a rounding noise instead of zero deviation for the flat float templates)
+        if (CV_MAT_DEPTH(type) == CV_8U)
+            templs.push_back(Mat(7, 7, type, Scalar::all(100)));
+
+        Ptr<TemplateMatcher> matcher = createTemplateMatcher();
+        matcher->setTemplates(templs);
+        for (int method = TM_SQDIFF; method <= TM_CCOEFF_NORMED; method++)
+        {
+            matcher->setMethod(method);
+            // the second frame reuses the spectra of the templates, the third one has another size
+            for (int frame = 0; frame < 3; frame++)
+            {
+                SCOPED_TRACE(cv::format("type=%d method=%d frame=%d", type, method, frame));
+                Mat src = frame < 2 ? img : img(Rect(3, 5, 97, 80));
+                std::vector<Mat> results;
+                matcher->match(src, results);
+                ASSERT_EQ(templs.size(), results.size());
+                for (size_t i = 0; i < templs.size(); i++)
+                {
+                    Mat ref;
+                    matchTemplate(src, templs[i], ref, method);
+                    ASSERT_EQ(ref.size(), results[i].size());
+                    ASSERT_EQ(CV_32FC1, results[i].type());
+                    double scale = method == TM_SQDIFF_NORMED || method == TM_CCORR_NORMED || method == TM_CCOEFF_NORMED ?
+                                   1 : 255.*255.*templs[i].total()*templs[i].channels()*1e-2;
+                    EXPECT_LE(cvtest::norm(ref, results[i], NORM_INF), 1e-4*scale) << i;
+                }
+                if (method == TM_CCOEFF_NORMED && frame == 0)
+                {
+                    Point maxLoc;
+                    minMaxLoc(results[0], 0, 0, 0, &maxLoc);
+                    EXPECT_EQ(Point(30, 20), maxLoc);
+                    minMaxLoc(results[1], 0, 0, 0, &maxLoc);
+                    EXPECT_EQ(Point(100, 70), maxLoc);
+                }
+            }
+        }
+    }
+
+    Ptr<TemplateMatcher> matcher = createTemplateMatcher(TM_SQDIFF);
+    std::vector<Mat> results;
+    EXPECT_THROW(matcher->match(Mat(10, 10, CV_8UC1), results), cv::Exception);
+    matcher->setTemplates(std::vector<Mat>(1, Mat(5, 5, CV_8UC1, Scalar::all(1))));
+    EXPECT_THROW(matcher->match(Mat(10, 10, CV_32FC1), results), cv::Exception);
+    EXPECT_THROW(matcher->match(Mat(4, 10, CV_8UC1), results), cv::Exception);
+    EXPECT_THROW(matcher->setMethod(TM_CCOEFF_NORMED + 1), cv::Exception);
+}
+
 }} // namespace
@@ -37,6 +37,7 @@
 #include "opencv2/core/utils/configuration.private.hpp"
 #include "opencv2/core/utils/logger.hpp"
 #include "opencv2/core/utils/tls.hpp"
+#include "opencv2/core/dlpack.hpp"
 
 #include "pyopencv_generated_include.h"
 #include "opencv2/core/types_c.h"
@@ -2151,6 +2152,125 @@ static PyObject *pycvCreateButton(PyObject*, PyObject *args, PyObject *kw)
 }
 #endif
 
+///////////////////////////////////////////////////////////////////////////////////////
+// DLPack interop
+
+static void pycvDLPackCapsuleDestructor(PyObject* capsule)
+{
+    // the capsule that was not consumed still owns the tensor
+    if (PyCapsule_IsValid(capsule, "dltensor"))
+    {
+        dlpack::ManagedTensor* t = (dlpack::ManagedTensor*)PyCapsule_GetPointer(capsule, "dltensor");
+        if (t && t->deleter)
+            t->deleter(t);
+    }
+}
+
+static void pycvMatCapsuleDestructor(PyObject* capsule)
+{
+    delete (Mat*)PyCapsule_GetPointer(capsule, "cv2.Mat");
+}
+
+// numpy array that shares the data with the matrix and keeps it alive
+static PyObject* pycvWrapMatData(Mat* m)
+{
+    int depth = m->depth(), cn = m->channels();
+    int typenum = depth == CV_8U ? NPY_UBYTE : depth == CV_8S ? NPY_BYTE :
+                  depth == CV_16U ? NPY_USHORT : depth == CV_16S ? NPY_SHORT :
+                  depth == CV_32S ? NPY_INT : depth == CV_32F ? NPY_FLOAT :
+                  depth == CV_64F ? NPY_DOUBLE : NPY_HALF;
+    npy_intp shape[CV_MAX_DIM + 1], strides[CV_MAX_DIM + 1];
+    int ndims = m->dims;
+    for (int i = 0; i < ndims; i++)
+    {
+        shape[i] = m->size[i];
+        strides[i] = (npy_intp)m->step[i];
+    }
+    if (cn > 1)
+    {
+        shape[ndims] = cn;
+        strides[ndims++] = (npy_intp)m->elemSize1();
+    }
+
+    PyObject* base = PyCapsule_New(m, "cv2.Mat", pycvMatCapsuleDestructor);
+    if (!base)
+    {
+        delete m;
+        return NULL;
+    }
+    PyObject* arr = PyArray_New(&PyArray_Type, ndims, shape, typenum, strides, m->data, 0,
+                                NPY_ARRAY_WRITEABLE | NPY_ARRAY_ALIGNED, NULL);
+    if (!arr)
+    {
+        Py_DECREF(base);
+        return NULL;
+    }
+    // the reference to base is stolen even if the call fails
+    if (PyArray_SetBaseObject((PyArrayObject*)arr, base) < 0)
+    {
+        Py_DECREF(arr);
+        return NULL;
+    }
+    return arr;
+}
+
+static PyObject *pycvFromDLPack(PyObject*, PyObject *args, PyObject *kw)
+{
+    const char *keywords[] = { "tensor", "lastDimAsChannels", NULL };
+    PyObject *tensor = NULL;
+    int lastDimAsChannels = 1;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "O|i", (char**)keywords, &tensor, &lastDimAsChannels))
+        return NULL;
+
+    PyObject* obj = tensor;
+    if (PyCapsule_CheckExact(tensor))
+        Py_INCREF(tensor);
+    else if (!(obj = PyObject_CallMethod(tensor, (char*)"__dlpack__", NULL)))
+        return NULL;
+    PySafeObject capsule(obj);
+    if (!PyCapsule_IsValid(capsule, "dltensor"))
+    {
+        failmsg("fromDLPack: expected a DLPack capsule or an object with __dlpack__() method");
+        return NULL;
+    }
+
+    dlpack::ManagedTensor* t = (dlpack::ManagedTensor*)PyCapsule_GetPointer(capsule, "dltensor");
+    Mat* m = new Mat();
+    try
+    {
+        // the deleter of the tensor may need GIL, so it is not released here
+        *m = dlpack::toMat(t, lastDimAsChannels != 0);
+    }
+    catch (const cv::Exception &e)
+    {
+        delete m;
+        pyRaiseCVException(e);
+        return NULL;
+    }
+    // the Mat owns the tensor now
+    PyCapsule_SetName(capsule, "used_dltensor");
+    return pycvWrapMatData(m);
+}
+
+static PyObject *pycvToDLPack(PyObject*, PyObject *args, PyObject *kw)
+{
+    const char *keywords[] = { "mat", NULL };
+    PyObject *pyobj = NULL;
+    Mat m;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "O", (char**)keywords, &pyobj) ||
+        !pyopencv_to(pyobj, m, ArgInfo("mat", 0)))
+        return NULL;
+
+    dlpack::ManagedTensor* t = NULL;
+    ERRWRAP2(t = dlpack::fromMat(m));
+    PyObject* capsule = PyCapsule_New(t, "dltensor", pycvDLPackCapsuleDestructor);
+    if (!capsule)
+        t->deleter(t);
+    return capsule;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////
 
 static int convert_to_char(PyObject *o, char *dst, const ArgInfo& info)
@@ -2188,6 +2308,8 @@ static int convert_to_char(PyObject *o, char *dst, const ArgInfo& info)
 
 static PyMethodDef special_methods[] = {
   {"redirectError", CV_PY_FN_WITH_KW(pycvRedirectError), "redirectError(onError) -> None"},
+  {"fromDLPack", CV_PY_FN_WITH_KW(pycvFromDLPack), "fromDLPack(tensor [, lastDimAsChannels]) -> array; shares the data of the DLPack capsule or the object with __dlpack__() method"},
+  {"toDLPack", CV_PY_FN_WITH_KW(pycvToDLPack), "toDLPack(mat) -> capsule; exports the array as the DLPack capsule without copying"},
 #ifdef HAVE_OPENCV_HIGHGUI
   {"createTrackbar", (PyCFunction)pycvCreateTrackbar, METH_VARARGS, "createTrackbar(trackbarName, windowName, value, count, onChange) -> None"},
   {"createButton", CV_PY_FN_WITH_KW(pycvCreateButton), "createButton(buttonName, onChange [, userData, buttonType, initialButtonState]) -> None"},
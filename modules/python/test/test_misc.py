@@ -80,6 +80,43 @@ class Bindings(NewOpenCVTests):
         except cv.error as _e:
             pass
 
+    def test_dlpack(self):
+        a = np.arange(60, dtype=np.uint8).reshape(4, 5, 3)
+        capsule = cv.toDLPack(a)
+        b = cv.fromDLPack(capsule)
+        self.assertEqual(a.shape, b.shape)
+        self.assertEqual(a.dtype, b.dtype)
+        self.assertTrue(np.array_equal(a, b))
+
+        # the data is shared, not copied
+        b[1, 2, 0] = 255
+        self.assertEqual(255, a[1, 2, 0])
+
+        # the capsule is consumed by the first import
+        with self.assertRaises(Exception):
+            cv.fromDLPack(capsule)
+
+        # the imported array keeps the exported matrix alive
+        c = cv.fromDLPack(cv.toDLPack(np.full((3, 4), 7, dtype=np.int16)))
+        self.assertEqual(7 * 12, int(c.sum()))
+
+        # an unused capsule releases the tensor on its own
+        del capsule
+        capsule = cv.toDLPack(np.zeros((2, 2), dtype=np.float64))
+        del capsule
+
+        if hasattr(np, 'from_dlpack'):
+            f = np.linspace(0, 1, 12, dtype=np.float32).reshape(3, 4)[:, 1:]
+            m = cv.fromDLPack(f)
+            self.assertTrue(np.array_equal(f, m))
+
+            for dtype in (np.int8, np.uint16, np.int32, np.float64, np.float16):
+                x = (np.arange(24) % 7).astype(dtype).reshape(2, 3, 4)
+                for lastDimAsChannels in (True, False):
+                    y = cv.fromDLPack(x, lastDimAsChannels=lastDimAsChannels)
+                    self.assertEqual(x.dtype, y.dtype)
+                    self.assertTrue(np.array_equal(x, y))
+
     def test_overload_resolution_can_choose_correct_overload(self):
         val = 123
         point = (51, 165)